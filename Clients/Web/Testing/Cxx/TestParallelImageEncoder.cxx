@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkImageData.h"
+#include "vtkImageReader2.h"
+#include "vtkJPEGReader.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPNGReader.h"
+#include "vtkPVParallelImageEncoder.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+vtkSmartPointer<vtkImageData> CreateImage(int width, int height, int ncomps)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(width, height, 1);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, ncomps);
+  auto ptr = static_cast<unsigned char*>(image->GetScalarPointer());
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      // smooth gradients with some rings, similar to a rendered scene.
+      const double r = std::sqrt(static_cast<double>((x - width / 2) * (x - width / 2) +
+        (y - height / 2) * (y - height / 2)));
+      const unsigned char values[4] = { static_cast<unsigned char>(255 * x / width),
+        static_cast<unsigned char>(255 * y / height),
+        static_cast<unsigned char>(127 + 127 * std::sin(r / 16.0)), 255 };
+      for (int cc = 0; cc < ncomps; ++cc)
+      {
+        *ptr++ = values[cc];
+      }
+    }
+  }
+  return image;
+}
+
+vtkImageData* Decode(vtkImageReader2* reader, vtkUnsignedCharArray* data)
+{
+  reader->SetMemoryBuffer(data->GetPointer(0));
+  reader->SetMemoryBufferLength(data->GetNumberOfValues());
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// Returns the mean absolute difference between the first components of the
+// two images, or a negative value if their dimensions differ.
+double Compare(vtkImageData* image, vtkImageData* decoded)
+{
+  int dims[3], ddims[3];
+  image->GetDimensions(dims);
+  decoded->GetDimensions(ddims);
+  const int ncomps = std::min(
+    image->GetNumberOfScalarComponents(), decoded->GetNumberOfScalarComponents());
+  if (dims[0] != ddims[0] || dims[1] != ddims[1] || ncomps == 0)
+  {
+    return -1.0;
+  }
+  auto a = static_cast<unsigned char*>(image->GetScalarPointer());
+  auto b = static_cast<unsigned char*>(decoded->GetScalarPointer());
+  double sum = 0.0;
+  const vtkIdType numPixels = static_cast<vtkIdType>(dims[0]) * dims[1];
+  for (vtkIdType cc = 0; cc < numPixels; ++cc)
+  {
+    for (int comp = 0; comp < ncomps; ++comp)
+    {
+      sum += std::abs(a[cc * image->GetNumberOfScalarComponents() + comp] -
+        b[cc * decoded->GetNumberOfScalarComponents() + comp]);
+    }
+  }
+  return sum / (numPixels * ncomps);
+}
+
+bool TestImage(vtkImageData* image, int numberOfThreads)
+{
+  int dims[3];
+  image->GetDimensions(dims);
+  const int ncomps = image->GetNumberOfScalarComponents();
+
+  vtkNew<vtkPVParallelImageEncoder> encoder;
+  encoder->SetNumberOfThreads(numberOfThreads);
+
+  vtkNew<vtkUnsignedCharArray> jpeg;
+  if (!encoder->EncodeJPEG(image, 95, jpeg))
+  {
+    vtkLogF(ERROR, "EncodeJPEG failed.");
+    return false;
+  }
+
+  vtkNew<vtkJPEGReader> jpegReader;
+  const double jpegError = ::Compare(image, ::Decode(jpegReader, jpeg));
+  if (jpegError < 0 || jpegError > 4.0)
+  {
+    vtkLogF(ERROR, "Incorrect JPEG for %dx%dx%d with %d stripes: %g", dims[0], dims[1], ncomps,
+      encoder->GetLastNumberOfStripes(), jpegError);
+    return false;
+  }
+
+  // PNG is lossless.
+  vtkNew<vtkUnsignedCharArray> png;
+  if (!encoder->EncodePNG(image, png))
+  {
+    vtkLogF(ERROR, "EncodePNG failed.");
+    return false;
+  }
+
+  vtkNew<vtkPNGReader> pngReader;
+  if (::Compare(image, ::Decode(pngReader, png)) != 0.0 ||
+    pngReader->GetOutput()->GetNumberOfScalarComponents() != ncomps)
+  {
+    vtkLogF(ERROR, "Incorrect PNG for %dx%dx%d with %d stripes.", dims[0], dims[1], ncomps,
+      encoder->GetLastNumberOfStripes());
+    return false;
+  }
+  return true;
+}
+}
+
+int TestParallelImageEncoder(int, char*[])
+{
+  // odd sizes exercise partial MCUs and uneven stripes.
+  const int sizes[][2] = { { 1, 1 }, { 17, 33 }, { 301, 257 }, { 1920, 1080 } };
+  for (const auto& size : sizes)
+  {
+    for (int ncomps = 1; ncomps <= 4; ++ncomps)
+    {
+      auto image = ::CreateImage(size[0], size[1], ncomps);
+      // use several stripes even when running on a single core, 0 lets
+      // vtkSMPTools decide.
+      for (int threads : { 1, 3, 0 })
+      {
+        if (!::TestImage(image, threads))
+        {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
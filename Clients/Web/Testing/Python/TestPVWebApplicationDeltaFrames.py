@@ -0,0 +1,103 @@
+#### import the simple module from the paraview
+import struct
+
+from paraview import simple
+
+from paraview.modules.vtkPVClientWeb import vtkPVWebApplication
+from paraview.vtk.vtkIOImage import vtkPNGReader
+
+HEADER = "<11I"
+HEADER_SIZE = struct.calcsize(HEADER)
+
+
+def decodePNG(data):
+    reader = vtkPNGReader()
+    reader.SetMemoryBuffer(data)
+    reader.SetMemoryBufferLength(len(data))
+    reader.Update()
+    image = reader.GetOutput()
+    return image.GetNumberOfScalarComponents(), memoryview(
+        image.GetPointData().GetScalars()
+    ).tobytes()
+
+
+# Applies a delta frame to the image displayed by the client, as a web client
+# would. Returns the header of the frame.
+def applyFrame(client, frame):
+    data = memoryview(frame).tobytes()
+    (magic, version, frameId, referenceId, keyFrame, width, height, x, y, w, h) = (
+        struct.unpack_from(HEADER, data)
+    )
+    assert magic == 0x49445650 and version == 2
+    if keyFrame:
+        assert referenceId == 0 and (x, y, w, h) == (0, 0, width, height)
+        client["width"], client["height"] = width, height
+    else:
+        assert referenceId == client["frame"], "client does not have the reference frame"
+    client["frame"] = frameId
+    if w == 0 or h == 0:
+        return keyFrame, referenceId
+
+    ncomps, pixels = decodePNG(data[HEADER_SIZE:])
+    if keyFrame:
+        client["ncomps"] = ncomps
+        client["pixels"] = bytearray(pixels)
+        return keyFrame, referenceId
+
+    # the rectangle uses a top-left origin while images are stored bottom up.
+    ymin = height - y - h
+    rowSize = w * ncomps
+    for row in range(h):
+        start = ((ymin + row) * width + x) * ncomps
+        client["pixels"][start : start + rowSize] = pixels[
+            row * rowSize : (row + 1) * rowSize
+        ]
+    return keyFrame, referenceId
+
+
+def capture(view):
+    image = view.SMProxy.CaptureWindow(1)
+    return memoryview(image.GetPointData().GetScalars()).tobytes()
+
+
+view = simple.CreateRenderView()
+view.ViewSize = [300, 300]
+view.OrientationAxesVisibility = 0
+
+sphere = simple.Sphere()
+simple.Show(sphere, view)
+simple.Render(view)
+
+webApp = vtkPVWebApplication()
+webApp.SetImageCompression(vtkPVWebApplication.COMPRESSION_PNG)
+webApp.SetKeyFrameInterval(0)
+
+client = {}
+
+# nothing acknowledged yet: key frame.
+keyFrame, _ = applyFrame(client, webApp.StillRenderDelta(view.SMProxy))
+assert keyFrame
+assert bytes(client["pixels"]) == capture(view)
+webApp.AcknowledgeFrame(view.SMProxy, client["frame"])
+firstFrame = client["frame"]
+
+# a small change only sends the changed rectangle.
+sphere.Center = [0.05, 0, 0]
+keyFrame, referenceId = applyFrame(
+    client, webApp.StillRenderDelta(view.SMProxy, 100, client["frame"])
+)
+assert not keyFrame and referenceId == firstFrame
+assert webApp.GetLastDeltaFrameSize() > HEADER_SIZE
+assert bytes(client["pixels"]) == capture(view)
+webApp.AcknowledgeFrame(view.SMProxy, client["frame"])
+
+# a client that does not display the acknowledged frame gets a key frame.
+sphere.Center = [0.1, 0, 0]
+client["frame"] = firstFrame
+keyFrame, _ = applyFrame(client, webApp.StillRenderDelta(view.SMProxy, 100, firstFrame))
+assert keyFrame
+assert bytes(client["pixels"]) == capture(view)
+
+simple.Delete(sphere)
+simple.Delete(view)
+del view
@@ -0,0 +1,47 @@
+#### import the simple module from the paraview
+from paraview import simple
+
+from paraview.modules.vtkPVClientWeb import vtkPVWebApplication
+
+
+def stillRender(webApp, view):
+    data = webApp.StillRender(view.SMProxy)
+    assert data is not None and data.GetNumberOfValues() > 0
+    return memoryview(data).tobytes()
+
+
+view = simple.CreateRenderView()
+view.ViewSize = [300, 300]
+
+sphere = simple.Sphere()
+simple.Show(sphere, view)
+simple.Render(view)
+
+webApp = vtkPVWebApplication()
+webApp.SetImageEncoding(vtkPVWebApplication.ENCODING_NONE)
+
+# the first frame goes through vtkDataEncoder.
+first = stillRender(webApp, view)
+
+# two different frames back to back, encoded using several threads.
+webApp.SetNumberOfEncodingThreads(2)
+sphere.Center = [0.2, 0, 0]
+second = stillRender(webApp, view)
+assert second != first
+
+sphere.Center = [0.4, 0, 0]
+third = stillRender(webApp, view)
+assert third != second
+
+# nothing changed, the cached image of the last frame is returned.
+assert stillRender(webApp, view) == third
+assert not webApp.GetHasImagesBeingProcessed(view.SMProxy)
+
+# back to vtkDataEncoder, earlier images must not be returned.
+webApp.SetNumberOfEncodingThreads(1)
+fourth = stillRender(webApp, view)
+assert fourth not in (first, second)
+
+simple.Delete(sphere)
+simple.Delete(view)
+del view
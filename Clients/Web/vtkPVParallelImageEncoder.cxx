@@ -0,0 +1,532 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVParallelImageEncoder.h"
+
+#include "vtkImageData.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+// clang-format off
+#include "vtk_jpeg.h"
+#include "vtk_zlib.h"
+// clang-format on
+
+namespace
+{
+//============================================================================
+// Image access helpers
+//============================================================================
+struct ImageRows
+{
+  const unsigned char* Scalars = nullptr;
+  int Width = 0;
+  int Height = 0;
+  int NumberOfComponents = 0;
+  size_t RowSize = 0;
+
+  bool Initialize(vtkImageData* image)
+  {
+    if (!image || image->GetScalarType() != VTK_UNSIGNED_CHAR ||
+      image->GetPointData()->GetScalars() == nullptr)
+    {
+      return false;
+    }
+    int dims[3];
+    image->GetDimensions(dims);
+    this->Width = dims[0];
+    this->Height = dims[1];
+    this->NumberOfComponents = image->GetNumberOfScalarComponents();
+    this->RowSize = static_cast<size_t>(this->Width) * this->NumberOfComponents;
+    this->Scalars = static_cast<const unsigned char*>(image->GetScalarPointer());
+    return this->Width > 0 && this->Height > 0 && this->NumberOfComponents >= 1 &&
+      this->NumberOfComponents <= 4;
+  }
+
+  // VTK images are stored bottom-up while JPEG and PNG are top-down.
+  const unsigned char* GetRow(int y) const
+  {
+    return this->Scalars + static_cast<size_t>(this->Height - 1 - y) * this->RowSize;
+  }
+};
+
+void CopyToOutput(const std::vector<unsigned char>& buffer, vtkUnsignedCharArray* output)
+{
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfValues(static_cast<vtkIdType>(buffer.size()));
+  std::copy(buffer.begin(), buffer.end(), output->GetPointer(0));
+}
+
+//============================================================================
+// JPEG
+//============================================================================
+struct JPEGErrorManager
+{
+  jpeg_error_mgr Manager;
+  jmp_buf SetJumpBuffer;
+};
+
+void JPEGErrorExit(j_common_ptr cinfo)
+{
+  auto err = reinterpret_cast<JPEGErrorManager*>(cinfo->err);
+  longjmp(err->SetJumpBuffer, 1);
+}
+
+void JPEGOutputMessage(j_common_ptr)
+{
+  // silence libjpeg warnings.
+}
+
+struct JPEGDestinationManager
+{
+  jpeg_destination_mgr Manager;
+  std::vector<unsigned char>* Buffer;
+};
+
+void JPEGInitDestination(j_compress_ptr cinfo)
+{
+  auto dest = reinterpret_cast<JPEGDestinationManager*>(cinfo->dest);
+  dest->Buffer->resize(65536);
+  dest->Manager.next_output_byte = dest->Buffer->data();
+  dest->Manager.free_in_buffer = dest->Buffer->size();
+}
+
+boolean JPEGEmptyOutputBuffer(j_compress_ptr cinfo)
+{
+  auto dest = reinterpret_cast<JPEGDestinationManager*>(cinfo->dest);
+  const size_t oldSize = dest->Buffer->size();
+  dest->Buffer->resize(oldSize * 2);
+  dest->Manager.next_output_byte = dest->Buffer->data() + oldSize;
+  dest->Manager.free_in_buffer = dest->Buffer->size() - oldSize;
+  return TRUE;
+}
+
+void JPEGTermDestination(j_compress_ptr cinfo)
+{
+  auto dest = reinterpret_cast<JPEGDestinationManager*>(cinfo->dest);
+  dest->Buffer->resize(dest->Buffer->size() - dest->Manager.free_in_buffer);
+}
+
+void JPEGConfigure(jpeg_compress_struct& cinfo, int width, int height, int ncomps, int quality)
+{
+  cinfo.image_width = width;
+  cinfo.image_height = height;
+  cinfo.input_components = ncomps;
+  cinfo.in_color_space = ncomps == 1 ? JCS_GRAYSCALE : JCS_RGB;
+  jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, quality, TRUE);
+  // standard Huffman tables are needed for all stripes to share the headers.
+  cinfo.optimize_coding = FALSE;
+}
+
+// Determines the MCU size used for an image with `ncomps` components.
+bool JPEGGetMCUSize(int ncomps, int quality, int& mcuWidth, int& mcuHeight)
+{
+  jpeg_compress_struct cinfo;
+  JPEGErrorManager jerr;
+  cinfo.err = jpeg_std_error(&jerr.Manager);
+  jerr.Manager.error_exit = JPEGErrorExit;
+  jerr.Manager.output_message = JPEGOutputMessage;
+  if (setjmp(jerr.SetJumpBuffer))
+  {
+    jpeg_destroy_compress(&cinfo);
+    return false;
+  }
+  jpeg_create_compress(&cinfo);
+  JPEGConfigure(cinfo, 1, 1, ncomps, quality);
+  int hfactor = 1, vfactor = 1;
+  for (int cc = 0; cc < cinfo.num_components; ++cc)
+  {
+    hfactor = std::max(hfactor, cinfo.comp_info[cc].h_samp_factor);
+    vfactor = std::max(vfactor, cinfo.comp_info[cc].v_samp_factor);
+  }
+  jpeg_destroy_compress(&cinfo);
+  mcuWidth = hfactor * DCTSIZE;
+  mcuHeight = vfactor * DCTSIZE;
+  return true;
+}
+
+// Encodes rows [y0, y1) as a standalone JPEG image.
+bool JPEGEncodeStripe(
+  const ImageRows& rows, int y0, int y1, int quality, std::vector<unsigned char>& buffer)
+{
+  const int ncomps = rows.NumberOfComponents >= 3 ? 3 : 1;
+  std::vector<unsigned char> converted(
+    rows.NumberOfComponents == ncomps ? 0 : static_cast<size_t>(rows.Width) * ncomps);
+
+  jpeg_compress_struct cinfo;
+  JPEGErrorManager jerr;
+  cinfo.err = jpeg_std_error(&jerr.Manager);
+  jerr.Manager.error_exit = JPEGErrorExit;
+  jerr.Manager.output_message = JPEGOutputMessage;
+  if (setjmp(jerr.SetJumpBuffer))
+  {
+    jpeg_destroy_compress(&cinfo);
+    return false;
+  }
+  jpeg_create_compress(&cinfo);
+
+  JPEGDestinationManager dest;
+  dest.Manager.init_destination = JPEGInitDestination;
+  dest.Manager.empty_output_buffer = JPEGEmptyOutputBuffer;
+  dest.Manager.term_destination = JPEGTermDestination;
+  dest.Buffer = &buffer;
+  cinfo.dest = &dest.Manager;
+
+  JPEGConfigure(cinfo, rows.Width, y1 - y0, ncomps, quality);
+  jpeg_start_compress(&cinfo, TRUE);
+  while (cinfo.next_scanline < cinfo.image_height)
+  {
+    const unsigned char* row = rows.GetRow(y0 + static_cast<int>(cinfo.next_scanline));
+    if (!converted.empty())
+    {
+      // drop components that JPEG cannot represent (e.g. alpha).
+      for (int x = 0; x < rows.Width; ++x)
+      {
+        std::copy(row + x * rows.NumberOfComponents,
+          row + x * rows.NumberOfComponents + ncomps, converted.data() + x * ncomps);
+      }
+      row = converted.data();
+    }
+    JSAMPROW samples = const_cast<JSAMPROW>(row);
+    jpeg_write_scanlines(&cinfo, &samples, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  return true;
+}
+
+// Locates the SOF and SOS markers, and the start of the entropy-coded data.
+bool JPEGParseHeader(
+  const std::vector<unsigned char>& data, size_t& sofPos, size_t& sosPos, size_t& scanPos)
+{
+  size_t pos = 2; // skip SOI
+  sofPos = 0;
+  while (pos + 4 <= data.size() && data[pos] == 0xFF)
+  {
+    const unsigned char marker = data[pos + 1];
+    const size_t length = (static_cast<size_t>(data[pos + 2]) << 8) | data[pos + 3];
+    if (marker == 0xC0 || marker == 0xC1)
+    {
+      sofPos = pos;
+    }
+    else if (marker == 0xDA)
+    {
+      sosPos = pos;
+      scanPos = pos + 2 + length;
+      return sofPos != 0 && scanPos + 2 <= data.size();
+    }
+    pos += 2 + length;
+  }
+  return false;
+}
+
+//============================================================================
+// PNG
+//============================================================================
+void AppendUInt32(std::vector<unsigned char>& buffer, vtkTypeUInt32 value)
+{
+  buffer.push_back(static_cast<unsigned char>((value >> 24) & 0xff));
+  buffer.push_back(static_cast<unsigned char>((value >> 16) & 0xff));
+  buffer.push_back(static_cast<unsigned char>((value >> 8) & 0xff));
+  buffer.push_back(static_cast<unsigned char>(value & 0xff));
+}
+
+void AppendPNGChunk(
+  std::vector<unsigned char>& buffer, const char* type, const unsigned char* data, size_t length)
+{
+  AppendUInt32(buffer, static_cast<vtkTypeUInt32>(length));
+  const size_t start = buffer.size();
+  buffer.insert(buffer.end(), type, type + 4);
+  if (length > 0)
+  {
+    buffer.insert(buffer.end(), data, data + length);
+  }
+  AppendUInt32(buffer,
+    static_cast<vtkTypeUInt32>(crc32(0, buffer.data() + start, static_cast<uInt>(length + 4))));
+}
+
+struct PNGStripe
+{
+  std::vector<unsigned char> Buffer;
+  uLong Adler = 0;
+  size_t RawLength = 0;
+};
+
+// Compresses rows [y0, y1) as raw deflate data. Unless `last` is true, the
+// stream is terminated with a sync flush so that stripes can be concatenated.
+bool PNGDeflateStripe(const ImageRows& rows, int y0, int y1, int level, bool last, PNGStripe& stripe)
+{
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  if (deflateInit2(&strm, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    return false;
+  }
+
+  const size_t rowSize = rows.RowSize;
+  const int ncomps = rows.NumberOfComponents;
+  std::vector<unsigned char> filtered(rowSize + 1);
+  stripe.Adler = adler32(0L, Z_NULL, 0);
+  stripe.RawLength = 0;
+  stripe.Buffer.resize(
+    deflateBound(&strm, static_cast<uLong>((rowSize + 1) * (y1 - y0))) + 64);
+  size_t used = 0;
+
+  bool status = true;
+  for (int y = y0; y < y1 && status; ++y)
+  {
+    // use the "Sub" filter which only depends on the current row.
+    const unsigned char* row = rows.GetRow(y);
+    filtered[0] = 1;
+    std::copy(row, row + ncomps, filtered.data() + 1);
+    for (size_t i = ncomps; i < rowSize; ++i)
+    {
+      filtered[i + 1] = static_cast<unsigned char>(row[i] - row[i - ncomps]);
+    }
+    stripe.Adler = adler32(stripe.Adler, filtered.data(), static_cast<uInt>(filtered.size()));
+    stripe.RawLength += filtered.size();
+
+    const int flush = (y + 1 < y1) ? Z_NO_FLUSH : (last ? Z_FINISH : Z_SYNC_FLUSH);
+    strm.next_in = filtered.data();
+    strm.avail_in = static_cast<uInt>(filtered.size());
+    do
+    {
+      if (used == stripe.Buffer.size())
+      {
+        stripe.Buffer.resize(stripe.Buffer.size() * 2);
+      }
+      strm.next_out = stripe.Buffer.data() + used;
+      strm.avail_out = static_cast<uInt>(stripe.Buffer.size() - used);
+      const int ret = deflate(&strm, flush);
+      used = stripe.Buffer.size() - strm.avail_out;
+      if (ret == Z_STREAM_ERROR)
+      {
+        status = false;
+        break;
+      }
+      // keep going until all input is consumed and, when flushing, until
+      // deflate had enough room to write all pending output.
+    } while (strm.avail_in > 0 || (flush != Z_NO_FLUSH && strm.avail_out == 0));
+  }
+  deflateEnd(&strm);
+  stripe.Buffer.resize(used);
+  return status;
+}
+}
+
+vtkStandardNewMacro(vtkPVParallelImageEncoder);
+//----------------------------------------------------------------------------
+vtkPVParallelImageEncoder::vtkPVParallelImageEncoder() = default;
+
+//----------------------------------------------------------------------------
+vtkPVParallelImageEncoder::~vtkPVParallelImageEncoder() = default;
+
+//----------------------------------------------------------------------------
+int vtkPVParallelImageEncoder::GetNumberOfStripes() const
+{
+  return this->NumberOfThreads > 0 ? this->NumberOfThreads
+                                   : std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads());
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVParallelImageEncoder::EncodeJPEG(
+  vtkImageData* image, int quality, vtkUnsignedCharArray* output)
+{
+  ImageRows rows;
+  if (!output || !rows.Initialize(image))
+  {
+    vtkErrorMacro("Unsupported image or missing output.");
+    return false;
+  }
+
+  int mcuWidth, mcuHeight;
+  if (!::JPEGGetMCUSize(rows.NumberOfComponents >= 3 ? 3 : 1, quality, mcuWidth, mcuHeight))
+  {
+    vtkErrorMacro("Failed to initialize JPEG compressor.");
+    return false;
+  }
+
+  // Stripes must be made up of whole MCU rows and the number of MCUs in a
+  // stripe is the restart interval, which must fit in 16 bits.
+  const int mcusPerRow = (rows.Width + mcuWidth - 1) / mcuWidth;
+  const int mcuRows = (rows.Height + mcuHeight - 1) / mcuHeight;
+  const int maxMCURowsPerStripe = 65535 / mcusPerRow;
+  int numStripes = 1;
+  int stripeMCURows = mcuRows;
+  if (maxMCURowsPerStripe > 0)
+  {
+    stripeMCURows = (mcuRows + this->GetNumberOfStripes() - 1) / this->GetNumberOfStripes();
+    stripeMCURows = std::max(1, std::min(stripeMCURows, maxMCURowsPerStripe));
+    numStripes = (mcuRows + stripeMCURows - 1) / stripeMCURows;
+  }
+  const int stripeHeight = stripeMCURows * mcuHeight;
+  this->LastNumberOfStripes = numStripes;
+
+  std::vector<std::vector<unsigned char>> stripes(numStripes);
+  std::vector<unsigned char> succeeded(numStripes, 0);
+  auto encode = [&]() {
+    vtkSMPTools::For(0, numStripes, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        const int y0 = static_cast<int>(cc) * stripeHeight;
+        const int y1 = std::min(y0 + stripeHeight, rows.Height);
+        succeeded[cc] = ::JPEGEncodeStripe(rows, y0, y1, quality, stripes[cc]) ? 1 : 0;
+      }
+    });
+  };
+  if (this->NumberOfThreads > 0)
+  {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ this->NumberOfThreads }, encode);
+  }
+  else
+  {
+    encode();
+  }
+
+  if (std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end())
+  {
+    vtkErrorMacro("Failed to encode JPEG image.");
+    return false;
+  }
+
+  if (numStripes == 1)
+  {
+    ::CopyToOutput(stripes[0], output);
+    return true;
+  }
+
+  // Stitch the stripes together. Headers come from the first stripe with the
+  // image height patched and a DRI marker added. Entropy-coded data of
+  // subsequent stripes follows, separated by RSTn markers.
+  size_t sofPos, sosPos, scanPos;
+  if (!::JPEGParseHeader(stripes[0], sofPos, sosPos, scanPos))
+  {
+    vtkErrorMacro("Failed to parse JPEG stripe.");
+    return false;
+  }
+
+  std::vector<unsigned char> result;
+  result.reserve(std::accumulate(stripes.begin(), stripes.end(), size_t(0),
+    [](size_t sum, const std::vector<unsigned char>& stripe) { return sum + stripe.size(); }));
+  result.insert(result.end(), stripes[0].begin(), stripes[0].begin() + sosPos);
+  // SOF layout: marker (2), length (2), precision (1), height (2), ...
+  result[sofPos + 5] = static_cast<unsigned char>((rows.Height >> 8) & 0xff);
+  result[sofPos + 6] = static_cast<unsigned char>(rows.Height & 0xff);
+
+  const int interval = mcusPerRow * stripeMCURows;
+  const unsigned char dri[6] = { 0xFF, 0xDD, 0x00, 0x04,
+    static_cast<unsigned char>((interval >> 8) & 0xff), static_cast<unsigned char>(interval & 0xff) };
+  result.insert(result.end(), dri, dri + 6);
+
+  // SOS header and the first stripe's data, without EOI.
+  result.insert(result.end(), stripes[0].begin() + sosPos, stripes[0].end() - 2);
+  for (int cc = 1; cc < numStripes; ++cc)
+  {
+    size_t stripeSOF, stripeSOS, stripeScan;
+    if (!::JPEGParseHeader(stripes[cc], stripeSOF, stripeSOS, stripeScan))
+    {
+      vtkErrorMacro("Failed to parse JPEG stripe.");
+      return false;
+    }
+    result.push_back(0xFF);
+    result.push_back(static_cast<unsigned char>(0xD0 + ((cc - 1) & 0x7)));
+    result.insert(result.end(), stripes[cc].begin() + stripeScan, stripes[cc].end() - 2);
+  }
+  result.push_back(0xFF);
+  result.push_back(0xD9);
+
+  ::CopyToOutput(result, output);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVParallelImageEncoder::EncodePNG(vtkImageData* image, vtkUnsignedCharArray* output)
+{
+  ImageRows rows;
+  if (!output || !rows.Initialize(image))
+  {
+    vtkErrorMacro("Unsupported image or missing output.");
+    return false;
+  }
+
+  const int numStripes = std::min(this->GetNumberOfStripes(), rows.Height);
+  const int stripeHeight = (rows.Height + numStripes - 1) / numStripes;
+  this->LastNumberOfStripes = (rows.Height + stripeHeight - 1) / stripeHeight;
+
+  std::vector<::PNGStripe> stripes(this->LastNumberOfStripes);
+  std::vector<unsigned char> succeeded(stripes.size(), 0);
+  const int level = this->PNGCompressionLevel;
+  auto encode = [&]() {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(stripes.size()), 1,
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          const int y0 = static_cast<int>(cc) * stripeHeight;
+          const int y1 = std::min(y0 + stripeHeight, rows.Height);
+          succeeded[cc] =
+            ::PNGDeflateStripe(rows, y0, y1, level, y1 == rows.Height, stripes[cc]) ? 1 : 0;
+        }
+      });
+  };
+  if (this->NumberOfThreads > 0)
+  {
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ this->NumberOfThreads }, encode);
+  }
+  else
+  {
+    encode();
+  }
+
+  if (std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end())
+  {
+    vtkErrorMacro("Failed to encode PNG image.");
+    return false;
+  }
+
+  // zlib stream: header, concatenated deflate data and the combined Adler-32.
+  std::vector<unsigned char> idat = { 0x78, 0x9C };
+  uLong adler = adler32(0L, Z_NULL, 0);
+  for (const auto& stripe : stripes)
+  {
+    idat.insert(idat.end(), stripe.Buffer.begin(), stripe.Buffer.end());
+    adler = adler32_combine(adler, stripe.Adler, static_cast<z_off_t>(stripe.RawLength));
+  }
+  ::AppendUInt32(idat, static_cast<vtkTypeUInt32>(adler));
+
+  // color types: grayscale, grayscale + alpha, RGB, RGBA.
+  const unsigned char colorTypes[4] = { 0, 4, 2, 6 };
+  std::vector<unsigned char> ihdr;
+  ::AppendUInt32(ihdr, static_cast<vtkTypeUInt32>(rows.Width));
+  ::AppendUInt32(ihdr, static_cast<vtkTypeUInt32>(rows.Height));
+  ihdr.push_back(8); // bit depth
+  ihdr.push_back(colorTypes[rows.NumberOfComponents - 1]);
+  ihdr.push_back(0); // compression method
+  ihdr.push_back(0); // filter method
+  ihdr.push_back(0); // interlace method
+
+  std::vector<unsigned char> result = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+  result.reserve(idat.size() + 64);
+  ::AppendPNGChunk(result, "IHDR", ihdr.data(), ihdr.size());
+  ::AppendPNGChunk(result, "IDAT", idat.data(), idat.size());
+  ::AppendPNGChunk(result, "IEND", nullptr, 0);
+
+  ::CopyToOutput(result, output);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVParallelImageEncoder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "PNGCompressionLevel: " << this->PNGCompressionLevel << endl;
+}
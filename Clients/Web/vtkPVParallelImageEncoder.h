@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVParallelImageEncoder
+ * @brief   multi-threaded JPEG/PNG encoder for rendered images.
+ *
+ * vtkPVParallelImageEncoder splits an image into horizontal stripes that are
+ * compressed concurrently using vtkSMPTools and then stitched together into a
+ * single, standard-conforming JPEG or PNG stream.
+ *
+ * For JPEG, each stripe is a whole number of MCU rows and is encoded as an
+ * independent entropy-coded segment. Segments are joined using restart markers
+ * with the restart interval set to the number of MCUs in a stripe, which
+ * produces exactly the same decoded image as a serial encode.
+ *
+ * For PNG, each stripe is compressed as a raw deflate stream terminated with a
+ * sync flush. The streams are concatenated into a single zlib stream inside
+ * one IDAT chunk and their Adler-32 checksums are combined.
+ *
+ * Images must have unsigned char scalars with 1 to 4 components. JPEG only
+ * encodes the luminance or RGB components, alpha is dropped.
+ */
+
+#ifndef vtkPVParallelImageEncoder_h
+#define vtkPVParallelImageEncoder_h
+
+#include "vtkObject.h"
+#include "vtkPVClientWebModule.h" // needed for exports
+
+class vtkImageData;
+class vtkUnsignedCharArray;
+
+class VTKPVCLIENTWEB_EXPORT vtkPVParallelImageEncoder : public vtkObject
+{
+public:
+  static vtkPVParallelImageEncoder* New();
+  vtkTypeMacro(vtkPVParallelImageEncoder, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set the number of threads used to encode stripes. When 0 (default), the
+   * number of threads is determined by vtkSMPTools. The image is split into at
+   * most this many stripes.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the zlib compression level used for PNG. Defaults to 6.
+   */
+  vtkSetClampMacro(PNGCompressionLevel, int, 0, 9);
+  vtkGetMacro(PNGCompressionLevel, int);
+  ///@}
+
+  ///@{
+  /**
+   * Encode `image` and store the result in `output`. Returns false on
+   * failure.
+   */
+  bool EncodeJPEG(vtkImageData* image, int quality, vtkUnsignedCharArray* output);
+  bool EncodePNG(vtkImageData* image, vtkUnsignedCharArray* output);
+  ///@}
+
+  /**
+   * Returns the number of stripes used by the last call to `EncodeJPEG` or
+   * `EncodePNG`.
+   */
+  vtkGetMacro(LastNumberOfStripes, int);
+
+protected:
+  vtkPVParallelImageEncoder();
+  ~vtkPVParallelImageEncoder() override;
+
+  int NumberOfThreads = 0;
+  int PNGCompressionLevel = 6;
+  int LastNumberOfStripes = 0;
+
+private:
+  vtkPVParallelImageEncoder(const vtkPVParallelImageEncoder&) = delete;
+  void operator=(const vtkPVParallelImageEncoder&) = delete;
+
+  int GetNumberOfStripes() const;
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include "vtkPVWebApplication.h"
 
 #include "vtkBase64Utilities.h"
+#include "vtkByteSwap.h"
 #include "vtkCamera.h"
 #include "vtkCommand.h"
 #include "vtkDataEncoder.h"
@@ -11,6 +12,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPNGWriter.h"
+#include "vtkPVParallelImageEncoder.h"
 #include "vtkPVRenderView.h"
 #include "vtkPointData.h"
 #include "vtkRenderWindow.h"
@@ -27,9 +29,150 @@
 #include "vtkWebGLObject.h"
 #include "vtkWebInteractionEvent.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <deque>
 #include <map>
+#include <utility>
+
+namespace
+{
+// Identifies delta frames produced by vtkPVWebApplication::StillRenderDelta.
+constexpr vtkTypeUInt32 DELTA_FRAME_MAGIC = 0x49445650; // "PVDI"
+constexpr vtkTypeUInt32 DELTA_FRAME_VERSION = 2;
+constexpr int DELTA_FRAME_HEADER_SIZE = 11;
+
+// Maximum number of unacknowledged frames to remember per view.
+constexpr size_t MAX_PENDING_FRAMES = 16;
+
+bool CanCompare(vtkImageData* image, vtkImageData* reference)
+{
+  int dims[3], rdims[3];
+  image->GetDimensions(dims);
+  reference->GetDimensions(rdims);
+  return dims[0] == rdims[0] && dims[1] == rdims[1] &&
+    image->GetNumberOfScalarComponents() == reference->GetNumberOfScalarComponents() &&
+    image->GetScalarType() == VTK_UNSIGNED_CHAR && reference->GetScalarType() == VTK_UNSIGNED_CHAR;
+}
+
+// Compares `image` and `reference` tile by tile. On return, `region` is the
+// bounding box of all changed tiles as [xmin, xmax) x [ymin, ymax) in pixels
+// (empty if nothing changed). Returns the fraction of tiles that changed.
+double ComputeDirtyRegion(vtkImageData* image, vtkImageData* reference, int tileSize, int region[4])
+{
+  int dims[3];
+  image->GetDimensions(dims);
+  const int ncomps = image->GetNumberOfScalarComponents();
+  const auto* cur = static_cast<const unsigned char*>(image->GetScalarPointer());
+  const auto* ref = static_cast<const unsigned char*>(reference->GetScalarPointer());
+  const size_t rowSize = static_cast<size_t>(dims[0]) * ncomps;
+
+  region[0] = region[2] = VTK_INT_MAX;
+  region[1] = region[3] = 0;
+  vtkIdType numTiles = 0, numDirtyTiles = 0;
+  for (int ty = 0; ty < dims[1]; ty += tileSize)
+  {
+    const int tyEnd = std::min(ty + tileSize, dims[1]);
+    for (int tx = 0; tx < dims[0]; tx += tileSize)
+    {
+      const int txEnd = std::min(tx + tileSize, dims[0]);
+      const size_t offset = static_cast<size_t>(tx) * ncomps;
+      const size_t length = static_cast<size_t>(txEnd - tx) * ncomps;
+      ++numTiles;
+      for (int y = ty; y < tyEnd; ++y)
+      {
+        if (memcmp(cur + y * rowSize + offset, ref + y * rowSize + offset, length) != 0)
+        {
+          ++numDirtyTiles;
+          region[0] = std::min(region[0], tx);
+          region[1] = std::max(region[1], txEnd);
+          region[2] = std::min(region[2], ty);
+          region[3] = std::max(region[3], tyEnd);
+          break;
+        }
+      }
+    }
+  }
+
+  if (numDirtyTiles == 0)
+  {
+    region[0] = region[1] = region[2] = region[3] = 0;
+  }
+  return numTiles > 0 ? static_cast<double>(numDirtyTiles) / numTiles : 0.0;
+}
+
+vtkSmartPointer<vtkImageData> CropImage(vtkImageData* image, const int region[4])
+{
+  int dims[3];
+  image->GetDimensions(dims);
+  const int ncomps = image->GetNumberOfScalarComponents();
+  const int width = region[1] - region[0];
+  const int height = region[3] - region[2];
+
+  vtkNew<vtkImageData> result;
+  result->SetDimensions(width, height, 1);
+  result->AllocateScalars(VTK_UNSIGNED_CHAR, ncomps);
+
+  const auto* src = static_cast<const unsigned char*>(image->GetScalarPointer());
+  auto* dst = static_cast<unsigned char*>(result->GetScalarPointer());
+  const size_t rowSize = static_cast<size_t>(width) * ncomps;
+  for (int y = 0; y < height; ++y)
+  {
+    memcpy(dst + y * rowSize,
+      src + (static_cast<size_t>(y + region[2]) * dims[0] + region[0]) * ncomps, rowSize);
+  }
+  return result;
+}
+
+// Encodes `image`. When `encoder` is non-null, it is used for JPEG and PNG
+// instead of the serial image writers.
+vtkSmartPointer<vtkUnsignedCharArray> EncodeImage(
+  vtkImageData* image, int compression, int quality, vtkPVParallelImageEncoder* encoder)
+{
+  switch (compression)
+  {
+    case vtkPVWebApplication::COMPRESSION_JPEG:
+    {
+      if (encoder)
+      {
+        vtkNew<vtkUnsignedCharArray> result;
+        if (encoder->EncodeJPEG(image, quality, result))
+        {
+          return result.GetPointer();
+        }
+      }
+      vtkNew<vtkJPEGWriter> writer;
+      writer->WriteToMemoryOn();
+      writer->SetInputData(image);
+      writer->SetQuality(quality);
+      writer->Write();
+      return writer->GetResult();
+    }
+
+    case vtkPVWebApplication::COMPRESSION_PNG:
+    {
+      if (encoder)
+      {
+        vtkNew<vtkUnsignedCharArray> result;
+        if (encoder->EncodePNG(image, result))
+        {
+          return result.GetPointer();
+        }
+      }
+      vtkNew<vtkPNGWriter> writer;
+      writer->WriteToMemoryOn();
+      writer->SetInputData(image);
+      writer->Write();
+      return writer->GetResult();
+    }
+
+    default:
+      return vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetScalars());
+  }
+}
+}
 
 class vtkPVWebApplication::vtkInternals
 {
@@ -40,6 +183,8 @@ public:
     vtkSmartPointer<vtkUnsignedCharArray> Data;
     bool NeedsRender;
     bool HasImagesBeingProcessed;
+    // Whether Data was encoded by the parallel encoder rather than vtkDataEncoder.
+    bool EncodedInParallel = false;
     vtkObject* ViewPointer;
     unsigned long ObserverId;
     ImageCacheValueType()
@@ -89,6 +234,19 @@ public:
   ButtonStatesType ButtonStates;
 
   vtkNew<vtkDataEncoder> Encoder;
+  vtkNew<vtkPVParallelImageEncoder> ParallelEncoder;
+
+  // Returns the parallel encoder configured for `numberOfThreads`, or nullptr
+  // when images should be encoded by a single thread.
+  vtkPVParallelImageEncoder* GetParallelEncoder(int numberOfThreads)
+  {
+    if (numberOfThreads == 1)
+    {
+      return nullptr;
+    }
+    this->ParallelEncoder->SetNumberOfThreads(numberOfThreads);
+    return this->ParallelEncoder;
+  }
 
   // WebGL related struct
   struct WebGLObjCacheValue
@@ -103,6 +261,44 @@ public:
   // map for <vtkSMViewProxy, vtkWebGLExporter>
   std::map<vtkSMViewProxy*, vtkSmartPointer<vtkWebGLExporter>> ViewWebGLMap;
   std::string LastAllWebGLBinaryObjects;
+
+  // Delta encoding related struct
+  struct DeltaFrameState
+  {
+    vtkTypeUInt32 NextFrameId = 1;
+    int FramesSinceKeyFrame = 0;
+    // Frames sent but not yet acknowledged, oldest first.
+    std::deque<std::pair<vtkTypeUInt32, vtkSmartPointer<vtkImageData>>> PendingFrames;
+    // Last acknowledged frame i.e. the image the client is known to have.
+    vtkSmartPointer<vtkImageData> Reference;
+    vtkTypeUInt32 ReferenceId = 0;
+    vtkSmartPointer<vtkUnsignedCharArray> Data;
+    unsigned long ObserverId = 0;
+  };
+  std::map<vtkObject*, DeltaFrameState> DeltaFrames;
+
+  // Returns the delta encoding state for `view`, creating it if needed. The
+  // state is released when the view is deleted.
+  DeltaFrameState& GetDeltaFrameState(vtkObject* view)
+  {
+    DeltaFrameState& state = this->DeltaFrames[view];
+    if (state.ObserverId == 0)
+    {
+      state.ObserverId =
+        view->AddObserver(vtkCommand::DeleteEvent, this, &vtkInternals::ViewDeleted);
+    }
+    return state;
+  }
+
+  void ViewDeleted(vtkObject* view, unsigned long, void*) { this->DeltaFrames.erase(view); }
+
+  ~vtkInternals()
+  {
+    for (auto& item : this->DeltaFrames)
+    {
+      item.first->RemoveObserver(item.second.ObserverId);
+    }
+  }
 };
 
 vtkStandardNewMacro(vtkPVWebApplication);
@@ -155,10 +351,13 @@ vtkUnsignedCharArray* vtkPVWebApplication::StillRender(vtkSMViewProxy* view, int
   vtkInternals::ImageCacheValueType& value = this->Internals->ImageCache[view];
   value.SetListener(view);
 
-  if (value.NeedsRender == false && value.Data != nullptr && view->GetNeedsUpdate() == false)
+  auto parallelEncoder = this->Internals->GetParallelEncoder(this->NumberOfEncodingThreads);
+  if (value.NeedsRender == false && value.Data != nullptr && view->GetNeedsUpdate() == false &&
+    value.EncodedInParallel == (parallelEncoder != nullptr))
   {
     // cout <<  "Reusing cache" << endl;
-    if (doThread)
+    // images encoded in parallel are never pending in vtkDataEncoder.
+    if (doThread && !value.EncodedInParallel)
     {
       bool latest = this->Internals->Encoder->GetLatestOutput(view->GetGlobalID(), value.Data);
       value.HasImagesBeingProcessed = !latest;
@@ -187,13 +386,42 @@ vtkUnsignedCharArray* vtkPVWebApplication::StillRender(vtkSMViewProxy* view, int
   // vtkTimerLog::MarkEndEvent("StillRenderToString");
   // vtkTimerLog::DumpLogWithIndents(&cout, 0.0);
 
-  if (doThread || this->ImageEncoding)
+  const bool wasEncodedInParallel = value.EncodedInParallel;
+  value.EncodedInParallel = parallelEncoder != nullptr;
+  if (parallelEncoder)
+  {
+    // encode synchronously, using multiple threads for a single image.
+    vtkNew<vtkUnsignedCharArray> jpeg;
+    if (!parallelEncoder->EncodeJPEG(image, quality, jpeg))
+    {
+      return nullptr;
+    }
+    if (this->ImageEncoding == ENCODING_BASE64)
+    {
+      vtkNew<vtkBase64Utilities> base64;
+      vtkNew<vtkUnsignedCharArray> encoded;
+      encoded->SetNumberOfValues(4 * ((jpeg->GetNumberOfValues() + 2) / 3) + 1);
+      const unsigned long size = base64->Encode(jpeg->GetPointer(0),
+        static_cast<unsigned long>(jpeg->GetNumberOfValues()), encoded->GetPointer(0), false);
+      // null-terminate, as needed by StillRenderToString().
+      encoded->SetValue(static_cast<vtkIdType>(size), 0);
+      encoded->SetNumberOfValues(static_cast<vtkIdType>(size) + 1);
+      value.Data = encoded;
+    }
+    else
+    {
+      value.Data = jpeg;
+    }
+    value.HasImagesBeingProcessed = false;
+  }
+  else if (doThread || this->ImageEncoding)
   {
     this->Internals->Encoder->Push(view->GetGlobalID(), image, quality, this->ImageEncoding);
 
-    if (value.Data == nullptr)
+    if (value.Data == nullptr || wasEncodedInParallel)
     {
-      // we need to wait till output is processed.
+      // we need to wait till output is processed, older outputs of the
+      // encoder predate the image encoded in parallel.
       // cout << "Flushing" << endl;
       this->Internals->Encoder->Flush(view->GetGlobalID());
       // cout << "Done Flushing" << endl;
@@ -216,6 +444,103 @@ vtkUnsignedCharArray* vtkPVWebApplication::StillRender(vtkSMViewProxy* view, int
   return value.Data;
 }
 
+//----------------------------------------------------------------------------
+vtkUnsignedCharArray* vtkPVWebApplication::StillRenderDelta(
+  vtkSMViewProxy* view, int quality, int referenceFrameId)
+{
+  if (!view)
+  {
+    vtkErrorMacro("No view specified.");
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkImageData> image;
+  image.TakeReference(view->CaptureWindow(1));
+  image->GetDimensions(this->LastStillRenderImageSize);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+
+  vtkInternals::DeltaFrameState& state = this->Internals->GetDeltaFrameState(view);
+  const int* dims = this->LastStillRenderImageSize;
+  int region[4] = { 0, dims[0], 0, dims[1] };
+  bool keyFrame = state.Reference == nullptr || !::CanCompare(image, state.Reference) ||
+    (referenceFrameId >= 0 && static_cast<vtkTypeUInt32>(referenceFrameId) != state.ReferenceId) ||
+    (this->KeyFrameInterval > 0 && state.FramesSinceKeyFrame >= this->KeyFrameInterval);
+  if (!keyFrame &&
+    ::ComputeDirtyRegion(image, state.Reference, this->DeltaTileSize, region) >
+      this->MaximumDeltaFraction)
+  {
+    keyFrame = true;
+    region[0] = region[2] = 0;
+    region[1] = dims[0];
+    region[3] = dims[1];
+  }
+  state.FramesSinceKeyFrame = keyFrame ? 0 : state.FramesSinceKeyFrame + 1;
+
+  vtkSmartPointer<vtkUnsignedCharArray> payload;
+  if (region[1] > region[0] && region[3] > region[2])
+  {
+    payload = ::EncodeImage(keyFrame ? image.GetPointer() : ::CropImage(image, region).GetPointer(),
+      this->ImageCompression, quality,
+      this->Internals->GetParallelEncoder(this->NumberOfEncodingThreads));
+  }
+
+  const vtkTypeUInt32 frameId = state.NextFrameId++;
+  vtkTypeUInt32 header[DELTA_FRAME_HEADER_SIZE] = { DELTA_FRAME_MAGIC, DELTA_FRAME_VERSION,
+    frameId, keyFrame ? 0u : state.ReferenceId, keyFrame ? 1u : 0u,
+    static_cast<vtkTypeUInt32>(dims[0]),
+    static_cast<vtkTypeUInt32>(dims[1]), static_cast<vtkTypeUInt32>(region[0]),
+    static_cast<vtkTypeUInt32>(dims[1] - region[3]),
+    static_cast<vtkTypeUInt32>(region[1] - region[0]),
+    static_cast<vtkTypeUInt32>(region[3] - region[2]) };
+  vtkByteSwap::Swap4LERange(header, DELTA_FRAME_HEADER_SIZE);
+
+  const vtkIdType payloadSize = payload ? payload->GetNumberOfValues() : 0;
+  state.Data = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  state.Data->SetNumberOfValues(sizeof(header) + payloadSize);
+  memcpy(state.Data->GetPointer(0), header, sizeof(header));
+  if (payloadSize > 0)
+  {
+    memcpy(state.Data->GetPointer(sizeof(header)), payload->GetPointer(0), payloadSize);
+  }
+
+  state.PendingFrames.emplace_back(frameId, image);
+  if (state.PendingFrames.size() > MAX_PENDING_FRAMES)
+  {
+    state.PendingFrames.pop_front();
+  }
+
+  timer->StopTimer();
+  this->LastDeltaEncodeTime = timer->GetElapsedTime();
+  this->LastDeltaFrameSize = state.Data->GetNumberOfValues();
+  this->LastDeltaFrameIsKeyFrame = keyFrame;
+  return state.Data;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVWebApplication::AcknowledgeFrame(vtkSMViewProxy* view, unsigned int frameId)
+{
+  auto iter = this->Internals->DeltaFrames.find(view);
+  if (iter == this->Internals->DeltaFrames.end())
+  {
+    return;
+  }
+
+  vtkInternals::DeltaFrameState& state = iter->second;
+  auto pending = std::find_if(state.PendingFrames.begin(), state.PendingFrames.end(),
+    [frameId](const std::pair<vtkTypeUInt32, vtkSmartPointer<vtkImageData>>& item) {
+      return item.first == frameId;
+    });
+  if (pending != state.PendingFrames.end())
+  {
+    // all earlier frames are superseded by this one.
+    state.Reference = pending->second;
+    state.ReferenceId = pending->first;
+    state.PendingFrames.erase(state.PendingFrames.begin(), pending + 1);
+  }
+}
+
 //----------------------------------------------------------------------------
 const char* vtkPVWebApplication::StillRenderToString(
   vtkSMViewProxy* view, unsigned long time, int quality)
@@ -423,5 +748,9 @@ void vtkPVWebApplication::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "ImageEncoding: " << this->ImageEncoding << endl;
+  os << indent << "NumberOfEncodingThreads: " << this->NumberOfEncodingThreads << endl;
   os << indent << "ImageCompression: " << this->ImageCompression << endl;
+  os << indent << "DeltaTileSize: " << this->DeltaTileSize << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+  os << indent << "MaximumDeltaFraction: " << this->MaximumDeltaFraction << endl;
 }
@@ -53,6 +53,19 @@ public:
   vtkGetMacro(ImageCompression, int);
   ///@}
 
+  ///@{
+  /**
+   * Set the number of threads used to compress a single rendered image. When
+   * 1 (default), images are compressed by vtkDataEncoder on a background
+   * thread. Otherwise, each image is split into stripes that are compressed
+   * concurrently using vtkPVParallelImageEncoder, which reduces the latency
+   * for large images; 0 lets vtkSMPTools pick the number of threads. This also
+   * applies to frames returned by `StillRenderDelta()`.
+   */
+  vtkSetClampMacro(NumberOfEncodingThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfEncodingThreads, int);
+  ///@}
+
   ///@{
   /**
    * Render a view and obtain the rendered image.
@@ -64,6 +77,58 @@ public:
     vtkSMViewProxy* view, unsigned long time = 0, int quality = 100);
   ///@}
 
+  ///@{
+  /**
+   * Render a view and obtain a delta-encoded frame. Instead of the full image,
+   * only the rectangle that changed compared to the last frame acknowledged
+   * using `AcknowledgeFrame()` is encoded. A full frame (key frame) is sent
+   * when no frame has been acknowledged yet, when the image size changes,
+   * every `KeyFrameInterval` frames, or when the changed area exceeds
+   * `MaximumDeltaFraction` of the image. When `referenceFrameId` is not
+   * negative, it is the id of the frame currently displayed by the client and
+   * a key frame is also sent if it differs from the last acknowledged frame.
+   *
+   * The returned buffer starts with a header of 11 little-endian 32-bit
+   * unsigned integers: magic number (`0x49445650`, "PVDI"), format version,
+   * frame id, id of the reference frame the rectangle applies to (0 for key
+   * frames), key frame flag, image width, image height, and the x, y, width,
+   * height of the encoded rectangle (top-left origin). The rest of the buffer
+   * is the rectangle encoded using `ImageCompression`. Empty rectangles have no
+   * payload. `ImageEncoding` is not applied to delta frames. Clients that do
+   * not have the reference frame must request a key frame.
+   */
+  vtkUnsignedCharArray* StillRenderDelta(
+    vtkSMViewProxy* view, int quality = 100, int referenceFrameId = -1);
+  void AcknowledgeFrame(vtkSMViewProxy* view, unsigned int frameId);
+  ///@}
+
+  ///@{
+  /**
+   * Parameters controlling delta-encoded frames returned by
+   * `StillRenderDelta()`. The image is compared in square tiles of
+   * `DeltaTileSize` pixels. A key frame is forced every `KeyFrameInterval`
+   * frames (0 to disable) or when the fraction of changed tiles exceeds
+   * `MaximumDeltaFraction`.
+   */
+  vtkSetClampMacro(DeltaTileSize, int, 1, 1024);
+  vtkGetMacro(DeltaTileSize, int);
+  vtkSetClampMacro(KeyFrameInterval, int, 0, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  vtkSetClampMacro(MaximumDeltaFraction, double, 0.0, 1.0);
+  vtkGetMacro(MaximumDeltaFraction, double);
+  ///@}
+
+  ///@{
+  /**
+   * Statistics for the last frame returned by `StillRenderDelta()`: its size
+   * in bytes (including the header), the time spent comparing and encoding it
+   * in seconds, and whether it was a key frame.
+   */
+  vtkGetMacro(LastDeltaFrameSize, vtkIdType);
+  vtkGetMacro(LastDeltaEncodeTime, double);
+  vtkGetMacro(LastDeltaFrameIsKeyFrame, bool);
+  ///@}
+
   /**
    * StillRenderToString() need not necessary returns the most recently rendered
    * image. Use this method to get whether there are any pending images being
@@ -115,8 +180,15 @@ protected:
 
   int ImageEncoding;
   int ImageCompression;
+  int NumberOfEncodingThreads = 1;
   vtkMTimeType LastStillRenderToMTime;
   int LastStillRenderImageSize[3];
+  int DeltaTileSize = 64;
+  int KeyFrameInterval = 60;
+  double MaximumDeltaFraction = 0.5;
+  vtkIdType LastDeltaFrameSize = 0;
+  double LastDeltaEncodeTime = 0.0;
+  bool LastDeltaFrameIsKeyFrame = false;
 
 private:
   vtkPVWebApplication(const vtkPVWebApplication&) = delete;
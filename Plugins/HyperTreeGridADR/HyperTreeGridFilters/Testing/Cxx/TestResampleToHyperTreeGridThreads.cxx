@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMaxArrayMeasurement.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkQuantileArrayMeasurement.h"
+#include "vtkResampleToHyperTreeGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+// A grid with many repeated values so that quantiles depend on the order in
+// which values are accumulated if that order is not preserved.
+vtkSmartPointer<vtkImageData> CreateInput()
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(24, 24, 24);
+  image->SetSpacing(0.5, 0.5, 0.5);
+  vtkNew<vtkDoubleArray> data;
+  data->SetName("data");
+  data->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    image->GetPoint(ptId, x);
+    data->SetValue(ptId, std::floor(8 * std::sin(0.7 * x[0]) * std::cos(0.4 * x[1]) + x[2]));
+  }
+  image->GetPointData()->AddArray(data);
+  return image;
+}
+
+vtkSmartPointer<vtkHyperTreeGrid> Resample(
+  vtkImageData* input, vtkAbstractArrayMeasurement* measurement)
+{
+  vtkNew<vtkResampleToHyperTreeGrid> resample;
+  resample->SetInputData(input);
+  resample->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "data");
+  resample->SetDimensions(4, 4, 4);
+  resample->SetBranchFactor(2);
+  resample->SetMaxDepth(3);
+  resample->SetArrayMeasurement(measurement);
+  resample->Update();
+  return vtkHyperTreeGrid::SafeDownCast(resample->GetOutputDataObject(0));
+}
+
+bool Compare(vtkHyperTreeGrid* expected, vtkHyperTreeGrid* actual, const char* label)
+{
+  if (!expected || !actual)
+  {
+    vtkLogF(ERROR, "%s: missing output.", label);
+    return false;
+  }
+  if (expected->GetNumberOfVertices() != actual->GetNumberOfVertices() ||
+    expected->GetCellData()->GetNumberOfArrays() != actual->GetCellData()->GetNumberOfArrays())
+  {
+    vtkLogF(ERROR, "%s: different hyper tree grids.", label);
+    return false;
+  }
+  vtkDataArray* expectedValues = expected->GetCellData()->GetArray("data_measure");
+  vtkDataArray* values = actual->GetCellData()->GetArray("data_measure");
+  if (!expectedValues || !values ||
+    expectedValues->GetNumberOfTuples() != values->GetNumberOfTuples())
+  {
+    vtkLogF(ERROR, "%s: missing or incomplete measured values.", label);
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < values->GetNumberOfTuples(); ++cellId)
+  {
+    const double expectedValue = expectedValues->GetTuple1(cellId);
+    const double value = values->GetTuple1(cellId);
+    // empty cells are NaN.
+    if (value != expectedValue && !(std::isnan(value) && std::isnan(expectedValue)))
+    {
+      vtkLogF(ERROR, "%s: cell %lld is %g, %g with a single thread.", label,
+        static_cast<long long>(cellId), value, expectedValue);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Resamples with a single thread, then with several, and compares the cell
+// values.
+bool TestMeasurement(vtkImageData* input, vtkAbstractArrayMeasurement* measurement,
+  const std::string& label)
+{
+  vtkSmartPointer<vtkHyperTreeGrid> serial;
+  vtkSMPTools::LocalScope(
+    vtkSMPTools::Config{ 1 }, [&]() { serial = ::Resample(input, measurement); });
+
+  for (int numberOfThreads : { 2, 8 })
+  {
+    vtkSmartPointer<vtkHyperTreeGrid> threaded;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+      [&]() { threaded = ::Resample(input, measurement); });
+    const std::string name = label + " with " + std::to_string(numberOfThreads) + " threads";
+    if (!::Compare(serial, threaded, name.c_str()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestResampleToHyperTreeGridThreads(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  auto input = ::CreateInput();
+  vtkNew<vtkMaxArrayMeasurement> max;
+  vtkNew<vtkQuantileArrayMeasurement> min;
+  min->SetPercentile(0.0);
+  vtkNew<vtkQuantileArrayMeasurement> median;
+  median->SetPercentile(50.0);
+  const bool success = ::TestMeasurement(input, max, "max") &&
+    ::TestMeasurement(input, min, "min") && ::TestMeasurement(input, median, "median");
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
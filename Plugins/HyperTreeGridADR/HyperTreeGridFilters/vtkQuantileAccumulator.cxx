@@ -10,6 +10,7 @@
 #include <cassert>
 #include <iterator>
 #include <memory>
+#include <utility>
 #include <vector>
 
 vtkStandardNewMacro(vtkQuantileAccumulator);
@@ -34,6 +35,7 @@ void vtkQuantileAccumulator::Add(vtkAbstractAccumulator* accumulator)
   {
     std::size_t i = 0;
     ListType out;
+    out.reserve(this->SortedList->size() + quantileAccumulator->SortedList->size());
     while (i < quantileAccumulator->SortedList->size() &&
       (*quantileAccumulator->SortedList)[i].Value < (*this->SortedList)[this->PercentileIdx].Value)
     {
@@ -43,7 +45,7 @@ void vtkQuantileAccumulator::Add(vtkAbstractAccumulator* accumulator)
     std::merge(this->SortedList->begin(), this->SortedList->end(),
       quantileAccumulator->SortedList->cbegin(), quantileAccumulator->SortedList->cend(),
       std::back_inserter(out));
-    this->SortedList = std::make_shared<ListType>(out);
+    this->SortedList = std::make_shared<ListType>(std::move(out));
     this->TotalWeight += quantileAccumulator->TotalWeight;
 
     // Move the percentile in the left direction.
@@ -40,6 +40,7 @@
 #include "vtkPoints.h"
 #include "vtkPolygon.h"
 #include "vtkRedistributeDataSetFilter.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTuple.h"
 #include "vtkUnsignedCharArray.h"
@@ -1012,11 +1013,9 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
     // First pass, we fill the highest resolution grid with input values
     if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS)
     {
-      for (vtkIdType pointId = 0; pointId < dataSet->GetNumberOfPoints(); ++pointId)
-      {
-        double* point = dataSet->GetPoint(pointId);
-        // (i, j, k) are the coordinates of the corresponding hyper tree
-
+      // Finds the hyper tree owning a point and the index of the point in the highest resolution
+      // grid of this hyper tree. Returns false if the point is not owned by this process.
+      auto locatePoint = [this](const double point[3], vtkIdType& gridIdx, vtkIdType& idx) {
         if (!this->LocalHyperTreeBoundingBox.empty())
         {
           // Checking if the considered point is in bounds, i.e. is owned by this process
@@ -1032,10 +1031,11 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
           }
           if (static_cast<std::size_t>(bidx) == this->LocalHyperTreeBoundingBox.size())
           {
-            continue;
+            return false;
           }
         }
 
+        // (i, j, k) are the coordinates of the corresponding hyper tree
         vtkIdType i = this->CellDims[0] == 1
           ? 0
           : std::floor<vtkIdType>(
@@ -1056,48 +1056,145 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
                 this->MaxResolutionPerTree * this->CellDims[2] - 1));
 
         // We bijectively convert the local coordinates within a hyper tree grid to an integer to
-        // pass
-        // it to the std::unordered_map at highest resolution
-        vtkIdType idx = this->MultiResGridCoordinatesToIndex(i % this->MaxResolutionPerTree,
+        // pass it to the std::unordered_map at highest resolution
+        idx = this->MultiResGridCoordinatesToIndex(i % this->MaxResolutionPerTree,
           j % this->MaxResolutionPerTree, k % this->MaxResolutionPerTree, this->MaxDepth);
 
-        vtkIdType gridIdx = this->GridCoordinatesToIndex(i / this->MaxResolutionPerTree,
+        gridIdx = this->GridCoordinatesToIndex(i / this->MaxResolutionPerTree,
           j / this->MaxResolutionPerTree, k / this->MaxResolutionPerTree);
-
-        auto& grid = this->GridOfMultiResolutionGrids[gridIdx][this->MaxDepth];
-
-        auto it = grid.find(idx);
-        // if this is the first time we pass by this grid location, we create a new ArrayMeasurement
-        // instance
-        // NOTE: GridElement::CanSubdivide does not need to be set at the highest resolution
-        if (it == grid.end())
+        return true;
+      };
+
+      // Hyper trees are filled independently, so we first sort the points by hyper tree.
+      // Points keep their input order inside of a hyper tree so the accumulated values do not
+      // depend on the number of threads. The points are split in a fixed number of chunks: each
+      // chunk counts its points in every hyper tree, then writes their ids at its own offsets.
+      // Point ids are stored relative to the first point of a pass on 32 bits, so inputs with
+      // more points are processed in several passes.
+      const vtkIdType numberOfPoints = dataSet->GetNumberOfPoints();
+      const vtkIdType numberOfTrees =
+        static_cast<vtkIdType>(this->GridOfMultiResolutionGrids.size());
+      const vtkIdType maxPointsPerPass = static_cast<vtkIdType>(
+        std::min<vtkTypeUInt64>(VTK_ID_MAX, std::numeric_limits<vtkTypeUInt32>::max()));
+      const vtkIdType maxNumberOfChunks = 256;
+      for (vtkIdType passBegin = 0; passBegin < numberOfPoints;)
+      {
+        const vtkIdType passSize = std::min(numberOfPoints - passBegin, maxPointsPerPass);
+        // There are never more counters than points.
+        const vtkIdType numberOfChunks = std::max<vtkIdType>(
+          1, std::min(maxNumberOfChunks, passSize / std::max<vtkIdType>(numberOfTrees, 1)));
+        const vtkIdType chunkSize = (passSize + numberOfChunks - 1) / numberOfChunks;
+
+        // Counts the points of a chunk in each hyper tree, or writes their ids at the offsets
+        // of the chunk for each hyper tree.
+        std::vector<vtkTypeUInt32> chunkOffsets(numberOfChunks * numberOfTrees, 0);
+        std::vector<vtkTypeUInt32> sortedPointIds;
+        auto binChunks = [&](vtkIdType begin, vtkIdType end, bool scatter) {
+          double point[3];
+          vtkIdType gridIdx, idx;
+          for (vtkIdType chunk = begin; chunk < end; ++chunk)
+          {
+            vtkTypeUInt32* counters = &chunkOffsets[chunk * numberOfTrees];
+            const vtkIdType chunkBegin = chunk * chunkSize;
+            const vtkIdType chunkEnd = chunkBegin + std::min(chunkSize, passSize - chunkBegin);
+            for (vtkIdType cc = chunkBegin; cc < chunkEnd; ++cc)
+            {
+              dataSet->GetPoint(passBegin + cc, point);
+              if (locatePoint(point, gridIdx, idx))
+              {
+                if (scatter)
+                {
+                  sortedPointIds[counters[gridIdx]] = static_cast<vtkTypeUInt32>(cc);
+                }
+                ++counters[gridIdx];
+              }
+            }
+          }
+        };
+        vtkSMPTools::For(0, numberOfChunks,
+          [&](vtkIdType begin, vtkIdType end) { binChunks(begin, end, false); });
+
+        // Turn the counts into offsets, ordered by hyper tree then by chunk.
+        std::vector<vtkIdType> treeOffsets(numberOfTrees + 1);
+        vtkTypeUInt32 offset = 0;
+        for (vtkIdType treeIdx = 0; treeIdx < numberOfTrees; ++treeIdx)
         {
-          GridElement& element = grid[idx];
-          element.NumberOfLeavesInSubtree = 1;
-          element.NumberOfPointsInSubtree = 1;
-          element.AccumulatedWeight = 1.0;
-          element.UnmaskedChildrenHaveNoMaskedLeaves = true;
-          for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+          treeOffsets[treeIdx] = offset;
+          for (vtkIdType chunk = 0; chunk < numberOfChunks; ++chunk)
           {
-            element.ArrayMeasurements.emplace_back(
-              vtkSmartPointer<vtkAbstractArrayMeasurement>::Take(
-                this->ArrayMeasurements[l]->NewInstance()));
-            element.ArrayMeasurements[l]->DeepCopy(this->ArrayMeasurements[l]);
-            element.ArrayMeasurements[l]->Add(
-              dataList[l]->GetTuple(pointId), dataList[l]->GetNumberOfComponents());
+            vtkTypeUInt32& counter = chunkOffsets[chunk * numberOfTrees + treeIdx];
+            const vtkTypeUInt32 count = counter;
+            counter = offset;
+            offset += count;
           }
         }
-        // if not, then the grid location is already created, just need to add the element into it
-        else
-        {
+        treeOffsets[numberOfTrees] = offset;
+
+        sortedPointIds.resize(offset);
+        vtkSMPTools::For(0, numberOfChunks,
+          [&](vtkIdType begin, vtkIdType end) { binChunks(begin, end, true); });
+        chunkOffsets.clear();
+        chunkOffsets.shrink_to_fit();
+
+        vtkSMPTools::For(0, numberOfTrees, [&](vtkIdType begin, vtkIdType end) {
+          double point[3];
+          std::vector<std::vector<double>> tuples(dataList.size());
           for (std::size_t l = 0; l < dataList.size(); ++l)
           {
-            it->second.ArrayMeasurements[l]->Add(
-              dataList[l]->GetTuple(pointId), dataList[l]->GetNumberOfComponents());
+            tuples[l].resize(dataList[l]->GetNumberOfComponents());
           }
-          ++(it->second.NumberOfPointsInSubtree);
-          ++(it->second.AccumulatedWeight);
-        }
+
+          for (vtkIdType treeIdx = begin; treeIdx < end; ++treeIdx)
+          {
+            auto& grid = this->GridOfMultiResolutionGrids[treeIdx][this->MaxDepth];
+            for (vtkIdType cc = treeOffsets[treeIdx]; cc < treeOffsets[treeIdx + 1]; ++cc)
+            {
+              const vtkIdType pointId = passBegin + sortedPointIds[cc];
+              vtkIdType gridIdx, idx;
+              dataSet->GetPoint(pointId, point);
+              locatePoint(point, gridIdx, idx);
+              for (std::size_t l = 0; l < dataList.size(); ++l)
+              {
+                dataList[l]->GetTuple(pointId, tuples[l].data());
+              }
+
+              auto it = grid.find(idx);
+              // if this is the first time we pass by this grid location, we create a new
+              // ArrayMeasurement instance
+              // NOTE: GridElement::CanSubdivide does not need to be set at the highest resolution
+              if (it == grid.end())
+              {
+                GridElement& element = grid[idx];
+                element.NumberOfLeavesInSubtree = 1;
+                element.NumberOfPointsInSubtree = 1;
+                element.AccumulatedWeight = 1.0;
+                element.UnmaskedChildrenHaveNoMaskedLeaves = true;
+                for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+                {
+                  element.ArrayMeasurements.emplace_back(
+                    vtkSmartPointer<vtkAbstractArrayMeasurement>::Take(
+                      this->ArrayMeasurements[l]->NewInstance()));
+                  element.ArrayMeasurements[l]->DeepCopy(this->ArrayMeasurements[l]);
+                  element.ArrayMeasurements[l]->Add(
+                    tuples[l].data(), dataList[l]->GetNumberOfComponents());
+                }
+              }
+              // if not, then the grid location is already created, just need to add the element
+              // into it
+              else
+              {
+                for (std::size_t l = 0; l < dataList.size(); ++l)
+                {
+                  it->second.ArrayMeasurements[l]->Add(
+                    tuples[l].data(), dataList[l]->GetNumberOfComponents());
+                }
+                ++(it->second.NumberOfPointsInSubtree);
+                ++(it->second.AccumulatedWeight);
+              }
+            }
+          }
+        });
+        passBegin += passSize;
       }
     }
     else if (fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_CELLS)
@@ -1276,106 +1373,14 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
     }
   }
 
-  // Now, we fill the multi-resolution grid bottom-up
-  for (std::size_t multiResGridIdx = 0; multiResGridIdx < this->GridOfMultiResolutionGrids.size();
-       ++multiResGridIdx)
-  {
-    auto& multiResolutionGrid = this->GridOfMultiResolutionGrids[multiResGridIdx];
-    for (std::size_t depth = this->MaxDepth; depth; --depth)
-    {
-      // The strategy is the following:
-      // Given an iterator on the elements of the grid at resolution depth,
-      // we propagate the accumulated values to the lower resolution depth-1
-      // using correct indexing
-      for (const auto& mapElement : multiResolutionGrid[depth])
+  // Now, we fill the multi-resolution grid bottom-up, each hyper tree independently
+  vtkSMPTools::For(0, static_cast<vtkIdType>(this->GridOfMultiResolutionGrids.size()),
+    [this](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType multiResGridIdx = begin; multiResGridIdx < end; ++multiResGridIdx)
       {
-        vtkTuple<vtkIdType, 3> coord =
-          this->IndexToMultiResGridCoordinates(mapElement.first, depth);
-        coord[0] /= this->BranchFactor;
-        coord[1] /= this->BranchFactor;
-        coord[2] /= this->BranchFactor;
-        vtkIdType idx =
-          this->MultiResGridCoordinatesToIndex(coord[0], coord[1], coord[2], depth - 1);
-
-        // Same as before: if the grid location is not created yet, we create it, if not,
-        // we merge the corresponding accumulated values
-        auto it = multiResolutionGrid[depth - 1].find(idx);
-        // if the grid element does not exist yet, we create it
-        if (it == multiResolutionGrid[depth - 1].end())
-        {
-          GridElement& element = multiResolutionGrid[depth - 1][idx];
-
-          // Initializing element
-          element.NumberOfLeavesInSubtree = mapElement.second.NumberOfLeavesInSubtree;
-          element.NumberOfPointsInSubtree = mapElement.second.NumberOfPointsInSubtree;
-          element.NumberOfNonMaskedChildren = 1;
-          element.AccumulatedWeight = mapElement.second.AccumulatedWeight;
-
-          // mapElement, from higher depth, can have no children with any masked leaves,
-          // but have a masked children, which we propagate upward.
-          element.UnmaskedChildrenHaveNoMaskedLeaves =
-            mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
-            mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
-
-          // A leaf can be subivided if each of the hypothetical child:
-          // - Has at least MinimumNumberOfPointsInSubtree set by the user
-          // - Has enough points to be measured
-          // Here we check with the first child.
-          element.CanSubdivide =
-            mapElement.second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
-            (!this->ArrayMeasurement ||
-              this->ArrayMeasurement->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
-            (!this->ArrayMeasurementDisplay ||
-              this->ArrayMeasurementDisplay->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
-
-          for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
-          {
-            element.ArrayMeasurements.emplace_back(
-              vtkSmartPointer<vtkAbstractArrayMeasurement>::Take(
-                this->ArrayMeasurements[l]->NewInstance()));
-            element.ArrayMeasurements[l]->DeepCopy(this->ArrayMeasurements[l]);
-            element.ArrayMeasurements[l]->Add(mapElement.second.ArrayMeasurements[l]);
-          }
-        }
-        // else, the grid element is already created, we add data to it
-        else
-        {
-          // Adding information from subtree
-          it->second.NumberOfLeavesInSubtree += mapElement.second.NumberOfLeavesInSubtree;
-          it->second.NumberOfPointsInSubtree += mapElement.second.NumberOfPointsInSubtree;
-          it->second.AccumulatedWeight += mapElement.second.AccumulatedWeight;
-
-          // mapElement, from higher depth, can have no children with any masked leaves,
-          // but have a masked children, which we propagate upward.
-          it->second.UnmaskedChildrenHaveNoMaskedLeaves &=
-            mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
-            mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
-          ++(it->second.NumberOfNonMaskedChildren);
-
-          // A leaf can be subivided if each of the hypothetical child:
-          // - Has at least MinimumNumberOfPointsInSubtree set by the user
-          // - Has enough points to be measured
-          // Here we accumulate for each child
-          it->second.CanSubdivide &=
-            it->second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
-            (!this->ArrayMeasurement ||
-              this->ArrayMeasurement->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
-            (!this->ArrayMeasurementDisplay ||
-              this->ArrayMeasurementDisplay->CanMeasure(
-                mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
-
-          // We add the accumulators from the child
-          for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
-          {
-            it->second.ArrayMeasurements[l]->Add(mapElement.second.ArrayMeasurements[l]);
-          }
-        }
+        this->FillMultiResolutionGrid(this->GridOfMultiResolutionGrids[multiResGridIdx]);
       }
-    }
-  }
+    });
 
   if (this->NoEmptyCells ||
     (this->Extrapolate && !this->ArrayMeasurements.empty() &&
@@ -1493,6 +1498,119 @@ void vtkResampleToHyperTreeGrid::CreateGridOfMultiResolutionGrids(
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkResampleToHyperTreeGrid::FillMultiResolutionGrid(MultiResGridType& multiResolutionGrid)
+{
+  for (std::size_t depth = this->MaxDepth; depth; --depth)
+  {
+    // The strategy is the following:
+    // Given an iterator on the elements of the grid at resolution depth,
+    // we propagate the accumulated values to the lower resolution depth-1
+    // using correct indexing
+    for (auto& mapElement : multiResolutionGrid[depth])
+    {
+      // The accumulators of this element are complete, so we measure them before merging them
+      // into the parent. Only the measured values are kept afterwards.
+      this->MeasureGridElement(mapElement.second);
+
+      vtkTuple<vtkIdType, 3> coord = this->IndexToMultiResGridCoordinates(mapElement.first, depth);
+      coord[0] /= this->BranchFactor;
+      coord[1] /= this->BranchFactor;
+      coord[2] /= this->BranchFactor;
+      vtkIdType idx = this->MultiResGridCoordinatesToIndex(coord[0], coord[1], coord[2], depth - 1);
+
+      // Same as before: if the grid location is not created yet, we create it, if not,
+      // we merge the corresponding accumulated values
+      auto it = multiResolutionGrid[depth - 1].find(idx);
+      // if the grid element does not exist yet, we create it
+      if (it == multiResolutionGrid[depth - 1].end())
+      {
+        GridElement& element = multiResolutionGrid[depth - 1][idx];
+
+        // Initializing element
+        element.NumberOfLeavesInSubtree = mapElement.second.NumberOfLeavesInSubtree;
+        element.NumberOfPointsInSubtree = mapElement.second.NumberOfPointsInSubtree;
+        element.NumberOfNonMaskedChildren = 1;
+        element.AccumulatedWeight = mapElement.second.AccumulatedWeight;
+
+        // mapElement, from higher depth, can have no children with any masked leaves,
+        // but have a masked children, which we propagate upward.
+        element.UnmaskedChildrenHaveNoMaskedLeaves =
+          mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
+          mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
+
+        // A leaf can be subivided if each of the hypothetical child:
+        // - Has at least MinimumNumberOfPointsInSubtree set by the user
+        // - Has enough points to be measured
+        // Here we check with the first child.
+        element.CanSubdivide =
+          mapElement.second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
+          (!this->ArrayMeasurement ||
+            this->ArrayMeasurement->CanMeasure(
+              mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
+          (!this->ArrayMeasurementDisplay ||
+            this->ArrayMeasurementDisplay->CanMeasure(
+              mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
+
+        // The parent takes over the accumulators of its first child instead of copying them.
+        element.ArrayMeasurements = std::move(mapElement.second.ArrayMeasurements);
+      }
+      // else, the grid element is already created, we add data to it
+      else
+      {
+        // Adding information from subtree
+        it->second.NumberOfLeavesInSubtree += mapElement.second.NumberOfLeavesInSubtree;
+        it->second.NumberOfPointsInSubtree += mapElement.second.NumberOfPointsInSubtree;
+        it->second.AccumulatedWeight += mapElement.second.AccumulatedWeight;
+
+        // mapElement, from higher depth, can have no children with any masked leaves,
+        // but have a masked children, which we propagate upward.
+        it->second.UnmaskedChildrenHaveNoMaskedLeaves &=
+          mapElement.second.UnmaskedChildrenHaveNoMaskedLeaves &&
+          mapElement.second.NumberOfNonMaskedChildren == this->NumberOfChildren;
+        ++(it->second.NumberOfNonMaskedChildren);
+
+        // A leaf can be subivided if each of the hypothetical child:
+        // - Has at least MinimumNumberOfPointsInSubtree set by the user
+        // - Has enough points to be measured
+        // Here we accumulate for each child
+        it->second.CanSubdivide &=
+          it->second.NumberOfPointsInSubtree >= this->MinimumNumberOfPointsInSubtree &&
+          (!this->ArrayMeasurement ||
+            this->ArrayMeasurement->CanMeasure(
+              mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight)) &&
+          (!this->ArrayMeasurementDisplay ||
+            this->ArrayMeasurementDisplay->CanMeasure(
+              mapElement.second.NumberOfPointsInSubtree, mapElement.second.AccumulatedWeight));
+
+        // We add the accumulators from the child
+        for (std::size_t l = 0; l < this->ArrayMeasurements.size(); ++l)
+        {
+          it->second.ArrayMeasurements[l]->Add(mapElement.second.ArrayMeasurements[l]);
+        }
+      }
+      mapElement.second.ArrayMeasurements.clear();
+      mapElement.second.ArrayMeasurements.shrink_to_fit();
+    }
+  }
+
+  for (auto& mapElement : multiResolutionGrid[0])
+  {
+    this->MeasureGridElement(mapElement.second);
+    mapElement.second.ArrayMeasurements.clear();
+    mapElement.second.ArrayMeasurements.shrink_to_fit();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkResampleToHyperTreeGrid::MeasureGridElement(GridElement& element)
+{
+  element.MeasuredValues.resize(element.ArrayMeasurements.size(), 0.0);
+  for (std::size_t l = 0; l < element.ArrayMeasurements.size(); ++l)
+  {
+    element.ArrayMeasurements[l]->Measure(element.MeasuredValues[l]);
+  }
+}
 //----------------------------------------------------------------------------
 bool vtkResampleToHyperTreeGrid::RecursivelyFillGaps(vtkCell* cell, const double bounds[6],
   const double cellBounds[6], vtkIdType i, vtkIdType j, vtkIdType k, double x[3],
@@ -1779,20 +1897,11 @@ void vtkResampleToHyperTreeGrid::SubdivideLeaves(vtkHyperTreeGridNonOrientedCurs
 
   std::vector<double> values(this->ArrayMeasurements.size(), 0.0);
 
-  std::size_t offset = this->ArrayMeasurement != nullptr;
-
   if (!values.empty() && it != multiResolutionGrid[level].end())
   {
-    if (!it->second.ArrayMeasurements.empty())
+    if (!it->second.MeasuredValues.empty())
     {
-      if (this->ArrayMeasurement)
-      {
-        it->second.ArrayMeasurements[0]->Measure(values[0]);
-      }
-      for (std::size_t l = offset; l < this->ArrayMeasurements.size(); ++l)
-      {
-        it->second.ArrayMeasurements[l]->Measure(values[l]);
-      }
+      values = it->second.MeasuredValues;
     }
     else
     {
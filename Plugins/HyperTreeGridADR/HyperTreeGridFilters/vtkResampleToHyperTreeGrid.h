@@ -277,6 +277,12 @@ protected:
      */
     std::vector<vtkSmartPointer<vtkAbstractArrayMeasurement>> ArrayMeasurements;
 
+    /**
+     * Values measured on the subtree. Accumulators are released once measured, as the
+     * measured values are all that is needed to generate the hyper trees.
+     */
+    std::vector<double> MeasuredValues;
+
     vtkIdType NumberOfLeavesInSubtree;
     vtkIdType NumberOfPointsInSubtree;
     vtkIdType NumberOfNonMaskedChildren;
@@ -432,6 +438,18 @@ protected:
    */
   void CreateGridOfMultiResolutionGrids(std::vector<vtkDataSet*>& dataSet, int fieldAssociation);
 
+  /**
+   * Fills the lower resolutions of a multi resolution grid bottom-up from its highest resolution.
+   * Accumulators are replaced by their measured values once merged into the parent element.
+   * Multi resolution grids are independent, so this can be run concurrently on different grids.
+   */
+  void FillMultiResolutionGrid(MultiResGridType& multiResolutionGrid);
+
+  /**
+   * Measures the accumulators of a grid element into GridElement::MeasuredValues.
+   */
+  void MeasureGridElement(GridElement& element);
+
   ///@{
   /**
    * This method computes the intersection volume between a box and a vtkCell3D.
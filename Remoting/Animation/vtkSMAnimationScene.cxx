@@ -28,6 +28,7 @@
 #include <vector>
 
 bool vtkSMAnimationScene::GlobalUseGeometryCache;
+unsigned long vtkSMAnimationScene::GlobalGeometryCacheLimit;
 //----------------------------------------------------------------------------
 void vtkSMAnimationScene::SetGlobalUseGeometryCache(bool val)
 {
@@ -40,6 +41,18 @@ bool vtkSMAnimationScene::GetGlobalUseGeometryCache()
   return vtkSMAnimationScene::GlobalUseGeometryCache;
 }
 
+//----------------------------------------------------------------------------
+void vtkSMAnimationScene::SetGlobalGeometryCacheLimit(unsigned long val)
+{
+  vtkSMAnimationScene::GlobalGeometryCacheLimit = val;
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkSMAnimationScene::GetGlobalGeometryCacheLimit()
+{
+  return vtkSMAnimationScene::GlobalGeometryCacheLimit;
+}
+
 //----------------------------------------------------------------------------
 class vtkSMAnimationScene::vtkInternals
 {
@@ -112,6 +125,19 @@ public:
       iter->GetPointer()->UpdateProperty("UseCache");
     }
   }
+
+  void PassCacheLimit(unsigned long limit)
+  {
+    VectorOfViews::iterator iter = this->ViewModules.begin();
+    for (; iter != this->ViewModules.end(); ++iter)
+    {
+      if (iter->GetPointer()->GetProperty("CacheLimit"))
+      {
+        vtkSMPropertyHelper((*iter), "CacheLimit").Set(static_cast<int>(limit));
+        iter->GetPointer()->UpdateProperty("CacheLimit");
+      }
+    }
+  }
 };
 
 namespace
@@ -462,6 +488,7 @@ void vtkSMAnimationScene::TickInternal(double currenttime, double deltatime, dou
   if (caching_enabled)
   {
     this->Internals->PassUseCache(true);
+    this->Internals->PassCacheLimit(vtkSMAnimationScene::GlobalGeometryCacheLimit);
     this->Internals->PassCacheTime(currenttime);
   }
 
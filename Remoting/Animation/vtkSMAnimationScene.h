@@ -190,6 +190,16 @@ public:
   static bool GetGlobalUseGeometryCache();
   ///@}
 
+  ///@{
+  /**
+   * Set the per-rank geometry cache limit, in KiB, passed on to views when
+   * caching is enabled. 0 implies no limit. Typically, one uses
+   * vtkPVGeneralSettings to set this rather than using this API directly.
+   */
+  static void SetGlobalGeometryCacheLimit(unsigned long);
+  static unsigned long GetGlobalGeometryCacheLimit();
+  ///@}
+
 protected:
   vtkSMAnimationScene();
   ~vtkSMAnimationScene() override;
@@ -234,6 +244,7 @@ private:
   unsigned long TimestepValuesObserverID;
 
   static bool GlobalUseGeometryCache;
+  static unsigned long GlobalGeometryCacheLimit;
 };
 
 #endif
@@ -0,0 +1,63 @@
+import os
+import os.path
+import shutil
+from paraview.simple import *
+from paraview import smtesting
+smtesting.ProcessCommandLineArguments()
+
+dname = os.path.join(smtesting.TempDir, "file_series_prefetch")
+shutil.rmtree(dname, ignore_errors=True)
+os.makedirs(dname)
+
+# Save a series of spheres with increasing radius.
+sphere = Sphere()
+fnames = []
+for ts in range(8):
+    sphere.Radius = ts + 1
+    fname = os.path.join(dname, "sphere_%d.vtp" % ts)
+    fnames.append(fname)
+    SaveData(fname, proxy=sphere)
+
+reader = XMLPolyDataReader(FileName=fnames, NumberOfFilesToPrefetch=3)
+fileSeries = reader.GetClientSideObject()
+if fileSeries.GetNumberOfFilesToPrefetch() != 3:
+    raise smtesting.TestError("NumberOfFilesToPrefetch not passed to the reader.")
+
+def check(ts):
+    reader.UpdatePipeline(ts)
+    bounds = reader.GetDataInformation().GetBounds()
+    if abs(bounds[1] - (ts + 1)) > 1e-3 * (ts + 1):
+        raise smtesting.TestError("Incorrect data for timestep %d: %s" % (ts, bounds))
+
+# Playing forward, each file after the first one is taken from the prefetched
+# files, unless the reader gets to it before the prefetching thread.
+fileSeries.ResetPrefetchStatistics()
+for ts in range(len(fnames)):
+    check(ts)
+hits = fileSeries.GetPrefetchHits()
+misses = fileSeries.GetPrefetchMisses()
+if hits + misses != len(fnames) - 1:
+    raise smtesting.TestError(
+        "Every file change must be counted (%d hits, %d misses)." % (hits, misses))
+if hits == 0:
+    raise smtesting.TestError("No prefetched file used while playing forward.")
+
+# Playing backward, the first file is a miss since files after the current one
+# were prefetched.
+fileSeries.ResetPrefetchStatistics()
+for ts in reversed(range(len(fnames) - 1)):
+    check(ts)
+hits = fileSeries.GetPrefetchHits()
+misses = fileSeries.GetPrefetchMisses()
+if hits + misses != len(fnames) - 1 or misses == 0:
+    raise smtesting.TestError(
+        "Incorrect counts playing backward (%d hits, %d misses)." % (hits, misses))
+
+# Disabling prefetching keeps reading correctly.
+reader.NumberOfFilesToPrefetch = 0
+reader.UpdateVTKObjects()
+for ts in range(len(fnames)):
+    check(ts)
+
+Delete(reader)
+shutil.rmtree(dname, ignore_errors=True)
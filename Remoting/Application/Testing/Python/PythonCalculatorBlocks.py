@@ -0,0 +1,66 @@
+# Checks that evaluating the Python Calculator concurrently on the blocks of a
+# composite dataset gives the same results as evaluating it on the whole
+# dataset.
+import paraview
+from paraview.modules.vtkPVVTKExtensionsFiltersPython import vtkPythonCalculator
+from paraview.vtk import vtkMultiBlockDataSet
+from vtkmodules.vtkImagingCore import vtkRTAnalyticSource
+from vtkmodules.numpy_interface import dataset_adapter as dsa
+import numpy as np
+
+numberOfBlocks = 200
+
+source = vtkRTAnalyticSource()
+source.SetWholeExtent(-4, 4, -4, 4, -4, 4)
+mb = vtkMultiBlockDataSet()
+for index in range(numberOfBlocks):
+    source.SetCenter(index, 0, 0)
+    source.Update()
+    block = source.GetOutput().NewInstance()
+    block.DeepCopy(source.GetOutput())
+    # Some blocks do not have the array used by the expression.
+    if index % 10 == 3:
+        block.GetPointData().RemoveArray("RTData")
+    mb.SetBlock(index, block)
+
+
+def evaluate(expression, concurrently, resultType=11):
+    calculator = vtkPythonCalculator()
+    calculator.SetInputDataObject(mb)
+    calculator.SetExpression(expression)
+    calculator.SetArrayName("result")
+    calculator.SetResultArrayType(resultType)
+    calculator.SetEvaluateBlocksConcurrently(concurrently)
+    calculator.Update()
+    return dsa.WrapDataObject(calculator.GetOutput())
+
+
+expressions = ["sqrt(RTData) * 2 + 1",
+               "RTData > 100",
+               "abs(RTData - 150) / 10",
+               # reductions are evaluated over the whole dataset.
+               "RTData - max(RTData)"]
+for expression in expressions:
+    expected = evaluate(expression, False)
+    result = evaluate(expression, True)
+
+    for index in range(numberOfBlocks):
+        expectedArray = expected.VTKObject.GetBlock(index).GetPointData().GetArray("result")
+        resultArray = result.VTKObject.GetBlock(index).GetPointData().GetArray("result")
+        if (expectedArray is None) != (resultArray is None):
+            raise RuntimeError("Missing result for block %d with %s" % (index, expression))
+        if expectedArray is None:
+            continue
+        if resultArray.GetDataType() != expectedArray.GetDataType():
+            raise RuntimeError("Incorrect result type with %s" % expression)
+        if not np.allclose(dsa.vtkDataArrayToVTKArray(expectedArray),
+                           dsa.vtkDataArrayToVTKArray(resultArray)):
+            raise RuntimeError("Incorrect result for block %d with %s" % (index, expression))
+
+# Input arrays are passed to the output without copies.
+result = evaluate("RTData", True, -1)
+inputArray = mb.GetBlock(0).GetPointData().GetArray("RTData")
+outputArray = result.VTKObject.GetBlock(0).GetPointData().GetArray("result")
+if not np.shares_memory(dsa.vtkDataArrayToVTKArray(inputArray),
+                        dsa.vtkDataArrayToVTKArray(outputArray)):
+    raise RuntimeError("Input array was copied.")
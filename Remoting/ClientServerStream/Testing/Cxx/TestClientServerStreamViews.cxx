@@ -0,0 +1,316 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerStream.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Builds a Reply message holding a padding string and the given values,
+// choosing the padding so that the values are aligned in the stream.
+bool BuildAligned(vtkClientServerStream& css, const std::vector<double>& values)
+{
+  for (size_t pad = 0; pad < sizeof(double); ++pad)
+  {
+    css.Reset();
+    css << vtkClientServerStream::Reply << std::string(pad, 'x').c_str()
+        << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(values.size()))
+        << vtkClientServerStream::End;
+    const double* view;
+    vtkTypeUInt32 length;
+    if (css.GetArgumentView(0, 1, &view, &length))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TestViews(const std::vector<double>& values)
+{
+  vtkClientServerStream css;
+  if (!::BuildAligned(css, values))
+  {
+    vtkLogF(ERROR, "no padding gives an aligned view.");
+    return false;
+  }
+
+  const double* view = nullptr;
+  vtkTypeUInt32 length = 0;
+  if (!css.GetArgumentView(0, 1, &view, &length))
+  {
+    vtkLogF(ERROR, "view of aligned array.");
+    return false;
+  }
+  if (length != values.size())
+  {
+    vtkLogF(ERROR, "view length.");
+    return false;
+  }
+  if (!std::equal(values.begin(), values.end(), view))
+  {
+    vtkLogF(ERROR, "view values.");
+    return false;
+  }
+  if (reinterpret_cast<const unsigned char*>(view) !=
+    css.GetArgument(0, 1).Data + 2 * sizeof(vtkTypeUInt32))
+  {
+    vtkLogF(ERROR, "view does not point into the stream.");
+    return false;
+  }
+
+  // Views require the exact stored type.
+  const float* floatView;
+  if (css.GetArgumentView(0, 1, &floatView, &length))
+  {
+    vtkLogF(ERROR, "view with mismatched type.");
+    return false;
+  }
+  if (css.GetArgumentView(0, 0, &view, &length))
+  {
+    vtkLogF(ERROR, "view of a string.");
+    return false;
+  }
+  if (css.GetArgumentView(0, 2, &view, &length))
+  {
+    vtkLogF(ERROR, "view past the last argument.");
+    return false;
+  }
+
+  // Misaligned data is reported so that callers copy instead.
+  css.Reset();
+  css << vtkClientServerStream::Reply << "x"
+      << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(values.size()))
+      << vtkClientServerStream::End;
+  const unsigned char* data = css.GetArgument(0, 1).Data + 2 * sizeof(vtkTypeUInt32);
+  const bool aligned = reinterpret_cast<uintptr_t>(data) % alignof(double) == 0;
+  if (css.GetArgumentView(0, 1, &view, &length) != (aligned ? 1 : 0))
+  {
+    vtkLogF(ERROR, "alignment check.");
+    return false;
+  }
+  return true;
+}
+
+bool TestReferences(const std::vector<double>& values)
+{
+  vtkClientServerStream source;
+  source << vtkClientServerStream::Reply
+         << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(values.size()))
+         << 17 << vtkClientServerStream::End;
+
+  vtkClientServerStream css;
+  css << vtkClientServerStream::Reply
+      << vtkClientServerStream::InsertReference(source.GetArgument(0, 0))
+      << vtkClientServerStream::InsertReference(source.GetArgument(0, 1))
+      << vtkClientServerStream::End;
+
+  // Large arguments are referenced, small ones are copied.
+  if (css.GetArgument(0, 0).Data != source.GetArgument(0, 0).Data)
+  {
+    vtkLogF(ERROR, "array was copied.");
+    return false;
+  }
+  if (css.GetArgument(0, 1).Data == source.GetArgument(0, 1).Data)
+  {
+    vtkLogF(ERROR, "int was referenced.");
+    return false;
+  }
+  if (css.GetArgumentType(0, 0) != vtkClientServerStream::float64_array)
+  {
+    vtkLogF(ERROR, "referenced type.");
+    return false;
+  }
+
+  std::vector<double> result(values.size());
+  int i = 0;
+  if (!css.GetArgument(0, 0, result.data(), static_cast<vtkTypeUInt32>(result.size())))
+  {
+    vtkLogF(ERROR, "referenced array.");
+    return false;
+  }
+  if (result != values)
+  {
+    vtkLogF(ERROR, "referenced values.");
+    return false;
+  }
+  if (!css.GetArgument(0, 1, &i) || i != 17)
+  {
+    vtkLogF(ERROR, "copied int.");
+    return false;
+  }
+
+  // Copies own their data.
+  vtkClientServerStream copy(css);
+  if (copy.GetArgument(0, 0).Data == source.GetArgument(0, 0).Data)
+  {
+    vtkLogF(ERROR, "copy references source.");
+    return false;
+  }
+
+  // GetData resolves references into a contiguous buffer.
+  const unsigned char* data;
+  size_t size;
+  if (!css.GetData(&data, &size))
+  {
+    vtkLogF(ERROR, "stream data.");
+    return false;
+  }
+  if (css.GetArgument(0, 0).Data == source.GetArgument(0, 0).Data)
+  {
+    vtkLogF(ERROR, "GetData kept reference.");
+    return false;
+  }
+  vtkClientServerStream parsed;
+  if (!parsed.SetData(data, size))
+  {
+    vtkLogF(ERROR, "parse stream data.");
+    return false;
+  }
+  for (vtkClientServerStream* stream : { &copy, &parsed })
+  {
+    std::fill(result.begin(), result.end(), 0.0);
+    if (stream->GetNumberOfMessages() != 1 || stream->GetNumberOfArguments(0) != 2)
+    {
+      vtkLogF(ERROR, "message structure.");
+      return false;
+    }
+    if (!stream->GetArgument(0, 0, result.data(), static_cast<vtkTypeUInt32>(result.size())) ||
+      result != values)
+    {
+      vtkLogF(ERROR, "resolved array.");
+      return false;
+    }
+    if (!stream->GetArgument(0, 1, &i) || i != 17)
+    {
+      vtkLogF(ERROR, "resolved int.");
+      return false;
+    }
+  }
+
+  // An explicit deep copy.
+  vtkClientServerStream explicitCopy;
+  explicitCopy << vtkClientServerStream::Reply
+               << vtkClientServerStream::InsertReference(source.GetArgument(0, 0))
+               << vtkClientServerStream::End;
+  explicitCopy.CopyReferences();
+  source.Reset();
+  if (!explicitCopy.GetArgument(0, 0, result.data(), static_cast<vtkTypeUInt32>(result.size())) ||
+    result != values)
+  {
+    vtkLogF(ERROR, "CopyReferences.");
+    return false;
+  }
+  return true;
+}
+
+// Stands in for a generated wrapper: reads the values in place if possible.
+struct Sink
+{
+  double Sum = 0.0;
+  int Views = 0;
+};
+
+int SinkCommand(vtkClientServerInterpreter*, vtkObjectBase*, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream&, void* ctx)
+{
+  Sink* sink = static_cast<Sink*>(ctx);
+  const double* values;
+  vtkTypeUInt32 length;
+  std::vector<double> copy;
+  if (!strncmp(method, "View", 4) && msg.GetArgumentView(0, 2, &values, &length))
+  {
+    ++sink->Views;
+  }
+  else if (msg.GetArgumentLength(0, 2, &length))
+  {
+    copy.resize(length);
+    msg.GetArgument(0, 2, copy.data(), length);
+    values = copy.data();
+  }
+  else
+  {
+    return 0;
+  }
+  sink->Sum += length ? values[length - 1] : 0.0;
+  return 1;
+}
+
+bool TestInterpreter(const std::vector<double>& values, int iterations)
+{
+  vtkNew<vtkClientServerInterpreter> interpreter;
+  vtkNew<vtkDoubleArray> object;
+  Sink sink;
+  interpreter->AddCommandFunction("vtkDoubleArray", &SinkCommand, &sink);
+  const vtkClientServerID id = interpreter->GetNextAvailableId();
+  if (!interpreter->NewInstance(object, id))
+  {
+    vtkLogF(ERROR, "create instance.");
+    return false;
+  }
+
+  // Pick a method name for which the array is aligned in the expanded
+  // message, as the interpreter references it in place.
+  vtkClientServerStream css;
+  std::string method = "View";
+  for (; method.size() < 12; method += ' ')
+  {
+    css.Reset();
+    css << vtkClientServerStream::Invoke << id << method.c_str()
+        << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(values.size()))
+        << vtkClientServerStream::End;
+    interpreter->ProcessStream(css);
+    if (sink.Views)
+    {
+      break;
+    }
+  }
+
+  for (int mode = 0; mode < 2; ++mode)
+  {
+    css.Reset();
+    css << vtkClientServerStream::Invoke << id << (mode == 0 ? "Copy" : method.c_str())
+        << vtkClientServerStream::InsertArray(values.data(), static_cast<int>(values.size()))
+        << vtkClientServerStream::End;
+    sink.Sum = 0;
+    for (int cc = 0; cc < iterations; ++cc)
+    {
+      if (!interpreter->ProcessStream(css))
+      {
+        vtkLogF(ERROR, "process stream.");
+        return false;
+      }
+    }
+    if (sink.Sum != iterations * values.back())
+    {
+      vtkLogF(ERROR, "values seen by the command function.");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestClientServerStreamViews(int, char*[])
+{
+  // Keep the values large enough to be inserted by reference.
+  std::vector<double> values(4096);
+  for (size_t cc = 0; cc < values.size(); ++cc)
+  {
+    values[cc] = 0.5 * static_cast<double>(cc);
+  }
+
+  bool success = ::TestViews(values);
+  success &= ::TestReferences(values);
+  success &= ::TestInterpreter(values, 10);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
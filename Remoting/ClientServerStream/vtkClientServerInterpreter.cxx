@@ -647,8 +647,9 @@ int vtkClientServerInterpreter::ExpandMessage(
     }
     else
     {
-      // Just copy the argument.
-      out << in.GetArgument(inIndex, a);
+      // Refer to the argument in place.  The input stream outlives the
+      // expanded message, so large arrays need not be copied.
+      out << vtkClientServerStream::InsertReference(in.GetArgument(inIndex, a));
     }
   }
 
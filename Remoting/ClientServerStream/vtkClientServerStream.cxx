@@ -13,6 +13,7 @@
 #include "vtkVariantExtract.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <typeinfo>
@@ -129,6 +130,7 @@ public:
   vtkClientServerStreamInternals(const vtkClientServerStreamInternals& r, vtkObjectBase* owner)
     : Data(r.Data)
     , ValueOffsets(r.ValueOffsets)
+    , External(r.External)
     , MessageIndexes(r.MessageIndexes)
     , Objects(r.Objects, owner)
     , StartIndex(r.StartIndex)
@@ -141,10 +143,15 @@ public:
   typedef std::vector<unsigned char> DataType;
   DataType Data;
 
-  // Offset to each value stored in the stream.
+  // Offset to each value stored in the stream.  A negative offset -(i+1)
+  // refers to the i-th entry of External instead.
   typedef std::vector<DataType::difference_type> ValueOffsetsType;
   ValueOffsetsType ValueOffsets;
 
+  // Values inserted by reference whose data are not in Data.
+  typedef std::vector<vtkClientServerStream::ArgumentReference> ExternalType;
+  ExternalType External;
+
   // Index into ValueOffsets of the first value corresponding to each
   // message.
   typedef std::vector<ValueOffsetsType::size_type> MessageIndexesType;
@@ -226,6 +233,55 @@ public:
   // Buffer for return value from StreamToString.
   std::string String;
 
+  // Copy the values inserted by reference into Data so that the stream
+  // is a contiguous buffer again.
+  void Materialize()
+  {
+    if (this->External.empty())
+    {
+      return;
+    }
+
+    // Each value inline in Data extends up to the next inline value.
+    const DataType::difference_type size = static_cast<DataType::difference_type>(this->Data.size());
+    ValueOffsetsType ends(this->ValueOffsets.size(), size);
+    DataType::difference_type next = size;
+    size_t total = this->Data.size();
+    for (size_t i = this->ValueOffsets.size(); i-- > 0;)
+    {
+      if (this->ValueOffsets[i] >= 0)
+      {
+        ends[i] = next;
+        next = this->ValueOffsets[i];
+      }
+      else
+      {
+        total += this->External[-this->ValueOffsets[i] - 1].Size;
+      }
+    }
+
+    // Keep everything before the first value, i.e. the byte order.
+    DataType data;
+    data.reserve(total);
+    data.insert(data.end(), this->Data.begin(), this->Data.begin() + next);
+    for (size_t i = 0; i < this->ValueOffsets.size(); ++i)
+    {
+      const DataType::difference_type offset = this->ValueOffsets[i];
+      this->ValueOffsets[i] = static_cast<DataType::difference_type>(data.size());
+      if (offset >= 0)
+      {
+        data.insert(data.end(), this->Data.begin() + offset, this->Data.begin() + ends[i]);
+      }
+      else
+      {
+        const vtkClientServerStream::ArgumentReference& ref = this->External[-offset - 1];
+        data.insert(data.end(), ref.Data, ref.Data + ref.Size);
+      }
+    }
+    this->Data.swap(data);
+    this->External.clear();
+  }
+
   // Access to protected members of vtkClientServerStream.
   static vtkClientServerStream& Write(vtkClientServerStream& css, const void* data, size_t length)
   {
@@ -261,12 +317,16 @@ vtkClientServerStream::vtkClientServerStream(const vtkClientServerStream& r, vtk
 {
   // Allocate and copy the internal representation of the stream.
   this->Internal = new vtkClientServerStreamInternals(*r.Internal, owner);
+
+  // The copy must not depend on buffers referenced by the original.
+  this->Internal->Materialize();
 }
 
 //----------------------------------------------------------------------------
 vtkClientServerStream& vtkClientServerStream::operator=(const vtkClientServerStream& that)
 {
   *this->Internal = *that.Internal;
+  this->Internal->Materialize();
   return *this;
 }
 
@@ -310,6 +370,7 @@ void vtkClientServerStream::Reset()
 
   this->Internal->ValueOffsets.erase(
     this->Internal->ValueOffsets.begin(), this->Internal->ValueOffsets.end());
+  this->Internal->External.clear();
   this->Internal->MessageIndexes.erase(
     this->Internal->MessageIndexes.begin(), this->Internal->MessageIndexes.end());
   this->Internal->Objects.Clear();
@@ -407,6 +468,50 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   return *this;
 }
 
+//----------------------------------------------------------------------------
+// Arguments smaller than this are cheaper to copy than to reference.
+static const size_t vtkClientServerStreamMinimumReferenceSize = 256;
+
+vtkClientServerStream& vtkClientServerStream::operator<<(
+  vtkClientServerStream::ArgumentReference r)
+{
+  if (!r.Data || r.Size < vtkClientServerStreamMinimumReferenceSize)
+  {
+    vtkClientServerStream::Argument a = { r.Data, r.Size };
+    return *this << a;
+  }
+
+  // Object pointers must be registered, so copy them.
+  vtkTypeUInt32 tp;
+  memcpy(&tp, r.Data, sizeof(tp));
+  if (tp == vtkClientServerStream::vtk_object_pointer)
+  {
+    vtkClientServerStream::Argument a = { r.Data, r.Size };
+    return *this << a;
+  }
+
+  // Mark the value as external.
+  this->Internal->External.push_back(r);
+  this->Internal->ValueOffsets.push_back(
+    -static_cast<vtkClientServerStreamInternals::DataType::difference_type>(
+      this->Internal->External.size()));
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+vtkClientServerStream::ArgumentReference vtkClientServerStream::InsertReference(
+  vtkClientServerStream::Argument a)
+{
+  vtkClientServerStream::ArgumentReference r = { a.Data, a.Size };
+  return r;
+}
+
+//----------------------------------------------------------------------------
+void vtkClientServerStream::CopyReferences()
+{
+  this->Internal->Materialize();
+}
+
 //----------------------------------------------------------------------------
 vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::Array a)
 {
@@ -1113,6 +1218,62 @@ VTK_CSS_GET_ARGUMENT_ARRAY(long long)
 VTK_CSS_GET_ARGUMENT_ARRAY(unsigned long long)
 #undef VTK_CSS_GET_ARGUMENT_ARRAY
 
+//----------------------------------------------------------------------------
+// Template and macro to implement GetArgumentView methods in the same way.
+template <class T>
+int vtkClientServerStreamGetArgumentView(
+  const vtkClientServerStream* self, int midx, int argument, const T** value, vtkTypeUInt32* length)
+{
+  typedef VTK_CSS_TYPENAME vtkTypeTraits<T>::SizedType Type;
+  if (const unsigned char* data =
+        vtkClientServerStreamInternals::GetValue(*self, midx, 1 + argument))
+  {
+    // Only an array of exactly the requested type can be used in place.
+    vtkTypeUInt32 tp;
+    memcpy(&tp, data, sizeof(tp));
+    data += sizeof(tp);
+    if (static_cast<vtkClientServerStream::Types>(tp) != vtkClientServerTypeTraits<Type>::Array())
+    {
+      return 0;
+    }
+
+    vtkTypeUInt32 len;
+    memcpy(&len, data, sizeof(len));
+    data += sizeof(len);
+
+    // Values are packed in the stream, so the data may be misaligned.
+    if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0)
+    {
+      return 0;
+    }
+    *value = reinterpret_cast<const T*>(data);
+    *length = len;
+    return 1;
+  }
+  return 0;
+}
+
+#define VTK_CSS_GET_ARGUMENT_VIEW(type)                                                            \
+  int vtkClientServerStream::GetArgumentView(                                                      \
+    int message, int argument, const type** value, vtkTypeUInt32* length) const                    \
+  {                                                                                                \
+    return vtkClientServerStreamGetArgumentView(this, message, argument, value, length);           \
+  }
+VTK_CSS_GET_ARGUMENT_VIEW(signed char)
+VTK_CSS_GET_ARGUMENT_VIEW(char)
+VTK_CSS_GET_ARGUMENT_VIEW(int)
+VTK_CSS_GET_ARGUMENT_VIEW(short)
+VTK_CSS_GET_ARGUMENT_VIEW(long)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned char)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned int)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned short)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned long)
+VTK_CSS_GET_ARGUMENT_VIEW(float)
+VTK_CSS_GET_ARGUMENT_VIEW(double)
+VTK_CSS_GET_ARGUMENT_VIEW(long long)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned long long)
+#undef VTK_CSS_GET_ARGUMENT_VIEW
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::GetArgument(int message, int argument, const char** value) const
 {
@@ -1452,6 +1613,9 @@ int vtkClientServerStream::GetData(const unsigned char** data, size_t* length) c
   // Do not return data unless stream is valid.
   if (!this->Internal->Invalid)
   {
+    // The data must be contiguous.
+    this->Internal->Materialize();
+
     if (data)
     {
       *data = &*this->Internal->Data.begin();
@@ -1839,9 +2003,16 @@ const unsigned char* vtkClientServerStream::GetValue(int message, int value) con
     vtkClientServerStreamInternals::ValueOffsetsType::size_type index =
       this->Internal->MessageIndexes[message];
 
-    // Return a pointer to the value-th value in the message.
+    // Return a pointer to the value-th value in the message, which may
+    // have been inserted by reference.
+    const vtkClientServerStreamInternals::DataType::difference_type offset =
+      this->Internal->ValueOffsets[index + value];
+    if (offset < 0)
+    {
+      return this->Internal->External[-offset - 1].Data;
+    }
     const unsigned char* data = &*this->Internal->Data.begin();
-    return data + this->Internal->ValueOffsets[index + value];
+    return data + offset;
   }
   else
   {
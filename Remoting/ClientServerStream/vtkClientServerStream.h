@@ -194,6 +194,39 @@ public:
    */
   int GetArgumentLength(int message, int argument, vtkTypeUInt32* length) const;
 
+  ///@{
+  /**
+   * Get a read-only view of an array argument without copying it out of
+   * the stream.  On success, \a value points at the array data inside
+   * the stream and \a length holds its number of elements.  The view is
+   * only valid until the stream is modified or destroyed.  Returns 0 if
+   * the argument is not an array of exactly the requested type or if its
+   * data is not suitably aligned in the stream, in which case the caller
+   * should fall back to the copying GetArgument.
+   */
+  int GetArgumentView(int message, int argument, const signed char** value,
+    vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const char** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const short** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const int** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const long** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const unsigned char** value,
+    vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const unsigned short** value,
+    vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const unsigned int** value,
+    vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const unsigned long** value,
+    vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const float** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(
+    int message, int argument, const double** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(
+    int message, int argument, const long long** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const unsigned long long** value,
+    vtkTypeUInt32* length) const;
+  ///@}
+
   /**
    * Get the given argument in the given message as an object of a
    * particular vtkObjectBase type.  Returns whether the argument is
@@ -224,7 +257,8 @@ public:
    * Get a pointer to the stream data and its length.  The values are
    * suitable for passing to another stream's SetData method, but are
    * invalidated when any further writing to the stream is done.
-   * Returns whether the stream is currently valid.
+   * Returns whether the stream is currently valid.  Any arguments
+   * inserted by reference are copied into the stream first.
    */
   int GetData(const unsigned char** data, size_t* length) const;
 
@@ -245,6 +279,18 @@ public:
   };
   ///@}
 
+  ///@{
+  /**
+   * Proxy-object returned by InsertReference and used to insert an
+   * argument into the stream without copying its data.
+   */
+  struct ArgumentReference
+  {
+    const unsigned char* Data;
+    size_t Size;
+  };
+  ///@}
+
   ///@{
   /**
    * Stream operators for special types.
@@ -252,6 +298,7 @@ public:
   vtkClientServerStream& operator<<(vtkClientServerStream::Commands);
   vtkClientServerStream& operator<<(vtkClientServerStream::Types);
   vtkClientServerStream& operator<<(vtkClientServerStream::Argument);
+  vtkClientServerStream& operator<<(vtkClientServerStream::ArgumentReference);
   vtkClientServerStream& operator<<(vtkClientServerStream::Array);
   vtkClientServerStream& operator<<(const vtkClientServerStream&);
   vtkClientServerStream& operator<<(vtkClientServerID);
@@ -300,6 +347,23 @@ public:
   static vtkClientServerStream::Array InsertArray(const double*, int);
   ///@}
 
+  /**
+   * Insert an argument obtained from another stream by reference
+   * instead of copying it.  The data of the argument must remain valid
+   * and unchanged for as long as this stream refers to it.  Small
+   * arguments and object pointers are copied anyway.  References are
+   * resolved into the stream's own buffer by GetData, by copying the
+   * stream, and by CopyReferences.
+   */
+  static vtkClientServerStream::ArgumentReference InsertReference(
+    vtkClientServerStream::Argument);
+
+  /**
+   * Copy the data of all arguments inserted by reference into the
+   * stream so that it no longer depends on the referenced buffers.
+   */
+  void CopyReferences();
+
   /**
    * Construct the entire stream from the given data.  This destroys
    * any data already in the stream.  Returns whether the stream is
@@ -505,6 +569,61 @@ public:
 private:
   T* Data;
 };
+
+// Extract the given argument of the given message as read-only data.
+// The data are used in place when the stream holds an array of exactly
+// the requested type and alignment, and copied otherwise.
+// This is for use only in generated wrappers.
+template <class T>
+class vtkClientServerStreamConstDataArg
+{
+public:
+  vtkClientServerStreamConstDataArg(const vtkClientServerStream& msg, int message, int argument)
+    : Data(nullptr)
+    , Copy(nullptr)
+  {
+    // Use the data in place if possible.
+    vtkTypeUInt32 length = 0;
+    if (msg.GetArgumentView(message, argument, &this->Data, &length))
+    {
+      if (length == 0)
+      {
+        this->Data = nullptr;
+      }
+      return;
+    }
+
+    // Otherwise, copy it as vtkClientServerStreamDataArg does.
+    if (msg.GetArgumentLength(message, argument, &length) && length > 0)
+    {
+      try
+      {
+        this->Copy = new T[length];
+      }
+      catch (...)
+      {
+      }
+    }
+    if (this->Copy && !msg.GetArgument(message, argument, this->Copy, length))
+    {
+      delete[] this->Copy;
+      this->Copy = nullptr;
+    }
+    this->Data = this->Copy;
+  }
+
+  ~vtkClientServerStreamConstDataArg() { delete[] this->Copy; }
+
+  vtkClientServerStreamConstDataArg(const vtkClientServerStreamConstDataArg&) = delete;
+  void operator=(const vtkClientServerStreamConstDataArg&) = delete;
+
+  // Allow this object to be passed as if it were a pointer.
+  operator const T*() const { return this->Data; }
+
+private:
+  const T* Data;
+  T* Copy;
+};
 #endif
 
 #endif
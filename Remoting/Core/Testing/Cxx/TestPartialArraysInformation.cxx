@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkCellData.h"
+#include "vtkClientServerStream.h"
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
@@ -97,6 +98,27 @@ int TestPartialArraysInformation(int, char*[])
     return EXIT_FAILURE;
   }
 
+  // The information, including the partial flags, must survive serialization.
+  vtkClientServerStream stream;
+  info->CopyToStream(&stream);
+  vtkNew<vtkPVDataInformation> copy;
+  copy->CopyFromStream(&stream);
+  if (copy->GetNumberOfPoints() != info->GetNumberOfPoints() ||
+    copy->GetNumberOfDataSets() != info->GetNumberOfDataSets() ||
+    copy->GetCompositeDataSetType() != info->GetCompositeDataSetType())
+  {
+    cerr << "ERROR: information changed by serialization." << endl;
+    return EXIT_FAILURE;
+  }
+  if (copy->GetArrayInformation("pd0", vtkDataObject::POINT) == nullptr ||
+    copy->GetArrayInformation("pd0", vtkDataObject::POINT)->GetIsPartial() ||
+    copy->GetArrayInformation("cd1", vtkDataObject::CELL) == nullptr ||
+    !copy->GetArrayInformation("cd1", vtkDataObject::CELL)->GetIsPartial())
+  {
+    cerr << "ERROR: array information changed by serialization." << endl;
+    return EXIT_FAILURE;
+  }
+
   // Now gather information for a specific block.
   vtkNew<vtkPVDataInformation> b1info;
   b1info->SetSubsetAssemblyNameToHierarchy();
@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerStream.h"
+#include "vtkDoubleArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVTemporalDataInformation.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <cstdlib>
+
+namespace
+{
+// Produces a single point at x = time, with a point array holding the time,
+// and counts how many times it executes.
+class vtkTemporalPointSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTemporalPointSource* New();
+  vtkTypeMacro(vtkTemporalPointSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions = 0;
+
+protected:
+  vtkTemporalPointSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    double timesteps[10];
+    for (int cc = 0; cc < 10; ++cc)
+    {
+      timesteps[cc] = cc;
+    }
+    double range[2] = { 0, 9 };
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timesteps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+    override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const double time = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      : 0.0;
+
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(time, 0, 0);
+    vtkNew<vtkDoubleArray> values;
+    values->SetName("time");
+    values->InsertNextValue(time);
+
+    auto output = vtkPolyData::GetData(outputVector);
+    output->SetPoints(points);
+    output->GetPointData()->AddArray(values);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    ++this->NumberOfExecutions;
+    return 1;
+  }
+
+private:
+  vtkTemporalPointSource(const vtkTemporalPointSource&) = delete;
+  void operator=(const vtkTemporalPointSource&) = delete;
+};
+vtkStandardNewMacro(vtkTemporalPointSource);
+
+bool CheckComplete(vtkPVTemporalDataInformation* info)
+{
+  if (info->GetNumberOfTimeSteps() != 10 || info->GetNumberOfPendingTimeSteps() != 0)
+  {
+    vtkLogF(ERROR, "Incorrect number of timesteps (%d, %d pending).",
+      info->GetNumberOfTimeSteps(), info->GetNumberOfPendingTimeSteps());
+    return false;
+  }
+  auto ainfo = info->GetArrayInformation("time", vtkDataObject::POINT);
+  if (ainfo == nullptr)
+  {
+    vtkLogF(ERROR, "Missing array information.");
+    return false;
+  }
+  if (ainfo->GetComponentRange(0)[0] != 0 || ainfo->GetComponentRange(0)[1] != 9)
+  {
+    vtkLogF(ERROR, "Incorrect range over all timesteps.");
+    return false;
+  }
+  if (info->GetBounds()[0] != 0 || info->GetBounds()[1] != 9)
+  {
+    vtkLogF(ERROR, "Incorrect bounds over all timesteps.");
+    return false;
+  }
+  return true;
+}
+
+bool TestCache(vtkTemporalPointSource* source)
+{
+  vtkNew<vtkPVTemporalDataInformation> info;
+  info->CopyFromObject(source);
+  if (!::CheckComplete(info))
+  {
+    vtkLogF(ERROR, "Incorrect information from the first gather.");
+    return false;
+  }
+  if (source->NumberOfExecutions != 10)
+  {
+    vtkLogF(ERROR, "Each timestep must be executed once.");
+    return false;
+  }
+
+  // Gathering again, even at another time, must not update the pipeline.
+  source->UpdateTimeStep(4);
+  source->NumberOfExecutions = 0;
+  vtkNew<vtkPVTemporalDataInformation> info2;
+  info2->CopyFromObject(source);
+  if (!::CheckComplete(info2))
+  {
+    vtkLogF(ERROR, "Incorrect information from the cache.");
+    return false;
+  }
+  if (source->NumberOfExecutions != 0)
+  {
+    vtkLogF(ERROR, "Cached timesteps were executed again.");
+    return false;
+  }
+
+  // Modifying the pipeline invalidates the cache.
+  source->Modified();
+  source->NumberOfExecutions = 0;
+  vtkNew<vtkPVTemporalDataInformation> info3;
+  info3->CopyFromObject(source);
+  if (!::CheckComplete(info3))
+  {
+    vtkLogF(ERROR, "Incorrect information after modification.");
+    return false;
+  }
+  if (source->NumberOfExecutions != 10)
+  {
+    vtkLogF(ERROR, "Cache not invalidated by modification.");
+    return false;
+  }
+  return true;
+}
+}
+
+bool TestIncremental(vtkTemporalPointSource* source)
+{
+  source->Modified();
+  source->UpdateTimeStep(0);
+  source->NumberOfExecutions = 0;
+
+  vtkNew<vtkPVTemporalDataInformation> info;
+  info->SetMaximumNumberOfTimeStepsToUpdate(4);
+  info->CopyFromObject(source);
+  if (info->GetNumberOfTimeSteps() != 10 || info->GetNumberOfPendingTimeSteps() != 5)
+  {
+    vtkLogF(ERROR, "Incorrect number of timesteps (%d, %d pending) after a partial gather.",
+      info->GetNumberOfTimeSteps(), info->GetNumberOfPendingTimeSteps());
+    return false;
+  }
+  if (info->GetArrayInformation("time", vtkDataObject::POINT)->GetComponentRange(0)[1] != 4)
+  {
+    vtkLogF(ERROR, "Incorrect partial range.");
+    return false;
+  }
+  if (info->GetCacheableMTime(source) != 0)
+  {
+    vtkLogF(ERROR, "Partial information must not be cached.");
+    return false;
+  }
+
+  // the pending count survives serialization.
+  vtkClientServerStream css;
+  info->CopyToStream(&css);
+  vtkNew<vtkPVTemporalDataInformation> copy;
+  copy->CopyFromStream(&css);
+  if (copy->GetNumberOfPendingTimeSteps() != 5)
+  {
+    vtkLogF(ERROR, "Pending timesteps not serialized.");
+    return false;
+  }
+
+  int passes = 1;
+  for (; info->GetNumberOfPendingTimeSteps() > 0 && passes < 10; ++passes)
+  {
+    info->CopyFromObject(source);
+  }
+  if (passes != 3 || !::CheckComplete(info))
+  {
+    vtkLogF(ERROR, "Incorrect incremental gather (%d passes).", passes);
+    return false;
+  }
+  if (source->NumberOfExecutions != 9)
+  {
+    vtkLogF(ERROR, "Each remaining timestep must be executed once.");
+    return false;
+  }
+  return true;
+}
+
+// With room for a single producer, gathering from another producer releases
+// the information cached for the first one.
+bool TestCacheLimit()
+{
+  const vtkIdType maximum = vtkPVTemporalDataInformation::GetMaximumNumberOfCachedTimeSteps();
+  vtkPVTemporalDataInformation::SetMaximumNumberOfCachedTimeSteps(10);
+
+  vtkNew<vtkTemporalPointSource> first;
+  vtkNew<vtkTemporalPointSource> second;
+  first->UpdateTimeStep(0);
+  second->UpdateTimeStep(0);
+
+  vtkNew<vtkPVTemporalDataInformation> info;
+  info->CopyFromObject(first);
+  info->CopyFromObject(second);
+  first->NumberOfExecutions = 0;
+  info->CopyFromObject(first);
+
+  vtkPVTemporalDataInformation::SetMaximumNumberOfCachedTimeSteps(maximum);
+  if (!::CheckComplete(info))
+  {
+    vtkLogF(ERROR, "Incorrect information with a full cache.");
+    return false;
+  }
+  if (first->NumberOfExecutions != 9)
+  {
+    vtkLogF(ERROR, "Released timesteps must be executed again (%d executions).",
+      first->NumberOfExecutions);
+    return false;
+  }
+  return true;
+}
+}
+
+int TestTemporalDataInformation(int, char*[])
+{
+  vtkNew<vtkTemporalPointSource> source;
+  bool success = ::TestCache(source);
+  success &= ::TestIncremental(source);
+  success &= ::TestCacheLimit();
+  vtkPVTemporalDataInformation::ClearCache();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -376,7 +376,13 @@ void vtkPVArrayInformation::CopyToStream(vtkClientServerStream* css) const
 {
   css->Reset();
   *css << vtkClientServerStream::Reply;
+  this->AppendToStream(css);
+  *css << vtkClientServerStream::End;
+}
 
+//----------------------------------------------------------------------------
+void vtkPVArrayInformation::AppendToStream(vtkClientServerStream* css) const
+{
   // Array name, data type, and number of components.
   *css << this->Name;
   *css << this->DataType;
@@ -405,21 +411,26 @@ void vtkPVArrayInformation::CopyToStream(vtkClientServerStream* css) const
   {
     *css << pair.first << pair.second;
   }
-
-  *css << vtkClientServerStream::End;
 }
 
 //----------------------------------------------------------------------------
 bool vtkPVArrayInformation::CopyFromStream(const vtkClientServerStream* css)
 {
-  assert(this->Components.size() == 0); // sanity check.
-
   // argument counter;
   int argument = 0;
-  if (!css->GetArgument(0, argument++, &this->Name) ||
-    !css->GetArgument(0, argument++, &this->DataType) ||
-    !css->GetArgument(0, argument++, &this->NumberOfTuples) ||
-    !css->GetArgument(0, argument++, &this->IsPartial))
+  return this->ReadFromStream(css, 0, argument);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVArrayInformation::ReadFromStream(
+  const vtkClientServerStream* css, int message, int& argument)
+{
+  assert(this->Components.size() == 0); // sanity check.
+
+  if (!css->GetArgument(message, argument++, &this->Name) ||
+    !css->GetArgument(message, argument++, &this->DataType) ||
+    !css->GetArgument(message, argument++, &this->NumberOfTuples) ||
+    !css->GetArgument(message, argument++, &this->IsPartial))
   {
     vtkErrorMacro("Error parsing message.");
     return false;
@@ -427,7 +438,7 @@ bool vtkPVArrayInformation::CopyFromStream(const vtkClientServerStream* css)
 
   // components
   int count;
-  if (!css->GetArgument(0, argument++, &count))
+  if (!css->GetArgument(message, argument++, &count))
   {
     vtkErrorMacro("Error parsing message.");
     return false;
@@ -436,10 +447,10 @@ bool vtkPVArrayInformation::CopyFromStream(const vtkClientServerStream* css)
   this->Components.resize(count);
   for (auto& info : this->Components)
   {
-    if (!css->GetArgument(0, argument++, info.Range.GetData(), 2) ||
-      !css->GetArgument(0, argument++, info.FiniteRange.GetData(), 2) ||
-      !css->GetArgument(0, argument++, &info.Name) ||
-      !css->GetArgument(0, argument++, &info.DefaultName))
+    if (!css->GetArgument(message, argument++, info.Range.GetData(), 2) ||
+      !css->GetArgument(message, argument++, info.FiniteRange.GetData(), 2) ||
+      !css->GetArgument(message, argument++, &info.Name) ||
+      !css->GetArgument(message, argument++, &info.DefaultName))
     {
       vtkErrorMacro("Error parsing message.");
       return false;
@@ -447,7 +458,7 @@ bool vtkPVArrayInformation::CopyFromStream(const vtkClientServerStream* css)
   }
 
   // string values
-  if (!css->GetArgument(0, argument++, &count))
+  if (!css->GetArgument(message, argument++, &count))
   {
     vtkErrorMacro("Error parsing message.");
     return false;
@@ -456,7 +467,7 @@ bool vtkPVArrayInformation::CopyFromStream(const vtkClientServerStream* css)
   this->StringValues.resize(count);
   for (auto& value : this->StringValues)
   {
-    if (!css->GetArgument(0, argument++, &value))
+    if (!css->GetArgument(message, argument++, &value))
     {
       vtkErrorMacro("Error parsing message.");
       return false;
@@ -464,7 +475,7 @@ bool vtkPVArrayInformation::CopyFromStream(const vtkClientServerStream* css)
   }
 
   // information keys
-  if (!css->GetArgument(0, argument++, &count))
+  if (!css->GetArgument(message, argument++, &count))
   {
     vtkErrorMacro("Error parsing message.");
     return false;
@@ -473,8 +484,8 @@ bool vtkPVArrayInformation::CopyFromStream(const vtkClientServerStream* css)
   for (int cc = 0; cc < count; ++cc)
   {
     std::pair<std::string, std::string> pair;
-    if (!css->GetArgument(0, argument++, &pair.first) ||
-      !css->GetArgument(0, argument++, &pair.second))
+    if (!css->GetArgument(message, argument++, &pair.first) ||
+      !css->GetArgument(message, argument++, &pair.second))
     {
       vtkErrorMacro("Error parsing message.");
       return false;
@@ -156,6 +156,16 @@ protected:
   vtkSetMacro(IsPartial, bool);
   ///@}
 
+  ///@{
+  /**
+   * Append the information to the current message of `css`, or read it from
+   * message `message` starting at `argument`, which is advanced past it. This
+   * lets containers serialize their arrays without nesting streams.
+   */
+  void AppendToStream(vtkClientServerStream* css) const;
+  bool ReadFromStream(const vtkClientServerStream* css, int message, int& argument);
+  ///@}
+
   vtkSetMacro(Name, std::string);
 
 private:
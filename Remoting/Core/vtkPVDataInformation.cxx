@@ -101,6 +101,10 @@ public:
 namespace
 {
 
+// Version of the layout written by `vtkPVDataInformation::AppendToStream`.
+// Increment it whenever the layout changes.
+constexpr int StreamFormatVersion = 2;
+
 void MergeBounds(double bds[6], const double obds[6])
 {
   vtkBoundingBox bbox(bds);
@@ -183,6 +187,51 @@ void vtkPVDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
   this->SetSubsetAssemblyName(name.empty() ? nullptr : name.c_str());
 }
 
+//----------------------------------------------------------------------------
+vtkMTimeType vtkPVDataInformation::GetCacheableMTime(vtkObject* object)
+{
+  vtkDataObject* dobj = vtkDataObject::SafeDownCast(object);
+  vtkAlgorithm* algo = vtkAlgorithm::SafeDownCast(object);
+  int port = this->PortNumber;
+  if (auto algOutput = vtkAlgorithmOutput::SafeDownCast(object))
+  {
+    algo = algOutput->GetProducer();
+    port = algOutput->GetIndex();
+    if (algo && algo->IsA("vtkPVPostFilter"))
+    {
+      algOutput = algo->GetInputConnection(0, 0);
+      algo = algOutput ? algOutput->GetProducer() : nullptr;
+      port = algOutput ? algOutput->GetIndex() : 0;
+    }
+  }
+
+  vtkMTimeType mtime = 0;
+  if (algo)
+  {
+    if (port < 0 || port >= algo->GetNumberOfOutputPorts() || !algo->GetExecutive())
+    {
+      return 0;
+    }
+    vtkInformation* pipelineInfo = algo->GetExecutive()->GetOutputInformation(port);
+    dobj = pipelineInfo ? vtkDataObject::GetData(pipelineInfo) : nullptr;
+    if (!dobj)
+    {
+      return 0;
+    }
+    // Pipeline meta-data (time steps, etc.) is part of the gathered information.
+    mtime = std::max(algo->GetMTime(), pipelineInfo->GetMTime());
+  }
+
+  if (!dobj)
+  {
+    return 0;
+  }
+
+  // A composite dataset's MTime does not change when only its blocks are
+  // modified, but its update time changes every time the data is regenerated.
+  return std::max({ mtime, dobj->GetMTime(), dobj->GetUpdateTime() });
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -1001,6 +1050,14 @@ void vtkPVDataInformation::CopyToStream(vtkClientServerStream* css)
 {
   css->Reset();
   *css << vtkClientServerStream::Reply;
+  this->AppendToStream(css);
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::AppendToStream(vtkClientServerStream* css)
+{
+  *css << StreamFormatVersion;
   *css << this->DataSetType << this->CompositeDataSetType << this->FirstLeafCompositeIndex
        << this->NumberOfTrees << this->NumberOfLeaves << this->NumberOfAMRLevels
        << this->NumberOfDataSets << this->MemorySize
@@ -1025,15 +1082,12 @@ void vtkPVDataInformation::CopyToStream(vtkClientServerStream* css)
       &this->UniqueBlockTypes.front(), static_cast<int>(this->UniqueBlockTypes.size()));
   }
 
-  vtkClientServerStream temp;
-  this->PointArrayInformation->CopyToStream(&temp);
-  *css << temp;
-
+  // Attribute and array information is written in place, avoiding a nested
+  // stream (and a copy of it) per attribute type.
+  this->PointArrayInformation->AppendToStream(css);
   for (int cc = 0; cc < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++cc)
   {
-    temp.Reset();
-    this->AttributeInformations[cc]->CopyToStream(&temp);
-    *css << temp;
+    this->AttributeInformations[cc]->AppendToStream(css);
   }
 
   if (this->CompositeDataSetType != -1)
@@ -1051,7 +1105,6 @@ void vtkPVDataInformation::CopyToStream(vtkClientServerStream* css)
   {
     assert(this->NumberOfAMRLevels == 0);
   }
-  *css << vtkClientServerStream::End;
 }
 
 //----------------------------------------------------------------------------
@@ -1059,109 +1112,120 @@ void vtkPVDataInformation::CopyFromStream(const vtkClientServerStream* css)
 {
   // argument counter.
   int argument = 0;
+  this->ReadFromStream(css, 0, argument);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataInformation::ReadFromStream(
+  const vtkClientServerStream* css, int message, int& argument)
+{
+  int version = 0;
+  if (!css->GetArgument(message, argument++, &version) || version != StreamFormatVersion)
+  {
+    this->Initialize();
+    vtkErrorMacro("Error parsing stream: unsupported format version " << version << ".");
+    return false;
+  }
 
-  if (!css->GetArgument(0, argument++, &this->DataSetType) ||
-    !css->GetArgument(0, argument++, &this->CompositeDataSetType) ||
-    !css->GetArgument(0, argument++, &this->FirstLeafCompositeIndex) ||
-    !css->GetArgument(0, argument++, &this->NumberOfTrees) ||
-    !css->GetArgument(0, argument++, &this->NumberOfLeaves) ||
-    !css->GetArgument(0, argument++, &this->NumberOfAMRLevels) ||
-    !css->GetArgument(0, argument++, &this->NumberOfDataSets) ||
-    !css->GetArgument(0, argument++, &this->MemorySize) ||
-    !css->GetArgument(0, argument++, this->Bounds, 6) ||
-    !css->GetArgument(0, argument++, this->Extent, 6) ||
-    !css->GetArgument(0, argument++, &this->HasTime) ||
-    !css->GetArgument(0, argument++, &this->Time) ||
-    !css->GetArgument(0, argument++, this->TimeRange, 2) ||
-    !css->GetArgument(0, argument++, &this->TimeLabel) ||
+  if (!css->GetArgument(message, argument++, &this->DataSetType) ||
+    !css->GetArgument(message, argument++, &this->CompositeDataSetType) ||
+    !css->GetArgument(message, argument++, &this->FirstLeafCompositeIndex) ||
+    !css->GetArgument(message, argument++, &this->NumberOfTrees) ||
+    !css->GetArgument(message, argument++, &this->NumberOfLeaves) ||
+    !css->GetArgument(message, argument++, &this->NumberOfAMRLevels) ||
+    !css->GetArgument(message, argument++, &this->NumberOfDataSets) ||
+    !css->GetArgument(message, argument++, &this->MemorySize) ||
+    !css->GetArgument(message, argument++, this->Bounds, 6) ||
+    !css->GetArgument(message, argument++, this->Extent, 6) ||
+    !css->GetArgument(message, argument++, &this->HasTime) ||
+    !css->GetArgument(message, argument++, &this->Time) ||
+    !css->GetArgument(message, argument++, this->TimeRange, 2) ||
+    !css->GetArgument(message, argument++, &this->TimeLabel) ||
     !css->GetArgument(
-      0, argument++, this->NumberOfElements, vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES))
+      message, argument++, this->NumberOfElements, vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES))
   {
     this->Initialize();
     vtkErrorMacro("Error parsing stream.");
-    return;
+    return false;
   }
 
   // read TimeSteps
   int timeStepsLength;
-  if (!css->GetArgument(0, argument++, &timeStepsLength))
+  if (!css->GetArgument(message, argument++, &timeStepsLength))
   {
     this->Initialize();
     vtkErrorMacro("Error parsing stream.");
-    return;
+    return false;
   }
   std::vector<double> vec;
   vec.resize(timeStepsLength);
-  if (timeStepsLength > 0 && !css->GetArgument(0, argument++, &vec[0], timeStepsLength))
+  if (timeStepsLength > 0 && !css->GetArgument(message, argument++, &vec[0], timeStepsLength))
   {
     this->Initialize();
     vtkErrorMacro("Error parsing stream.");
-    return;
+    return false;
   }
   this->TimeSteps.insert(vec.begin(), vec.end());
 
   // read UniqueBlockTypes.
   int uniqueBlockTypesLength;
-  if (!css->GetArgument(0, argument++, &uniqueBlockTypesLength))
+  if (!css->GetArgument(message, argument++, &uniqueBlockTypesLength))
   {
     this->Initialize();
     vtkErrorMacro("Error parsing stream.");
-    return;
+    return false;
   }
   this->UniqueBlockTypes.resize(uniqueBlockTypesLength);
   if (uniqueBlockTypesLength > 0 &&
-    !css->GetArgument(0, argument++, &this->UniqueBlockTypes[0], uniqueBlockTypesLength))
+    !css->GetArgument(message, argument++, &this->UniqueBlockTypes[0], uniqueBlockTypesLength))
   {
     this->Initialize();
     vtkErrorMacro("Error parsing stream.");
-    return;
+    return false;
   }
 
-  vtkClientServerStream temp;
-  if (!css->GetArgument(0, argument++, &temp))
+  if (!this->PointArrayInformation->ReadFromStream(css, message, argument))
   {
     this->Initialize();
     vtkErrorMacro("Error parsing stream.");
-    return;
+    return false;
   }
-  this->PointArrayInformation->CopyFromStream(&temp);
 
   for (int cc = 0; cc < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++cc)
   {
-    temp.Reset();
-    if (!css->GetArgument(0, argument++, &temp))
+    if (!this->AttributeInformations[cc]->ReadFromStream(css, message, argument))
     {
       this->Initialize();
       vtkErrorMacro("Error parsing stream.");
-      return;
+      return false;
     }
-    this->AttributeInformations[cc]->CopyFromStream(&temp);
   }
 
   if (this->CompositeDataSetType != -1)
   {
     std::string hierarchy, assembly;
-    if (!css->GetArgument(0, argument++, &assembly) ||
+    if (!css->GetArgument(message, argument++, &assembly) ||
       !this->DataAssembly->InitializeFromXML(assembly.c_str()) ||
-      !css->GetArgument(0, argument++, &hierarchy) ||
+      !css->GetArgument(message, argument++, &hierarchy) ||
       !this->Hierarchy->InitializeFromXML(hierarchy.c_str()))
     {
       this->Initialize();
       vtkErrorMacro("Error parsing stream.");
-      return;
+      return false;
     }
   }
 
   // read AMRNumberOfDataSets.
   this->AMRNumberOfDataSets.resize(this->NumberOfAMRLevels);
   if (this->NumberOfAMRLevels > 0 &&
-    !css->GetArgument(
-      0, argument++, &this->AMRNumberOfDataSets[0], static_cast<int>(this->NumberOfAMRLevels)))
+    !css->GetArgument(message, argument++, &this->AMRNumberOfDataSets[0],
+      static_cast<int>(this->NumberOfAMRLevels)))
   {
     this->Initialize();
     vtkErrorMacro("Error parsing stream.");
-    return;
+    return false;
   }
+  return true;
 }
 
 //----------------------------------------------------------------------------
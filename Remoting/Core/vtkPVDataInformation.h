@@ -102,6 +102,7 @@ public:
   void CopyFromStream(const vtkClientServerStream*) override;
   void CopyParametersToStream(vtkMultiProcessStream&) override;
   void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  vtkMTimeType GetCacheableMTime(vtkObject* object) override;
   ///@}
 
   /**
@@ -474,6 +475,18 @@ protected:
   void CopyFromDataObject(vtkDataObject* dobj);
   friend class vtkPVDataInformationHelper;
 
+  ///@{
+  /**
+   * Serialize the information as part of the current message of `css`, or
+   * read it from message `message` starting at `argument`, which is advanced
+   * past it. `CopyToStream` and `CopyFromStream` use these with a message of
+   * its own, subclasses can use them to add their own values to the same
+   * message. The values are written in a flat layout led by a format version.
+   */
+  void AppendToStream(vtkClientServerStream* css);
+  bool ReadFromStream(const vtkClientServerStream* css, int message, int& argument);
+  ///@}
+
   /**
    * Extracts selected blocks. Use SubsetSelector and SubsetAssemblyName to extract
    * chosen part of the composite dataset and returns that.
@@ -367,72 +367,76 @@ vtkPVArrayInformation* vtkPVDataSetAttributesInformation::GetArrayInformation(
 //----------------------------------------------------------------------------
 void vtkPVDataSetAttributesInformation::CopyToStream(vtkClientServerStream* css)
 {
-  const auto& internals = (*this->Internals);
-
   css->Reset();
   *css << vtkClientServerStream::Reply;
+  this->AppendToStream(css);
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataSetAttributesInformation::AppendToStream(vtkClientServerStream* css)
+{
+  const auto& internals = (*this->Internals);
 
   // Number of arrays.
   *css << internals.ValuesPopulated << static_cast<int>(internals.ArrayInformation.size());
 
-  // Serialize each array's information.
+  // Serialize each array's information in place rather than as nested streams.
   for (auto& pair : internals.ArrayInformation)
   {
-    vtkClientServerStream temp;
-    pair.second->CopyToStream(&temp);
-    *css << temp;
+    pair.second->AppendToStream(css);
   }
 
   for (int cc = 0; cc < vtkDataSetAttributes::NUM_ATTRIBUTES; ++cc)
   {
     *css << internals.AttributesInformation[cc];
   }
-  *css << vtkClientServerStream::End;
 }
 
 //----------------------------------------------------------------------------
 void vtkPVDataSetAttributesInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  // argument counter.
+  int argument = 0;
+  this->ReadFromStream(css, 0, argument);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataSetAttributesInformation::ReadFromStream(
+  const vtkClientServerStream* css, int message, int& argument)
 {
   auto& internals = (*this->Internals);
   assert(internals.ValuesPopulated == false);
 
-  // argument counter.
-  int argument = 0;
   int num_arrays = 0;
-  if (!css->GetArgument(0, argument++, &internals.ValuesPopulated) ||
-    !css->GetArgument(0, argument++, &num_arrays))
+  if (!css->GetArgument(message, argument++, &internals.ValuesPopulated) ||
+    !css->GetArgument(message, argument++, &num_arrays))
   {
     this->Initialize();
     vtkErrorMacro("Error parsing stream");
-    return;
+    return false;
   }
 
   for (int cc = 0; cc < num_arrays; ++cc)
   {
-    vtkClientServerStream temp;
-    if (!css->GetArgument(0, argument++, &temp))
-    {
-      this->Initialize();
-      vtkErrorMacro("Error parsing stream");
-      return;
-    }
-    auto ainfo = vtkPVArrayInformation::New();
-    if (!ainfo->CopyFromStream(&temp))
+    vtkSmartPointer<vtkPVArrayInformation> ainfo = vtkSmartPointer<vtkPVArrayInformation>::New();
+    if (!ainfo->ReadFromStream(css, message, argument))
     {
       this->Initialize();
       vtkErrorMacro("Error parsing stream");
-      return;
+      return false;
     }
-    internals.ArrayInformation[ainfo->GetName()].TakeReference(ainfo);
+    internals.ArrayInformation[ainfo->GetName()] = ainfo;
   }
 
   for (int cc = 0; cc < vtkDataSetAttributes::NUM_ATTRIBUTES; ++cc)
   {
-    if (!css->GetArgument(0, argument++, &internals.AttributesInformation[cc]))
+    if (!css->GetArgument(message, argument++, &internals.AttributesInformation[cc]))
     {
       this->Initialize();
       vtkErrorMacro("Error parsing stream");
-      return;
+      return false;
     }
   }
+  return true;
 }
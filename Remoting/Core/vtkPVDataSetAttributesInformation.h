@@ -93,6 +93,16 @@ protected:
   void CopyFromStream(const vtkClientServerStream*);
   ///@}
 
+  ///@{
+  /**
+   * Same as `CopyToStream` and `CopyFromStream`, but appending to the current
+   * message of `css` or reading message `message` from `argument`, which is
+   * advanced past the information.
+   */
+  void AppendToStream(vtkClientServerStream* css);
+  bool ReadFromStream(const vtkClientServerStream* css, int message, int& argument);
+  ///@}
+
   /**
    * Combine with another vtkPVDataSetAttributesInformation instance.
    */
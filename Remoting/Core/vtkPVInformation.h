@@ -51,6 +51,16 @@ public:
   virtual void CopyParametersFromStream(vtkMultiProcessStream&){};
   ///@}
 
+  /**
+   * Information gathered from `object` may be cached by the session and reused
+   * as long as the parameters (see `CopyParametersToStream`) and the returned
+   * modification time remain unchanged. Subclasses whose result depends solely
+   * on the state of `object` can override this to return a time that changes
+   * whenever the gathered information may have changed. The default returns 0,
+   * which indicates that the information must not be cached.
+   */
+  virtual vtkMTimeType GetCacheableMTime(vtkObject* vtkNotUsed(object)) { return 0; }
+
   ///@{
   /**
    * Set/get whether to gather information only from the root.
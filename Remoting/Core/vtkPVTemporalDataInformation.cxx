@@ -4,14 +4,127 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkCallbackCommand.h"
+#include "vtkClientServerStream.h"
+#include "vtkCommand.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
 #include <vector>
 
+namespace
+{
+// Serialized information for each timestep of a producer, valid as long as the
+// pipeline MTime of the producer is unchanged.
+struct vtkTimeStepCache
+{
+  vtkMTimeType PipelineMTime = 0;
+  vtkTypeUInt64 LastUse = 0;
+  std::map<double, vtkClientServerStream> TimeSteps;
+};
+
+using vtkTimeStepCacheKey = std::tuple<vtkAlgorithm*, int, std::string>;
+
+struct vtkTimeStepCaches
+{
+  std::map<vtkTimeStepCacheKey, vtkTimeStepCache> Caches;
+
+  // Observers of the DeleteEvent of each producer, so that the caches of a
+  // producer are released when it is deleted. Otherwise, a new producer
+  // allocated at the same address could use them.
+  std::map<vtkAlgorithm*, unsigned long> Observers;
+  vtkNew<vtkCallbackCommand> DeleteObserver;
+
+  vtkTypeUInt64 Clock = 0;
+  vtkIdType MaximumNumberOfTimeSteps = 10000;
+
+  vtkTimeStepCaches()
+  {
+    this->DeleteObserver->SetCallback([](vtkObject* caller, unsigned long, void*, void*) {
+      auto producer = static_cast<vtkAlgorithm*>(caller);
+      auto& self = vtkTimeStepCaches::GetInstance();
+      self.Observers.erase(producer);
+      for (auto iter = self.Caches.begin(); iter != self.Caches.end();)
+      {
+        iter = std::get<0>(iter->first) == producer ? self.Caches.erase(iter) : std::next(iter);
+      }
+    });
+  }
+
+  ~vtkTimeStepCaches() { this->Clear(); }
+
+  static vtkTimeStepCaches& GetInstance()
+  {
+    static vtkTimeStepCaches instance;
+    return instance;
+  }
+
+  vtkTimeStepCache& Get(vtkAlgorithm* producer, int port, const std::string& parameters)
+  {
+    if (this->Observers.find(producer) == this->Observers.end())
+    {
+      this->Observers[producer] =
+        producer->AddObserver(vtkCommand::DeleteEvent, this->DeleteObserver);
+    }
+    auto& cache = this->Caches[vtkTimeStepCacheKey(producer, port, parameters)];
+    cache.LastUse = ++this->Clock;
+    return cache;
+  }
+
+  /**
+   * Caches the information of a timestep unless the cache is full. Other
+   * caches are released, least recently used first, to make room.
+   */
+  void Store(vtkTimeStepCache& cache, double time, vtkPVDataInformation* dinfo)
+  {
+    vtkIdType count = 0;
+    for (const auto& pair : this->Caches)
+    {
+      count += static_cast<vtkIdType>(pair.second.TimeSteps.size());
+    }
+
+    while (count >= this->MaximumNumberOfTimeSteps)
+    {
+      auto lru = this->Caches.end();
+      for (auto iter = this->Caches.begin(); iter != this->Caches.end(); ++iter)
+      {
+        if (&iter->second != &cache && !iter->second.TimeSteps.empty() &&
+          (lru == this->Caches.end() || iter->second.LastUse < lru->second.LastUse))
+        {
+          lru = iter;
+        }
+      }
+      if (lru == this->Caches.end())
+      {
+        // only this cache is left and it is full.
+        return;
+      }
+      count -= static_cast<vtkIdType>(lru->second.TimeSteps.size());
+      lru->second.TimeSteps.clear();
+    }
+    dinfo->CopyToStream(&cache.TimeSteps[time]);
+  }
+
+  void Clear()
+  {
+    for (const auto& pair : this->Observers)
+    {
+      pair.first->RemoveObserver(pair.second);
+    }
+    this->Observers.clear();
+    this->Caches.clear();
+  }
+};
+}
+
 vtkStandardNewMacro(vtkPVTemporalDataInformation);
 //----------------------------------------------------------------------------
 vtkPVTemporalDataInformation::vtkPVTemporalDataInformation() = default;
@@ -36,6 +149,9 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
     return;
   }
 
+  this->NumberOfTimeSteps = 0;
+  this->NumberOfPendingTimeSteps = 0;
+
   port->GetProducer()->Update();
   vtkDataObject* dobj = port->GetProducer()->GetOutputDataObject(port->GetIndex());
 
@@ -78,27 +194,155 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
     return;
   }
 
+  this->NumberOfTimeSteps = static_cast<int>(timesteps.size());
+
+  // The information of each timestep is cached by the data information
+  // parameters and reused until the pipeline is modified.
+  vtkMultiProcessStream parameters;
+  this->Superclass::CopyParametersToStream(parameters);
+  std::vector<unsigned char> rawParameters;
+  parameters.GetRawData(rawParameters);
+  auto& caches = vtkTimeStepCaches::GetInstance();
+  auto& cache = caches.Get(port->GetProducer(), port->GetIndex(),
+    std::string(rawParameters.begin(), rawParameters.end()));
+
+  sddp->UpdatePipelineMTime();
+  if (cache.PipelineMTime != sddp->GetPipelineMTime())
+  {
+    cache.PipelineMTime = sddp->GetPipelineMTime();
+    cache.TimeSteps.clear();
+  }
+
   double current_time = this->GetTime();
-  for (auto time : timesteps)
+  if (cache.TimeSteps.find(current_time) == cache.TimeSteps.end())
+  {
+    vtkNew<vtkPVDataInformation> dinfo;
+    dinfo->CopyFromObject(dobj);
+    caches.Store(cache, current_time, dinfo);
+  }
+
+  int numberOfUpdates = 0;
+  for (size_t cc = 0; cc < timesteps.size(); ++cc)
   {
+    const double time = timesteps[cc];
     if (time == current_time)
     {
       // skip the timestep already seen.
       continue;
     }
-    pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), time);
-    sddp->Update(port->GetIndex());
-
-    dobj = port->GetProducer()->GetOutputDataObject(port->GetIndex());
 
     vtkNew<vtkPVDataInformation> dinfo;
-    dinfo->CopyFromObject(dobj);
+    auto iter = cache.TimeSteps.find(time);
+    if (iter != cache.TimeSteps.end())
+    {
+      dinfo->CopyFromStream(&iter->second);
+    }
+    else if (this->MaximumNumberOfTimeStepsToUpdate > 0 &&
+      numberOfUpdates >= this->MaximumNumberOfTimeStepsToUpdate)
+    {
+      // leave this timestep for a subsequent gather.
+      ++this->NumberOfPendingTimeSteps;
+      continue;
+    }
+    else
+    {
+      pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), time);
+      sddp->Update(port->GetIndex());
+      ++numberOfUpdates;
+
+      dobj = port->GetProducer()->GetOutputDataObject(port->GetIndex());
+      dinfo->CopyFromObject(dobj);
+      caches.Store(cache, time, dinfo);
+    }
     this->AddInformation(dinfo);
+
+    double progress = static_cast<double>(cc + 1) / timesteps.size();
+    this->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::AddInformation(vtkPVInformation* oinfo)
+{
+  this->Superclass::AddInformation(oinfo);
+  if (auto other = vtkPVTemporalDataInformation::SafeDownCast(oinfo))
+  {
+    this->NumberOfTimeSteps = std::max(this->NumberOfTimeSteps, other->NumberOfTimeSteps);
+    this->NumberOfPendingTimeSteps =
+      std::max(this->NumberOfPendingTimeSteps, other->NumberOfPendingTimeSteps);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << this->NumberOfTimeSteps
+       << this->NumberOfPendingTimeSteps;
+  this->Superclass::AppendToStream(css);
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  int argument = 0;
+  if (!css->GetArgument(0, argument++, &this->NumberOfTimeSteps) ||
+    !css->GetArgument(0, argument++, &this->NumberOfPendingTimeSteps) ||
+    !this->Superclass::ReadFromStream(css, 0, argument))
+  {
+    this->Initialize();
+    this->NumberOfTimeSteps = 0;
+    this->NumberOfPendingTimeSteps = 0;
+    vtkErrorMacro("Error parsing stream.");
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  this->Superclass::CopyParametersToStream(str);
+  str << this->MaximumNumberOfTimeStepsToUpdate;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  this->Superclass::CopyParametersFromStream(str);
+  str >> this->MaximumNumberOfTimeStepsToUpdate;
+}
+
+//----------------------------------------------------------------------------
+vtkMTimeType vtkPVTemporalDataInformation::GetCacheableMTime(vtkObject* object)
+{
+  // Partial results must be gathered again to collect the pending timesteps.
+  return this->NumberOfPendingTimeSteps > 0 ? 0 : this->Superclass::GetCacheableMTime(object);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::ClearCache()
+{
+  vtkTimeStepCaches::GetInstance().Clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::SetMaximumNumberOfCachedTimeSteps(vtkIdType count)
+{
+  vtkTimeStepCaches::GetInstance().MaximumNumberOfTimeSteps = std::max<vtkIdType>(count, 0);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVTemporalDataInformation::GetMaximumNumberOfCachedTimeSteps()
+{
+  return vtkTimeStepCaches::GetInstance().MaximumNumberOfTimeSteps;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumNumberOfTimeStepsToUpdate: " << this->MaximumNumberOfTimeStepsToUpdate
+     << endl;
+  os << indent << "NumberOfTimeSteps: " << this->NumberOfTimeSteps << endl;
+  os << indent << "NumberOfPendingTimeSteps: " << this->NumberOfPendingTimeSteps << endl;
 }
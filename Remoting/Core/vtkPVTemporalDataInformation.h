@@ -7,6 +7,16 @@
  * vtkPVTemporalDataInformation is used to gather data information over time.
  * It simply overrides `vtkPVDataInformation::CopyFromObject` to ensure that the
  * data information is collected from all timesteps and not just 1.
+ *
+ * The information collected for each timestep is cached on every process and
+ * reused as long as the pipeline MTime of the producer is unchanged, so that
+ * gathering it again, e.g. after changing the current time, does not update
+ * the pipeline for every timestep. `MaximumNumberOfTimeStepsToUpdate` can be
+ * used to limit the number of pipeline updates done by each gather, so that
+ * the information for long series can be filled in incrementally.
+ *
+ * The cache is bounded by `SetMaximumNumberOfCachedTimeSteps` and the
+ * information cached for a producer is released when the producer is deleted.
  */
 
 #ifndef vtkPVTemporalDataInformation_h
@@ -31,10 +41,65 @@ public:
    */
   void CopyFromObject(vtkObject* object) override;
 
+  ///@{
+  /**
+   * vtkPVInformation API implementation.
+   */
+  void AddInformation(vtkPVInformation* info) override;
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  vtkMTimeType GetCacheableMTime(vtkObject* object) override;
+  ///@}
+
+  ///@{
+  /**
+   * Set/get the maximum number of timesteps for which the pipeline is updated
+   * by a single call to `CopyFromObject`. Timesteps served from the cache do
+   * not count. When the limit is reached, the information only covers the
+   * timesteps collected so far and the remaining ones are reported by
+   * `GetNumberOfPendingTimeSteps`; gathering the information again continues
+   * where the previous gather stopped, as long as the collected timesteps fit
+   * in the cache. 0 (default) means no limit.
+   */
+  vtkSetClampMacro(MaximumNumberOfTimeStepsToUpdate, int, 0, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfTimeStepsToUpdate, int);
+  ///@}
+
+  ///@{
+  /**
+   * Returns the number of timesteps provided by the pipeline and the number of
+   * them that are not included in this information yet.
+   */
+  vtkGetMacro(NumberOfTimeSteps, int);
+  vtkGetMacro(NumberOfPendingTimeSteps, int);
+  ///@}
+
+  /**
+   * Release the information cached for all timesteps of all producers.
+   */
+  static void ClearCache();
+
+  ///@{
+  /**
+   * Set/get the maximum number of timesteps, over all producers, for which
+   * information is cached on each process. When the cache is full, the
+   * information cached for the least recently used producers is released.
+   * Timesteps that do not fit are not cached. Default is 10000.
+   */
+  static void SetMaximumNumberOfCachedTimeSteps(vtkIdType count);
+  static vtkIdType GetMaximumNumberOfCachedTimeSteps();
+  ///@}
+
 protected:
   vtkPVTemporalDataInformation();
   ~vtkPVTemporalDataInformation() override;
 
+  int MaximumNumberOfTimeStepsToUpdate = 0;
+  int NumberOfTimeSteps = 0;
+  int NumberOfPendingTimeSteps = 0;
+
 private:
   vtkPVTemporalDataInformation(const vtkPVTemporalDataInformation&) = delete;
   void operator=(const vtkPVTemporalDataInformation&) = delete;
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVSessionCore.h"
+#include "vtkPVTestUtilities.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+vtkIdType GatherNumberOfPoints(vtkSMSession* session, vtkSMProxy* proxy)
+{
+  vtkNew<vtkPVDataInformation> info;
+  info->Initialize();
+  session->GatherInformation(vtkPVSession::DATA_SERVER, info, proxy->GetGlobalID());
+  return info->GetNumberOfPoints();
+}
+}
+
+int TestInformationCache(int argc, char* argv[])
+{
+  vtkNew<vtkPVTestUtilities> testing;
+  testing->Initialize(argc, argv);
+
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  int status = EXIT_SUCCESS;
+  {
+    vtkNew<vtkSMParaViewPipelineController> controller;
+    vtkNew<vtkSMSession> session;
+    controller->InitializeSession(session);
+
+    auto pxm = session->GetSessionProxyManager();
+    auto sphere = vtkSmartPointer<vtkSMSourceProxy>::Take(
+      vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+    controller->InitializeProxy(sphere);
+    controller->RegisterPipelineProxy(sphere);
+    vtkSMPropertyHelper(sphere, "ThetaResolution").Set(8);
+    vtkSMPropertyHelper(sphere, "PhiResolution").Set(8);
+    sphere->UpdateVTKObjects();
+    sphere->UpdatePipeline();
+
+    auto core = session->GetSessionCore();
+    const vtkTypeUInt64 expectedSkips = core->GetNumberOfProcesses() > 1 ? 1 : 0;
+
+    // the first gather is a miss.
+    vtkTypeUInt64 hits = core->GetInformationCacheHits();
+    vtkTypeUInt64 misses = core->GetInformationCacheMisses();
+    vtkTypeUInt64 skips = core->GetSkippedSatelliteGathers();
+    const vtkIdType npts = GatherNumberOfPoints(session, sphere);
+    if (npts <= 0 || core->GetInformationCacheHits() != hits ||
+      core->GetInformationCacheMisses() != misses + 1)
+    {
+      vtkLogF(ERROR, "First gather should be a cache miss.");
+      status = EXIT_FAILURE;
+    }
+
+    // gathering again without changes is a hit, with identical results.
+    hits = core->GetInformationCacheHits();
+    misses = core->GetInformationCacheMisses();
+    if (GatherNumberOfPoints(session, sphere) != npts ||
+      core->GetInformationCacheHits() != hits + 1 ||
+      core->GetInformationCacheMisses() != misses ||
+      core->GetSkippedSatelliteGathers() != skips + expectedSkips)
+    {
+      vtkLogF(ERROR, "Repeated gather should be a cache hit.");
+      status = EXIT_FAILURE;
+    }
+
+    // changing the pipeline must invalidate any cached information.
+    vtkSMPropertyHelper(sphere, "ThetaResolution").Set(16);
+    sphere->UpdateVTKObjects();
+    sphere->UpdatePipeline();
+    hits = core->GetInformationCacheHits();
+    misses = core->GetInformationCacheMisses();
+    skips = core->GetSkippedSatelliteGathers();
+    const vtkIdType npts2 = GatherNumberOfPoints(session, sphere);
+    if (npts2 <= npts)
+    {
+      vtkLogF(ERROR, "Stale information returned after pipeline change (%lld <= %lld).",
+        static_cast<long long>(npts2), static_cast<long long>(npts));
+      status = EXIT_FAILURE;
+    }
+    if (core->GetInformationCacheHits() != hits ||
+      core->GetInformationCacheMisses() != misses + 1 ||
+      core->GetSkippedSatelliteGathers() != skips)
+    {
+      vtkLogF(ERROR, "Gather after a pipeline change should be a cache miss.");
+      status = EXIT_FAILURE;
+    }
+
+    controller->UnRegisterProxy(sphere);
+  }
+
+  vtkInitializationHelper::Finalize();
+  return status;
+}
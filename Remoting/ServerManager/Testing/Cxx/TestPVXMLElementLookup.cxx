@@ -0,0 +1,369 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCollection.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVVersion.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPTools.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMStateLoader.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace
+{
+// A state with `numberOfProxies` sphere sources, listed in the reverse order
+// of the proxy collection referring to them, so that the state loader has to
+// look up each proxy element by id.
+std::string CreateState(int numberOfProxies)
+{
+  std::ostringstream xml;
+  xml << "<ParaView><ServerManagerState version=\"" << PARAVIEW_VERSION_FULL << "\">\n";
+  for (int cc = numberOfProxies - 1; cc >= 0; --cc)
+  {
+    const int id = 1000 + 3 * cc;
+    xml << "  <Proxy group=\"sources\" type=\"SphereSource\" id=\"" << id << "\" servers=\"1\">\n"
+        << "    <Property name=\"Radius\" id=\"" << id << ".Radius\" number_of_elements=\"1\">\n"
+        << "      <Element index=\"0\" value=\"" << cc + 1 << "\"/>\n"
+        << "      <Domain name=\"range\" id=\"" << id << ".Radius.range\"/>\n"
+        << "    </Property>\n"
+        << "    <Property name=\"PhiResolution\" id=\"" << id
+        << ".PhiResolution\" number_of_elements=\"1\">\n"
+        << "      <Element index=\"0\" value=\"" << 3 + cc % 50 << "\"/>\n"
+        << "      <Domain name=\"range\" id=\"" << id << ".PhiResolution.range\"/>\n"
+        << "    </Property>\n"
+        << "  </Proxy>\n";
+  }
+  xml << "  <ProxyCollection name=\"sources\">\n";
+  for (int cc = 0; cc < numberOfProxies; ++cc)
+  {
+    xml << "    <Item id=\"" << 1000 + 3 * cc << "\" name=\"Sphere" << cc << "\"/>\n";
+  }
+  xml << "  </ProxyCollection>\n</ServerManagerState></ParaView>\n";
+  return xml.str();
+}
+
+// Linear searches, as done before elements used hash tables.
+const char* ReferenceGetAttribute(vtkPVXMLElement* element, const char* name)
+{
+  for (unsigned int cc = 0; cc < element->GetNumberOfAttributes(); ++cc)
+  {
+    if (strcmp(element->GetAttributeName(cc), name) == 0)
+    {
+      return element->GetAttributeValue(cc);
+    }
+  }
+  return nullptr;
+}
+
+vtkPVXMLElement* ReferenceFind(vtkPVXMLElement* element, const char* key, bool byName)
+{
+  for (unsigned int cc = 0; cc < element->GetNumberOfNestedElements(); ++cc)
+  {
+    vtkPVXMLElement* nested = element->GetNestedElement(cc);
+    const char* value = byName ? nested->GetName() : nested->GetId();
+    if (value && strcmp(value, key) == 0)
+    {
+      return nested;
+    }
+  }
+  return nullptr;
+}
+
+bool CheckAttributes(vtkPVXMLElement* element, int numberOfNames)
+{
+  for (int cc = 0; cc < numberOfNames; ++cc)
+  {
+    const std::string name = "attribute" + std::to_string(cc);
+    const char* expected = ::ReferenceGetAttribute(element, name.c_str());
+    const char* value = element->GetAttribute(name.c_str());
+    if (!((!expected && !value) || (expected && value && strcmp(expected, value) == 0)))
+    {
+      vtkLogF(ERROR, "Incorrect value for %s", name.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestAttributes()
+{
+  vtkNew<vtkPVXMLElement> element;
+  element->SetName("Element");
+  for (int cc = 0; cc < 20; ++cc)
+  {
+    element->AddAttribute(("attribute" + std::to_string(cc)).c_str(), cc);
+  }
+  if (!::CheckAttributes(element, 25))
+  {
+    vtkLogF(ERROR, "Incorrect attributes.");
+    return false;
+  }
+
+  // The first attribute with a name is the one used.
+  element->AddAttribute("attribute3", "duplicate");
+  if (strcmp(element->GetAttribute("attribute3"), "3") != 0)
+  {
+    vtkLogF(ERROR, "Duplicate attribute returned.");
+    return false;
+  }
+  element->RemoveAttribute("attribute3");
+  if (strcmp(element->GetAttribute("attribute3"), "duplicate") != 0)
+  {
+    vtkLogF(ERROR, "Attribute not removed.");
+    return false;
+  }
+  element->SetAttribute("attribute5", "five");
+  element->SetAttribute("attribute21", "twenty-one");
+  element->RemoveAttribute("attribute0");
+  if (!::CheckAttributes(element, 25))
+  {
+    vtkLogF(ERROR, "Incorrect attributes after changes.");
+    return false;
+  }
+  if (strcmp(element->GetAttribute("attribute21"), "twenty-one") != 0)
+  {
+    vtkLogF(ERROR, "Attribute not set.");
+    return false;
+  }
+
+  vtkNew<vtkPVXMLElement> copy;
+  element->CopyTo(copy);
+  copy->RemoveAttribute("attribute10");
+  if (!::CheckAttributes(copy, 25) || copy->GetAttribute("attribute10"))
+  {
+    vtkLogF(ERROR, "Incorrect copy.");
+    return false;
+  }
+  copy->Merge(element, nullptr);
+  if (!::CheckAttributes(copy, 25) || !copy->GetAttribute("attribute10"))
+  {
+    vtkLogF(ERROR, "Incorrect merge.");
+    return false;
+  }
+  if (copy->GetNumberOfAttributes() != element->GetNumberOfAttributes())
+  {
+    vtkLogF(ERROR, "Merge duplicated attributes.");
+    return false;
+  }
+  return true;
+}
+
+bool CheckNested(vtkPVXMLElement* parent, int numberOfNames)
+{
+  for (int cc = 0; cc < numberOfNames; ++cc)
+  {
+    const std::string name = "Name" + std::to_string(cc);
+    vtkPVXMLElement* expected = ::ReferenceFind(parent, name.c_str(), true);
+    if (parent->FindNestedElementByName(name.c_str()) != expected)
+    {
+      vtkLogF(ERROR, "Incorrect element named %s", name.c_str());
+      return false;
+    }
+    vtkNew<vtkCollection> elements;
+    parent->FindNestedElementByName(name.c_str(), elements);
+    int count = 0;
+    for (unsigned int i = 0; i < parent->GetNumberOfNestedElements(); ++i)
+    {
+      vtkPVXMLElement* nested = parent->GetNestedElement(i);
+      if (nested->GetName() && name == nested->GetName())
+      {
+        if (elements->GetItemAsObject(count++) != nested)
+        {
+          vtkLogF(ERROR, "Incorrect order for %s", name.c_str());
+          return false;
+        }
+      }
+    }
+    if (elements->GetNumberOfItems() != count)
+    {
+      vtkLogF(ERROR, "Incorrect elements named %s", name.c_str());
+      return false;
+    }
+
+    const std::string id = std::to_string(cc);
+    if (parent->FindNestedElement(id.c_str()) != ::ReferenceFind(parent, id.c_str(), false))
+    {
+      vtkLogF(ERROR, "Incorrect element with id %s", id.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestNested()
+{
+  vtkNew<vtkPVXMLParser> parser;
+  std::ostringstream xml;
+  xml << "<Parent>";
+  for (int cc = 0; cc < 20; ++cc)
+  {
+    xml << "<Name" << cc % 7 << " id=\"" << cc << "\"/>";
+  }
+  xml << "</Parent>";
+  if (!parser->Parse(xml.str().c_str()))
+  {
+    vtkLogF(ERROR, "Failed to parse.");
+    return false;
+  }
+  vtkPVXMLElement* parent = parser->GetRootElement();
+  if (!::CheckNested(parent, 10))
+  {
+    vtkLogF(ERROR, "Incorrect nested elements.");
+    return false;
+  }
+
+  // Renaming nested elements, including into a name used by a later element.
+  parent->GetNestedElement(0)->SetName("Name3");
+  parent->GetNestedElement(1)->SetName("Name8");
+  if (!::CheckNested(parent, 10))
+  {
+    vtkLogF(ERROR, "Incorrect nested elements after renaming.");
+    return false;
+  }
+
+  vtkNew<vtkPVXMLElement> added;
+  added->SetName("Name9");
+  parent->AddNestedElement(added);
+  vtkNew<vtkPVXMLElement> replacement;
+  replacement->SetName("Name4");
+  parent->ReplaceNestedElement(parent->GetNestedElement(5), replacement);
+  parent->RemoveNestedElement(parent->GetNestedElement(2));
+  if (!::CheckNested(parent, 10))
+  {
+    vtkLogF(ERROR, "Incorrect nested elements after changes.");
+    return false;
+  }
+
+  // Elements nested without setting their parent must be found as well.
+  vtkNew<vtkPVXMLElement> other;
+  other->SetName("Other");
+  for (unsigned int cc = 0; cc < parent->GetNumberOfNestedElements(); ++cc)
+  {
+    other->AddNestedElement(parent->GetNestedElement(cc), 0);
+  }
+  if (!::CheckNested(other, 10))
+  {
+    vtkLogF(ERROR, "Incorrect shared elements.");
+    return false;
+  }
+  other->GetNestedElement(4)->SetName("Name0");
+  if (!::CheckNested(other, 10) || !::CheckNested(parent, 10))
+  {
+    vtkLogF(ERROR, "Incorrect renamed element.");
+    return false;
+  }
+
+  parent->RemoveAllNestedElements();
+  if (!::CheckNested(parent, 10))
+  {
+    vtkLogF(ERROR, "Incorrect nested elements after removing all.");
+    return false;
+  }
+  return true;
+}
+
+// Lookups do not modify the elements, so they can be done from several
+// threads, including the first ones after the element is parsed.
+bool TestConcurrentLookups()
+{
+  std::ostringstream xml;
+  xml << "<Parent>";
+  for (int cc = 0; cc < 100; ++cc)
+  {
+    xml << "<Name" << cc % 10 << " id=\"" << cc << "\"";
+    for (int attr = 0; attr < 20; ++attr)
+    {
+      xml << " attribute" << attr << "=\"" << cc * attr << "\"";
+    }
+    xml << "/>";
+  }
+  xml << "</Parent>";
+  vtkNew<vtkPVXMLParser> parser;
+  if (!parser->Parse(xml.str().c_str()))
+  {
+    vtkLogF(ERROR, "Failed to parse.");
+    return false;
+  }
+  vtkPVXMLElement* parent = parser->GetRootElement();
+
+  std::atomic<bool> success(true);
+  vtkSMPTools::For(0, 1000, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const int index = static_cast<int>(cc % 100);
+      const std::string id = std::to_string(index);
+      const std::string name = "Name" + std::to_string(index % 10);
+      const std::string attribute = "attribute" + std::to_string(cc % 20);
+      vtkPVXMLElement* element = parent->FindNestedElement(id.c_str());
+      if (element != parent->GetNestedElement(index) ||
+        parent->FindNestedElementByName(name.c_str()) != parent->GetNestedElement(index % 10) ||
+        std::stoi(element->GetAttribute(attribute.c_str())) != index * (cc % 20))
+      {
+        success = false;
+      }
+    }
+  });
+  if (!success)
+  {
+    vtkLogF(ERROR, "Incorrect concurrent lookups.");
+  }
+  return success;
+}
+
+bool TestState(int numberOfProxies)
+{
+  const std::string xml = ::CreateState(numberOfProxies);
+  vtkNew<vtkPVXMLParser> parser;
+  if (!parser->Parse(xml.c_str()))
+  {
+    vtkLogF(ERROR, "Failed to parse state.");
+    return false;
+  }
+
+  vtkNew<vtkSMSession> session;
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  vtkNew<vtkSMStateLoader> loader;
+  loader->SetSessionProxyManager(pxm);
+  pxm->LoadXMLState(parser->GetRootElement(), loader);
+
+  for (int cc = 0; cc < numberOfProxies; ++cc)
+  {
+    const std::string name = "Sphere" + std::to_string(cc);
+    vtkSMProxy* proxy = pxm->GetProxy("sources", name.c_str());
+    if (!proxy)
+    {
+      vtkLogF(ERROR, "Proxy '%s' not loaded.", name.c_str());
+      return false;
+    }
+    if (vtkSMPropertyHelper(proxy, "Radius").GetAsDouble() != cc + 1 ||
+      vtkSMPropertyHelper(proxy, "PhiResolution").GetAsInt() != 3 + cc % 50)
+    {
+      vtkLogF(ERROR, "Incorrect properties loaded for '%s'.", name.c_str());
+      return false;
+    }
+  }
+  pxm->UnRegisterProxies();
+  return true;
+}
+}
+
+int TestPVXMLElementLookup(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argc, argv, vtkProcessModule::PROCESS_CLIENT);
+  const bool success = ::TestAttributes() && ::TestNested() && ::TestConcurrentLookups() &&
+    ::TestState(500);
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -27,9 +27,12 @@
 #include "vtksys/FStream.hxx"
 
 #include <cassert>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -108,6 +111,12 @@ public:
     // Update map to keep track on which client is pointing to what
     size_t found = this->ClientSIRegistrationMap[origin].erase(globalUniqueId);
 
+    // Cached information for the object is not going to be requested anymore.
+    this->InformationCache.erase(
+      this->InformationCache.lower_bound(InformationCacheKeyType(globalUniqueId, std::string())),
+      this->InformationCache.lower_bound(
+        InformationCacheKeyType(globalUniqueId + 1, std::string())));
+
     // Remove SI (ServerImplementation) object
     SIObjectMapType::iterator iter = this->SIObjectMap.find(globalUniqueId);
     if (found && iter != this->SIObjectMap.end())
@@ -216,6 +225,32 @@ public:
   unsigned long InterpreterObserverID;
   std::map<vtkTypeUInt32, vtkSMMessage> MessageCacheMap;
   std::set<int> KnownClients;
+
+  // Cache for serialized vtkPVInformation results. The key is the global id of
+  // the object the information was gathered from and a string made up of the
+  // information class name and its serialized parameters.
+  struct vtkCachedInformation
+  {
+    vtkMTimeType MTime;
+    vtkClientServerStream Stream;
+  };
+  typedef std::pair<vtkTypeUInt32, std::string> InformationCacheKeyType;
+  std::map<InformationCacheKeyType, vtkCachedInformation> InformationCache;
+
+  static InformationCacheKeyType GetInformationCacheKey(
+    vtkPVInformation* information, vtkTypeUInt32 globalid)
+  {
+    vtkMultiProcessStream stream;
+    information->CopyParametersToStream(stream);
+    std::vector<unsigned char> params;
+    stream.GetRawData(params);
+
+    std::string key = information->GetClassName();
+    key.push_back('\0');
+    key.append(params.begin(), params.end());
+    return InformationCacheKeyType(globalid, key);
+  }
+
   // Used for collaboration as client may trigger invalid server request when
   // they are in a transitional state.
   bool DisableErrorMacro;
@@ -501,6 +536,10 @@ void vtkPVSessionCore::PushStateSatelliteCallback()
 void vtkPVSessionCore::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "EnableInformationCache: " << this->EnableInformationCache << endl;
+  os << indent << "InformationCacheHits: " << this->InformationCacheHits << endl;
+  os << indent << "InformationCacheMisses: " << this->InformationCacheMisses << endl;
+  os << indent << "SkippedSatelliteGathers: " << this->SkippedSatelliteGathers << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -797,6 +836,30 @@ bool vtkPVSessionCore::GatherInformation(
   const bool skip_satellites = (information->GetRootOnly() ||
     (location & vtkProcessModule::SERVERS) == 0 || this->SymmetricMPIMode);
 
+  // check if the result can be served from the information cache.
+  vtkInternals::InformationCacheKeyType cacheKey;
+  vtkMTimeType cacheMTime = 0;
+  if (this->EnableInformationCache && globalid != 0)
+  {
+    cacheMTime = information->GetCacheableMTime(this->GetInformationSource(globalid));
+  }
+  if (cacheMTime != 0)
+  {
+    cacheKey = vtkInternals::GetInformationCacheKey(information, globalid);
+    auto iter = this->Internals->InformationCache.find(cacheKey);
+    if (iter != this->Internals->InformationCache.end() && iter->second.MTime == cacheMTime)
+    {
+      information->CopyFromStream(&iter->second.Stream);
+      ++this->InformationCacheHits;
+      if (nranks > 1 && !skip_satellites)
+      {
+        ++this->SkippedSatelliteGathers;
+      }
+      return true;
+    }
+    ++this->InformationCacheMisses;
+  }
+
   // send message to satellites and then start processing.
   // this must be done before calling `GatherInformationInternal` on this process to
   // avoid deadlocks if the gather results in pipeline updates
@@ -826,7 +889,33 @@ bool vtkPVSessionCore::GatherInformation(
   // Now collect local information.
   const bool status = this->GatherInformationInternal(information, globalid);
 
-  return (skip_satellites || this->CollectInformation(information)) && status;
+  const bool result = (skip_satellites || this->CollectInformation(information)) && status;
+  if (result && cacheMTime != 0)
+  {
+    // gathering may have updated the pipeline, hence get the time again.
+    auto& cached = this->Internals->InformationCache[cacheKey];
+    cached.MTime = information->GetCacheableMTime(this->GetInformationSource(globalid));
+    cached.Stream.Reset();
+    information->CopyToStream(&cached.Stream);
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkObject* vtkPVSessionCore::GetInformationSource(vtkTypeUInt32 globalid)
+{
+  vtkSIObject* siObject = this->GetSIObject(globalid);
+  if (vtkSIProxy* siProxy = vtkSIProxy::SafeDownCast(siObject))
+  {
+    return vtkObject::SafeDownCast(siProxy->GetVTKObject());
+  }
+  return siObject;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVSessionCore::ClearInformationCache()
+{
+  this->Internals->InformationCache.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -857,23 +946,10 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 }
 
 //----------------------------------------------------------------------------
-#define SafeDeleteArray(array_ptr)                                                                 \
-  {                                                                                                \
-    if ((array_ptr) != nullptr)                                                                    \
-    {                                                                                              \
-      delete[](array_ptr);                                                                         \
-      (array_ptr) = nullptr;                                                                       \
-    }                                                                                              \
-  }
-
 bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
 {
-  // Sanity checks
-  assert("pre: nullptr PV information!" && (info != nullptr));
-
-  // STEP 0: temporary variables
-  int rank = this->ParallelController->GetLocalProcessId();
-  int nranks = this->ParallelController->GetNumberOfProcesses();
+  const int rank = this->ParallelController->GetLocalProcessId();
+  const int nranks = this->ParallelController->GetNumberOfProcesses();
 
   if (nranks == 1)
   {
@@ -881,81 +957,78 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
     return true;
   }
 
-  vtkIdType* rcvcounts = nullptr;     /* significant only at rank 0 */
-  vtkIdType* offSet = nullptr;        /* significant only at rank 0 */
-  int rbufsize = 0;                   /* significant only at rank 0 */
-  unsigned char* rcvbuffer = nullptr; /* significant only at rank 0 */
-
-  // STEP 1: Initialize data-structures at rank 0
-  if (rank == 0)
-  {
-    rcvcounts = new vtkIdType[nranks];
-    offSet = new vtkIdType[nranks];
-  } // END if rank == 0
-
-  // STEP 2: Serialize the vtkPVInformation object
+  // Reduce the information along a binomial tree rooted at rank 0: at each
+  // step, ranks with the `mask` bit set send their partial result to
+  // `rank - mask` and stop, while the others merge what they receive. Each
+  // rank thus deserializes at most log2(nranks) streams, instead of rank 0
+  // deserializing all of them, and the results are still merged in rank
+  // order. A null `info` (i.e. a satellite that failed to gather) cannot
+  // merge anything, so it forwards the streams received from its children
+  // unchanged; it still takes part, otherwise its parent would hang.
   vtkClientServerStream stream;
-  info->CopyToStream(&stream);
-
-  const unsigned char* data;
-  size_t length;
-
-  // Get pointer to the raw stream data. Note, this is a shallow copy, no
-  // need to delete the data.
-  stream.GetData(&data, &length);
-  vtkIdType local_length = static_cast<vtkIdType>(length);
-
-  // STEP 3: Get number of bytes that each process will send
-  this->ParallelController->Gather(&local_length, rcvcounts, 1, 0);
-
-  // STEP 4: Allocate temporary arrays at rank 0
-  if (rank == 0)
+  std::vector<std::vector<unsigned char>> pending;
+  for (int mask = 1; mask < nranks; mask <<= 1)
   {
-    // STEP 4.1: Calculate rcvbuffer size & allocate rcvbuffer
-    rbufsize = rcvcounts[0];
-    for (int i = 1; i < nranks; ++i)
+    if ((rank & mask) != 0)
     {
-      rbufsize += rcvcounts[i];
+      if (info)
+      {
+        const unsigned char* data = nullptr;
+        size_t length = 0;
+        info->CopyToStream(&stream);
+        // Shallow access to the raw stream data, no need to delete it.
+        stream.GetData(&data, &length);
+        pending.clear();
+        pending.emplace_back(data, data + length);
+      }
+
+      vtkIdType count = static_cast<vtkIdType>(pending.size());
+      this->ParallelController->Send(&count, 1, rank - mask, ROOT_SATELLITE_INFO_TAG);
+      for (const auto& piece : pending)
+      {
+        vtkIdType length = static_cast<vtkIdType>(piece.size());
+        this->ParallelController->Send(&length, 1, rank - mask, ROOT_SATELLITE_INFO_TAG);
+        if (length > 0)
+        {
+          this->ParallelController->Send(
+            piece.data(), length, rank - mask, ROOT_SATELLITE_INFO_TAG);
+        }
+      }
+      break;
     }
-    rcvbuffer = new unsigned char[rbufsize];
 
-    // STEP 4.2: populate offset array
-    offSet[0] = 0;
-    for (int i = 1; i < nranks; ++i)
+    const int child = rank + mask;
+    if (child < nranks)
     {
-      offSet[i] = offSet[i - 1] + rcvcounts[i - 1];
+      vtkIdType count = 0;
+      this->ParallelController->Receive(&count, 1, child, ROOT_SATELLITE_INFO_TAG);
+      for (vtkIdType cc = 0; cc < count; ++cc)
+      {
+        vtkIdType length = 0;
+        this->ParallelController->Receive(&length, 1, child, ROOT_SATELLITE_INFO_TAG);
+        if (length <= 0)
+        {
+          continue;
+        }
+        std::vector<unsigned char> buffer(static_cast<size_t>(length));
+        this->ParallelController->Receive(buffer.data(), length, child, ROOT_SATELLITE_INFO_TAG);
+        if (info)
+        {
+          stream.SetData(buffer.data(), buffer.size());
+          vtkSmartPointer<vtkPVInformation> tempInfo;
+          tempInfo.TakeReference(info->NewInstance());
+          tempInfo->CopyFromStream(&stream);
+          info->AddInformation(tempInfo);
+        }
+        else
+        {
+          pending.push_back(std::move(buffer));
+        }
+      }
     }
-  } // END if rank==0
-
-  // STEP 5: GatherV all data from satellites
-  this->ParallelController->GatherV(data, rcvbuffer, local_length, rcvcounts, offSet, 0);
+  }
 
-  // STEP 6: Deserialize data from other ranks at rank 0 and add them to
-  // the information object associated with rank 0.
-  if (rank == 0)
-  {
-    vtkClientServerStream rcvStream;
-    for (int i = 1; i < nranks; ++i)
-    {
-      rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
-      vtkPVInformation* tempInfo = info->NewInstance();
-      tempInfo->CopyFromStream(&rcvStream);
-      info->AddInformation(tempInfo);
-      tempInfo->Delete();
-    } // END for all remote ranks
-  }   // END if rank == 0
-
-  // STEP 7: De-allocate temporary arrays at rank 0
-  SafeDeleteArray(rcvcounts);
-  SafeDeleteArray(offSet);
-  SafeDeleteArray(rcvbuffer);
-
-  // Sanity checks -- ensure we return all dynamically allocated memory
-  assert("post: rcvcounts should be nullptr" && (rcvcounts == nullptr));
-  assert("post: offSet should be nullptr" && (offSet == nullptr));
-  assert("post: rcvbuffer should be nullptr" && (rcvbuffer == nullptr));
-
-  // STEP 8: Barrier synchronization
+  // Barrier synchronization
   this->ParallelController->Barrier();
   return true;
 }
@@ -115,6 +115,36 @@ public:
   virtual bool GatherInformation(
     vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid);
 
+  ///@{
+  /**
+   * When enabled (default), results of `GatherInformation` for information
+   * objects that support caching (see `vtkPVInformation::GetCacheableMTime`)
+   * are cached on the root node and reused while the parameters and the
+   * modification time of the source object remain unchanged. This avoids
+   * communicating with satellites and recomputing the information.
+   */
+  vtkSetMacro(EnableInformationCache, bool);
+  vtkGetMacro(EnableInformationCache, bool);
+  vtkBooleanMacro(EnableInformationCache, bool);
+  ///@}
+
+  /**
+   * Discard all cached information results.
+   */
+  void ClearInformationCache();
+
+  ///@{
+  /**
+   * Information cache statistics. `InformationCacheHits` is the number of
+   * `GatherInformation` calls served from the cache. Of these,
+   * `SkippedSatelliteGathers` is the number of calls that would otherwise have
+   * required communication with the satellites.
+   */
+  vtkGetMacro(InformationCacheHits, vtkTypeUInt64);
+  vtkGetMacro(InformationCacheMisses, vtkTypeUInt64);
+  vtkGetMacro(SkippedSatelliteGathers, vtkTypeUInt64);
+  ///@}
+
   /**
    * Returns the number of processes. This simply calls the
    * GetNumberOfProcesses() on this->ParallelController
@@ -198,6 +228,12 @@ protected:
    */
   bool GatherInformationInternal(vtkPVInformation* information, vtkTypeUInt32 globalid);
 
+  /**
+   * Returns the object that information for the given \c globalid is gathered
+   * from, if any.
+   */
+  vtkObject* GetInformationSource(vtkTypeUInt32 globalid);
+
   /**
    * Gather information across MPI satellites.
    */
@@ -242,6 +278,11 @@ private:
   // Local counter for global Ids
   vtkTypeUInt32 LocalGlobalID;
 
+  bool EnableInformationCache = true;
+  vtkTypeUInt64 InformationCacheHits = 0;
+  vtkTypeUInt64 InformationCacheMisses = 0;
+  vtkTypeUInt64 SkippedSatelliteGathers = 0;
+
   ostream* LogStream;
 };
 
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include <vtksys/RegularExpression.hxx>
+#include <vtksys/SystemTools.hxx>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -801,8 +802,12 @@ bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(const char* xml
 bool vtkSIProxyDefinitionManager::LoadConfigurationXMLFromString(
   const char* xmlContent, bool attachHints, bool invoke, const std::string& ensurePluginLoaded)
 {
+  // Parsing the XML of all the modules and plugins is a noticeable part of
+  // the startup time, so it can be cached in a directory shared by the runs.
   vtkNew<vtkPVXMLParser> parser;
-  return (parser->Parse(xmlContent) != 0) &&
+  const char* cacheDirectory =
+    vtksys::SystemTools::GetEnv("PARAVIEW_PROXY_DEFINITION_CACHE_DIRECTORY");
+  return (parser->ParseWithCache(xmlContent, cacheDirectory) != 0) &&
     this->LoadConfigurationXML(parser->GetRootElement(), attachHints, invoke, ensurePluginLoaded);
 }
 
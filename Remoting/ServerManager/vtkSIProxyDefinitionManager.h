@@ -139,7 +139,10 @@ public:
 
   ///@{
   /**
-   * Loads server-manager configuration xml.
+   * Loads server-manager configuration xml. If the
+   * `PARAVIEW_PROXY_DEFINITION_CACHE_DIRECTORY` environment variable is set,
+   * the parsed XML strings are cached in that directory to speed up
+   * subsequent runs (see `vtkPVXMLParser::ParseWithCache`).
    */
   bool LoadConfigurationXML(vtkPVXMLElement* root);
   bool LoadConfigurationXMLFromString(const char* xmlContent);
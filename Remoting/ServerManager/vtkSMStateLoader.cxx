@@ -20,6 +20,7 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <string>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkSMStateLoader);
@@ -321,6 +322,16 @@ vtkPVXMLElement* vtkSMStateLoader::LocateProxyElementInternal(
   }
   vtkIdType id = static_cast<vtkIdType>(id_);
 
+  // The parser uses the "id" attribute as the element id, which
+  // FindNestedElement looks up without going over all the proxies.
+  vtkPVXMLElement* candidate = root->FindNestedElement(std::to_string(id).c_str());
+  vtkIdType candidateId;
+  if (candidate && candidate->GetName() && strcmp(candidate->GetName(), "Proxy") == 0 &&
+    candidate->GetScalarAttribute("id", &candidateId) && candidateId == id)
+  {
+    return candidate;
+  }
+
   unsigned int numElems = root->GetNumberOfNestedElements();
   unsigned int i = 0;
   for (i = 0; i < numElems; i++)
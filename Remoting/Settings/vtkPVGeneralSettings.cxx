@@ -101,6 +101,9 @@ void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
   if (this->AnimationGeometryCacheLimit != val)
   {
     this->AnimationGeometryCacheLimit = val;
+#if VTK_MODULE_ENABLE_ParaView_RemotingAnimation
+    vtkSMAnimationScene::SetGlobalGeometryCacheLimit(val);
+#endif
     this->Modified();
   }
 }
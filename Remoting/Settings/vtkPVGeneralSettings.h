@@ -134,7 +134,9 @@ public:
 
   ///@{
   /**
-   * Set the animation cache limit in KBs.
+   * Set the animation cache limit in KBs. When the geometry cached on a rank
+   * exceeds this limit, least-recently used cached geometries are evicted.
+   * 0 implies no limit.
    */
   void SetAnimationGeometryCacheLimit(unsigned long val);
   vtkGetMacro(AnimationGeometryCacheLimit, unsigned long);
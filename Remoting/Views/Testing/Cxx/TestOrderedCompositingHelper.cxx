@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBoundingBox.h"
+#include "vtkCamera.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkOrderedCompositingHelper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Recursively bisects `box` along its longest axis into `count` boxes, as
+// the cuts used for ordered compositing do.
+void Partition(const vtkBoundingBox& box, int count, std::vector<vtkBoundingBox>& boxes)
+{
+  if (count == 1)
+  {
+    boxes.push_back(box);
+    return;
+  }
+
+  const int axis = box.GetMaxLength() == box.GetLength(0)
+    ? 0
+    : (box.GetMaxLength() == box.GetLength(1) ? 1 : 2);
+  const int lowerCount = count / 2;
+  double bds[6];
+  box.GetBounds(bds);
+  const double split =
+    bds[2 * axis] + (bds[2 * axis + 1] - bds[2 * axis]) * lowerCount / static_cast<double>(count);
+
+  double lower[6], upper[6];
+  std::copy(bds, bds + 6, lower);
+  std::copy(bds, bds + 6, upper);
+  lower[2 * axis + 1] = split;
+  upper[2 * axis] = split;
+  ::Partition(vtkBoundingBox(lower), lowerCount, boxes);
+  ::Partition(vtkBoundingBox(upper), count - lowerCount, boxes);
+}
+
+// Checks that, for every pair of boxes sharing a face, the box on the side of
+// the camera comes first.
+bool CheckOrder(const std::vector<vtkBoundingBox>& boxes, const std::vector<int>& order,
+  vtkCamera* camera)
+{
+  if (order.size() != boxes.size())
+  {
+    vtkLogF(ERROR, "Incorrect number of ranks.");
+    return false;
+  }
+  std::vector<int> position(boxes.size(), -1);
+  for (size_t cc = 0; cc < order.size(); ++cc)
+  {
+    if (order[cc] < 0 || order[cc] >= static_cast<int>(boxes.size()) || position[order[cc]] != -1)
+    {
+      vtkLogF(ERROR, "Order is not a permutation of the ranks.");
+      return false;
+    }
+    position[order[cc]] = static_cast<int>(cc);
+  }
+
+  const double* pos = camera->GetPosition();
+  const double* dop = camera->GetDirectionOfProjection();
+  const bool parallel = camera->GetParallelProjection() != 0;
+  for (size_t a = 0; a < boxes.size(); ++a)
+  {
+    for (size_t b = 0; b < boxes.size(); ++b)
+    {
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        const int other1 = (axis + 1) % 3, other2 = (axis + 2) % 3;
+        if (boxes[a].GetBound(2 * axis + 1) != boxes[b].GetBound(2 * axis) ||
+          boxes[a].GetBound(2 * other1 + 1) <= boxes[b].GetBound(2 * other1) ||
+          boxes[b].GetBound(2 * other1 + 1) <= boxes[a].GetBound(2 * other1) ||
+          boxes[a].GetBound(2 * other2 + 1) <= boxes[b].GetBound(2 * other2) ||
+          boxes[b].GetBound(2 * other2 + 1) <= boxes[a].GetBound(2 * other2))
+        {
+          continue;
+        }
+        // `a` is below `b` along `axis` and they share a face.
+        const double side = parallel ? -dop[axis] : pos[axis] - boxes[a].GetBound(2 * axis + 1);
+        if (side < 0)
+        {
+          if (position[a] >= position[b])
+          {
+            vtkLogF(ERROR, "Box %d must be in front of box %d.", static_cast<int>(a),
+              static_cast<int>(b));
+            return false;
+          }
+        }
+        else if (side > 0)
+        {
+          if (position[b] >= position[a])
+          {
+            vtkLogF(ERROR, "Box %d must be in front of box %d.", static_cast<int>(b),
+              static_cast<int>(a));
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void Orbit(vtkCamera* camera, int frame, int frames)
+{
+  const double angle = 2.0 * vtkMath::Pi() * frame / frames;
+  camera->SetFocalPoint(0.5, 0.5, 0.5);
+  camera->SetPosition(0.5 + 3.0 * std::cos(angle), 0.5 + std::sin(3.0 * angle),
+    0.5 + 3.0 * std::sin(angle));
+  camera->SetViewUp(0, 1, 0);
+}
+
+bool TestOrder(const std::vector<vtkBoundingBox>& boxes)
+{
+  vtkNew<vtkOrderedCompositingHelper> helper;
+  helper->SetBoundingBoxes(boxes);
+  if (!helper->GetUsingKdTree())
+  {
+    vtkLogF(ERROR, "Cuts must be ordered using a k-d tree.");
+    return false;
+  }
+
+  vtkNew<vtkCamera> camera;
+  for (int parallel = 0; parallel < 2; ++parallel)
+  {
+    camera->SetParallelProjection(parallel);
+    for (int frame = 0; frame < 16; ++frame)
+    {
+      ::Orbit(camera, frame, 16);
+      const auto order = helper->ComputeSortOrder(camera);
+      if (!::CheckOrder(boxes, order, camera))
+      {
+        vtkLogF(ERROR, "Incorrect order for frame %d.", frame);
+        return false;
+      }
+      if (helper->ComputeSortOrder(camera) != order)
+      {
+        vtkLogF(ERROR, "Cached order differs.");
+        return false;
+      }
+    }
+  }
+
+  // Ranks without data are still part of the order.
+  auto withEmpty = boxes;
+  withEmpty.insert(withEmpty.begin() + withEmpty.size() / 2, vtkBoundingBox());
+  helper->SetBoundingBoxes(withEmpty);
+  if (!helper->GetUsingKdTree())
+  {
+    vtkLogF(ERROR, "Empty ranks must not prevent using a k-d tree.");
+    return false;
+  }
+  if (helper->ComputeSortOrder(camera).size() != withEmpty.size())
+  {
+    vtkLogF(ERROR, "Missing empty rank.");
+    return false;
+  }
+
+  // Overlapping boxes cannot be separated and are sorted instead.
+  auto overlapping = boxes;
+  overlapping[0].Inflate(0.25);
+  helper->SetBoundingBoxes(overlapping);
+  if (helper->GetUsingKdTree())
+  {
+    vtkLogF(ERROR, "Overlapping boxes cannot use a k-d tree.");
+    return false;
+  }
+  if (helper->ComputeSortOrder(camera).size() != boxes.size())
+  {
+    vtkLogF(ERROR, "Incorrect sorted order.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestOrderedCompositingHelper(int, char*[])
+{
+  std::vector<vtkBoundingBox> boxes;
+  ::Partition(vtkBoundingBox(0, 1, 0, 1, 0, 1), 64, boxes);
+  std::shuffle(boxes.begin(), boxes.end(), std::mt19937(0));
+  return ::TestOrder(boxes) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
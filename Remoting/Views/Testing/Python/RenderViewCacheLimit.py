@@ -0,0 +1,54 @@
+from paraview.simple import *
+from paraview import smtesting
+smtesting.ProcessCommandLineArguments()
+
+source = TimeSource(XAmplitude=1.0)
+times = source.TimestepValues
+assert len(times) > 2
+
+view = CreateRenderView()
+Show(source, view)
+view.ViewTime = times[0]
+Render(view)
+
+dmgr = view.GetClientSideObject().GetDeliveryManager()
+
+def sweep():
+    for t in times:
+        view.ViewTime = t
+        view.CacheKey = t
+        Render(view)
+
+view.UseCache = 1
+dmgr.ResetCacheStatistics()
+
+# nothing is cached yet, every time step is a miss.
+sweep()
+assert dmgr.GetCacheHits() == 0
+assert dmgr.GetCacheMisses() >= len(times) - 1
+cachedSize = dmgr.GetCachedDataSize()
+assert cachedSize > 0
+
+# the time steps are now cached.
+dmgr.ResetCacheStatistics()
+sweep()
+assert dmgr.GetCacheHits() >= len(times) - 1
+assert dmgr.GetCacheEvictions() == 0
+
+# with a tiny limit, only the current time step is kept after each update so
+# going back to an earlier time step misses.
+view.CacheLimit = 1
+dmgr.ResetCacheStatistics()
+sweep()
+assert dmgr.GetCacheEvictions() > 0
+assert dmgr.GetEvictedDataSize() > 0
+assert dmgr.GetCachedDataSize() < cachedSize
+assert dmgr.GetCacheHits() <= 1
+
+dmgr.ResetCacheStatistics()
+sweep()
+assert dmgr.GetCacheHits() == 0
+assert dmgr.GetCacheMisses() >= len(times) - 1
+
+view.UseCache = 0
+view.CacheLimit = 0
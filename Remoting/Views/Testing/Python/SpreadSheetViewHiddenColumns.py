@@ -0,0 +1,35 @@
+from paraview.simple import *
+from paraview import smtesting
+smtesting.ProcessCommandLineArguments()
+
+view = CreateView("SpreadSheetView")
+# enough points for several blocks.
+sphere = Sphere(ThetaResolution=100, PhiResolution=100)
+Show()
+Render()
+
+pvview = view.GetClientSideObject()
+
+def columnNames():
+    return [pvview.GetColumnName(cc) for cc in range(pvview.GetNumberOfColumns())]
+
+names = columnNames()
+assert "Normals_Magnitude" in names and "Points_Magnitude" in names
+normalsCol = names.index("Normals_Magnitude")
+pointsCol = names.index("Points_Magnitude")
+value = pvview.GetValue(5000, pointsCol).ToDouble()
+
+# hidden columns are skipped when fetching new blocks, they are still listed.
+pvview.HideColumnByName("Normals_Magnitude")
+pvview.HideColumnByName("Points_Magnitude")
+pvview.GetValue(9000, 0)
+assert columnNames() == names
+
+# showing a skipped column again drops the cached blocks. The next blocks
+# are fetched without the column that is still hidden.
+pvview.ClearHiddenColumnsByName()
+pvview.HideColumnByName("Normals_Magnitude")
+assert pvview.GetValue(5000, pointsCol).ToDouble() == value
+assert pvview.GetNumberOfColumns() == len(names)
+assert columnNames() == names
+assert pvview.GetColumnByName("Normals_Magnitude") == normalsCol
@@ -247,7 +247,11 @@ void vtkIceTCompositePass::SetupContext(const vtkRenderState* render_state)
 
     // Order all the regions.
     vtkCamera* camera = render_state->GetRenderer()->GetActiveCamera();
+    const double sortStart = vtkTimerLog::GetUniversalTime();
     const auto orderedProcessIds = this->OrderedCompositingHelper->ComputeSortOrder(camera);
+    const double sortTime = vtkTimerLog::GetUniversalTime() - sortStart;
+    vtkTimerLog::InsertTimedEvent("ORDERED_COMPOSITING_SORT_TIME", sortTime, 0);
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "ORDERED_COMPOSITING_SORT_TIME: %lf", sortTime);
     if (sizeof(int) == sizeof(IceTInt))
     {
       icetCompositeOrder(reinterpret_cast<const IceTInt*>(&orderedProcessIds[0]));
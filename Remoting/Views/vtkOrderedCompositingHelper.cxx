@@ -7,6 +7,11 @@
 #include "vtkObjectFactory.h"
 #include "vtkVector.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iterator>
+
 namespace
 {
 struct BoxT
@@ -17,9 +22,146 @@ struct BoxT
 };
 }
 
+class vtkOrderedCompositingHelper::vtkInternals
+{
+public:
+  // A node of the k-d tree. Leaves have `Axis == -1` and refer to a rank,
+  // other nodes split their boxes along `Axis`: boxes of the `Lower` child lie
+  // below `Split` and boxes of the `Upper` child above it.
+  struct Node
+  {
+    int Axis = -1;
+    double Split = 0.0;
+    int Lower = -1;
+    int Upper = -1;
+    int Rank = -1;
+  };
+
+  std::vector<Node> Nodes;
+  int Root = -1;
+  bool UsingKdTree = false;
+  std::vector<int> EmptyRanks;
+  vtkTimeStamp TreeTime;
+
+  // Last computed order and the view it was computed for.
+  std::vector<int> Order;
+  bool OrderIsParallel = false;
+  double OrderVector[3] = { 0.0, 0.0, 0.0 };
+  vtkTimeStamp OrderTime;
+
+  void Build(const std::vector<vtkBoundingBox>& boxes)
+  {
+    this->Nodes.clear();
+    this->EmptyRanks.clear();
+    this->Root = -1;
+
+    std::vector<int> ranks;
+    for (int rank = 0; rank < static_cast<int>(boxes.size()); ++rank)
+    {
+      // Ranks without data can be composited in any order.
+      (boxes[rank].IsValid() ? ranks : this->EmptyRanks).push_back(rank);
+    }
+    this->UsingKdTree = true;
+    if (!ranks.empty())
+    {
+      this->Root = this->BuildNode(boxes, ranks.begin(), ranks.end());
+    }
+    this->UsingKdTree = this->UsingKdTree && (this->Root != -1 || ranks.empty());
+    this->TreeTime.Modified();
+  }
+
+  // Appends the ranks below `node` to `order` in front-to-back order.
+  // `parallel` selects whether `vector` is a view direction or a position.
+  void Traverse(int node, bool parallel, const double vector[3], std::vector<int>& order) const
+  {
+    const Node& current = this->Nodes[node];
+    if (current.Axis == -1)
+    {
+      order.push_back(current.Rank);
+      return;
+    }
+
+    const bool lowerFirst =
+      parallel ? vector[current.Axis] >= 0.0 : vector[current.Axis] < current.Split;
+    this->Traverse(lowerFirst ? current.Lower : current.Upper, parallel, vector, order);
+    this->Traverse(lowerFirst ? current.Upper : current.Lower, parallel, vector, order);
+  }
+
+private:
+  using IteratorT = std::vector<int>::iterator;
+
+  // Returns the index of the node for the ranks in [begin, end), or -1 if they
+  // cannot be separated by axis-aligned planes.
+  int BuildNode(const std::vector<vtkBoundingBox>& boxes, IteratorT begin, IteratorT end)
+  {
+    const auto count = std::distance(begin, end);
+    if (count == 1)
+    {
+      Node leaf;
+      leaf.Rank = *begin;
+      this->Nodes.push_back(leaf);
+      return static_cast<int>(this->Nodes.size()) - 1;
+    }
+
+    // Look for the most balanced split along any axis: sort the boxes by their
+    // lower bound and find positions where all the preceding boxes end before
+    // the next one starts.
+    int bestAxis = -1;
+    std::ptrdiff_t bestPosition = 0;
+    double bestSplit = 0.0;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      std::sort(begin, end, [&boxes, axis](int a, int b) {
+        return boxes[a].GetBound(2 * axis) < boxes[b].GetBound(2 * axis);
+      });
+      double maxBound = boxes[*begin].GetBound(2 * axis + 1);
+      for (std::ptrdiff_t position = 1; position < count; ++position)
+      {
+        const int rank = *(begin + position);
+        if (maxBound <= boxes[rank].GetBound(2 * axis) &&
+          (bestAxis == -1 ||
+            std::abs(2 * position - count) < std::abs(2 * bestPosition - count)))
+        {
+          bestAxis = axis;
+          bestPosition = position;
+          bestSplit = maxBound;
+        }
+        maxBound = std::max(maxBound, boxes[rank].GetBound(2 * axis + 1));
+      }
+    }
+
+    if (bestAxis == -1)
+    {
+      this->UsingKdTree = false;
+      return -1;
+    }
+
+    std::sort(begin, end, [&boxes, bestAxis](int a, int b) {
+      return boxes[a].GetBound(2 * bestAxis) < boxes[b].GetBound(2 * bestAxis);
+    });
+    const int lower = this->BuildNode(boxes, begin, begin + bestPosition);
+    const int upper = lower == -1 ? -1 : this->BuildNode(boxes, begin + bestPosition, end);
+    if (upper == -1)
+    {
+      return -1;
+    }
+
+    Node node;
+    node.Axis = bestAxis;
+    node.Split = bestSplit;
+    node.Lower = lower;
+    node.Upper = upper;
+    this->Nodes.push_back(node);
+    return static_cast<int>(this->Nodes.size()) - 1;
+  }
+};
+
 vtkStandardNewMacro(vtkOrderedCompositingHelper);
 //----------------------------------------------------------------------------
-vtkOrderedCompositingHelper::vtkOrderedCompositingHelper() = default;
+vtkOrderedCompositingHelper::vtkOrderedCompositingHelper()
+  : Internals(new vtkOrderedCompositingHelper::vtkInternals())
+{
+}
 
 //----------------------------------------------------------------------------
 vtkOrderedCompositingHelper::~vtkOrderedCompositingHelper() = default;
@@ -45,6 +187,17 @@ const vtkBoundingBox& vtkOrderedCompositingHelper::GetBoundingBox(int index) con
   return this->InvalidBox;
 }
 
+//------------------------------------------------------------------------------
+bool vtkOrderedCompositingHelper::GetUsingKdTree()
+{
+  auto& internals = (*this->Internals);
+  if (internals.TreeTime < this->GetMTime())
+  {
+    internals.Build(this->Boxes);
+  }
+  return internals.UsingKdTree;
+}
+
 //------------------------------------------------------------------------------
 std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrder(vtkCamera* camera)
 {
@@ -57,40 +210,60 @@ std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrder(vtkCamera* camera
 //------------------------------------------------------------------------------
 std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrderInViewDirection(const double dop[3])
 {
-  std::vector<BoxT> boxes(this->Boxes.size());
-  int rank = 0;
-  for (auto& box : boxes)
-  {
-    box.self = this;
-    box.rank = rank++;
-  }
-
-  vtkBlockSortHelper::BackToFront<BoxT> sortBoxes(
-    vtkVector3d(0.0), vtkVector3d(dop), /*is_parallel = */ true);
-  vtkBlockSortHelper::Sort(boxes.begin(), boxes.end(), sortBoxes);
-  std::vector<int> indexes(boxes.size());
-  std::transform(
-    boxes.rbegin(), boxes.rend(), indexes.begin(), [](const BoxT& box) { return box.rank; });
-  return indexes;
+  return this->ComputeSortOrderInternal(true, dop);
 }
 
 //------------------------------------------------------------------------------
 std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrderFromPosition(const double pos[3])
 {
-  std::vector<BoxT> boxes(this->Boxes.size());
-  int rank = 0;
-  for (auto& box : boxes)
+  return this->ComputeSortOrderInternal(false, pos);
+}
+
+//------------------------------------------------------------------------------
+std::vector<int> vtkOrderedCompositingHelper::ComputeSortOrderInternal(
+  bool parallel, const double vector[3])
+{
+  auto& internals = (*this->Internals);
+  const bool useKdTree = this->GetUsingKdTree();
+  if (internals.OrderTime > internals.TreeTime && internals.OrderIsParallel == parallel &&
+    std::equal(vector, vector + 3, internals.OrderVector))
   {
-    box.self = this;
-    box.rank = rank++;
+    return internals.Order;
+  }
+
+  std::vector<int> indexes;
+  if (useKdTree)
+  {
+    indexes.reserve(this->Boxes.size());
+    if (internals.Root != -1)
+    {
+      internals.Traverse(internals.Root, parallel, vector, indexes);
+    }
+    indexes.insert(indexes.end(), internals.EmptyRanks.begin(), internals.EmptyRanks.end());
+  }
+  else
+  {
+    std::vector<BoxT> boxes(this->Boxes.size());
+    int rank = 0;
+    for (auto& box : boxes)
+    {
+      box.self = this;
+      box.rank = rank++;
+    }
+
+    const vtkVector3d position = parallel ? vtkVector3d(0.0) : vtkVector3d(vector);
+    const vtkVector3d direction = parallel ? vtkVector3d(vector) : vtkVector3d(0.0);
+    vtkBlockSortHelper::BackToFront<BoxT> sortBoxes(position, direction, parallel);
+    vtkBlockSortHelper::Sort(boxes.begin(), boxes.end(), sortBoxes);
+    indexes.resize(boxes.size());
+    std::transform(
+      boxes.rbegin(), boxes.rend(), indexes.begin(), [](const BoxT& box) { return box.rank; });
   }
 
-  vtkBlockSortHelper::BackToFront<BoxT> sortBoxes(
-    vtkVector3d(pos), vtkVector3d(0.0), /*is_parallel = */ false);
-  vtkBlockSortHelper::Sort(boxes.begin(), boxes.end(), sortBoxes);
-  std::vector<int> indexes(boxes.size());
-  std::transform(
-    boxes.rbegin(), boxes.rend(), indexes.begin(), [](const BoxT& box) { return box.rank; });
+  internals.Order = indexes;
+  internals.OrderIsParallel = parallel;
+  std::copy(vector, vector + 3, internals.OrderVector);
+  internals.OrderTime.Modified();
   return indexes;
 }
 
@@ -6,6 +6,14 @@
  *
  * vtkOrderedCompositingHelper is used to help determine compositing order for
  * ranks when ordered-compositing is being used.
+ *
+ * When the bounding boxes are separable by axis-aligned planes, as is the case
+ * for the cuts of a k-d tree, the helper builds a k-d tree over them the first
+ * time an order is requested after the boxes change. The order is then
+ * obtained by traversing that tree, which is linear in the number of ranks.
+ * Otherwise, the boxes are sorted using vtkBlockSortHelper. In both cases, the
+ * last order is cached and returned again as long as neither the boxes nor the
+ * view direction or position change.
  */
 
 #ifndef vtkOrderedCompositingHelper_h
@@ -15,6 +23,7 @@
 #include "vtkObject.h"
 #include "vtkRemotingViewsModule.h" //needed for exports
 
+#include <memory> // for std::unique_ptr
 #include <vector> // for std::vector
 
 class vtkBoundingBox;
@@ -31,9 +40,21 @@ public:
   const std::vector<vtkBoundingBox>& GetBoundingBoxes() const { return this->Boxes; }
   const vtkBoundingBox& GetBoundingBox(int index) const;
 
+  ///@{
+  /**
+   * Returns the ranks in front-to-back order for the given camera, view
+   * direction (for parallel projection) or view position.
+   */
   std::vector<int> ComputeSortOrder(vtkCamera* camera);
   std::vector<int> ComputeSortOrderInViewDirection(const double directionOfProjection[3]);
   std::vector<int> ComputeSortOrderFromPosition(const double position[3]);
+  ///@}
+
+  /**
+   * Returns true if the current bounding boxes are ordered using a k-d tree
+   * rather than by sorting them.
+   */
+  bool GetUsingKdTree();
 
 protected:
   vtkOrderedCompositingHelper();
@@ -46,6 +67,11 @@ private:
   void operator=(const vtkOrderedCompositingHelper&) = delete;
 
   const vtkBoundingBox InvalidBox;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+
+  std::vector<int> ComputeSortOrderInternal(bool parallel, const double vector[3]);
 };
 
 #endif
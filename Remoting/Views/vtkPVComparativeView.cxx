@@ -722,10 +722,29 @@ void vtkPVComparativeView::Initialize(vtkSMViewProxy* rootView)
 
   // Root view is the first view in the views list.
   this->Internal->Views->Initialize(rootView);
+  this->SetCacheLimit(this->CacheLimit);
 
   this->Build(this->Dimensions[0], this->Dimensions[1]);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVComparativeView::SetCacheLimit(unsigned long limit)
+{
+  if (this->CacheLimit != limit)
+  {
+    this->CacheLimit = limit;
+    this->Modified();
+  }
+
+  ENSURE_INIT();
+  // the other views are clones linked to the root view, so they get it too.
+  if (this->RootView->GetProperty("CacheLimit"))
+  {
+    vtkSMPropertyHelper(this->RootView, "CacheLimit").Set(static_cast<int>(limit));
+    this->RootView->UpdateProperty("CacheLimit");
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVComparativeView::SetOverlayAllComparisons(bool overlay)
 {
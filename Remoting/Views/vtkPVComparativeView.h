@@ -179,6 +179,15 @@ public:
   }
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the cache limit (in KiB) of the internal views.
+   * @sa vtkPVView::SetCacheLimit
+   */
+  vtkGetMacro(CacheLimit, unsigned long);
+  void SetCacheLimit(unsigned long limit);
+  ///@}
+
   /**
    * Marks the view dirty i.e. on next Update() it needs to regenerate the
    * comparative vis by replaying the animation(s).
@@ -208,6 +217,7 @@ protected:
   int ViewPosition[2];
   int Spacing[2];
   double ViewTime;
+  unsigned long CacheLimit = 0;
   bool OverlayAllComparisons;
   bool Outdated;
 
@@ -5,6 +5,7 @@
 
 #include "vtkAlgorithmOutput.h"
 #include "vtkInformation.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVDataRepresentation.h"
@@ -108,6 +109,7 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
       {
         item->SetActualMemorySize(trueSize, cacheKey);
       }
+      item->Touch(cacheKey, this->Internals->AccessClock);
 
       if (low_res == false)
       {
@@ -140,6 +142,15 @@ bool vtkPVDataDeliveryManager::HasPiece(vtkPVDataRepresentation* repr, bool low_
     this->Internals->GetItem(repr, low_res, port, /*create_if_needed=*/false);
   const auto cacheKey = this->GetCacheKey(repr);
   const bool val = item ? (item->GetDataObject(cacheKey) != nullptr) : false;
+  if (val)
+  {
+    item->Touch(cacheKey, this->Internals->AccessClock);
+  }
+
+  if (this->View && (this->View->GetUseCache() || repr->GetForceUseCache()))
+  {
+    ++(val ? this->Internals->CacheHits : this->Internals->CacheMisses);
+  }
 
   vtkLogF(TRACE, "HasPiece %s (key=%g) : %d", repr->GetLogName().c_str(), cacheKey, val);
   return val;
@@ -169,6 +180,7 @@ vtkAlgorithmOutput* vtkPVDataDeliveryManager::GetProducer(
 
   const int dataKey = this->GetDeliveredDataKey(low_res);
   const auto cacheKey = this->GetCacheKey(repr);
+  item->Touch(cacheKey, this->Internals->AccessClock);
   return item->GetProducer(dataKey, cacheKey)->GetOutputPort(0);
 }
 
@@ -285,8 +297,104 @@ void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
   this->Internals->ClearCache(repr);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::CopyCacheEntriesToStream(vtkMultiProcessStream& stream)
+{
+  vtkInternals::Write(this->Internals->GetCacheEntries(this), stream);
+  // entries accessed from now on are more recent than the ones just reported.
+  ++this->Internals->AccessClock;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::MergeCacheEntries(
+  std::vector<vtkMultiProcessStream>& streams, vtkMultiProcessStream& merged)
+{
+  vtkInternals::CacheEntriesType entries;
+  for (auto& stream : streams)
+  {
+    vtkInternals::Read(stream, entries);
+  }
+  merged.Reset();
+  vtkInternals::Write(entries, merged);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::SelectCacheEntriesToEvict(
+  vtkMultiProcessStream& merged, vtkTypeUInt64 limit, vtkMultiProcessStream& victims)
+{
+  vtkInternals::CacheEntriesType entries;
+  vtkInternals::Read(merged, entries);
+
+  vtkInternals::CacheEntriesType selected;
+  for (const auto& key : vtkInternals::SelectEntriesToEvict(entries, limit))
+  {
+    selected[key] = entries[key];
+  }
+  victims.Reset();
+  vtkInternals::Write(selected, victims);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::EvictCacheEntries(vtkMultiProcessStream& victims)
+{
+  vtkInternals::CacheEntriesType entries;
+  vtkInternals::Read(victims, entries);
+
+  vtkTypeUInt64 released = 0;
+  for (const auto& pair : entries)
+  {
+    released += this->Internals->EvictCacheEntry(pair.first);
+  }
+  vtkVLogIfF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), !entries.empty(),
+    "evicted %llu KiB from geometry cache (%d entries)", static_cast<unsigned long long>(released),
+    static_cast<int>(entries.size()));
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheHits() const
+{
+  return this->Internals->CacheHits;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheMisses() const
+{
+  return this->Internals->CacheMisses;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheEvictions() const
+{
+  return this->Internals->CacheEvictions;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetEvictedDataSize() const
+{
+  return this->Internals->EvictedDataSize;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCachedDataSize() const
+{
+  return this->Internals->GetCachedDataSize();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::ResetCacheStatistics()
+{
+  this->Internals->CacheHits = 0;
+  this->Internals->CacheMisses = 0;
+  this->Internals->CacheEvictions = 0;
+  this->Internals->EvictedDataSize = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheHits: " << this->Internals->CacheHits << endl;
+  os << indent << "CacheMisses: " << this->Internals->CacheMisses << endl;
+  os << indent << "CacheEvictions: " << this->Internals->CacheEvictions << endl;
+  os << indent << "EvictedDataSize: " << this->Internals->EvictedDataSize << endl;
 }
@@ -27,6 +27,7 @@ class vtkAlgorithmOutput;
 class vtkDataObject;
 class vtkExtentTranslator;
 class vtkInformation;
+class vtkMultiProcessStream;
 class vtkPVDataRepresentation;
 class vtkPVView;
 
@@ -95,6 +96,42 @@ public:
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  ///@{
+  /**
+   * Cache statistics. A cache hit (or miss) is recorded each time a
+   * representation checks for cached data while caching is enabled on the
+   * view. Evictions are counted when cached data is released to keep the cache
+   * within vtkPVView::GetCacheLimit(). `GetCachedDataSize` and
+   * `GetEvictedDataSize` are in KiB.
+   */
+  vtkTypeUInt64 GetCacheHits() const;
+  vtkTypeUInt64 GetCacheMisses() const;
+  vtkTypeUInt64 GetCacheEvictions() const;
+  vtkTypeUInt64 GetEvictedDataSize() const;
+  vtkTypeUInt64 GetCachedDataSize() const;
+  void ResetCacheStatistics();
+  ///@}
+
+  ///@{
+  /**
+   * Internal methods used by vtkPVView to keep the cache within
+   * vtkPVView::GetCacheLimit(). Since representations skip their update when
+   * their data is cached, all processes must evict the same entries. Each
+   * process serializes its entries with `CopyCacheEntriesToStream`, one process
+   * merges them all with `MergeCacheEntries` and picks least-recently used
+   * entries with `SelectCacheEntriesToEvict`, then every process evicts those
+   * with `EvictCacheEntries`. Entries for the current cache key of a
+   * representation are never evicted. Calling `CopyCacheEntriesToStream` also
+   * advances the clock used to timestamp cache accesses.
+   */
+  void CopyCacheEntriesToStream(vtkMultiProcessStream& stream);
+  static void MergeCacheEntries(
+    std::vector<vtkMultiProcessStream>& streams, vtkMultiProcessStream& merged);
+  static void SelectCacheEntriesToEvict(
+    vtkMultiProcessStream& merged, vtkTypeUInt64 limit, vtkMultiProcessStream& victims);
+  void EvictCacheEntries(vtkMultiProcessStream& victims);
+  ///@}
+
   ///@{
   /**
    * Provides access to the producer port for the geometry of a registered
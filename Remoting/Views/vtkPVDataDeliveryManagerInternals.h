@@ -4,19 +4,23 @@
 #define vtkPVDataDeliveryManagerInternals_h
 #ifndef __WRAP__
 
-#include "vtkDataObject.h"  // for vtkDataObject
-#include "vtkInformation.h" // for vtkInformation
-#include "vtkNew.h"         // for vtkNew
+#include "vtkDataObject.h"         // for vtkDataObject
+#include "vtkInformation.h"        // for vtkInformation
+#include "vtkMultiProcessStream.h" // for vtkMultiProcessStream
+#include "vtkNew.h"                // for vtkNew
 #include "vtkPVDataDeliveryManager.h"
 #include "vtkPVDataRepresentation.h" // for vtkPVDataRepresentation
 #include "vtkPVTrivialProducer.h"    // for vtkPVTrivialProducer
 #include "vtkSmartPointer.h"         // for vtkSmartPointer
 #include "vtkWeakPointer.h"          // for vtkWeakPointer
 
-#include <cassert> // for assert
-#include <map>     // for std::map
-#include <numeric> // for std::accumulate
-#include <utility> // for std::pair
+#include <algorithm> // for std::stable_sort
+#include <cassert>   // for assert
+#include <map>       // for std::map
+#include <numeric>   // for std::accumulate
+#include <tuple>     // for std::tuple
+#include <utility>   // for std::pair
+#include <vector>    // for std::vector
 
 class vtkPVDataDeliveryManager::vtkInternals
 {
@@ -58,6 +62,10 @@ public:
     vtkMTimeType TimeStamp{ 0 };
     vtkMTimeType ActualMemorySize{ 0 };
 
+    // Value of vtkInternals::AccessClock when this entry was last used. Used
+    // to pick entries to evict when the cache exceeds the view's CacheLimit.
+    vtkTypeUInt64 LastAccess{ 0 };
+
     // Arbitrary meta-data container.
     vtkSmartPointer<vtkInformation> Information;
   };
@@ -78,6 +86,26 @@ public:
 
     void ClearCache() { this->Data.clear(); }
 
+    void EvictCacheEntry(double cacheKey) { this->Data.erase(cacheKey); }
+
+    template <typename Functor>
+    void ForEachCacheEntry(Functor&& functor) const
+    {
+      for (const auto& pair : this->Data)
+      {
+        functor(pair.first, pair.second);
+      }
+    }
+
+    void Touch(double cacheKey, vtkTypeUInt64 clock)
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter != this->Data.end())
+      {
+        iter->second.LastAccess = clock;
+      }
+    }
+
     void SetDataObject(vtkDataObject* data, vtkInternals* helper, double cacheKey)
     {
       auto& store = this->Data[cacheKey];
@@ -276,8 +304,171 @@ public:
     }
   }
 
+  /**
+   * Returns the total size (in KiB) of all cached data objects, irrespective
+   * of visibility or cache key.
+   */
+  vtkTypeUInt64 GetCachedDataSize() const
+  {
+    vtkTypeUInt64 size = 0;
+    for (const auto& ipair : this->ItemsMap)
+    {
+      for (const vtkItem* item : { &ipair.second.first, &ipair.second.second })
+      {
+        item->ForEachCacheEntry(
+          [&size](double, const vtkRepresentedData& store) { size += store.ActualMemorySize; });
+      }
+    }
+    return size;
+  }
+
+  // Identifies a cache entry consistently across processes: representation
+  // id, port, low-res flag and cache key.
+  typedef std::tuple<unsigned int, int, bool, double> CacheEntryKeyType;
+
+  struct vtkCacheEntry
+  {
+    vtkTypeUInt64 Size{ 0 };
+    vtkTypeUInt64 LastAccess{ 0 };
+    // Set for the entry of the representation's current cache key, which is
+    // the one being rendered.
+    bool Current{ false };
+  };
+  typedef std::map<CacheEntryKeyType, vtkCacheEntry> CacheEntriesType;
+
+  /**
+   * Returns all local cache entries.
+   */
+  CacheEntriesType GetCacheEntries(vtkPVDataDeliveryManager* dmgr) const
+  {
+    CacheEntriesType entries;
+    for (const auto& ipair : this->ItemsMap)
+    {
+      auto riter = this->RepresentationsMap.find(ipair.first.first);
+      vtkPVDataRepresentation* repr =
+        riter != this->RepresentationsMap.end() ? riter->second.GetPointer() : nullptr;
+      for (const bool lowRes : { false, true })
+      {
+        const vtkItem& item = lowRes ? ipair.second.second : ipair.second.first;
+        item.ForEachCacheEntry([&](double cacheKey, const vtkRepresentedData& store) {
+          auto& entry = entries[CacheEntryKeyType(ipair.first.first, ipair.first.second, lowRes,
+            cacheKey)];
+          entry.Size = store.ActualMemorySize;
+          entry.LastAccess = store.LastAccess;
+          entry.Current = repr != nullptr && dmgr->GetCacheKey(repr) == cacheKey;
+        });
+      }
+    }
+    return entries;
+  }
+
+  static void Write(const CacheEntriesType& entries, vtkMultiProcessStream& stream)
+  {
+    stream << static_cast<unsigned int>(entries.size());
+    for (const auto& pair : entries)
+    {
+      stream << std::get<0>(pair.first) << std::get<1>(pair.first) << std::get<2>(pair.first)
+             << std::get<3>(pair.first) << pair.second.Size << pair.second.LastAccess
+             << pair.second.Current;
+    }
+  }
+
+  /**
+   * Reads entries written by `Write` and merges them into `entries`. An entry
+   * present on several processes uses its largest size and its latest access,
+   * and is current if it is current on any of them.
+   */
+  static void Read(vtkMultiProcessStream& stream, CacheEntriesType& entries)
+  {
+    unsigned int count = 0;
+    stream >> count;
+    for (unsigned int cc = 0; cc < count; ++cc)
+    {
+      unsigned int id;
+      int port;
+      bool lowRes;
+      double cacheKey;
+      vtkCacheEntry value;
+      stream >> id >> port >> lowRes >> cacheKey >> value.Size >> value.LastAccess >>
+        value.Current;
+      auto& entry = entries[CacheEntryKeyType(id, port, lowRes, cacheKey)];
+      entry.Size = std::max(entry.Size, value.Size);
+      entry.LastAccess = std::max(entry.LastAccess, value.LastAccess);
+      entry.Current = entry.Current || value.Current;
+    }
+  }
+
+  /**
+   * Picks least-recently used entries to evict until the total size of
+   * `entries` is no more than `limit` KiB. Current entries are never picked.
+   */
+  static std::vector<CacheEntryKeyType> SelectEntriesToEvict(
+    const CacheEntriesType& entries, vtkTypeUInt64 limit)
+  {
+    vtkTypeUInt64 total = 0;
+    std::vector<CacheEntriesType::const_iterator> candidates;
+    for (auto iter = entries.begin(); iter != entries.end(); ++iter)
+    {
+      total += iter->second.Size;
+      if (!iter->second.Current)
+      {
+        candidates.push_back(iter);
+      }
+    }
+
+    std::vector<CacheEntryKeyType> victims;
+    if (total <= limit)
+    {
+      return victims;
+    }
+
+    // stable, so that ties are broken by the key order.
+    std::stable_sort(candidates.begin(), candidates.end(),
+      [](CacheEntriesType::const_iterator a, CacheEntriesType::const_iterator b) {
+        return a->second.LastAccess < b->second.LastAccess;
+      });
+    for (const auto& candidate : candidates)
+    {
+      if (total <= limit)
+      {
+        break;
+      }
+      victims.push_back(candidate->first);
+      total -= candidate->second.Size;
+    }
+    return victims;
+  }
+
+  /**
+   * Evicts a cache entry, if present. Returns the number of KiB released.
+   */
+  vtkTypeUInt64 EvictCacheEntry(const CacheEntryKeyType& key)
+  {
+    vtkItem* item =
+      this->GetItem(std::get<0>(key), std::get<2>(key), std::get<1>(key), /*create*/ false);
+    if (item == nullptr || item->GetDataObject(std::get<3>(key)) == nullptr)
+    {
+      return 0;
+    }
+    const vtkTypeUInt64 size = item->GetActualMemorySize(std::get<3>(key));
+    item->EvictCacheEntry(std::get<3>(key));
+    ++this->CacheEvictions;
+    this->EvictedDataSize += size;
+    return size;
+  }
+
   ItemsMapType ItemsMap;
   RepresentationsMapType RepresentationsMap;
+
+  // Timestamp for cache accesses. It is advanced once per view update on all
+  // processes so that timestamps of the same entry agree across processes.
+  vtkTypeUInt64 AccessClock{ 0 };
+
+  // Cache statistics.
+  vtkTypeUInt64 CacheHits{ 0 };
+  vtkTypeUInt64 CacheMisses{ 0 };
+  vtkTypeUInt64 CacheEvictions{ 0 };
+  vtkTypeUInt64 EvictedDataSize{ 0 };
 };
 
 #endif // __WRAP__
@@ -1427,6 +1427,18 @@ void vtkPVRenderView::Update()
   this->AllReduce(lsize, gsize, vtkCommunicator::SUM_OP);
   const double geometry_size = gsize / 1024.0;
 
+  if (this->GetUseCache())
+  {
+    auto dmgr = this->GetDeliveryManager();
+    vtkTimerLog::FormatAndMarkEvent(
+      "Geometry cache: hits=%llu, misses=%llu, evictions=%llu (%llu KiB), cached=%llu KiB",
+      static_cast<unsigned long long>(dmgr->GetCacheHits()),
+      static_cast<unsigned long long>(dmgr->GetCacheMisses()),
+      static_cast<unsigned long long>(dmgr->GetCacheEvictions()),
+      static_cast<unsigned long long>(dmgr->GetEvictedDataSize()),
+      static_cast<unsigned long long>(dmgr->GetCachedDataSize()));
+  }
+
   // Update decisions about lod-rendering and remote-rendering.
   this->UseLODForInteractiveRender = this->ShouldUseLODRendering(geometry_size);
   this->UseDistributedRenderingForRender =
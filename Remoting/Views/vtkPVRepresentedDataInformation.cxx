@@ -27,6 +27,12 @@ void vtkPVRepresentedDataInformation::CopyFromObject(vtkObject* object)
   }
 }
 
+//----------------------------------------------------------------------------
+vtkMTimeType vtkPVRepresentedDataInformation::GetCacheableMTime(vtkObject* vtkNotUsed(object))
+{
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRepresentedDataInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -25,6 +25,12 @@ public:
    */
   void CopyFromObject(vtkObject*) override;
 
+  /**
+   * The rendered data object may change without the representation being
+   * modified, hence this information is never cached. Returns 0.
+   */
+  vtkMTimeType GetCacheableMTime(vtkObject* object) override;
+
 protected:
   vtkPVRepresentedDataInformation();
   ~vtkPVRepresentedDataInformation() override;
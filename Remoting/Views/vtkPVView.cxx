@@ -33,6 +33,7 @@
 #include <cassert>
 #include <map>
 #include <sstream>
+#include <vector>
 
 namespace
 {
@@ -413,6 +414,7 @@ void vtkPVView::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ViewTime: " << this->ViewTime << endl;
   os << indent << "CacheKey: " << this->CacheKey << endl;
   os << indent << "UseCache: " << this->UseCache << endl;
+  os << indent << "CacheLimit: " << this->CacheLimit << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -463,6 +465,7 @@ void vtkPVView::Update()
     this->SynchronizeRepresentationTemporalPipelineStates();
   }
 
+  this->EnforceCacheLimit();
   this->UpdateTimeStamp.Modified();
 }
 
@@ -826,6 +829,81 @@ void vtkPVView::AllReduce(
   vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "source=%llu, result=%llu", arg_source, dest);
 }
 
+//-----------------------------------------------------------------------------
+void vtkPVView::EnforceCacheLimit()
+{
+  if (this->CacheLimit == 0 || this->DeliveryManager == nullptr)
+  {
+    return;
+  }
+
+  assert(this->Session);
+  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: enforce cache limit (%lu KiB)",
+    this->GetLogName().c_str(), this->CacheLimit);
+
+  std::vector<vtkMultiProcessStream> entries(1);
+  this->DeliveryManager->CopyCacheEntriesToStream(entries[0]);
+
+  auto pController = vtkMultiProcessController::GetGlobalController();
+  const bool parallel = pController && pController->GetNumberOfProcesses() > 1;
+  if (parallel)
+  {
+    std::vector<vtkMultiProcessStream> gathered;
+    pController->Gather(entries[0], gathered, 0);
+    entries.swap(gathered);
+  }
+
+  vtkMultiProcessStream victims;
+  auto cController = this->Session->GetController(vtkPVSession::CLIENT);
+  if (cController)
+  {
+    // server root: the client decides for all processes.
+    assert(!parallel || pController->GetLocalProcessId() == 0);
+    vtkMultiProcessStream merged;
+    vtkPVDataDeliveryManager::MergeCacheEntries(entries, merged);
+    cController->Send(merged, 1, 41236);
+    cController->Receive(victims, 1, 41237);
+  }
+  else if (!parallel || pController->GetLocalProcessId() == 0)
+  {
+    // client, or root in builtin and batch modes.
+    auto crController = this->Session->GetController(vtkPVSession::RENDER_SERVER_ROOT);
+    auto cdController = this->Session->GetController(vtkPVSession::DATA_SERVER_ROOT);
+    if (crController == cdController)
+    {
+      cdController = nullptr;
+    }
+
+    for (auto controller : { crController, cdController })
+    {
+      if (controller)
+      {
+        entries.emplace_back();
+        controller->Receive(entries.back(), 1, 41236);
+      }
+    }
+
+    vtkMultiProcessStream merged;
+    vtkPVDataDeliveryManager::MergeCacheEntries(entries, merged);
+    vtkPVDataDeliveryManager::SelectCacheEntriesToEvict(merged, this->CacheLimit, victims);
+
+    for (auto controller : { crController, cdController })
+    {
+      if (controller)
+      {
+        controller->Send(victims, 1, 41237);
+      }
+    }
+  }
+
+  if (parallel)
+  {
+    pController->Broadcast(victims, 0);
+  }
+
+  this->DeliveryManager->EvictCacheEntries(victims);
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVView::SetTileScale(int x, int y)
 {
@@ -855,12 +933,21 @@ vtkPVSession* vtkPVView::GetSession()
 //----------------------------------------------------------------------------
 bool vtkPVView::IsCached(vtkPVDataRepresentation* repr)
 {
-  if (this->DeliveryManager && this->DeliveryManager->HasPiece(repr))
+  bool cached = this->DeliveryManager && this->DeliveryManager->HasPiece(repr);
+  if (this->DeliveryManager && (this->UseCache || repr->GetForceUseCache()))
+  {
+    // skipping the update on some processes but not on others would deadlock
+    // the representation's pipeline, so all processes must agree.
+    vtkTypeUInt64 allCached = 0;
+    this->AllReduce(cached ? 1 : 0, allCached, vtkCommunicator::MIN_OP);
+    cached = (allCached != 0);
+  }
+
+  if (cached)
   {
     vtkLogF(TRACE, "cached %s", repr->GetLogName().c_str());
-    return true;
   }
-  return false;
+  return cached;
 }
 
 //----------------------------------------------------------------------------
@@ -113,6 +113,19 @@ public:
   vtkGetMacro(UseCache, bool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the maximum size, in KiB, of cached data on each rank. When the
+   * cache exceeds this limit after an update, least-recently used cache
+   * entries are evicted. Eviction is collective: the same entries are evicted
+   * on all processes, sized by their largest size on any process. Entries for
+   * the current cache key are never evicted. 0 (default) implies no limit.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(CacheLimit, unsigned long);
+  vtkGetMacro(CacheLimit, unsigned long);
+  ///@}
+
   ///@{
   /**
    * These methods are used to setup the view for capturing screen shots.
@@ -270,7 +283,9 @@ public:
   /**
    * Called in `vtkPVDataRepresentation::ProcessViewRequest` to check if the
    * representation already has cached data. If so, the representation may
-   * choose to not update itself.
+   * choose to not update itself. When caching is in use, the result is
+   * reduced across all processes so that they all skip the update or none
+   * does. Hence this method has to be called on all processes.
    */
   virtual bool IsCached(vtkPVDataRepresentation*);
 
@@ -311,6 +326,13 @@ protected:
   void AllReduce(
     vtkTypeUInt64 source, vtkTypeUInt64& dest, int operation, bool skip_data_server = false);
 
+  /**
+   * Evicts least-recently used cached data, on all participating processes,
+   * until the cache fits within CacheLimit. Called at the end of `Update`.
+   * Does nothing if there is no cache limit.
+   */
+  void EnforceCacheLimit();
+
   ///@{
   /**
    * Overridden to assign IDs to each representation. This assumes that
@@ -355,6 +377,7 @@ protected:
   double ViewTime;
   double CacheKey;
   bool UseCache;
+  unsigned long CacheLimit = 0;
 
   int Size[2];
   int Position[2];
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkSpreadSheetView.h"
 
+#include "vtkAbstractArray.h"
 #include "vtkAlgorithmOutput.h"
 #include "vtkCSVExporter.h"
 #include "vtkCharArray.h"
@@ -226,11 +227,14 @@ class vtkSpreadSheetView::vtkInternals
   public:
     vtkSmartPointer<vtkTable> Dataobject;
     vtkTimeStamp RecentUseTime;
+    // true when hidden columns were skipped when fetching the block.
+    bool Projected;
 
     CacheInfo()
     {
       this->Dataobject = nullptr;
       this->RecentUseTime = vtkTimeStamp();
+      this->Projected = false;
     }
   };
 
@@ -238,18 +242,99 @@ class vtkSpreadSheetView::vtkInternals
   CacheType CachedBlocks;
   std::pair<vtkIdType, CacheInfo> PreviousFirstCachedBlock;
 
-public:
-  void ClearCache()
+  // Columns left out of the cached blocks.
+  std::set<std::string> SkippedColumns;
+
+  void ClearCachedBlocks()
   {
     if (!this->CachedBlocks.empty())
     {
-      this->PreviousFirstCachedBlock = *this->CachedBlocks.begin();
+      // a projected block does not have all the columns, it cannot stand in
+      // for the data until the next fetch.
+      this->PreviousFirstCachedBlock = std::pair<vtkIdType, CacheInfo>();
+      for (const auto& block : this->CachedBlocks)
+      {
+        if (!block.second.Projected)
+        {
+          this->PreviousFirstCachedBlock = block;
+          break;
+        }
+      }
     }
     this->CachedBlocks.clear();
+    this->SkippedColumns.clear();
+  }
+
+public:
+  void ClearCache()
+  {
+    this->ClearCachedBlocks();
     this->ColumnMetaData.clear();
     this->ColumnIndexMap.clear();
   }
 
+  bool IsCached(vtkIdType blockId) const
+  {
+    return this->CachedBlocks.find(blockId) != this->CachedBlocks.end();
+  }
+
+  /**
+   * Returns the names of the columns that do not need to be fetched: the
+   * hidden data arrays, with their valid masks. Internal and special columns
+   * as well as the column to sort are always fetched. Nothing is skipped until
+   * the columns are known from a first fetch.
+   */
+  std::vector<std::string> GetColumnsToSkip(vtkSpreadSheetView* self) const
+  {
+    std::vector<std::string> columns;
+    const char* columnToSort = self->TableStreamer->GetColumnNameToSort();
+    for (const auto& tuple : this->ColumnMetaData)
+    {
+      const std::string& name = std::get<0>(tuple);
+      bool converted = false;
+      ::get_userfriendly_name(name.c_str(), self, &converted);
+      if (converted || self->IsColumnInternal(name.c_str()) ||
+        (columnToSort && name == columnToSort))
+      {
+        continue;
+      }
+      if (self->IsColumnHiddenByName(name.c_str()) ||
+        self->IsColumnHiddenByLabel(self->GetColumnLabel(name.c_str())))
+      {
+        columns.push_back(name);
+        columns.push_back("__vtkValidMask__" + name);
+      }
+    }
+    return columns;
+  }
+
+  /**
+   * Drops the cached blocks if a column they skipped has been shown since.
+   * The column metadata is kept.
+   */
+  void UpdateSkippedColumns(vtkSpreadSheetView* self)
+  {
+    if (!this->HiddenColumnsModified)
+    {
+      return;
+    }
+    this->HiddenColumnsModified = false;
+    for (const auto& name : this->SkippedColumns)
+    {
+      if (!self->IsColumnInternal(name.c_str()) && !self->IsColumnHiddenByName(name.c_str()) &&
+        !self->IsColumnHiddenByLabel(self->GetColumnLabel(name.c_str())))
+      {
+        this->ClearCachedBlocks();
+        return;
+      }
+    }
+  }
+
+  void AddSkippedColumns(const std::vector<std::string>& columns)
+  {
+    this->SkippedColumns.insert(columns.begin(), columns.end());
+  }
+
   vtkIdType GetNumberOfColumns(vtkSpreadSheetView* self)
   {
     if (this->ActiveRepresentation != nullptr && this->ColumnMetaData.empty())
@@ -366,7 +451,12 @@ public:
     return a1Index > a2Index;
   }
 
-  vtkTable* AddToCache(vtkIdType blockId, vtkTable* data, vtkIdType max)
+  /**
+   * Adds a block to the cache. `projected` indicates that hidden columns were
+   * skipped when fetching it. The column metadata is only built from blocks
+   * with all the columns so that hidden columns are still listed.
+   */
+  vtkTable* AddToCache(vtkIdType blockId, vtkTable* data, vtkIdType max, bool projected = false)
   {
     CacheType::iterator iter = this->CachedBlocks.find(blockId);
     if (iter != this->CachedBlocks.end())
@@ -419,9 +509,10 @@ public:
     info.Dataobject = clone;
     clone->FastDelete();
     info.RecentUseTime.Modified();
+    info.Projected = projected;
     this->CachedBlocks[blockId] = info;
     this->MostRecentlyAccessedBlock = blockId;
-    if (this->CachedBlocks.size() == 1)
+    if (this->CachedBlocks.size() == 1 && !projected)
     {
       this->UpdateColumnMetaData(clone);
     }
@@ -475,11 +566,13 @@ public:
   }
 
   vtkIdType MostRecentlyAccessedBlock;
+  vtkIdType LastFetchedBlock = -1;
   vtkWeakPointer<vtkSpreadSheetRepresentation> ActiveRepresentation;
   vtkCommand* Observer;
 
   std::set<std::string> HiddenColumnsByName;
   std::set<std::string> HiddenColumnsByLabel;
+  bool HiddenColumnsModified = false;
 
   std::vector<std::string> OrderedColumnList;
   bool OrderColumnsByList = false;
@@ -489,15 +582,50 @@ namespace
 {
 void FetchRMI(void* localArg, void* remoteArg, int remoteArgLength, int)
 {
-  assert(remoteArgLength == sizeof(vtkTypeUInt64) * 2);
-  (void)remoteArgLength;
+  vtkMultiProcessStream stream;
+  stream.SetRawData(reinterpret_cast<const unsigned char*>(remoteArg), remoteArgLength);
+
+  unsigned int identifier;
+  vtkTypeInt64 blockindex, numberOfBlocks;
+  unsigned int numberOfColumnsToSkip;
+  stream >> identifier >> blockindex >> numberOfBlocks >> numberOfColumnsToSkip;
 
-  auto arg = reinterpret_cast<vtkTypeUInt64*>(remoteArg);
   vtkSpreadSheetView* self = reinterpret_cast<vtkSpreadSheetView*>(localArg);
-  if (static_cast<vtkTypeUInt32>(self->GetIdentifier()) == arg[0])
+  if (static_cast<vtkTypeUInt32>(self->GetIdentifier()) == identifier)
   {
-    self->FetchBlockCallback(static_cast<vtkIdType>(arg[1]));
+    std::vector<std::string> columnsToSkip(numberOfColumnsToSkip);
+    for (auto& name : columnsToSkip)
+    {
+      stream >> name;
+    }
+    self->FetchBlockCallback(static_cast<vtkIdType>(blockindex),
+      static_cast<vtkIdType>(numberOfBlocks), columnsToSkip);
+  }
+}
+
+/// Returns a table with at most `size` rows of `table`, starting at `offset`.
+vtkSmartPointer<vtkTable> vtkExtractRows(vtkTable* table, vtkIdType offset, vtkIdType size)
+{
+  auto result = vtkSmartPointer<vtkTable>::New();
+  result->GetFieldData()->ShallowCopy(table->GetFieldData());
+  size = std::max<vtkIdType>(0, std::min(size, table->GetNumberOfRows() - offset));
+  for (vtkIdType cc = 0; cc < table->GetNumberOfColumns(); ++cc)
+  {
+    vtkAbstractArray* column = table->GetColumn(cc);
+    auto rows = vtk::TakeSmartPointer(column->NewInstance());
+    rows->SetName(column->GetName());
+    rows->SetNumberOfComponents(column->GetNumberOfComponents());
+    if (column->HasInformation())
+    {
+      rows->CopyInformation(column->GetInformation());
+    }
+    if (size > 0)
+    {
+      rows->InsertTuples(0, size, offset, column);
+    }
+    result->AddColumn(rows);
   }
+  return result;
 }
 
 unsigned long vtkCountNumberOfRows(vtkDataObject* dobj)
@@ -634,6 +762,7 @@ void vtkSpreadSheetView::HideColumnByName(const char* columnName)
   {
     auto& internals = *this->Internals;
     internals.HiddenColumnsByName.insert(columnName);
+    internals.HiddenColumnsModified = true;
   }
 }
 
@@ -642,6 +771,7 @@ void vtkSpreadSheetView::ClearHiddenColumnsByName()
 {
   auto& internals = *this->Internals;
   internals.HiddenColumnsByName.clear();
+  internals.HiddenColumnsModified = true;
 }
 
 //----------------------------------------------------------------------------
@@ -660,6 +790,7 @@ void vtkSpreadSheetView::HideColumnByLabel(const char* columnLabel)
   {
     auto& internals = *this->Internals;
     internals.HiddenColumnsByLabel.insert(columnLabel);
+    internals.HiddenColumnsModified = true;
   }
 }
 
@@ -668,6 +799,7 @@ void vtkSpreadSheetView::ClearHiddenColumnsByLabel()
 {
   auto& internals = *this->Internals;
   internals.HiddenColumnsByLabel.clear();
+  internals.HiddenColumnsModified = true;
 }
 
 //----------------------------------------------------------------------------
@@ -765,6 +897,7 @@ void vtkSpreadSheetView::ClearOrderedColumnList()
 void vtkSpreadSheetView::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfReadAheadBlocks: " << this->NumberOfReadAheadBlocks << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -924,20 +1057,77 @@ void vtkSpreadSheetView::OnRepresentationUpdated()
 //----------------------------------------------------------------------------
 vtkTable* vtkSpreadSheetView::FetchBlock(vtkIdType blockindex)
 {
-  vtkTable* block = this->Internals->GetDataObject(blockindex);
+  auto& internals = *this->Internals;
+  internals.UpdateSkippedColumns(this);
+  vtkTable* block = internals.GetDataObject(blockindex);
   if (!block)
   {
-    block = this->FetchBlockCallback(blockindex);
-    // use the block returned from the AddToCache since that is cleaned up
-    // to have columns in correct order.
-    block = this->Internals->AddToCache(blockindex, block, 10);
-    this->InvokeEvent(vtkCommand::UpdateEvent, &blockindex);
+    // Fetch the blocks following the requested one in the direction of the
+    // previous fetches as well, in the same pass.
+    const vtkIdType blockSize = this->TableStreamer->GetBlockSize();
+    const vtkIdType lastBlock = std::max(blockindex, (this->NumberOfRows - 1) / blockSize);
+    vtkIdType first = blockindex;
+    vtkIdType last = blockindex;
+    if (blockindex >= internals.LastFetchedBlock)
+    {
+      last = std::min(blockindex + this->NumberOfReadAheadBlocks, lastBlock);
+      while (last > first && internals.IsCached(last))
+      {
+        --last;
+      }
+    }
+    else
+    {
+      first = std::max<vtkIdType>(blockindex - this->NumberOfReadAheadBlocks, 0);
+      while (first < last && internals.IsCached(first))
+      {
+        ++first;
+      }
+    }
+    internals.LastFetchedBlock = blockindex;
+
+    const auto columnsToSkip = internals.GetColumnsToSkip(this);
+    const bool projected = !columnsToSkip.empty();
+    vtkTable* table = this->FetchBlockCallback(first, last - first + 1, columnsToSkip);
+    if (!table || first == last)
+    {
+      // use the block returned from the AddToCache since that is cleaned up
+      // to have columns in correct order.
+      block = internals.AddToCache(blockindex, table, 10, projected);
+    }
+    else
+    {
+      // split the fetched rows into blocks, adding the requested one last so
+      // that it is the most recently used.
+      for (vtkIdType cc = first; cc <= last; ++cc)
+      {
+        if (cc != blockindex)
+        {
+          auto rows = ::vtkExtractRows(table, (cc - first) * blockSize, blockSize);
+          internals.AddToCache(cc, rows, 10, projected);
+        }
+      }
+      block = internals.AddToCache(blockindex,
+        ::vtkExtractRows(table, (blockindex - first) * blockSize, blockSize), 10, projected);
+    }
+    internals.AddSkippedColumns(columnsToSkip);
+    for (vtkIdType cc = first; cc <= last; ++cc)
+    {
+      this->InvokeEvent(vtkCommand::UpdateEvent, &cc);
+    }
   }
   return block;
 }
 
 //----------------------------------------------------------------------------
 vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
+{
+  return this->FetchBlockCallback(blockindex, 1, std::vector<std::string>());
+}
+
+//----------------------------------------------------------------------------
+vtkTable* vtkSpreadSheetView::FetchBlockCallback(
+  vtkIdType blockindex, vtkIdType numberOfBlocks, const std::vector<std::string>& columnsToSkip)
 {
   // Sanity Check
   if (!this->Internals->ActiveRepresentation)
@@ -946,19 +1136,36 @@ vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
   }
 
   // cout << "FetchBlockCallback" << endl;
-  vtkTypeUInt64 data[2] = { this->Identifier, static_cast<vtkTypeUInt64>(blockindex) };
+  vtkMultiProcessStream stream;
+  stream << static_cast<unsigned int>(this->Identifier) << static_cast<vtkTypeInt64>(blockindex)
+         << static_cast<vtkTypeInt64>(numberOfBlocks)
+         << static_cast<unsigned int>(columnsToSkip.size());
+  for (const auto& name : columnsToSkip)
+  {
+    stream << name;
+  }
+  std::vector<unsigned char> data;
+  stream.GetRawData(data);
   if (auto dController = this->GetSession()->GetController(vtkPVSession::DATA_SERVER_ROOT))
   {
-    dController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 2, FETCH_BLOCK_TAG);
+    dController->TriggerRMIOnAllChildren(
+      data.data(), static_cast<int>(data.size()), FETCH_BLOCK_TAG);
   }
   auto pController = vtkMultiProcessController::GetGlobalController();
   if (pController && pController->GetLocalProcessId() == 0 &&
     pController->GetNumberOfProcesses() > 1)
   {
-    pController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 2, FETCH_BLOCK_TAG);
+    pController->TriggerRMIOnAllChildren(
+      data.data(), static_cast<int>(data.size()), FETCH_BLOCK_TAG);
   }
 
   this->TableStreamer->SetBlock(blockindex);
+  this->TableStreamer->SetNumberOfBlocks(numberOfBlocks);
+  this->TableStreamer->RemoveAllColumnsToSkip();
+  for (const auto& name : columnsToSkip)
+  {
+    this->TableStreamer->AddColumnToSkip(name.c_str());
+  }
   this->TableStreamer->SetShowFieldData(this->ShowFieldData);
   this->TableStreamer->Modified();
   this->TableSelectionMarker->SetFieldAssociation(this->FieldAssociation);
@@ -1023,7 +1230,14 @@ vtkVariant vtkSpreadSheetView::GetValue(vtkIdType row, vtkIdType col)
   vtkIdType blockIndex = row / blockSize;
   vtkTable* block = this->FetchBlock(blockIndex);
   vtkIdType blockOffset = row - (blockIndex * blockSize);
-  return block->GetValue(blockOffset, col);
+  if (block->GetNumberOfColumns() == this->GetNumberOfColumns())
+  {
+    return block->GetValue(blockOffset, col);
+  }
+
+  // hidden columns may have been skipped when fetching the block.
+  const char* columnName = this->GetColumnName(col);
+  return columnName ? block->GetValueByName(blockOffset, columnName) : vtkVariant();
 }
 
 //----------------------------------------------------------------------------
@@ -1055,6 +1269,7 @@ bool vtkSpreadSheetView::IsRowSelected(vtkIdType row)
 //----------------------------------------------------------------------------
 bool vtkSpreadSheetView::IsAvailable(vtkIdType row)
 {
+  this->Internals->UpdateSkippedColumns(this);
   vtkIdType blockSize = this->TableStreamer->GetBlockSize();
   vtkIdType blockIndex = row / blockSize;
   return this->Internals->GetDataObject(blockIndex) != nullptr;
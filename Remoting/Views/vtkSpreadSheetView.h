@@ -16,6 +16,7 @@
 #include "vtkRemotingViewsModule.h" //needed for exports
 
 #include <string> // for std::string
+#include <vector> // for std::vector
 
 class vtkCSVExporter;
 class vtkClientServerMoveData;
@@ -98,6 +99,17 @@ public:
   vtkGetMacro(FieldAssociation, int);
   ///@}
 
+  ///@{
+  /**
+   * Number of neighboring blocks, in the direction of the previous fetches,
+   * to fetch along with a block that is not cached. The blocks are sorted,
+   * reduced and delivered in a single pass. Default is 2.
+   * \note CallOnClient
+   */
+  vtkSetClampMacro(NumberOfReadAheadBlocks, int, 0, 4);
+  vtkGetMacro(NumberOfReadAheadBlocks, int);
+  ///@}
+
   ///@{
   /**
    * Specify sorting method that we want to use, when it's enabled, columns will be sorted
@@ -238,8 +250,12 @@ public:
   void ClearCache();
   using Superclass::ClearCache;
 
+  ///@{
   // INTERNAL METHOD. Don't call directly.
   vtkTable* FetchBlockCallback(vtkIdType blockindex);
+  vtkTable* FetchBlockCallback(vtkIdType blockindex, vtkIdType numberOfBlocks,
+    const std::vector<std::string>& columnsToSkip);
+  ///@}
 
 protected:
   vtkSpreadSheetView();
@@ -260,6 +276,7 @@ protected:
   bool ShowExtractedSelection = false;
   bool GenerateCellConnectivity = false;
   bool ShowFieldData = false;
+  int NumberOfReadAheadBlocks = 2;
   vtkSortedTableStreamer* TableStreamer;
   vtkMarkSelectedRows* TableSelectionMarker;
   vtkReductionFilter* ReductionFilter;
@@ -82,8 +82,12 @@ void output_temp(FILE* fp, int i, unsigned int argType, const char* Id, int coun
     return;
   }
 
-  /* Start pointer-to-data arguments.  */
-  if (isPointerToData)
+  /* Start pointer-to-data arguments.  Const data can be used in place.  */
+  if (isPointerToData && (argType & VTK_PARSE_CONST) != 0)
+  {
+    fprintf(fp, "vtkClientServerStreamConstDataArg<");
+  }
+  else if (isPointerToData)
   {
     fprintf(fp, "vtkClientServerStreamDataArg<");
   }
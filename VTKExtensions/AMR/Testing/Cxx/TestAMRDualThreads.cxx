@@ -0,0 +1,276 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkAMRDualClip.h"
+#include "vtkAMRDualContour.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkIdList.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUniformGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Blocks have 8 cells per axis plus a ghost layer on every side that has a
+// neighbor, as the SPCTH reader produces them.
+constexpr int BlockCells = 8;
+
+void AddBlock(vtkNonOverlappingAMR* amr, int level, int blockId, const int gridIndex[3])
+{
+  const int numberOfBlocks = 3 << level;
+  const double spacing = 1.0 / (1 << level);
+  int extent[6];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    extent[2 * axis] = gridIndex[axis] * BlockCells - (gridIndex[axis] > 0 ? 1 : 0);
+    extent[2 * axis + 1] =
+      (gridIndex[axis] + 1) * BlockCells + (gridIndex[axis] < numberOfBlocks - 1 ? 1 : 0);
+  }
+
+  vtkNew<vtkUniformGrid> grid;
+  grid->SetOrigin(extent[0] * spacing, extent[2] * spacing, extent[4] * spacing);
+  grid->SetSpacing(spacing, spacing, spacing);
+  grid->SetDimensions(
+    extent[1] - extent[0] + 1, extent[3] - extent[2] + 1, extent[5] - extent[4] + 1);
+
+  // volume fraction of a sphere of radius 8 centered in the domain.
+  vtkNew<vtkDoubleArray> fraction;
+  fraction->SetName("fraction");
+  fraction->SetNumberOfTuples(grid->GetNumberOfCells());
+  vtkIdType cellId = 0;
+  for (int kk = extent[4]; kk < extent[5]; ++kk)
+  {
+    for (int jj = extent[2]; jj < extent[3]; ++jj)
+    {
+      for (int ii = extent[0]; ii < extent[1]; ++ii)
+      {
+        const double dx = (ii + 0.5) * spacing - 12.0;
+        const double dy = (jj + 0.5) * spacing - 12.0;
+        const double dz = (kk + 0.5) * spacing - 12.0;
+        const double value = 0.5 + (8.0 - std::sqrt(dx * dx + dy * dy + dz * dz)) / 4.0;
+        fraction->SetValue(cellId++, std::min(1.0, std::max(0.0, value)));
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(fraction);
+  amr->SetDataSet(level, blockId, grid);
+}
+
+// 26 blocks on level 0, the last octant of the domain is refined into 8
+// blocks on level 1 so that the surface crosses a level boundary.
+vtkSmartPointer<vtkNonOverlappingAMR> CreateInput()
+{
+  const int blocksPerLevel[2] = { 26, 8 };
+  auto amr = vtkSmartPointer<vtkNonOverlappingAMR>::New();
+  amr->Initialize(2, blocksPerLevel);
+
+  int blockId = 0;
+  int gridIndex[3];
+  for (gridIndex[2] = 0; gridIndex[2] < 3; ++gridIndex[2])
+  {
+    for (gridIndex[1] = 0; gridIndex[1] < 3; ++gridIndex[1])
+    {
+      for (gridIndex[0] = 0; gridIndex[0] < 3; ++gridIndex[0])
+      {
+        if (gridIndex[0] != 2 || gridIndex[1] != 2 || gridIndex[2] != 2)
+        {
+          ::AddBlock(amr, 0, blockId++, gridIndex);
+        }
+      }
+    }
+  }
+  blockId = 0;
+  for (gridIndex[2] = 4; gridIndex[2] < 6; ++gridIndex[2])
+  {
+    for (gridIndex[1] = 4; gridIndex[1] < 6; ++gridIndex[1])
+    {
+      for (gridIndex[0] = 4; gridIndex[0] < 6; ++gridIndex[0])
+      {
+        ::AddBlock(amr, 1, blockId++, gridIndex);
+      }
+    }
+  }
+  return amr;
+}
+
+void AppendTuple(vtkDataSetAttributes* attributes, vtkIdType tupleId, std::vector<double>& values)
+{
+  for (int arrayIdx = 0; arrayIdx < attributes->GetNumberOfArrays(); ++arrayIdx)
+  {
+    vtkDataArray* array = attributes->GetArray(arrayIdx);
+    for (int comp = 0; comp < array->GetNumberOfComponents(); ++comp)
+    {
+      values.push_back(array->GetComponent(tupleId, comp));
+    }
+  }
+}
+
+// Describes every cell by its type, its attributes and the coordinates and
+// attributes of its points, in the order the cell lists them. Threads append
+// blocks in a different order than the serial path, so the point and cell ids
+// differ while the cells themselves must be identical.
+std::vector<std::vector<double>> GetCells(vtkDataSet* dataset)
+{
+  std::vector<std::vector<double>> cells(dataset->GetNumberOfCells());
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < dataset->GetNumberOfCells(); ++cellId)
+  {
+    std::vector<double>& cell = cells[cellId];
+    cell.push_back(dataset->GetCellType(cellId));
+    ::AppendTuple(dataset->GetCellData(), cellId, cell);
+    dataset->GetCellPoints(cellId, ptIds);
+    for (vtkIdType idx = 0; idx < ptIds->GetNumberOfIds(); ++idx)
+    {
+      double x[3];
+      dataset->GetPoint(ptIds->GetId(idx), x);
+      cell.insert(cell.end(), x, x + 3);
+      ::AppendTuple(dataset->GetPointData(), ptIds->GetId(idx), cell);
+    }
+  }
+  std::sort(cells.begin(), cells.end());
+  return cells;
+}
+
+bool Compare(vtkDataObject* expected, vtkDataObject* actual, const std::string& label)
+{
+  auto expectedCD = vtkCompositeDataSet::SafeDownCast(expected);
+  auto actualCD = vtkCompositeDataSet::SafeDownCast(actual);
+  if (!expectedCD || !actualCD)
+  {
+    vtkLogF(ERROR, "%s: missing output.", label.c_str());
+    return false;
+  }
+
+  vtkSmartPointer<vtkCompositeDataIterator> expectedIter;
+  expectedIter.TakeReference(expectedCD->NewIterator());
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(actualCD->NewIterator());
+  int numberOfCells = 0;
+  for (expectedIter->InitTraversal(), iter->InitTraversal(); !expectedIter->IsDoneWithTraversal();
+       expectedIter->GoToNextItem(), iter->GoToNextItem())
+  {
+    auto expectedDS = vtkDataSet::SafeDownCast(expectedIter->GetCurrentDataObject());
+    vtkDataObject* current = iter->IsDoneWithTraversal() ? nullptr : iter->GetCurrentDataObject();
+    auto dataset = vtkDataSet::SafeDownCast(current);
+    if (!expectedDS || !dataset)
+    {
+      vtkLogF(ERROR, "%s: the output has a different structure.", label.c_str());
+      return false;
+    }
+    // merged points must be shared the same way.
+    if (dataset->GetNumberOfPoints() != expectedDS->GetNumberOfPoints() ||
+      dataset->GetCellData()->GetNumberOfArrays() !=
+        expectedDS->GetCellData()->GetNumberOfArrays() ||
+      dataset->GetPointData()->GetNumberOfArrays() !=
+        expectedDS->GetPointData()->GetNumberOfArrays())
+    {
+      vtkLogF(ERROR, "%s: %lld points, %lld without threads.", label.c_str(),
+        static_cast<long long>(dataset->GetNumberOfPoints()),
+        static_cast<long long>(expectedDS->GetNumberOfPoints()));
+      return false;
+    }
+    if (::GetCells(dataset) != ::GetCells(expectedDS))
+    {
+      vtkLogF(ERROR, "%s: the cells differ from the ones generated without threads.",
+        label.c_str());
+      return false;
+    }
+    numberOfCells += expectedDS->GetNumberOfCells();
+  }
+  if (!iter->IsDoneWithTraversal())
+  {
+    vtkLogF(ERROR, "%s: the output has a different structure.", label.c_str());
+    return false;
+  }
+  if (numberOfCells == 0)
+  {
+    vtkLogF(ERROR, "%s: empty output.", label.c_str());
+    return false;
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkDataObject> Execute(
+  vtkMultiBlockDataSetAlgorithm* filter, vtkNonOverlappingAMR* input, bool useThreads)
+{
+  filter->SetInputData(input);
+  filter->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "fraction");
+  if (auto contour = vtkAMRDualContour::SafeDownCast(filter))
+  {
+    contour->SetUseThreads(useThreads);
+  }
+  else if (auto clip = vtkAMRDualClip::SafeDownCast(filter))
+  {
+    clip->SetUseThreads(useThreads);
+  }
+  // the thread count is not part of the pipeline state.
+  filter->Modified();
+  filter->Update();
+  auto output = vtkSmartPointer<vtkDataObject>::Take(filter->GetOutputDataObject(0)->NewInstance());
+  output->DeepCopy(filter->GetOutputDataObject(0));
+  return output;
+}
+
+// Runs the filter without threads, then with threads using several thread
+// counts, and compares the outputs.
+bool TestFilter(
+  vtkMultiBlockDataSetAlgorithm* filter, vtkNonOverlappingAMR* input, const std::string& label)
+{
+  auto serial = ::Execute(filter, input, false);
+  for (int numberOfThreads : { 1, 2, 8 })
+  {
+    vtkSmartPointer<vtkDataObject> threaded;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+      [&]() { threaded = ::Execute(filter, input, true); });
+    const std::string name = label + " with " + std::to_string(numberOfThreads) + " threads";
+    if (!::Compare(serial, threaded, name))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestAMRDualThreads(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  auto input = ::CreateInput();
+  bool success = true;
+  for (int mergePoints = 0; mergePoints < 2; ++mergePoints)
+  {
+    const std::string suffix = mergePoints ? " merging points" : "";
+
+    vtkNew<vtkAMRDualContour> contour;
+    contour->SetIsoValue(0.5);
+    contour->SetEnableMergePoints(mergePoints);
+    success = ::TestFilter(contour, input, "contour" + suffix) && success;
+
+    vtkNew<vtkAMRDualClip> clip;
+    clip->SetIsoValue(0.5);
+    clip->SetEnableMergePoints(mergePoints);
+    success = ::TestFilter(clip, input, "clip" + suffix) && success;
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -13,6 +13,8 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
 #include "vtkCallbackCommand.h"
@@ -35,6 +37,7 @@
 #include "vtkUnstructuredGrid.h"
 #include <cmath>
 #include <ctime>
+#include <memory>
 
 vtkStandardNewMacro(vtkAMRDualClip);
 
@@ -132,6 +135,11 @@ public:
 
   vtkUnsignedCharArray* GetLevelMaskArray() { return this->LevelMaskArray; }
 
+  // Points created by a worker running concurrently with others are stored
+  // as -2 - id. This converts them to output ids once the worker's points
+  // are appended to the output starting at `offset`.
+  void ResolveLocalPointIds(vtkIdType offset);
+
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -159,6 +167,21 @@ private:
   unsigned char CenterLevelMaskComputed;
 };
 
+//----------------------------------------------------------------------------
+void vtkAMRDualClipLocator::ResolveLocalPointIds(vtkIdType offset)
+{
+  for (vtkIdType* ids : { this->XEdges, this->YEdges, this->ZEdges, this->Corners })
+  {
+    for (int idx = 0; idx < this->ArrayLength; ++idx)
+    {
+      if (ids[idx] < -1)
+      {
+        ids[idx] = offset - 2 - ids[idx];
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 unsigned char* vtkAMRDualClipLocator::GetLevelMaskPointer()
 {
@@ -844,6 +867,67 @@ void vtkAMRDualClipLocator::SharePointIdsWithNeighbor(
   }
 }
 
+//============================================================================
+// Where ProcessBlock puts the tetrahedra it generates. The serial path writes
+// directly to the output. When blocks are processed concurrently, each one
+// gets its own worker which is appended to the output afterwards.
+class vtkAMRDualClipWorker
+{
+public:
+  // Returns the id to store in locators and cells for a point of `Points`.
+  vtkIdType ExportId(vtkIdType ptId) const { return this->LocalPointIds ? -2 - ptId : ptId; }
+
+  vtkSmartPointer<vtkUnstructuredGrid> Mesh;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Cells;
+  vtkSmartPointer<vtkIntArray> BlockIdCellArray;
+  vtkSmartPointer<vtkUnsignedCharArray> LevelMaskPointArray;
+
+  vtkAMRDualClipLocator* BlockLocator = nullptr;
+  // Reused for every block when points are not merged.
+  std::unique_ptr<vtkAMRDualClipLocator> PrivateLocator;
+
+  // Set for concurrent workers. Their points are numbered from 0 and
+  // encoded so that they cannot be mistaken for points already in the
+  // output, which they may share with neighbor blocks through the locator.
+  bool LocalPointIds = false;
+};
+
+//----------------------------------------------------------------------------
+// Appends the points and tetrahedra of a concurrent worker to the output and
+// returns the output id of its first point.
+vtkIdType vtkAMRDualClipAppendWorker(vtkAMRDualClipWorker* worker, vtkUnstructuredGrid* mesh,
+  vtkPoints* points, vtkCellArray* cells, vtkIntArray* blockIds)
+{
+  vtkIdType offset = points->GetNumberOfPoints();
+  points->InsertPoints(offset, worker->Points->GetNumberOfPoints(), 0, worker->Points);
+
+  // Both point data were set up the same way from the same input, so their
+  // arrays match.
+  vtkPointData* inPD = worker->Mesh->GetPointData();
+  vtkPointData* outPD = mesh->GetPointData();
+  for (int idx = 0; idx < inPD->GetNumberOfArrays() && idx < outPD->GetNumberOfArrays(); ++idx)
+  {
+    vtkAbstractArray* inArray = inPD->GetAbstractArray(idx);
+    outPD->GetAbstractArray(idx)->InsertTuples(offset, inArray->GetNumberOfTuples(), 0, inArray);
+  }
+
+  vtkIdType ids[4];
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (worker->Cells->InitTraversal(); worker->Cells->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType idx = 0; idx < npts; ++idx)
+    {
+      ids[idx] = pts[idx] < -1 ? offset - 2 - pts[idx] : pts[idx];
+    }
+    cells->InsertNextCell(npts, ids);
+  }
+  blockIds->InsertTuples(blockIds->GetNumberOfTuples(),
+    worker->BlockIdCellArray->GetNumberOfTuples(), 0, worker->BlockIdCellArray);
+  return offset;
+}
+
 //----------------------------------------------------------------------------
 // This version works with higher level neighbor blocks.
 // Move the points on boundaries to neighbor locator so there will
@@ -1017,6 +1101,7 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->EnableDegenerateCells = 1;
   this->EnableMultiProcessCommunication = 0;
   this->EnableMergePoints = 0;
+  this->UseThreads = 0;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1027,18 +1112,11 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->LevelMaskPointArray = nullptr;
   this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualClip::~vtkAMRDualClip()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -1051,6 +1129,7 @@ void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableInternalDecimation: " << this->EnableInternalDecimation << endl;
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "UseThreads: " << this->UseThreads << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -1189,6 +1268,13 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   this->Mesh = mesh;
   this->InitializeCopyAttributes(hbdsInput, this->Mesh);
 
+  vtkAMRDualClipWorker worker;
+  worker.Mesh = this->Mesh;
+  worker.Points = this->Points;
+  worker.Cells = this->Cells;
+  worker.BlockIdCellArray = this->BlockIdCellArray;
+  worker.LevelMaskPointArray = this->LevelMaskPointArray;
+
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
   int numBlocks;
@@ -1197,11 +1283,20 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   // Add each block.
   for (int level = 0; level < numLevels; ++level)
   {
+    if (this->UseThreads)
+    {
+      this->ProcessLevelInParallel(hbdsInput, level, arrayNameToProcess);
+      continue;
+    }
     numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      if (this->ProcessBlock(&worker, block, blockId, arrayNameToProcess) &&
+        this->EnableMergePoints)
+      {
+        this->FinishBlock(block);
+      }
     }
   }
 
@@ -1443,13 +1538,108 @@ void vtkAMRDualClip::ShareLevelMask(vtkAMRDualGridHelperBlock* block)
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualClip::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+void vtkAMRDualClip::ProcessLevelInParallel(
+  vtkNonOverlappingAMR* hbdsInput, int level, const char* arrayNameToProcess)
+{
+  // Blocks whose grid indexes have the same parities are never neighbors, so
+  // the blocks of each of the 8 parity classes can be processed at the same
+  // time without touching each other's locators. Each class is appended to
+  // the output before its locators are shared with the remaining blocks.
+  std::vector<int> classBlockIds[8];
+  int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+  for (int blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+    if (block->Image)
+    {
+      int parity = (block->GridIndex[0] & 1) | ((block->GridIndex[1] & 1) << 1) |
+        ((block->GridIndex[2] & 1) << 2);
+      classBlockIds[parity].push_back(blockId);
+    }
+  }
+
+  for (const std::vector<int>& blockIds : classBlockIds)
+  {
+    vtkIdType numClassBlocks = static_cast<vtkIdType>(blockIds.size());
+    std::vector<std::unique_ptr<vtkAMRDualClipWorker>> workers(numClassBlocks);
+    for (vtkIdType idx = 0; idx < numClassBlocks; ++idx)
+    {
+      auto& worker = workers[idx];
+      worker.reset(new vtkAMRDualClipWorker);
+      worker->Mesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      worker->Points = vtkSmartPointer<vtkPoints>::New();
+      worker->Cells = vtkSmartPointer<vtkCellArray>::New();
+      worker->BlockIdCellArray = vtkSmartPointer<vtkIntArray>::New();
+      worker->LevelMaskPointArray = vtkSmartPointer<vtkUnsignedCharArray>::New();
+      worker->LevelMaskPointArray->SetName("LevelMask");
+      worker->Mesh->SetPoints(worker->Points);
+      worker->Mesh->GetPointData()->AddArray(worker->LevelMaskPointArray);
+      worker->LocalPointIds = true;
+      this->InitializeCopyAttributes(hbdsInput, worker->Mesh);
+
+      // Initializing the level mask reads and writes the locators of the
+      // neighbor blocks, so it cannot be done concurrently.
+      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockIds[idx]);
+      if (this->EnableMergePoints && block->Image->GetCellData()->GetArray(arrayNameToProcess))
+      {
+        this->InitializeLevelMask(block);
+      }
+    }
+
+    std::vector<unsigned char> processed(numClassBlocks, 0);
+    vtkSMPTools::For(0, numClassBlocks, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockIds[idx]);
+        processed[idx] =
+          this->ProcessBlock(workers[idx].get(), block, blockIds[idx], arrayNameToProcess);
+      }
+    });
+
+    for (vtkIdType idx = 0; idx < numClassBlocks; ++idx)
+    {
+      if (!processed[idx])
+      {
+        continue;
+      }
+      vtkIdType offset = vtkAMRDualClipAppendWorker(
+        workers[idx].get(), this->Mesh, this->Points, this->Cells, this->BlockIdCellArray);
+      if (this->EnableMergePoints)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockIds[idx]);
+        vtkAMRDualClipGetBlockLocator(block)->ResolveLocalPointIds(offset);
+        this->FinishBlock(block);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClip::FinishBlock(vtkAMRDualGridHelperBlock* block)
+{
+  this->ShareLevelMask(block);
+  // Copy point ids into neighbor locators.
+  this->ShareBlockLocatorWithNeighbors(block);
+  // We are done.  We no longer need the locator for this block.
+  delete vtkAMRDualClipGetBlockLocator(block);
+  block->UserData = nullptr;
+  // Lets use this unused flag (owner of center region/block) to indicate
+  // that the block is already processes.
+  // This will keep neighbors from recreating the locator.
+  // Another option would be to create the locator object for
+  // all blocks but do not allocate until needed.  Then the existence of the locator
+  // would tell whether the block was processed.
+  block->RegionBits[1][1][1] = 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkAMRDualClip::ProcessBlock(vtkAMRDualClipWorker* worker, vtkAMRDualGridHelperBlock* block,
+  int blockId, const char* arrayNameToProcess)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
   { // Remote blocks are only to setup local block bit flags.
-    return;
+    return false;
   }
 
   // We are looking for only cell data arrays.
@@ -1457,7 +1647,7 @@ void vtkAMRDualClip::ProcessBlock(
 
   if (!volumeFractionArray)
   {
-    return;
+    return false;
   }
 
   // void* volumeFractionPtr = volumeFractionArray->GetVoidPointer(0);
@@ -1476,18 +1666,23 @@ void vtkAMRDualClip::ProcessBlock(
   // Input the dimensions of the dual cells with ghosts.
   if (this->EnableMergePoints)
   {
-    this->InitializeLevelMask(block);
-    this->BlockLocator = vtkAMRDualClipGetBlockLocator(block);
+    // Concurrent workers had their level mask initialized beforehand.
+    if (!worker->LocalPointIds)
+    {
+      this->InitializeLevelMask(block);
+    }
+    worker->BlockLocator = vtkAMRDualClipGetBlockLocator(block);
   }
   else
   { // Shared locator.
-    if (this->BlockLocator == nullptr)
+    if (worker->PrivateLocator == nullptr)
     {
-      this->BlockLocator = new vtkAMRDualClipLocator;
+      worker->PrivateLocator.reset(new vtkAMRDualClipLocator);
     }
-    this->BlockLocator->Initialize(
+    worker->BlockLocator = worker->PrivateLocator.get();
+    worker->BlockLocator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    // this->BlockLocator->CopyRegionLevelDifferences(block);
+    // worker->BlockLocator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -1563,7 +1758,8 @@ void vtkAMRDualClip::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + yInc + zInc;
           cornerOffsets[7] = xOffset + 1 + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(
+            worker, block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -1571,31 +1767,16 @@ void vtkAMRDualClip::ProcessBlock(
     }
     zOffset += zInc;
   }
-
-  if (this->EnableMergePoints)
-  {
-    this->ShareLevelMask(block);
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
-    // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-    block->UserData = nullptr;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
-  }
+  worker->BlockLocator = nullptr;
+  return true;
 }
 
 //----------------------------------------------------------------------------
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
-void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualClip::ProcessDualCell(vtkAMRDualClipWorker* worker,
+  vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+  vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1823,8 +2004,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
       // convert from VTK corner ids to bit (x,y,z) corner ids.
       if (casePtId < 8)
       { // Corner (internal point)
-        ptIdPtr = this->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
-        levelMaskValue = this->BlockLocator->GetLevelMaskValue(
+        ptIdPtr = worker->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
+        levelMaskValue = worker->BlockLocator->GetLevelMaskValue(
           x + ((casePtId & 1) ? 1 : 0), y + ((casePtId & 2) ? 1 : 0), z + ((casePtId & 4) ? 1 : 0));
         if (levelMaskValue == 0)
         { // bug !!!!! trying to figure out what is going on.
@@ -1876,7 +2057,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           pt[0] = origin[0] + spacing[0] * (double)(1 << levelDiff) * ((double)(px) + dx);
           pt[1] = origin[1] + spacing[1] * (double)(1 << levelDiff) * ((double)(py) + dy);
           pt[2] = origin[2] + spacing[2] * (double)(1 << levelDiff) * ((double)(pz) + dz);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          vtkIdType ptId = worker->Points->InsertNextPoint(pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1890,14 +2071,15 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Averaging could be a pre processing step but we would have to modify input attributes
           // .......
           vtkIdType offset = cornerOffsets[casePtId];
-          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
+          worker->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, ptId);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          worker->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          *ptIdPtr = worker->ExportId(ptId);
         }
       }
       else
       { // Edge (clipped cell, point on iso surface)
-        ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
+        ptIdPtr = worker->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
         if (*ptIdPtr == -1)
         {
           int edge = casePtId - 8;
@@ -1914,7 +2096,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
             cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
           pt[2] =
             cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          vtkIdType ptId = worker->Points->InsertNextPoint(pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1924,10 +2106,11 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Find the offsets of the two attributes to interpolate
           vtkIdType offset0 = cornerOffsets[pt1Idx >> 2];
           vtkIdType offset1 = cornerOffsets[pt2Idx >> 2];
-          this->Mesh->GetPointData()->InterpolateEdge(
-            block->Image->GetCellData(), *ptIdPtr, offset0, offset1, k);
+          worker->Mesh->GetPointData()->InterpolateEdge(
+            block->Image->GetCellData(), ptId, offset0, offset1, k);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          worker->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          *ptIdPtr = worker->ExportId(ptId);
         }
       }
       pointIds[ii] = *ptIdPtr;
@@ -1935,8 +2118,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
       pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
     {
-      this->Cells->InsertNextCell(4, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      worker->Cells->InsertNextCell(4, pointIds);
+      worker->BlockIdCellArray->InsertNextValue(blockId);
     }
   }
 }
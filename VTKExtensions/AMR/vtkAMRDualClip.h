@@ -36,6 +36,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualClipLocator;
+class vtkAMRDualClipWorker;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualClip : public vtkMultiBlockDataSetAlgorithm
 {
@@ -74,6 +75,19 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   ///@}
 
+  ///@{
+  /**
+   * When on, the blocks of each level are clipped concurrently using
+   * vtkSMPTools. Neighbor blocks are never processed at the same time and
+   * still share their points when EnableMergePoints is on, so the mesh is
+   * the same as with the serial path, only numbered in a different order.
+   * Off by default.
+   */
+  vtkSetMacro(UseThreads, int);
+  vtkGetMacro(UseThreads, int);
+  vtkBooleanMacro(UseThreads, int);
+  ///@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -88,6 +102,7 @@ protected:
   int EnableDegenerateCells;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
+  int UseThreads;
 
   // Needed for copying cell data to point data.
   vtkUnstructuredGrid* Mesh;
@@ -107,10 +122,27 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  /**
+   * Clips the dual cells owned by `block` into `worker`. Returns false if
+   * the block is remote or lacks the array.
+   */
+  bool ProcessBlock(vtkAMRDualClipWorker* worker, vtkAMRDualGridHelperBlock* block, int blockId,
+    const char* arrayName);
+
+  /**
+   * Shares the level mask and locator of a processed block with its
+   * neighbors, then releases the locator.
+   */
+  void FinishBlock(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  /**
+   * Processes the blocks of a level concurrently (see UseThreads).
+   */
+  void ProcessLevelInParallel(vtkNonOverlappingAMR* input, int level, const char* arrayName);
+
+  void ProcessDualCell(vtkAMRDualClipWorker* worker, vtkAMRDualGridHelperBlock* block,
+    int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+    vtkDataArray* volumeFractionArray);
 
   void InitializeLevelMask(vtkAMRDualGridHelperBlock* block);
   void ShareLevelMask(vtkAMRDualGridHelperBlock* block);
@@ -137,8 +169,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualClipLocator* BlockLocator;
-
 private:
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
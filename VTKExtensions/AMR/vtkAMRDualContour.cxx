@@ -12,6 +12,8 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
 #include "vtkCallbackCommand.h"
@@ -25,6 +27,7 @@
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
@@ -35,6 +38,7 @@
 #include "vtkUnstructuredGrid.h"
 #include <cmath>
 #include <ctime>
+#include <memory>
 
 vtkStandardNewMacro(vtkAMRDualContour);
 
@@ -92,6 +96,12 @@ public:
   void ShareBlockLocatorWithNeighbor(
     vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
 
+  // Description:
+  // Points created by a worker running concurrently with others are stored
+  // as -2 - id. This converts them to output ids once the worker's points
+  // are appended to the output starting at `offset`.
+  void ResolveLocalPointIds(vtkIdType offset);
+
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -107,6 +117,20 @@ private:
   int RegionLevelDifference[3][3][3];
 };
 //----------------------------------------------------------------------------
+void vtkAMRDualContourEdgeLocator::ResolveLocalPointIds(vtkIdType offset)
+{
+  for (vtkIdType* ids : { this->XEdges, this->YEdges, this->ZEdges, this->Corners })
+  {
+    for (int idx = 0; idx < this->ArrayLength; ++idx)
+    {
+      if (ids[idx] < -1)
+      {
+        ids[idx] = offset - 2 - ids[idx];
+      }
+    }
+  }
+}
+//----------------------------------------------------------------------------
 void vtkAMRDualContourEdgeLocator::CopyRegionLevelDifferences(vtkAMRDualGridHelperBlock* block)
 {
   int x, y, z;
@@ -446,6 +470,70 @@ vtkAMRDualContourEdgeLocator* vtkAMRDualContourGetBlockLocator(vtkAMRDualGridHel
   return (vtkAMRDualContourEdgeLocator*)(block->UserData);
 }
 
+//============================================================================
+// Where ProcessBlock puts the surface it generates. The serial path writes
+// directly to the output. When blocks are processed concurrently, each one
+// gets its own worker which is appended to the output afterwards.
+class vtkAMRDualContourWorker
+{
+public:
+  // Returns the id to store in locators and cells for a point of `Points`.
+  vtkIdType ExportId(vtkIdType ptId) const { return this->LocalPointIds ? -2 - ptId : ptId; }
+
+  vtkSmartPointer<vtkPolyData> Mesh;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Faces;
+  vtkSmartPointer<vtkIntArray> BlockIdCellArray;
+
+  vtkAMRDualContourEdgeLocator* BlockLocator = nullptr;
+  // Reused for every block when points are not merged.
+  std::unique_ptr<vtkAMRDualContourEdgeLocator> PrivateLocator;
+
+  // Set for concurrent workers. Their points are numbered from 0 and
+  // encoded so that they cannot be mistaken for points already in the
+  // output, which they may share with neighbor blocks through the locator.
+  bool LocalPointIds = false;
+};
+
+//----------------------------------------------------------------------------
+// Appends the points and faces of a concurrent worker to the output and
+// returns the output id of its first point.
+vtkIdType vtkAMRDualContourAppendWorker(vtkAMRDualContourWorker* worker, vtkPolyData* mesh,
+  vtkPoints* points, vtkCellArray* faces, vtkIntArray* blockIds)
+{
+  vtkIdType offset = points->GetNumberOfPoints();
+  points->InsertPoints(offset, worker->Points->GetNumberOfPoints(), 0, worker->Points);
+
+  // Both point data were allocated by InitializeCopyAttributes from the same
+  // input, so their arrays match.
+  vtkPointData* inPD = worker->Mesh->GetPointData();
+  vtkPointData* outPD = mesh->GetPointData();
+  for (int idx = 0; idx < inPD->GetNumberOfArrays() && idx < outPD->GetNumberOfArrays(); ++idx)
+  {
+    vtkAbstractArray* inArray = inPD->GetAbstractArray(idx);
+    outPD->GetAbstractArray(idx)->InsertTuples(offset, inArray->GetNumberOfTuples(), 0, inArray);
+  }
+
+  std::vector<vtkIdType> ids;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (worker->Faces->InitTraversal(); worker->Faces->GetNextCell(npts, pts);)
+  {
+    ids.assign(pts, pts + npts);
+    for (vtkIdType& id : ids)
+    {
+      if (id < -1)
+      {
+        id = offset - 2 - id;
+      }
+    }
+    faces->InsertNextCell(npts, ids.data());
+  }
+  blockIds->InsertTuples(blockIds->GetNumberOfTuples(),
+    worker->BlockIdCellArray->GetNumberOfTuples(), 0, worker->BlockIdCellArray);
+  return offset;
+}
+
 //----------------------------------------------------------------------------
 // This version works with higher level neighbor blocks.
 void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
@@ -612,6 +700,7 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
   this->TriangulateCap = 1;
+  this->UseThreads = 0;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -622,18 +711,11 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->TemperatureArray = nullptr;
   this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualContour::~vtkAMRDualContour()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -650,6 +732,7 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
   os << indent << "TriangulateCap: " << this->TriangulateCap << endl;
   os << indent << "SkipGhostCopy: " << this->SkipGhostCopy << endl;
+  os << indent << "UseThreads: " << this->UseThreads << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -795,17 +878,32 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   this->BlockIdCellArray->SetName("BlockIds");
   this->Mesh->GetCellData()->AddArray(this->BlockIdCellArray);
 
+  vtkAMRDualContourWorker worker;
+  worker.Mesh = this->Mesh;
+  worker.Points = this->Points;
+  worker.Faces = this->Faces;
+  worker.BlockIdCellArray = this->BlockIdCellArray;
+
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
 
   // Add each block.
   for (int level = 0; level < numLevels; ++level)
   {
+    if (this->UseThreads)
+    {
+      this->ProcessLevelInParallel(hbdsInput, level, arrayNameToProcess);
+      continue;
+    }
     int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      if (this->ProcessBlock(&worker, block, blockId, arrayNameToProcess) &&
+        this->EnableMergePoints)
+      {
+        this->FinishBlock(block);
+      }
     }
   }
 
@@ -873,13 +971,95 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::ProcessBlock(
+void vtkAMRDualContour::ProcessLevelInParallel(
+  vtkNonOverlappingAMR* hbdsInput, int level, const char* arrayNameToProcess)
+{
+  // Blocks whose grid indexes have the same parities are never neighbors, so
+  // the blocks of each of the 8 parity classes can be processed at the same
+  // time without touching each other's locators. Each class is appended to
+  // the output before its locators are shared with the remaining blocks.
+  std::vector<int> classBlockIds[8];
+  int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+  for (int blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+    if (block->Image)
+    {
+      int parity = (block->GridIndex[0] & 1) | ((block->GridIndex[1] & 1) << 1) |
+        ((block->GridIndex[2] & 1) << 2);
+      classBlockIds[parity].push_back(blockId);
+    }
+  }
+
+  for (const std::vector<int>& blockIds : classBlockIds)
+  {
+    vtkIdType numClassBlocks = static_cast<vtkIdType>(blockIds.size());
+    std::vector<std::unique_ptr<vtkAMRDualContourWorker>> workers(numClassBlocks);
+    for (auto& worker : workers)
+    {
+      worker.reset(new vtkAMRDualContourWorker);
+      worker->Mesh = vtkSmartPointer<vtkPolyData>::New();
+      worker->Points = vtkSmartPointer<vtkPoints>::New();
+      worker->Faces = vtkSmartPointer<vtkCellArray>::New();
+      worker->BlockIdCellArray = vtkSmartPointer<vtkIntArray>::New();
+      worker->Mesh->SetPoints(worker->Points);
+      worker->LocalPointIds = true;
+      this->InitializeCopyAttributes(hbdsInput, worker->Mesh);
+    }
+
+    std::vector<unsigned char> processed(numClassBlocks, 0);
+    vtkSMPTools::For(0, numClassBlocks, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockIds[idx]);
+        processed[idx] =
+          this->ProcessBlock(workers[idx].get(), block, blockIds[idx], arrayNameToProcess);
+      }
+    });
+
+    for (vtkIdType idx = 0; idx < numClassBlocks; ++idx)
+    {
+      if (!processed[idx])
+      {
+        continue;
+      }
+      vtkIdType offset = vtkAMRDualContourAppendWorker(
+        workers[idx].get(), this->Mesh, this->Points, this->Faces, this->BlockIdCellArray);
+      if (this->EnableMergePoints)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockIds[idx]);
+        vtkAMRDualContourGetBlockLocator(block)->ResolveLocalPointIds(offset);
+        this->FinishBlock(block);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualContour::FinishBlock(vtkAMRDualGridHelperBlock* block)
+{
+  // Copy point ids into neighbor locators.
+  this->ShareBlockLocatorWithNeighbors(block);
+  // We are done.  We no longer need the locator for this block.
+  delete vtkAMRDualContourGetBlockLocator(block);
+  block->UserData = nullptr;
+  // Lets use this unused flag (owner of center region/block) to indicate
+  // that the block is already processes.
+  // This will keep neighbors from recreating the locator.
+  // Another option would be to create the locator object for
+  // all blocks but do not allocate until needed.  Then the existence of the locator
+  // would tell whether the block was processed.
+  block->RegionBits[1][1][1] = 0;
+}
+
+//----------------------------------------------------------------------------
+bool vtkAMRDualContour::ProcessBlock(vtkAMRDualContourWorker* worker,
   vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
   { // Remote blocks are only to setup local block bit flags.
-    return;
+    return false;
   }
 
   // We are looking for only cell data arrays.
@@ -887,7 +1067,7 @@ void vtkAMRDualContour::ProcessBlock(
 
   if (!volumeFractionArray)
   {
-    return;
+    return false;
   }
 
   double origin[3];
@@ -905,17 +1085,18 @@ void vtkAMRDualContour::ProcessBlock(
   // Input the dimensions of the dual cells with ghosts.
   if (this->EnableMergePoints)
   {
-    this->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
+    worker->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
   }
   else
   { // Shared locator.
-    if (this->BlockLocator == nullptr)
+    if (worker->PrivateLocator == nullptr)
     {
-      this->BlockLocator = new vtkAMRDualContourEdgeLocator;
+      worker->PrivateLocator.reset(new vtkAMRDualContourEdgeLocator);
     }
-    this->BlockLocator->Initialize(
+    worker->BlockLocator = worker->PrivateLocator.get();
+    worker->BlockLocator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    this->BlockLocator->CopyRegionLevelDifferences(block);
+    worker->BlockLocator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -996,7 +1177,8 @@ void vtkAMRDualContour::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + 1 + yInc + zInc;
           cornerOffsets[7] = xOffset + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(
+            worker, block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -1004,23 +1186,8 @@ void vtkAMRDualContour::ProcessBlock(
     }
     zOffset += zInc;
   }
-
-  if (this->EnableMergePoints)
-  {
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
-    // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-    block->UserData = nullptr;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
-  }
+  worker->BlockLocator = nullptr;
+  return true;
 }
 
 //----------------------------------------------------------------------------
@@ -1080,8 +1247,9 @@ static int vtkAMRDualLegacyIdToBitIdMap[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
 // Corner offsets are absolute (relative to origin / 0).
-void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualContour::ProcessDualCell(vtkAMRDualContourWorker* worker,
+  vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+  vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1318,7 +1486,7 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     // Only permanently keep locator for edges shared between two blocks.
     for (int ii = 0; ii < 3; ++ii, ++edge) // insert triangle
     {
-      vtkIdType* ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, *edge);
+      vtkIdType* ptIdPtr = worker->BlockLocator->GetEdgePointer(x, y, z, *edge);
 
       if (*ptIdPtr == -1)
       {
@@ -1346,31 +1514,33 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
           cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
+        vtkIdType ptId = worker->Points->InsertNextPoint(pt);
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
         vtkIdType offset1 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][1]];
-        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, *ptIdPtr);
+        this->InterpolateAttributes(block->Image, offset0, offset1, k, worker->Mesh, ptId);
+        *ptIdPtr = worker->ExportId(ptId);
       }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr;
     }
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[1] != pointIds[2])
     {
-      this->Faces->InsertNextCell(3, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      worker->Faces->InsertNextCell(3, pointIds);
+      worker->BlockIdCellArray->InsertNextValue(blockId);
     }
   }
 
   if (this->EnableCapping)
   {
-    this->CapCell(x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, cornerOffsets,
-      blockId, block->Image);
+    this->CapCell(worker, x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints,
+      cornerOffsets, blockId, block->Image);
   }
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId)
+void vtkAMRDualContour::AddCapPolygon(
+  vtkAMRDualContourWorker* worker, int ptCount, vtkIdType* pointIds, int blockId)
 {
   if (this->TriangulateCap)
   {
@@ -1386,8 +1556,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          worker->Faces->InsertNextCell(3, tri);
+          worker->BlockIdCellArray->InsertNextValue(blockId);
         }
       }
       else
@@ -1397,16 +1567,16 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          worker->Faces->InsertNextCell(3, tri);
+          worker->BlockIdCellArray->InsertNextValue(blockId);
         }
         tri[0] = pointIds[high];
         tri[1] = pointIds[high + 1];
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          worker->Faces->InsertNextCell(3, tri);
+          worker->BlockIdCellArray->InsertNextValue(blockId);
         }
       }
       ++low;
@@ -1416,8 +1586,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
   else
   {
     // Do not worry about degenerate polygons in this path.
-    this->Faces->InsertNextCell(ptCount, pointIds);
-    this->BlockIdCellArray->InsertNextValue(blockId);
+    worker->Faces->InsertNextCell(ptCount, pointIds);
+    worker->BlockIdCellArray->InsertNextValue(blockId);
   }
 }
 
@@ -1428,7 +1598,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
 // and I permute the face corners and edges into hex corners and endges.
 // It ends up being a little long to duplicate the code 6 times,
 // but it is still fast.
-void vtkAMRDualContour::CapCell(
+void vtkAMRDualContour::CapCell(vtkAMRDualContourWorker* worker,
   // cell index in block coordinates.
   int cellX, int cellY, int cellZ,
   // Which cell faces need to be capped.
@@ -1463,12 +1633,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = worker->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType ptId = worker->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], worker->Mesh, ptId);
+            *ptIdPtr = worker->ExportId(ptId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1478,7 +1649,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(worker, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1499,12 +1670,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = worker->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType ptId = worker->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], worker->Mesh, ptId);
+            *ptIdPtr = worker->ExportId(ptId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1514,7 +1686,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(worker, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1536,12 +1708,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = worker->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType ptId = worker->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], worker->Mesh, ptId);
+            *ptIdPtr = worker->ExportId(ptId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1551,7 +1724,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(worker, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1573,12 +1746,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = worker->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType ptId = worker->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], worker->Mesh, ptId);
+            *ptIdPtr = worker->ExportId(ptId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1588,7 +1762,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(worker, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1609,12 +1783,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = worker->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType ptId = worker->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], worker->Mesh, ptId);
+            *ptIdPtr = worker->ExportId(ptId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1624,7 +1799,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(worker, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1646,12 +1821,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = worker->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            vtkIdType ptId = worker->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], worker->Mesh, ptId);
+            *ptIdPtr = worker->ExportId(ptId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1661,7 +1837,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(worker, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -43,6 +43,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourWorker;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
 {
@@ -103,6 +104,19 @@ public:
   vtkBooleanMacro(SkipGhostCopy, int);
   ///@}
 
+  ///@{
+  /**
+   * When on, the blocks of each level are contoured concurrently using
+   * vtkSMPTools. Neighbor blocks are never processed at the same time and
+   * still share their points when EnableMergePoints is on, so the surface is
+   * the same as with the serial path, only numbered in a different order.
+   * Off by default.
+   */
+  vtkSetMacro(UseThreads, int);
+  vtkGetMacro(UseThreads, int);
+  vtkBooleanMacro(UseThreads, int);
+  ///@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -119,6 +133,7 @@ protected:
   int EnableMergePoints;
   int TriangulateCap;
   int SkipGhostCopy;
+  int UseThreads;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
@@ -143,16 +158,34 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  /**
+   * Contours the dual cells owned by `block` into `worker`. Returns false if
+   * the block is remote or lacks the array.
+   */
+  bool ProcessBlock(vtkAMRDualContourWorker* worker, vtkAMRDualGridHelperBlock* block,
+    int blockId, const char* arrayName);
+
+  /**
+   * Shares the locator of a processed block with its neighbors, then
+   * releases it.
+   */
+  void FinishBlock(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  /**
+   * Processes the blocks of a level concurrently (see UseThreads).
+   */
+  void ProcessLevelInParallel(vtkNonOverlappingAMR* input, int level, const char* arrayName);
+
+  void ProcessDualCell(vtkAMRDualContourWorker* worker, vtkAMRDualGridHelperBlock* block,
+    int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+    vtkDataArray* volumeFractionArray);
 
-  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId);
+  void AddCapPolygon(
+    vtkAMRDualContourWorker* worker, int ptCount, vtkIdType* pointIds, int blockId);
 
   // This method is getting too many arguments!
   // Capping was an after thought...
-  void CapCell(
+  void CapCell(vtkAMRDualContourWorker* worker,
     // block coordinates
     int cellX, int cellY, int cellZ,
     // Which cell faces need to be capped.
@@ -187,8 +220,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualContourEdgeLocator* BlockLocator;
-
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
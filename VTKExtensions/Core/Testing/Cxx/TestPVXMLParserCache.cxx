@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/Directory.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+// Proxy definitions similar to the ones found in the server manager XMLs.
+std::string CreateXML(int numberOfProxies)
+{
+  std::ostringstream xml;
+  xml << "<ServerManagerConfiguration>\n  <ProxyGroup name=\"filters\">\n";
+  for (int cc = 0; cc < numberOfProxies; ++cc)
+  {
+    xml << "    <SourceProxy name=\"Filter" << cc << "\" class=\"vtkFilter" << cc
+        << "\" label=\"Filter &amp; &quot;" << cc << "&quot;\">\n"
+        << "      <Documentation short_help=\"Filter.\">Filter number " << cc
+        << " &lt;documentation&gt;.</Documentation>\n"
+        << "      <InputProperty name=\"Input\" command=\"SetInputConnection\">\n"
+        << "        <ProxyGroupDomain name=\"groups\"><Group name=\"sources\"/>"
+        << "<Group name=\"filters\"/></ProxyGroupDomain>\n"
+        << "      </InputProperty>\n"
+        << "      <DoubleVectorProperty name=\"Value\" command=\"SetValue\""
+        << " number_of_elements=\"3\" default_values=\"0 0 " << cc << "\" id=\"value" << cc
+        << "\">\n"
+        << "        <DoubleRangeDomain name=\"range\"/>\n"
+        << "      </DoubleVectorProperty>\n"
+        << "      <Hints><ShowInMenu category=\"Common\"/></Hints>\n"
+        << "    </SourceProxy>\n";
+  }
+  xml << "  </ProxyGroup>\n</ServerManagerConfiguration>\n";
+  return xml.str();
+}
+
+// `Equals` compares the XML, which does not include the ids assigned by the
+// parser.
+bool CompareIds(vtkPVXMLElement* expected, vtkPVXMLElement* element)
+{
+  if (strcmp(expected->GetId(), element->GetId()) != 0)
+  {
+    vtkLogF(ERROR, "Expected id %s, got %s.", expected->GetId(), element->GetId());
+    return false;
+  }
+  if (expected->GetNumberOfNestedElements() != element->GetNumberOfNestedElements())
+  {
+    vtkLogF(ERROR, "Incorrect number of nested elements for %s.", expected->GetId());
+    return false;
+  }
+  for (unsigned int cc = 0; cc < expected->GetNumberOfNestedElements(); ++cc)
+  {
+    if (element->GetNestedElement(cc)->GetParent() != element)
+    {
+      vtkLogF(ERROR, "Incorrect parent.");
+      return false;
+    }
+    if (!::CompareIds(expected->GetNestedElement(cc), element->GetNestedElement(cc)))
+    {
+      vtkLogF(ERROR, "Incorrect nested element.");
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckParse(const std::string& xml, const std::string& directory, bool loadedFromCache)
+{
+  vtkNew<vtkPVXMLParser> expected;
+  if (!expected->Parse(xml.c_str()))
+  {
+    vtkLogF(ERROR, "Failed to parse XML.");
+    return false;
+  }
+
+  vtkNew<vtkPVXMLParser> parser;
+  if (!parser->ParseWithCache(xml.c_str(), directory.c_str()))
+  {
+    vtkLogF(ERROR, "Failed to parse with cache.");
+    return false;
+  }
+  if (parser->GetLoadedFromCache() != loadedFromCache)
+  {
+    vtkLogF(ERROR, "%s", loadedFromCache ? "Cache not used." : "Unexpected use of the cache.");
+    return false;
+  }
+  if (!parser->GetRootElement()->Equals(expected->GetRootElement()))
+  {
+    vtkLogF(ERROR, "Trees differ.");
+    return false;
+  }
+  if (!::CompareIds(expected->GetRootElement(), parser->GetRootElement()))
+  {
+    vtkLogF(ERROR, "Ids differ.");
+    return false;
+  }
+  if (parser->GetRootElement()->GetParent() != nullptr)
+  {
+    vtkLogF(ERROR, "Root must not have a parent.");
+    return false;
+  }
+  vtkPVXMLElement* documentation = parser->GetRootElement()
+                                     ->FindNestedElementByName("ProxyGroup")
+                                     ->FindNestedElementByName("SourceProxy")
+                                     ->FindNestedElementByName("Documentation");
+  if (strcmp(documentation->GetCharacterData(), "Filter number 0 <documentation>.") != 0)
+  {
+    vtkLogF(ERROR, "Incorrect character data.");
+    return false;
+  }
+  return true;
+}
+
+std::string GetCacheFile(const std::string& directory)
+{
+  vtksys::Directory dir;
+  dir.Load(directory);
+  for (unsigned long cc = 0; cc < dir.GetNumberOfFiles(); ++cc)
+  {
+    if (vtksys::SystemTools::GetFilenameLastExtension(dir.GetFile(cc)) == ".bin")
+    {
+      return directory + "/" + dir.GetFile(cc);
+    }
+  }
+  return std::string();
+}
+
+bool TestCache(const std::string& xml, const std::string& directory)
+{
+  if (!::CheckParse(xml, directory, false))
+  {
+    vtkLogF(ERROR, "Incorrect first parse.");
+    return false;
+  }
+  const std::string file = ::GetCacheFile(directory);
+  if (file.empty())
+  {
+    vtkLogF(ERROR, "Cache file not written.");
+    return false;
+  }
+  if (!::CheckParse(xml, directory, true))
+  {
+    vtkLogF(ERROR, "Incorrect parse from the cache.");
+    return false;
+  }
+
+  // Other contents do not use the same cache file.
+  if (!::CheckParse(xml + " ", directory, false))
+  {
+    vtkLogF(ERROR, "Cache used for other contents.");
+    return false;
+  }
+
+  // Truncated files are ignored and replaced.
+  const unsigned long length = vtksys::SystemTools::FileLength(file);
+  std::string contents(length / 2, '\0');
+  std::ifstream(file, std::ios::binary).read(&contents[0], contents.size());
+  std::ofstream(file, std::ios::binary | std::ios::trunc).write(contents.data(), contents.size());
+  if (!::CheckParse(xml, directory, false))
+  {
+    vtkLogF(ERROR, "Truncated cache file used.");
+    return false;
+  }
+  if (vtksys::SystemTools::FileLength(file) != length)
+  {
+    vtkLogF(ERROR, "Cache file not replaced.");
+    return false;
+  }
+  if (!::CheckParse(xml, directory, true))
+  {
+    vtkLogF(ERROR, "Replaced cache file not used.");
+    return false;
+  }
+
+  // A file with the same hash and length created from other contents, as
+  // with a hash collision, is ignored and replaced.
+  contents.assign(length, '\0');
+  std::ifstream(file, std::ios::binary).read(&contents[0], contents.size());
+  const size_t position = contents.find(xml);
+  if (position == std::string::npos)
+  {
+    vtkLogF(ERROR, "XML contents not stored in the cache file.");
+    return false;
+  }
+  contents[position + xml.size() / 2] ^= 1;
+  std::ofstream(file, std::ios::binary | std::ios::trunc).write(contents.data(), contents.size());
+  if (!::CheckParse(xml, directory, false))
+  {
+    vtkLogF(ERROR, "Cache file created from other contents used.");
+    return false;
+  }
+  if (!::CheckParse(xml, directory, true))
+  {
+    vtkLogF(ERROR, "Replaced cache file not used.");
+    return false;
+  }
+
+  // Without a directory there is no caching.
+  vtkNew<vtkPVXMLParser> parser;
+  if (!parser->ParseWithCache(xml.c_str(), nullptr) || parser->GetLoadedFromCache())
+  {
+    vtkLogF(ERROR, "Cache used without a directory.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPVXMLParserCache(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string directory = std::string(tempDir) + "/TestPVXMLParserCache";
+  delete[] tempDir;
+  vtksys::SystemTools::RemoveADirectory(directory);
+
+  const bool success = ::TestCache(::CreateXML(100), directory);
+  vtksys::SystemTools::RemoveADirectory(directory);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -8,9 +8,12 @@
 
 vtkStandardNewMacro(vtkPVXMLElement);
 
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #if defined(_WIN32) && !defined(__CYGWIN__)
 #define SNPRINTF _snprintf
@@ -18,6 +21,15 @@ vtkStandardNewMacro(vtkPVXMLElement);
 #define SNPRINTF snprintf
 #endif
 
+namespace
+{
+// Elements with more attributes or nested elements than this use hash tables
+// for lookups.
+constexpr size_t IndexThreshold = 8;
+}
+
+// The hash tables are kept up to date by every method that modifies an
+// element, so that lookups never modify it and can be done concurrently.
 struct vtkPVXMLElementInternals
 {
   std::vector<std::string> AttributeNames;
@@ -25,6 +37,137 @@ struct vtkPVXMLElementInternals
   typedef std::vector<vtkSmartPointer<vtkPVXMLElement>> VectorOfElements;
   VectorOfElements NestedElements;
   std::string CharacterData;
+
+  // Position of the first attribute with each name, when there are more than
+  // IndexThreshold attributes.
+  std::unordered_map<std::string, size_t> AttributeIndex;
+
+  // Positions of the nested elements with each name, and of the first one with
+  // each id, when there are more than IndexThreshold nested elements.
+  std::unordered_map<std::string, std::vector<size_t>> NestedByName;
+  std::unordered_map<std::string, size_t> NestedById;
+
+  // Elements this one is nested in, once per time it was added, so that
+  // their tables can be updated when it is renamed.
+  std::vector<vtkPVXMLElement*> Containers;
+
+  // Returns the position of the first attribute named `name`, or
+  // `AttributeNames.size()` if there is none.
+  size_t FindAttribute(const char* name) const
+  {
+    const size_t numAttributes = this->AttributeNames.size();
+    if (numAttributes <= IndexThreshold)
+    {
+      for (size_t i = 0; i < numAttributes; ++i)
+      {
+        if (strcmp(this->AttributeNames[i].c_str(), name) == 0)
+        {
+          return i;
+        }
+      }
+      return numAttributes;
+    }
+    auto iter = this->AttributeIndex.find(name);
+    return iter != this->AttributeIndex.end() ? iter->second : numAttributes;
+  }
+
+  void BuildAttributeIndex()
+  {
+    this->AttributeIndex.clear();
+    if (this->AttributeNames.size() > IndexThreshold)
+    {
+      for (size_t i = 0; i < this->AttributeNames.size(); ++i)
+      {
+        this->AttributeIndex.emplace(this->AttributeNames[i], i);
+      }
+    }
+  }
+
+  void AddAttribute(const char* name, const char* value)
+  {
+    this->AttributeNames.emplace_back(name);
+    this->AttributeValues.emplace_back(value);
+    if (this->AttributeNames.size() == IndexThreshold + 1)
+    {
+      this->BuildAttributeIndex();
+    }
+    else if (this->AttributeNames.size() > IndexThreshold)
+    {
+      this->AttributeIndex.emplace(name, this->AttributeNames.size() - 1);
+    }
+  }
+
+  void SetAttributes(const std::vector<std::string>& names, const std::vector<std::string>& values)
+  {
+    this->AttributeNames = names;
+    this->AttributeValues = values;
+    this->BuildAttributeIndex();
+  }
+
+  // Returns true if the nested element tables are used.
+  bool HasNestedIndex() const { return this->NestedElements.size() > IndexThreshold; }
+
+  void BuildNestedIndex()
+  {
+    this->NestedByName.clear();
+    this->NestedById.clear();
+    if (this->HasNestedIndex())
+    {
+      for (size_t i = 0; i < this->NestedElements.size(); ++i)
+      {
+        this->IndexNestedElement(i);
+      }
+    }
+  }
+
+  void IndexNestedElement(size_t i)
+  {
+    vtkPVXMLElement* element = this->NestedElements[i];
+    if (element && element->GetName())
+    {
+      this->NestedByName[element->GetName()].push_back(i);
+    }
+    if (element && element->GetId())
+    {
+      this->NestedById.emplace(element->GetId(), i);
+    }
+  }
+
+  void AddNestedElement(vtkPVXMLElement* container, vtkPVXMLElement* element)
+  {
+    this->NestedElements.push_back(element);
+    element->Internal->Containers.push_back(container);
+    if (this->NestedElements.size() == IndexThreshold + 1)
+    {
+      this->BuildNestedIndex();
+    }
+    else if (this->HasNestedIndex())
+    {
+      this->IndexNestedElement(this->NestedElements.size() - 1);
+    }
+  }
+
+  static void RemoveContainer(vtkPVXMLElement* container, vtkPVXMLElement* element)
+  {
+    std::vector<vtkPVXMLElement*>& containers = element->Internal->Containers;
+    auto iter = std::find(containers.begin(), containers.end(), container);
+    if (iter != containers.end())
+    {
+      containers.erase(iter);
+    }
+  }
+
+  // Called when `element` is renamed.
+  static void UpdateContainers(vtkPVXMLElement* element)
+  {
+    for (vtkPVXMLElement* container : element->Internal->Containers)
+    {
+      if (container->Internal->HasNestedIndex())
+      {
+        container->Internal->BuildNestedIndex();
+      }
+    }
+  }
 };
 
 // Function to check if a string is full of whitespace characters.
@@ -40,6 +183,38 @@ static bool vtkIsSpace(const std::string& str)
   return true;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVXMLElement::SetName(const char* name)
+{
+  if (this->Name == name || (this->Name && name && strcmp(this->Name, name) == 0))
+  {
+    return;
+  }
+  delete[] this->Name;
+  this->Name = name ? strcpy(new char[strlen(name) + 1], name) : nullptr;
+  if (this->Internal)
+  {
+    vtkPVXMLElementInternals::UpdateContainers(this);
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLElement::SetId(const char* id)
+{
+  if (this->Id == id || (this->Id && id && strcmp(this->Id, id) == 0))
+  {
+    return;
+  }
+  delete[] this->Id;
+  this->Id = id ? strcpy(new char[strlen(id) + 1], id) : nullptr;
+  if (this->Internal)
+  {
+    vtkPVXMLElementInternals::UpdateContainers(this);
+  }
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 vtkPVXMLElement::vtkPVXMLElement()
 {
@@ -56,6 +231,10 @@ vtkPVXMLElement::~vtkPVXMLElement()
   this->SetName(nullptr);
   this->SetId(nullptr);
 
+  for (auto& element : this->Internal->NestedElements)
+  {
+    vtkPVXMLElementInternals::RemoveContainer(this, element);
+  }
   delete this->Internal;
 }
 
@@ -132,8 +311,7 @@ void vtkPVXMLElement::AddAttribute(const char* attrName, const char* attrValue)
     return;
   }
 
-  this->Internal->AttributeNames.push_back(attrName);
-  this->Internal->AttributeValues.push_back(attrValue);
+  this->Internal->AddAttribute(attrName, attrValue);
 }
 
 //----------------------------------------------------------------------------
@@ -144,16 +322,12 @@ void vtkPVXMLElement::SetAttribute(const char* attrName, const char* attrValue)
     return;
   }
 
-  // iterate over the names, and find if the attribute name exists.
-  size_t numAttributes = this->Internal->AttributeNames.size();
-  size_t i;
-  for (i = 0; i < numAttributes; ++i)
+  // find if the attribute name exists.
+  size_t i = this->Internal->FindAttribute(attrName);
+  if (i < this->Internal->AttributeNames.size())
   {
-    if (strcmp(this->Internal->AttributeNames[i].c_str(), attrName) == 0)
-    {
-      this->Internal->AttributeValues[i] = attrValue;
-      return;
-    }
+    this->Internal->AttributeValues[i] = attrValue;
+    return;
   }
   // add the attribute.
   this->AddAttribute(attrName, attrValue);
@@ -164,6 +338,7 @@ void vtkPVXMLElement::ReadXMLAttributes(const char** atts)
 {
   this->Internal->AttributeNames.clear();
   this->Internal->AttributeValues.clear();
+  this->Internal->BuildAttributeIndex();
 
   if (atts)
   {
@@ -186,7 +361,12 @@ void vtkPVXMLElement::ReadXMLAttributes(const char** atts)
 //----------------------------------------------------------------------------
 void vtkPVXMLElement::RemoveAllNestedElements()
 {
+  for (auto& element : this->Internal->NestedElements)
+  {
+    vtkPVXMLElementInternals::RemoveContainer(this, element);
+  }
   this->Internal->NestedElements.clear();
+  this->Internal->BuildNestedIndex();
 }
 
 //----------------------------------------------------------------------------
@@ -198,7 +378,9 @@ void vtkPVXMLElement::RemoveNestedElement(vtkPVXMLElement* element)
   {
     if (iter->GetPointer() == element)
     {
+      vtkPVXMLElementInternals::RemoveContainer(this, element);
       this->Internal->NestedElements.erase(iter);
+      this->Internal->BuildNestedIndex();
       break;
     }
   }
@@ -212,7 +394,10 @@ void vtkPVXMLElement::ReplaceNestedElement(
   {
     if (elem.GetPointer() == elementToReplace)
     {
+      vtkPVXMLElementInternals::RemoveContainer(this, elementToReplace);
       elem = element;
+      element->Internal->Containers.push_back(this);
+      this->Internal->BuildNestedIndex();
       break;
     }
   }
@@ -231,7 +416,7 @@ void vtkPVXMLElement::AddNestedElement(vtkPVXMLElement* element, int setParent)
   {
     element->SetParent(this);
   }
-  this->Internal->NestedElements.push_back(element);
+  this->Internal->AddNestedElement(this, element);
 }
 
 //----------------------------------------------------------------------------
@@ -243,16 +428,9 @@ void vtkPVXMLElement::AddCharacterData(const char* data, int length)
 //----------------------------------------------------------------------------
 const char* vtkPVXMLElement::GetAttributeOrDefault(const char* name, const char* notFound)
 {
-  size_t numAttributes = this->Internal->AttributeNames.size();
-  size_t i;
-  for (i = 0; i < numAttributes; ++i)
-  {
-    if (strcmp(this->Internal->AttributeNames[i].c_str(), name) == 0)
-    {
-      return this->Internal->AttributeValues[i].c_str();
-    }
-  }
-  return notFound;
+  size_t i = this->Internal->FindAttribute(name);
+  return i < this->Internal->AttributeValues.size() ? this->Internal->AttributeValues[i].c_str()
+                                                     : notFound;
 }
 //----------------------------------------------------------------------------
 const char* vtkPVXMLElement::GetCharacterData()
@@ -260,6 +438,28 @@ const char* vtkPVXMLElement::GetCharacterData()
   return this->Internal->CharacterData.c_str();
 }
 
+//----------------------------------------------------------------------------
+unsigned int vtkPVXMLElement::GetNumberOfAttributes()
+{
+  return static_cast<unsigned int>(this->Internal->AttributeNames.size());
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElement::GetAttributeName(unsigned int index)
+{
+  return index < this->Internal->AttributeNames.size()
+    ? this->Internal->AttributeNames[index].c_str()
+    : nullptr;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElement::GetAttributeValue(unsigned int index)
+{
+  return index < this->Internal->AttributeValues.size()
+    ? this->Internal->AttributeValues[index].c_str()
+    : nullptr;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVXMLElement::PrintXML()
 {
@@ -352,6 +552,13 @@ vtkPVXMLElement* vtkPVXMLElement::LookupElement(const char* id)
 //----------------------------------------------------------------------------
 vtkPVXMLElement* vtkPVXMLElement::FindNestedElement(const char* id)
 {
+  if (this->Internal->HasNestedIndex())
+  {
+    auto iter = this->Internal->NestedById.find(id);
+    return iter != this->Internal->NestedById.end()
+      ? this->Internal->NestedElements[iter->second].GetPointer()
+      : nullptr;
+  }
   size_t numberOfNestedElements = this->Internal->NestedElements.size();
   size_t i;
   for (i = 0; i < numberOfNestedElements; ++i)
@@ -368,6 +575,13 @@ vtkPVXMLElement* vtkPVXMLElement::FindNestedElement(const char* id)
 //----------------------------------------------------------------------------
 vtkPVXMLElement* vtkPVXMLElement::FindNestedElementByName(const char* name)
 {
+  if (name && this->Internal->HasNestedIndex())
+  {
+    auto iter = this->Internal->NestedByName.find(name);
+    return iter != this->Internal->NestedByName.end()
+      ? this->Internal->NestedElements[iter->second.front()].GetPointer()
+      : nullptr;
+  }
   vtkPVXMLElementInternals::VectorOfElements::iterator iter =
     this->Internal->NestedElements.begin();
   for (; iter != this->Internal->NestedElements.end(); ++iter)
@@ -555,12 +769,26 @@ void vtkPVXMLElement::GetElementsByName(const char* name, vtkCollection* element
 
   unsigned int numChildren = this->GetNumberOfNestedElements();
   unsigned int cc;
-  for (cc = 0; cc < numChildren; cc++)
+  if (this->Internal->HasNestedIndex())
   {
-    vtkPVXMLElement* child = this->GetNestedElement(cc);
-    if (child && child->GetName() && strcmp(child->GetName(), name) == 0)
+    auto iter = this->Internal->NestedByName.find(name);
+    if (iter != this->Internal->NestedByName.end())
     {
-      elements->AddItem(child);
+      for (size_t i : iter->second)
+      {
+        elements->AddItem(this->Internal->NestedElements[i]);
+      }
+    }
+  }
+  else
+  {
+    for (cc = 0; cc < numChildren; cc++)
+    {
+      vtkPVXMLElement* child = this->GetNestedElement(cc);
+      if (child && child->GetName() && strcmp(child->GetName(), name) == 0)
+      {
+        elements->AddItem(child);
+      }
     }
   }
 
@@ -653,17 +881,13 @@ void vtkPVXMLElement::Merge(vtkPVXMLElement* element, const char* attributeName)
 
   for (size_t i = 0; i < numAttributes; ++i)
   {
-    bool found = false;
-    for (size_t j = 0; !found && j < numAttributes2; ++j)
+    size_t j = this->Internal->FindAttribute(element->Internal->AttributeNames[i].c_str());
+    if (j < numAttributes2)
     {
-      if (element->Internal->AttributeNames[i] == this->Internal->AttributeNames[j])
-      {
-        this->Internal->AttributeValues[j] = element->Internal->AttributeValues[i];
-        found = true;
-      }
+      this->Internal->AttributeValues[j] = element->Internal->AttributeValues[i];
     }
     // if not found, add it
-    if (!found)
+    else
     {
       this->AddAttribute(element->Internal->AttributeNames[i].c_str(),
         element->Internal->AttributeValues[i].c_str());
@@ -697,8 +921,8 @@ void vtkPVXMLElement::Merge(vtkPVXMLElement* element, const char* attributeName)
       vtkSmartPointer<vtkPVXMLElement> newElement = vtkSmartPointer<vtkPVXMLElement>::New();
       newElement->SetName((*iter)->GetName());
       newElement->SetId((*iter)->GetId());
-      newElement->Internal->AttributeNames = (*iter)->Internal->AttributeNames;
-      newElement->Internal->AttributeValues = (*iter)->Internal->AttributeValues;
+      newElement->Internal->SetAttributes(
+        (*iter)->Internal->AttributeNames, (*iter)->Internal->AttributeValues);
       this->AddNestedElement(newElement);
       newElement->Merge(*iter, attributeName);
     }
@@ -710,8 +934,7 @@ void vtkPVXMLElement::CopyTo(vtkPVXMLElement* other)
 {
   other->SetName(GetName());
   other->SetId(GetId());
-  other->Internal->AttributeNames = this->Internal->AttributeNames;
-  other->Internal->AttributeValues = this->Internal->AttributeValues;
+  other->Internal->SetAttributes(this->Internal->AttributeNames, this->Internal->AttributeValues);
   other->AddCharacterData(
     this->Internal->CharacterData.c_str(), static_cast<int>(this->Internal->CharacterData.size()));
 
@@ -731,8 +954,7 @@ void vtkPVXMLElement::CopyAttributesTo(vtkPVXMLElement* other)
 {
   other->SetName(GetName());
   other->SetId(GetId());
-  other->Internal->AttributeNames = this->Internal->AttributeNames;
-  other->Internal->AttributeValues = this->Internal->AttributeValues;
+  other->Internal->SetAttributes(this->Internal->AttributeNames, this->Internal->AttributeValues);
   other->AddCharacterData(
     this->Internal->CharacterData.c_str(), static_cast<int>(this->Internal->CharacterData.size()));
 }
@@ -766,6 +988,7 @@ void vtkPVXMLElement::RemoveAttribute(const char* name)
     {
       this->Internal->AttributeNames.erase(nameIterator);
       this->Internal->AttributeValues.erase(valueIterator);
+      this->Internal->BuildAttributeIndex();
       return;
     }
     nameIterator++;
@@ -5,6 +5,11 @@
  *
  * This is used by vtkPVXMLParser to represent an XML document starting
  * at the root element.
+ *
+ * Looking up attributes by name and nested elements by name or id is done
+ * using hash tables once an element has more than a few of them. The tables
+ * are updated when the element or its nested elements change, never during a
+ * lookup, so that an element can be read from several threads at once.
  */
 
 #ifndef vtkPVXMLElement_h
@@ -32,7 +37,7 @@ public:
    * Set/Get the name of the element.  This is its XML tag.
    * (\c \<Name/\>).
    */
-  vtkSetStringMacro(Name);
+  virtual void SetName(const char* name);
   vtkGetStringMacro(Name);
   ///@}
 
@@ -70,6 +75,16 @@ public:
    */
   const char* GetCharacterData();
 
+  ///@{
+  /**
+   * Access the attributes of the element by index, in the order in which they
+   * were added. Returns nullptr if `index` is out of range.
+   */
+  unsigned int GetNumberOfAttributes();
+  const char* GetAttributeName(unsigned int index);
+  const char* GetAttributeValue(unsigned int index);
+  ///@}
+
   ///@{
   /**
    * Get the attribute with the given name converted to a scalar
@@ -264,7 +279,7 @@ protected:
   vtkPVXMLElement* Parent;
 
   // Method used by vtkPVXMLParser to setup the element.
-  vtkSetStringMacro(Id);
+  virtual void SetId(const char* id);
   void ReadXMLAttributes(const char** atts);
   void AddCharacterData(const char* data, int length);
 
@@ -274,6 +289,7 @@ protected:
   void SetParent(vtkPVXMLElement* parent);
 
   friend class vtkPVXMLParser;
+  friend struct vtkPVXMLElementInternals;
 
 private:
   vtkPVXMLElement(const vtkPVXMLElement&) = delete;
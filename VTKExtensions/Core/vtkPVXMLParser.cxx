@@ -5,10 +5,97 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVXMLElement.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkPVXMLParser);
 
+namespace
+{
+// Bump when the layout of the cache files changes.
+constexpr vtkTypeUInt32 CacheVersion = 2;
+constexpr char CacheMagic[8] = { 'P', 'V', 'X', 'M', 'L', 'B', '\0', '\0' };
+
+// 64-bit FNV-1a hash of the XML contents, used to name the cache files.
+vtkTypeUInt64 HashContents(const char* data, size_t length)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ull;
+  for (size_t cc = 0; cc < length; ++cc)
+  {
+    hash ^= static_cast<unsigned char>(data[cc]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+template <typename T>
+void Write(std::string& buffer, T value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Bounds-checked reads from a cache file.
+class Reader
+{
+public:
+  Reader(const std::string& buffer)
+    : Position(buffer.data())
+    , End(buffer.data() + buffer.size())
+  {
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (static_cast<size_t>(this->End - this->Position) < sizeof(T))
+    {
+      return false;
+    }
+    std::memcpy(&value, this->Position, sizeof(T));
+    this->Position += sizeof(T);
+    return true;
+  }
+
+  bool Read(std::string& value, size_t length)
+  {
+    if (static_cast<size_t>(this->End - this->Position) < length)
+    {
+      return false;
+    }
+    value.assign(this->Position, length);
+    this->Position += length;
+    return true;
+  }
+
+  // Returns true if the next `length` bytes are `data`.
+  bool Compare(const char* data, size_t length)
+  {
+    if (static_cast<size_t>(this->End - this->Position) < length ||
+      std::memcmp(this->Position, data, length) != 0)
+    {
+      return false;
+    }
+    this->Position += length;
+    return true;
+  }
+
+  bool AtEnd() const { return this->Position == this->End; }
+
+private:
+  const char* Position;
+  const char* End;
+};
+}
+
 //----------------------------------------------------------------------------
 vtkPVXMLParser::vtkPVXMLParser()
 {
@@ -153,6 +240,216 @@ void vtkPVXMLParser::ReportXmlParseError()
   }
 }
 
+//-----------------------------------------------------------------------------
+int vtkPVXMLParser::ParseWithCache(const char* xmlContents, const char* cacheDirectory)
+{
+  this->LoadedFromCache = false;
+  if (!xmlContents || !cacheDirectory || !*cacheDirectory)
+  {
+    return this->Parse(xmlContents);
+  }
+
+  const size_t length = strlen(xmlContents);
+  const vtkTypeUInt64 hash = ::HashContents(xmlContents, length);
+  std::ostringstream name;
+  name << "pvxml-" << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+  const std::string path = std::string(cacheDirectory) + "/" + name.str();
+
+  std::ifstream input(path, std::ios::in | std::ios::binary);
+  if (input)
+  {
+    std::ostringstream contents;
+    contents << input.rdbuf();
+    if (this->ReadBinary(contents.str(), xmlContents, length, hash))
+    {
+      vtkDebugMacro("Read parsed XML from cache file " << path);
+      this->LoadedFromCache = true;
+      return 1;
+    }
+    vtkDebugMacro("Ignoring invalid cache file " << path);
+  }
+  input.close();
+
+  if (!this->Parse(xmlContents))
+  {
+    return 0;
+  }
+
+  // Write to a temporary file first so that processes starting concurrently
+  // never read a partially written cache file.
+  std::string buffer;
+  vtkPVXMLParser::WriteBinary(this->RootElement, xmlContents, length, hash, buffer);
+  std::ostringstream temporary;
+  temporary << path << "." << std::hex << std::random_device{}() << ".tmp";
+  vtksys::SystemTools::MakeDirectory(cacheDirectory);
+  std::ofstream output(temporary.str(), std::ios::out | std::ios::binary);
+  const bool written = output && output.write(buffer.data(), buffer.size()) && output.flush();
+  output.close();
+  if (!written || !vtksys::SystemTools::RenameFile(temporary.str(), path))
+  {
+    vtkDebugMacro("Failed to write cache file " << path);
+    vtksys::SystemTools::RemoveFile(temporary.str());
+  }
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVXMLParser::WriteBinary(vtkPVXMLElement* root, const char* xmlContents,
+  vtkTypeUInt64 length, vtkTypeUInt64 hash, std::string& buffer)
+{
+  // Names, ids and attributes are highly repetitive, so all the strings are
+  // stored once in a table and referenced by their index.
+  std::vector<const std::string*> strings;
+  std::unordered_map<std::string, vtkTypeUInt32> indices;
+  std::string elements;
+  auto writeString = [&](const char* str) {
+    auto inserted =
+      indices.emplace(str ? str : "", static_cast<vtkTypeUInt32>(indices.size()));
+    if (inserted.second)
+    {
+      strings.push_back(&inserted.first->first);
+    }
+    ::Write(elements, inserted.first->second);
+  };
+
+  // Elements are written in pre-order, each followed by its number of nested
+  // elements.
+  std::vector<vtkPVXMLElement*> stack(1, root);
+  while (!stack.empty())
+  {
+    vtkPVXMLElement* element = stack.back();
+    stack.pop_back();
+    writeString(element->GetName());
+    writeString(element->GetId());
+    const unsigned int numberOfAttributes = element->GetNumberOfAttributes();
+    ::Write(elements, static_cast<vtkTypeUInt32>(numberOfAttributes));
+    for (unsigned int cc = 0; cc < numberOfAttributes; ++cc)
+    {
+      writeString(element->GetAttributeName(cc));
+      writeString(element->GetAttributeValue(cc));
+    }
+    writeString(element->GetCharacterData());
+    const unsigned int numberOfNested = element->GetNumberOfNestedElements();
+    ::Write(elements, static_cast<vtkTypeUInt32>(numberOfNested));
+    for (unsigned int cc = numberOfNested; cc > 0; --cc)
+    {
+      stack.push_back(element->GetNestedElement(cc - 1));
+    }
+  }
+
+  buffer.assign(CacheMagic, sizeof(CacheMagic));
+  ::Write(buffer, CacheVersion);
+  ::Write(buffer, static_cast<vtkTypeUInt32>(strings.size()));
+  ::Write(buffer, hash);
+  ::Write(buffer, length);
+  // The XML contents are stored so that the cache is only used for the exact
+  // contents it was created from, not for others with the same hash.
+  buffer.append(xmlContents, length);
+  for (const std::string* str : strings)
+  {
+    ::Write(buffer, static_cast<vtkTypeUInt32>(str->size()));
+    buffer.append(*str);
+  }
+  buffer.append(elements);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVXMLParser::ReadBinary(
+  const std::string& buffer, const char* xmlContents, vtkTypeUInt64 length, vtkTypeUInt64 hash)
+{
+  ::Reader reader(buffer);
+  std::string magic;
+  vtkTypeUInt32 version, numberOfStrings;
+  vtkTypeUInt64 fileHash, fileLength;
+  if (!reader.Read(magic, sizeof(CacheMagic)) ||
+    magic != std::string(CacheMagic, sizeof(CacheMagic)) || !reader.Read(version) ||
+    version != CacheVersion || !reader.Read(numberOfStrings) || !reader.Read(fileHash) ||
+    fileHash != hash || !reader.Read(fileLength) || fileLength != length ||
+    !reader.Compare(xmlContents, length))
+  {
+    return false;
+  }
+
+  std::vector<std::string> strings;
+  for (vtkTypeUInt32 cc = 0; cc < numberOfStrings; ++cc)
+  {
+    vtkTypeUInt32 size;
+    std::string str;
+    if (!reader.Read(size) || !reader.Read(str, size))
+    {
+      return false;
+    }
+    strings.push_back(std::move(str));
+  }
+  auto readString = [&](const std::string*& str) {
+    vtkTypeUInt32 index;
+    if (!reader.Read(index) || index >= strings.size())
+    {
+      return false;
+    }
+    str = &strings[index];
+    return true;
+  };
+
+  // The stack holds the elements being read along with the number of nested
+  // elements they are still missing.
+  vtkSmartPointer<vtkPVXMLElement> root;
+  std::vector<std::pair<vtkPVXMLElement*, vtkTypeUInt32>> stack;
+  do
+  {
+    const std::string *name, *id, *characterData;
+    vtkTypeUInt32 numberOfAttributes, numberOfNested;
+    if (!readString(name) || !readString(id) || !reader.Read(numberOfAttributes))
+    {
+      return false;
+    }
+    auto element = vtkSmartPointer<vtkPVXMLElement>::New();
+    element->SetName(name->c_str());
+    element->SetId(id->c_str());
+    for (vtkTypeUInt32 cc = 0; cc < numberOfAttributes; ++cc)
+    {
+      const std::string *attributeName, *attributeValue;
+      if (!readString(attributeName) || !readString(attributeValue))
+      {
+        return false;
+      }
+      element->AddAttribute(attributeName->c_str(), attributeValue->c_str());
+    }
+    if (!readString(characterData) || !reader.Read(numberOfNested))
+    {
+      return false;
+    }
+    element->AddCharacterData(characterData->c_str(), static_cast<int>(characterData->size()));
+
+    if (stack.empty())
+    {
+      root = element;
+    }
+    else
+    {
+      stack.back().first->AddNestedElement(element);
+      --stack.back().second;
+    }
+    stack.emplace_back(element, numberOfNested);
+    while (!stack.empty() && stack.back().second == 0)
+    {
+      stack.pop_back();
+    }
+  } while (!stack.empty());
+
+  if (!reader.AtEnd())
+  {
+    return false;
+  }
+  if (this->RootElement)
+  {
+    this->RootElement->Delete();
+  }
+  this->RootElement = root;
+  this->RootElement->Register(this);
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 vtkSmartPointer<vtkPVXMLElement> vtkPVXMLParser::ParseXML(
   const char* xmlcontents, bool suppress_errors)
@@ -14,6 +14,8 @@
 #include "vtkSmartPointer.h"              // needed for vtkSmartPointer.
 #include "vtkXMLParser.h"
 
+#include <string> // for std::string
+
 class vtkPVXMLElement;
 
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVXMLParser : public vtkXMLParser
@@ -52,6 +54,29 @@ public:
   static vtkSmartPointer<vtkPVXMLElement> ParseXML(
     const char* xmlcontents, bool suppress_errors = false);
 
+  /**
+   * Parse `xmlContents` like `Parse(const char*)`, using a binary cache of the
+   * parsed element tree stored in `cacheDirectory`. The cache file is named
+   * after a hash of `xmlContents` and also stores `xmlContents`: if it exists,
+   * is valid and was created from the same contents, the element tree is read
+   * from it instead of parsing the XML, otherwise the XML is parsed and the
+   * cache file is written for the next time. Failing to read or write the
+   * cache is not an error. If `cacheDirectory` is nullptr or empty, this is
+   * the same as `Parse(xmlContents)`.
+   *
+   * Comparing the contents protects against stale files and hash collisions,
+   * not against tampering: anyone who can write to `cacheDirectory` can
+   * change the element trees that are loaded. Only use a directory that is
+   * writable by trusted users, as for plugin directories.
+   */
+  int ParseWithCache(const char* xmlContents, const char* cacheDirectory);
+
+  /**
+   * Returns true if the element tree was read from the cache by the last call
+   * to `ParseWithCache`.
+   */
+  vtkGetMacro(LoadedFromCache, bool);
+
 protected:
   vtkPVXMLParser();
   ~vtkPVXMLParser() override;
@@ -84,6 +109,17 @@ protected:
   // Overridden to implement the SuppressErrorMessages feature.
   void ReportXmlParseError() override;
 
+  // Set when ParseWithCache reads the element tree from the cache.
+  bool LoadedFromCache = false;
+
+  // Serialize the element tree rooted at `root` along with the XML contents it
+  // was parsed from, and read it back into RootElement if the buffer was
+  // created from the same XML contents.
+  static void WriteBinary(vtkPVXMLElement* root, const char* xmlContents, vtkTypeUInt64 length,
+    vtkTypeUInt64 hash, std::string& buffer);
+  bool ReadBinary(const std::string& buffer, const char* xmlContents, vtkTypeUInt64 length,
+    vtkTypeUInt64 hash);
+
 private:
   vtkPVXMLParser(const vtkPVXMLParser&) = delete;
   void operator=(const vtkPVXMLParser&) = delete;
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVArrayCalculator.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+// Points on a regular grid with a vector field `V`, a scalar field `s` in
+// [0, 1] and a vector field `Gradient`.
+vtkSmartPointer<vtkPolyData> CreateData(int dimension)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> v;
+  v->SetName("V");
+  v->SetNumberOfComponents(3);
+  vtkNew<vtkFloatArray> s;
+  s->SetName("s");
+  vtkNew<vtkFloatArray> gradient;
+  gradient->SetName("Gradient");
+  gradient->SetNumberOfComponents(3);
+
+  const double spacing = 1.0 / dimension;
+  for (int k = 0; k < dimension; ++k)
+  {
+    for (int j = 0; j < dimension; ++j)
+    {
+      for (int i = 0; i < dimension; ++i)
+      {
+        const double x = i * spacing, y = j * spacing, z = k * spacing;
+        points->InsertNextPoint(x, y, z);
+        v->InsertNextTuple3(std::sin(6 * x), std::cos(4 * y) * z, x - y);
+        s->InsertNextValue(static_cast<float>(0.5 + 0.5 * std::sin(10 * x * y + z)));
+        gradient->InsertNextTuple3(y * z, x * z - 0.5, x * y);
+      }
+    }
+  }
+
+  auto data = vtkSmartPointer<vtkPolyData>::New();
+  data->SetPoints(points);
+  data->GetPointData()->AddArray(v);
+  data->GetPointData()->AddArray(s);
+  data->GetPointData()->AddArray(gradient);
+  return data;
+}
+
+vtkSmartPointer<vtkDataArray> Evaluate(vtkPolyData* data, const std::string& function,
+  bool compiled, int resultType = VTK_DOUBLE)
+{
+  vtkNew<vtkPVArrayCalculator> calculator;
+  calculator->SetInputData(data);
+  calculator->SetFunctionParserTypeFromInt(vtkArrayCalculator::EXPRTK);
+  calculator->SetFunction(function.c_str());
+  calculator->SetResultArrayName("Result");
+  calculator->SetResultArrayType(resultType);
+  calculator->ReplaceInvalidValuesOn();
+  calculator->SetReplacementValue(-1.0);
+  calculator->SetUseCompiledExpressions(compiled);
+  calculator->Update();
+  auto output = vtkPolyData::SafeDownCast(calculator->GetOutput());
+  return output ? output->GetPointData()->GetArray("Result") : nullptr;
+}
+
+bool TestExpression(vtkPolyData* data, const std::string& function, int resultType = VTK_DOUBLE)
+{
+  auto expected = ::Evaluate(data, function, false, resultType);
+  auto result = ::Evaluate(data, function, true, resultType);
+  if (expected == nullptr || result == nullptr)
+  {
+    vtkLogF(ERROR, "Missing result for '%s'.", function.c_str());
+    return false;
+  }
+  if (result->GetDataType() != expected->GetDataType())
+  {
+    vtkLogF(ERROR, "Incorrect type for '%s'.", function.c_str());
+    return false;
+  }
+  if (result->GetNumberOfComponents() != expected->GetNumberOfComponents() ||
+    result->GetNumberOfTuples() != expected->GetNumberOfTuples())
+  {
+    vtkLogF(ERROR, "Incorrect size for '%s'.", function.c_str());
+    return false;
+  }
+  for (vtkIdType tuple = 0; tuple < result->GetNumberOfTuples(); ++tuple)
+  {
+    for (int comp = 0; comp < result->GetNumberOfComponents(); ++comp)
+    {
+      const double a = expected->GetComponent(tuple, comp);
+      const double b = result->GetComponent(tuple, comp);
+      if (std::abs(a - b) > 1e-10 * std::max(1.0, std::abs(a)))
+      {
+        vtkLogF(ERROR, "'%s' at %lld: expected %g, got %g.", function.c_str(),
+          static_cast<long long>(tuple), a, b);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPVArrayCalculatorCompiled(int, char*[])
+{
+  auto data = ::CreateData(24);
+  const char* functions[] = { "sqrt(V_X^2 + V_Y^2 + V_Z^2)", "mag(Gradient)",
+    "if(s > 0.5, s * 2, -s)", "s > 0.25 and s < 0.75 ? ln(s) : exp(-s)",
+    "norm(V) * s + cross(V, Gradient) - 2 * coords",
+    "dot(V, iHat) + min(s, 0.5, coordsX) / max(abs(V_Y), 1) - Gradient_Y^-2",
+    "ln(s - 0.5) + log10(\"s\") * atan(coordsZ)",
+    // not compiled, these are evaluated by the parser in both cases.
+    "s == 0.5", "s^2^3", "-s^2 + V_X" };
+  bool success = true;
+  for (const char* function : functions)
+  {
+    success &= ::TestExpression(data, function);
+  }
+  success &= ::TestExpression(data, "mag(V) * 100", VTK_INT);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBoundingBox.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkOctreePointLocator.h"
+#include "vtkPVGlyphFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <set>
+
+// Gives access to the locator cached by the filter.
+class vtkTestGlyphFilter : public vtkPVGlyphFilter
+{
+public:
+  static vtkTestGlyphFilter* New();
+  vtkTypeMacro(vtkTestGlyphFilter, vtkPVGlyphFilter);
+  using vtkPVGlyphFilter::GetCachedLocator;
+
+protected:
+  vtkTestGlyphFilter() = default;
+  ~vtkTestGlyphFilter() override = default;
+
+private:
+  vtkTestGlyphFilter(const vtkTestGlyphFilter&) = delete;
+  void operator=(const vtkTestGlyphFilter&) = delete;
+};
+vtkStandardNewMacro(vtkTestGlyphFilter);
+
+namespace
+{
+// Random points in [-1, 1] x [-1, 2] x [-1, 3].
+vtkSmartPointer<vtkPoints> CreatePoints(vtkIdType numberOfPoints, int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numberOfPoints);
+  for (vtkIdType cc = 0; cc < numberOfPoints; ++cc)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      random->Next();
+      x[i] = random->GetRangeValue(-1.0, 1.0 + i);
+    }
+    points->SetPoint(cc, x);
+  }
+  return points;
+}
+
+// Random points with an `Ids` array holding the point ids and a `Scale` array.
+vtkSmartPointer<vtkPolyData> CreateData(vtkIdType numberOfPoints)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkDoubleArray> scale;
+  scale->SetName("Scale");
+  scale->SetNumberOfTuples(numberOfPoints);
+  for (vtkIdType cc = 0; cc < numberOfPoints; ++cc)
+  {
+    ids->SetValue(cc, cc);
+    scale->SetValue(cc, 1.0 + cc % 7);
+  }
+
+  auto data = vtkSmartPointer<vtkPolyData>::New();
+  data->SetPoints(::CreatePoints(numberOfPoints, 42));
+  data->GetPointData()->AddArray(ids);
+  data->GetPointData()->AddArray(scale);
+  return data;
+}
+
+// The serial sampling with an octree, as done before the locator was cached.
+std::set<vtkIdType> ReferenceSample(vtkPolyData* data, int numberOfSamples, int seed)
+{
+  vtkBoundingBox bounds(data->GetBounds());
+  double l[3];
+  bounds.GetLengths(l);
+  const int dim = (l[0] > 0.0 && l[1] > 0.0 && l[2] > 0.0) ? 3 : 2;
+  const double volume = std::pow(bounds.GetDiagonalLength(), dim);
+  const double radius = volume > 0.0 ? std::pow(volume / numberOfSamples, 1.0 / dim) / 2.0 : 0.0001;
+
+  vtkNew<vtkOctreePointLocator> locator;
+  locator->SetDataSet(data);
+  locator->BuildLocator();
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  std::set<vtkIdType> pointIds;
+  for (int cc = 0; cc < numberOfSamples; ++cc)
+  {
+    double x[3], dist2;
+    for (int i = 0; i < 3; ++i)
+    {
+      random->Next();
+      x[i] = random->GetRangeValue(bounds.GetMinPoint()[i], bounds.GetMaxPoint()[i]);
+    }
+    vtkIdType ptId = locator->FindClosestPointWithinRadius(radius, x, dist2);
+    if (ptId >= 0)
+    {
+      pointIds.insert(ptId);
+    }
+  }
+  return pointIds;
+}
+
+std::set<vtkIdType> GetGlyphedIds(vtkPolyData* output)
+{
+  std::set<vtkIdType> pointIds;
+  vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("Ids"));
+  for (vtkIdType cc = 0; ids && cc < ids->GetNumberOfTuples(); ++cc)
+  {
+    pointIds.insert(ids->GetValue(cc));
+  }
+  return pointIds;
+}
+
+// Glyphs the data with a new filter, so that no cached locator is used.
+vtkSmartPointer<vtkPolyData> Glyph(vtkPolyData* data, int numberOfSamples)
+{
+  vtkNew<vtkPVGlyphFilter> glyph;
+  glyph->SetInputData(data);
+  glyph->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Scale");
+  glyph->SetGlyphMode(vtkPVGlyphFilter::SPATIALLY_UNIFORM_DISTRIBUTION);
+  glyph->SetMaximumNumberOfSamplePoints(numberOfSamples);
+  glyph->SetSeed(3);
+  glyph->Update();
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+  output->DeepCopy(glyph->GetOutput());
+  return output;
+}
+
+bool TestSampling(vtkIdType numberOfPoints, int numberOfSamples)
+{
+  auto data = ::CreateData(numberOfPoints);
+  vtkNew<vtkTestGlyphFilter> glyph;
+  glyph->SetInputData(data);
+  glyph->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Scale");
+  glyph->SetGlyphMode(vtkPVGlyphFilter::SPATIALLY_UNIFORM_DISTRIBUTION);
+  glyph->SetMaximumNumberOfSamplePoints(numberOfSamples);
+  glyph->SetSeed(3);
+
+  glyph->Update();
+  const std::set<vtkIdType> expected = ::ReferenceSample(data, numberOfSamples, 3);
+  if (expected.empty())
+  {
+    vtkLogF(ERROR, "No points sampled.");
+    return false;
+  }
+  if (::GetGlyphedIds(glyph->GetOutput()) != expected)
+  {
+    vtkLogF(ERROR, "Incorrect glyphed points.");
+    return false;
+  }
+  vtkSmartPointer<vtkStaticPointLocator> locator = glyph->GetCachedLocator(0);
+  if (!locator)
+  {
+    vtkLogF(ERROR, "No cached locator.");
+    return false;
+  }
+  const vtkMTimeType buildTime = locator->GetBuildTime();
+
+  // Only glyph parameters change, the cached locator is used without being built again.
+  glyph->SetScaleFactor(2.0);
+  glyph->Update();
+  if (::GetGlyphedIds(glyph->GetOutput()) != expected)
+  {
+    vtkLogF(ERROR, "Incorrect glyphed points after changing the scale factor.");
+    return false;
+  }
+  if (glyph->GetCachedLocator(0) != locator || locator->GetBuildTime() != buildTime)
+  {
+    vtkLogF(ERROR, "Locator built again after changing the scale factor.");
+    return false;
+  }
+
+  // Changing the points of the same dataset must not use the cached locator.
+  data->SetPoints(::CreatePoints(numberOfPoints, 7));
+  glyph->Update();
+  if (::GetGlyphedIds(glyph->GetOutput()) != ::ReferenceSample(data, numberOfSamples, 3))
+  {
+    vtkLogF(ERROR, "Incorrect glyphed points after changing the input.");
+    return false;
+  }
+  vtkStaticPointLocator* newLocator = glyph->GetCachedLocator(0);
+  if (!newLocator || (newLocator == locator && locator->GetBuildTime() == buildTime))
+  {
+    vtkLogF(ERROR, "Cached locator used after changing the input.");
+    return false;
+  }
+  return true;
+}
+
+// The sampling runs with vtkSMPTools, the output must not depend on the number
+// of threads.
+bool TestThreads(vtkIdType numberOfPoints, int numberOfSamples)
+{
+  auto data = ::CreateData(numberOfPoints);
+  vtkSmartPointer<vtkPolyData> serial;
+  vtkSMPTools::LocalScope(
+    vtkSMPTools::Config{ 1 }, [&]() { serial = ::Glyph(data, numberOfSamples); });
+
+  for (int numberOfThreads : { 2, 8 })
+  {
+    vtkSmartPointer<vtkPolyData> threaded;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+      [&]() { threaded = ::Glyph(data, numberOfSamples); });
+    if (::GetGlyphedIds(threaded) != ::GetGlyphedIds(serial) ||
+      threaded->GetNumberOfPoints() != serial->GetNumberOfPoints() ||
+      threaded->GetNumberOfCells() != serial->GetNumberOfCells())
+    {
+      vtkLogF(ERROR, "Different glyphs with %d threads.", numberOfThreads);
+      return false;
+    }
+    for (vtkIdType ptId = 0; ptId < serial->GetNumberOfPoints(); ++ptId)
+    {
+      double expectedX[3], x[3];
+      serial->GetPoint(ptId, expectedX);
+      threaded->GetPoint(ptId, x);
+      if (x[0] != expectedX[0] || x[1] != expectedX[1] || x[2] != expectedX[2])
+      {
+        vtkLogF(ERROR, "Different glyph point %lld with %d threads.",
+          static_cast<long long>(ptId), numberOfThreads);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPVGlyphFilterSpatialSampling(int, char*[])
+{
+  const bool success = ::TestSampling(20000, 500) && ::TestThreads(20000, 500);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
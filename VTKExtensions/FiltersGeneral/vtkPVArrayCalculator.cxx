@@ -12,8 +12,12 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVArrayCalculatorKernel.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
 #include <algorithm>
@@ -21,6 +25,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -268,11 +273,181 @@ int vtkPVArrayCalculator::RequestData(
   assert(this->GetMTime() == mtime && "post: mtime cannot be changed in RequestData()");
   (void)mtime;
 
+  if (this->ExecuteCompiled(input, vtkDataObject::GetData(outputVector, 0)))
+  {
+    return 1;
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
+// ----------------------------------------------------------------------------
+bool vtkPVArrayCalculator::ExecuteCompiled(vtkDataObject* input, vtkDataObject* output)
+{
+  const char* function = this->GetFunction();
+  const char* resultArrayName = this->GetResultArrayName();
+  if (!this->UseCompiledExpressions || !output ||
+    this->GetFunctionParserType() != vtkArrayCalculator::EXPRTK || !function || !*function ||
+    !resultArrayName || !*resultArrayName || this->GetCoordinateResults() ||
+    this->GetResultNormals() || this->GetResultTCoords())
+  {
+    return false;
+  }
+
+  vtkPVArrayCalculatorKernel kernel;
+  for (int cc = 0; cc < this->GetNumberOfCoordinateScalarArrays(); ++cc)
+  {
+    kernel.AddScalarVariable(this->GetCoordinateScalarVariableName(cc), std::string(),
+      this->GetSelectedCoordinateScalarComponent(cc), true);
+  }
+  for (int cc = 0; cc < this->GetNumberOfCoordinateVectorArrays(); ++cc)
+  {
+    kernel.AddVectorVariable(this->GetCoordinateVectorVariableName(cc), std::string(),
+      this->GetSelectedCoordinateVectorComponents(cc).GetData(), true);
+  }
+  for (int cc = 0; cc < this->GetNumberOfScalarArrays(); ++cc)
+  {
+    kernel.AddScalarVariable(this->GetScalarVariableName(cc), this->GetScalarArrayName(cc),
+      this->GetSelectedScalarComponent(cc), false);
+  }
+  for (int cc = 0; cc < this->GetNumberOfVectorArrays(); ++cc)
+  {
+    kernel.AddVectorVariable(this->GetVectorVariableName(cc), this->GetVectorArrayName(cc),
+      this->GetSelectedVectorComponents(cc).GetData(), false);
+  }
+  if (!kernel.Compile(function))
+  {
+    vtkDebugMacro("Expression not supported by the compiled evaluation: " << function);
+    return false;
+  }
+
+  // Find the arrays to evaluate each block from, before producing any output
+  // so that the superclass can still be used if one of them is not supported.
+  struct Block
+  {
+    vtkDataObject* Input;
+    int AttributeType;
+    vtkIdType NumberOfTuples;
+    std::vector<vtkDataArray*> Arrays;
+  };
+  std::vector<Block> blocks;
+  auto inputCD = vtkCompositeDataSet::SafeDownCast(input);
+  auto outputCD = vtkCompositeDataSet::SafeDownCast(output);
+  vtkSmartPointer<vtkCompositeDataIterator> cdIter;
+  if (inputCD)
+  {
+    if (!outputCD)
+    {
+      return false;
+    }
+    cdIter.TakeReference(inputCD->NewIterator());
+    cdIter->SkipEmptyNodesOn();
+    for (cdIter->InitTraversal(); !cdIter->IsDoneWithTraversal(); cdIter->GoToNextItem())
+    {
+      blocks.push_back(Block{ cdIter->GetCurrentDataObject(), 0, 0, {} });
+    }
+  }
+  else
+  {
+    blocks.push_back(Block{ input, 0, 0, {} });
+  }
+
+  for (auto& block : blocks)
+  {
+    if (!vtkDataSet::SafeDownCast(block.Input) && !vtkGraph::SafeDownCast(block.Input) &&
+      !vtkTable::SafeDownCast(block.Input))
+    {
+      return false;
+    }
+    block.AttributeType = this->GetAttributeTypeFromInput(block.Input);
+    vtkDataSetAttributes* attributes = block.Input->GetAttributes(block.AttributeType);
+    if (!attributes)
+    {
+      return false;
+    }
+    block.NumberOfTuples = attributes->GetNumberOfTuples();
+    if (block.NumberOfTuples == 0)
+    {
+      continue;
+    }
+
+    auto pointSet = vtkPointSet::SafeDownCast(block.Input);
+    for (const auto& kernelInput : kernel.GetInputs())
+    {
+      vtkDataArray* array = nullptr;
+      if (kernelInput.Coordinates)
+      {
+        array = block.AttributeType == vtkDataObject::POINT && pointSet && pointSet->GetPoints()
+          ? pointSet->GetPoints()->GetData()
+          : nullptr;
+      }
+      else
+      {
+        array = attributes->GetArray(kernelInput.ArrayName.c_str());
+      }
+      if (!array || kernelInput.Component >= array->GetNumberOfComponents() ||
+        array->GetNumberOfTuples() != block.NumberOfTuples)
+      {
+        return false;
+      }
+      block.Arrays.push_back(array);
+    }
+  }
+
+  // Evaluate each block.
+  const bool replaceInvalidValues = this->GetReplaceInvalidValues() != 0;
+  // vtkExprTkFunctionParser returns VTK_FLOAT_MAX for invalid results.
+  const double invalidValue = replaceInvalidValues ? this->GetReplacementValue() : VTK_FLOAT_MAX;
+  vtkIdType numberOfInvalidValues = 0;
+  if (outputCD)
+  {
+    outputCD->CopyStructure(inputCD);
+    cdIter->InitTraversal();
+  }
+  for (const auto& block : blocks)
+  {
+    vtkSmartPointer<vtkDataObject> outputBlock = output;
+    if (outputCD)
+    {
+      outputBlock.TakeReference(block.Input->NewInstance());
+      outputCD->SetDataSet(cdIter, outputBlock);
+      cdIter->GoToNextItem();
+    }
+    outputBlock->ShallowCopy(block.Input);
+    if (block.NumberOfTuples == 0)
+    {
+      continue;
+    }
+
+    vtkSmartPointer<vtkDataArray> result;
+    result.TakeReference(vtkDataArray::CreateDataArray(this->GetResultArrayType()));
+    result->SetName(resultArrayName);
+    result->SetNumberOfComponents(kernel.GetNumberOfResultComponents());
+    result->SetNumberOfTuples(block.NumberOfTuples);
+    numberOfInvalidValues += kernel.Evaluate(block.Arrays, result, invalidValue);
+
+    vtkDataSetAttributes* outAttributes = outputBlock->GetAttributes(block.AttributeType);
+    outAttributes->AddArray(result);
+    if (kernel.GetNumberOfResultComponents() == 1)
+    {
+      outAttributes->SetActiveScalars(resultArrayName);
+    }
+    else
+    {
+      outAttributes->SetActiveVectors(resultArrayName);
+    }
+  }
+
+  if (numberOfInvalidValues > 0 && !replaceInvalidValues)
+  {
+    vtkErrorMacro("Invalid result because of mathematically wrong input for "
+      << numberOfInvalidValues << " values.");
+  }
+  return true;
+}
+
 // ----------------------------------------------------------------------------
 void vtkPVArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseCompiledExpressions: " << this->UseCompiledExpressions << endl;
 }
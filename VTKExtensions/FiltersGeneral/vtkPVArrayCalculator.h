@@ -46,6 +46,18 @@ public:
   }
   ///@}
 
+  ///@{
+  /**
+   * When set, expressions using the ExprTk parser are compiled and evaluated
+   * over blocks of tuples in parallel, if they only use supported features
+   * (see vtkPVArrayCalculatorKernel). Other expressions are evaluated by the
+   * parser as usual. Default is true.
+   */
+  vtkSetMacro(UseCompiledExpressions, bool);
+  vtkGetMacro(UseCompiledExpressions, bool);
+  vtkBooleanMacro(UseCompiledExpressions, bool);
+  ///@}
+
 protected:
   vtkPVArrayCalculator();
   ~vtkPVArrayCalculator() override;
@@ -77,6 +89,16 @@ protected:
    */
   void AddArrayAndVariableNames(vtkDataObject* theInputObj, vtkDataSetAttributes* inDataAttrs);
 
+  /**
+   * Evaluates the function using a compiled expression, once the variables
+   * have been registered. Returns false, without modifying `output`, if the
+   * function or the input are not supported, in which case the superclass
+   * must be used instead.
+   */
+  bool ExecuteCompiled(vtkDataObject* input, vtkDataObject* output);
+
+  bool UseCompiledExpressions = true;
+
 private:
   vtkPVArrayCalculator(const vtkPVArrayCalculator&) = delete;
   void operator=(const vtkPVArrayCalculator&) = delete;
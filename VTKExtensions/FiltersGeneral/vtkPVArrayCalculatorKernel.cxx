@@ -0,0 +1,938 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVArrayCalculatorKernel.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+using OpCode = vtkPVArrayCalculatorKernel::OpCode;
+
+// Upper bound on the number of registers of a compiled expression, to bound
+// the memory used by each thread.
+constexpr int MaximumNumberOfRegisters = 256;
+
+// Reads a component of a range of tuples into a buffer of doubles.
+struct LoadComponent
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, int component, double* out) const
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    for (const auto tuple : tuples)
+    {
+      *out++ = static_cast<double>(tuple[component]);
+    }
+  }
+};
+
+// Writes a range of tuples from one buffer of doubles per component, replacing
+// values that are not finite and counting them.
+struct StoreResult
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, const double* const* components,
+    double invalidValue, vtkIdType& numberOfInvalidValues) const
+  {
+    using ValueT = vtk::GetAPIType<ArrayT>;
+    auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    const int numComps = tuples.GetTupleSize();
+    vtkIdType index = 0;
+    for (auto tuple : tuples)
+    {
+      for (int comp = 0; comp < numComps; ++comp)
+      {
+        double value = components[comp][index];
+        if (!std::isfinite(value))
+        {
+          value = invalidValue;
+          ++numberOfInvalidValues;
+        }
+        tuple[comp] = static_cast<ValueT>(value);
+      }
+      ++index;
+    }
+  }
+};
+
+template <typename FunctorT>
+void Apply(double* out, const double* a, vtkIdType count, FunctorT f)
+{
+  for (vtkIdType i = 0; i < count; ++i)
+  {
+    out[i] = f(a[i]);
+  }
+}
+
+template <typename FunctorT>
+void Apply(double* out, const double* a, const double* b, vtkIdType count, FunctorT f)
+{
+  for (vtkIdType i = 0; i < count; ++i)
+  {
+    out[i] = f(a[i], b[i]);
+  }
+}
+
+class EvaluateFunctor
+{
+  const std::vector<vtkPVArrayCalculatorKernel::Instruction>& Program;
+  const std::vector<int>& Result;
+  const std::vector<vtkDataArray*>& Inputs;
+  const int NumberOfRegisters;
+  vtkDataArray* Output;
+  const double InvalidValue;
+  vtkSMPThreadLocal<std::vector<double>> Registers;
+  vtkSMPThreadLocal<vtkIdType> NumberOfInvalidValues;
+
+public:
+  EvaluateFunctor(const std::vector<vtkPVArrayCalculatorKernel::Instruction>& program,
+    const std::vector<int>& result, const std::vector<vtkDataArray*>& inputs, int numRegisters,
+    vtkDataArray* output, double invalidValue)
+    : Program(program)
+    , Result(result)
+    , Inputs(inputs)
+    , NumberOfRegisters(numRegisters)
+    , Output(output)
+    , InvalidValue(invalidValue)
+    , NumberOfInvalidValues(0)
+  {
+  }
+
+  vtkIdType GetNumberOfInvalidValues()
+  {
+    vtkIdType count = 0;
+    for (vtkIdType local : this->NumberOfInvalidValues)
+    {
+      count += local;
+    }
+    return count;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    constexpr vtkIdType blockSize = vtkPVArrayCalculatorKernel::BlockSize;
+    auto& registers = this->Registers.Local();
+    auto& numberOfInvalidValues = this->NumberOfInvalidValues.Local();
+    registers.resize(static_cast<size_t>(this->NumberOfRegisters * blockSize));
+    const auto reg = [&registers](int index) { return registers.data() + index * blockSize; };
+
+    for (vtkIdType start = begin; start < end; start += blockSize)
+    {
+      const vtkIdType stop = std::min(start + blockSize, end);
+      const vtkIdType count = stop - start;
+      for (const auto& instruction : this->Program)
+      {
+        double* out = reg(instruction.Destination);
+        const double* a = instruction.Operands[0] >= 0 ? reg(instruction.Operands[0]) : nullptr;
+        const double* b = instruction.Operands[1] >= 0 ? reg(instruction.Operands[1]) : nullptr;
+        switch (instruction.Code)
+        {
+          case OpCode::Load:
+          {
+            vtkDataArray* array = this->Inputs[static_cast<size_t>(instruction.Value)];
+            const int component = instruction.Operands[2];
+            if (!vtkArrayDispatch::Dispatch::Execute(
+                  array, LoadComponent{}, start, stop, component, out))
+            {
+              LoadComponent{}(array, start, stop, component, out);
+            }
+            break;
+          }
+          case OpCode::Constant:
+            std::fill(out, out + count, instruction.Value);
+            break;
+          case OpCode::Negate:
+            ::Apply(out, a, count, [](double x) { return -x; });
+            break;
+          case OpCode::Add:
+            ::Apply(out, a, b, count, [](double x, double y) { return x + y; });
+            break;
+          case OpCode::Subtract:
+            ::Apply(out, a, b, count, [](double x, double y) { return x - y; });
+            break;
+          case OpCode::Multiply:
+            ::Apply(out, a, b, count, [](double x, double y) { return x * y; });
+            break;
+          case OpCode::Divide:
+            ::Apply(out, a, b, count, [](double x, double y) { return x / y; });
+            break;
+          case OpCode::Power:
+            ::Apply(out, a, b, count, [](double x, double y) { return std::pow(x, y); });
+            break;
+          case OpCode::Minimum:
+            ::Apply(out, a, b, count, [](double x, double y) { return std::min(x, y); });
+            break;
+          case OpCode::Maximum:
+            ::Apply(out, a, b, count, [](double x, double y) { return std::max(x, y); });
+            break;
+          case OpCode::Less:
+            ::Apply(out, a, b, count, [](double x, double y) { return x < y ? 1.0 : 0.0; });
+            break;
+          case OpCode::LessEqual:
+            ::Apply(out, a, b, count, [](double x, double y) { return x <= y ? 1.0 : 0.0; });
+            break;
+          case OpCode::Greater:
+            ::Apply(out, a, b, count, [](double x, double y) { return x > y ? 1.0 : 0.0; });
+            break;
+          case OpCode::GreaterEqual:
+            ::Apply(out, a, b, count, [](double x, double y) { return x >= y ? 1.0 : 0.0; });
+            break;
+          case OpCode::And:
+            ::Apply(out, a, b, count,
+              [](double x, double y) { return (x != 0.0 && y != 0.0) ? 1.0 : 0.0; });
+            break;
+          case OpCode::Or:
+            ::Apply(out, a, b, count,
+              [](double x, double y) { return (x != 0.0 || y != 0.0) ? 1.0 : 0.0; });
+            break;
+          case OpCode::Select:
+          {
+            const double* c = reg(instruction.Operands[2]);
+            for (vtkIdType i = 0; i < count; ++i)
+            {
+              out[i] = a[i] != 0.0 ? b[i] : c[i];
+            }
+            break;
+          }
+          case OpCode::Abs:
+            ::Apply(out, a, count, [](double x) { return std::abs(x); });
+            break;
+          case OpCode::Sqrt:
+            ::Apply(out, a, count, [](double x) { return std::sqrt(x); });
+            break;
+          case OpCode::Exp:
+            ::Apply(out, a, count, [](double x) { return std::exp(x); });
+            break;
+          case OpCode::Log:
+            ::Apply(out, a, count, [](double x) { return std::log(x); });
+            break;
+          case OpCode::Log10:
+            ::Apply(out, a, count, [](double x) { return std::log10(x); });
+            break;
+          case OpCode::Sin:
+            ::Apply(out, a, count, [](double x) { return std::sin(x); });
+            break;
+          case OpCode::Cos:
+            ::Apply(out, a, count, [](double x) { return std::cos(x); });
+            break;
+          case OpCode::Tan:
+            ::Apply(out, a, count, [](double x) { return std::tan(x); });
+            break;
+          case OpCode::Asin:
+            ::Apply(out, a, count, [](double x) { return std::asin(x); });
+            break;
+          case OpCode::Acos:
+            ::Apply(out, a, count, [](double x) { return std::acos(x); });
+            break;
+          case OpCode::Atan:
+            ::Apply(out, a, count, [](double x) { return std::atan(x); });
+            break;
+          case OpCode::Sinh:
+            ::Apply(out, a, count, [](double x) { return std::sinh(x); });
+            break;
+          case OpCode::Cosh:
+            ::Apply(out, a, count, [](double x) { return std::cosh(x); });
+            break;
+          case OpCode::Tanh:
+            ::Apply(out, a, count, [](double x) { return std::tanh(x); });
+            break;
+          case OpCode::Ceil:
+            ::Apply(out, a, count, [](double x) { return std::ceil(x); });
+            break;
+          case OpCode::Floor:
+            ::Apply(out, a, count, [](double x) { return std::floor(x); });
+            break;
+        }
+      }
+
+      const double* components[3] = { nullptr, nullptr, nullptr };
+      for (size_t comp = 0; comp < this->Result.size(); ++comp)
+      {
+        components[comp] = reg(this->Result[comp]);
+      }
+      if (!vtkArrayDispatch::Dispatch::Execute(this->Output, StoreResult{}, start, stop,
+            components, this->InvalidValue, numberOfInvalidValues))
+      {
+        StoreResult{}(
+          this->Output, start, stop, components, this->InvalidValue, numberOfInvalidValues);
+      }
+    }
+  }
+};
+}
+
+//============================================================================
+// Recursive descent parser emitting the instructions of the kernel. Each value
+// is either a scalar held in one register or a vector held in three.
+class vtkPVArrayCalculatorKernel::Parser
+{
+public:
+  Parser(vtkPVArrayCalculatorKernel* self, const std::string& expression)
+    : Self(self)
+    , Expression(expression)
+  {
+  }
+
+  struct Value
+  {
+    int Size = 0;
+    int Registers[3] = { -1, -1, -1 };
+  };
+
+  bool Parse(Value& result)
+  {
+    this->Next();
+    result = this->ParseConditional();
+    return !this->Failed && result.Size > 0 && this->Token == TokenType::End &&
+      this->Self->NumberOfRegisters <= MaximumNumberOfRegisters;
+  }
+
+private:
+  enum class TokenType
+  {
+    End,
+    Number,
+    Name,
+    Operator,
+    Invalid
+  };
+
+  vtkPVArrayCalculatorKernel* Self;
+  const std::string& Expression;
+  size_t Position = 0;
+  TokenType Token = TokenType::End;
+  std::string Text;
+  double Number = 0.0;
+  bool Failed = false;
+  bool LastWasPower = false;
+  std::map<double, int> Constants;
+  std::map<std::pair<size_t, int>, int> Loads;
+
+  //--------------------------------------------------------------------------
+  // Tokenizer
+  void Next()
+  {
+    const std::string& expr = this->Expression;
+    while (this->Position < expr.size() && std::isspace(expr[this->Position]))
+    {
+      ++this->Position;
+    }
+    this->Text.clear();
+    if (this->Position >= expr.size())
+    {
+      this->Token = TokenType::End;
+      return;
+    }
+
+    const char c = expr[this->Position];
+    const char next = this->Position + 1 < expr.size() ? expr[this->Position + 1] : '\0';
+    if (std::isdigit(c) || (c == '.' && std::isdigit(next)))
+    {
+      const char* start = expr.c_str() + this->Position;
+      char* stop = nullptr;
+      this->Number = std::strtod(start, &stop);
+      // only accept plain decimal notation, as strtod also parses hexadecimal.
+      if (std::any_of(start, static_cast<const char*>(stop),
+            [](char d) { return !std::isdigit(d) && !std::strchr(".eE+-", d); }))
+      {
+        this->Token = TokenType::Invalid;
+        return;
+      }
+      this->Position += stop - start;
+      this->Token = TokenType::Number;
+    }
+    else if (std::isalpha(c) || c == '_')
+    {
+      const size_t start = this->Position;
+      while (this->Position < expr.size() &&
+        (std::isalnum(expr[this->Position]) || expr[this->Position] == '_'))
+      {
+        ++this->Position;
+      }
+      this->Text = expr.substr(start, this->Position - start);
+      this->Token = TokenType::Name;
+    }
+    else if (c == '"')
+    {
+      // quoted variable names are registered with their quotes.
+      const size_t stop = expr.find('"', this->Position + 1);
+      if (stop == std::string::npos || expr.find('\\', this->Position) < stop)
+      {
+        this->Token = TokenType::Invalid;
+        return;
+      }
+      this->Text = expr.substr(this->Position, stop + 1 - this->Position);
+      this->Position = stop + 1;
+      this->Token = TokenType::Name;
+    }
+    else if ((c == '<' || c == '>') && next == '=')
+    {
+      this->Text = expr.substr(this->Position, 2);
+      this->Position += 2;
+      this->Token = TokenType::Operator;
+    }
+    else if (std::strchr("+-*/^(),?:<>", c))
+    {
+      this->Text = std::string(1, c);
+      ++this->Position;
+      this->Token = TokenType::Operator;
+    }
+    else
+    {
+      this->Token = TokenType::Invalid;
+    }
+  }
+
+  bool IsOperator(const char* op) const
+  {
+    return this->Token == TokenType::Operator && this->Text == op;
+  }
+
+  bool IsKeyword(const char* word) const
+  {
+    return this->Token == TokenType::Name && this->Text == word;
+  }
+
+  bool Expect(const char* op)
+  {
+    if (!this->IsOperator(op))
+    {
+      return this->Fail();
+    }
+    this->Next();
+    return true;
+  }
+
+  bool Fail()
+  {
+    this->Failed = true;
+    return false;
+  }
+
+  //--------------------------------------------------------------------------
+  // Code generation
+  int Emit(OpCode code, int a = -1, int b = -1, int c = -1, double value = 0.0)
+  {
+    const int destination = this->Self->NumberOfRegisters++;
+    this->Self->Program.push_back(Instruction{ code, destination, { a, b, c }, value });
+    return destination;
+  }
+
+  int EmitConstant(double value)
+  {
+    auto iter = this->Constants.find(value);
+    if (iter == this->Constants.end())
+    {
+      iter = this->Constants.emplace(value, this->Emit(OpCode::Constant, -1, -1, -1, value)).first;
+    }
+    return iter->second;
+  }
+
+  int EmitLoad(const std::string& arrayName, bool coordinates, int component)
+  {
+    auto& inputs = this->Self->Inputs;
+    size_t index = 0;
+    for (; index < inputs.size(); ++index)
+    {
+      if (inputs[index].ArrayName == arrayName && inputs[index].Coordinates == coordinates &&
+        inputs[index].Component == component)
+      {
+        break;
+      }
+    }
+    if (index == inputs.size())
+    {
+      inputs.push_back(Input{ arrayName, coordinates, component });
+    }
+
+    auto iter = this->Loads.find(std::make_pair(index, component));
+    if (iter == this->Loads.end())
+    {
+      iter = this->Loads
+               .emplace(std::make_pair(index, component),
+                 this->Emit(OpCode::Load, -1, -1, component, static_cast<double>(index)))
+               .first;
+    }
+    return iter->second;
+  }
+
+  static Value Scalar(int reg)
+  {
+    Value value;
+    value.Size = 1;
+    value.Registers[0] = reg;
+    return value;
+  }
+
+  Value Unary(OpCode code, const Value& a)
+  {
+    if (a.Size != 1)
+    {
+      this->Fail();
+      return Value();
+    }
+    return Scalar(this->Emit(code, a.Registers[0]));
+  }
+
+  Value Binary(OpCode code, const Value& a, const Value& b)
+  {
+    if (a.Size != 1 || b.Size != 1)
+    {
+      this->Fail();
+      return Value();
+    }
+    return Scalar(this->Emit(code, a.Registers[0], b.Registers[0]));
+  }
+
+  // Component-wise operation on two values of the same size.
+  Value ComponentWise(OpCode code, const Value& a, const Value& b)
+  {
+    if (a.Size == 0 || a.Size != b.Size)
+    {
+      this->Fail();
+      return Value();
+    }
+    Value result;
+    result.Size = a.Size;
+    for (int comp = 0; comp < a.Size; ++comp)
+    {
+      result.Registers[comp] = this->Emit(code, a.Registers[comp], b.Registers[comp]);
+    }
+    return result;
+  }
+
+  // Multiplication or division of a vector by a scalar.
+  Value Scale(OpCode code, const Value& vector, const Value& scalar, bool scalarFirst)
+  {
+    Value result;
+    result.Size = 3;
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      result.Registers[comp] = scalarFirst
+        ? this->Emit(code, scalar.Registers[0], vector.Registers[comp])
+        : this->Emit(code, vector.Registers[comp], scalar.Registers[0]);
+    }
+    return result;
+  }
+
+  Value Dot(const Value& a, const Value& b)
+  {
+    if (a.Size != 3 || b.Size != 3)
+    {
+      this->Fail();
+      return Value();
+    }
+    const int xx = this->Emit(OpCode::Multiply, a.Registers[0], b.Registers[0]);
+    const int yy = this->Emit(OpCode::Multiply, a.Registers[1], b.Registers[1]);
+    const int zz = this->Emit(OpCode::Multiply, a.Registers[2], b.Registers[2]);
+    return Scalar(this->Emit(OpCode::Add, this->Emit(OpCode::Add, xx, yy), zz));
+  }
+
+  Value Cross(const Value& a, const Value& b)
+  {
+    if (a.Size != 3 || b.Size != 3)
+    {
+      this->Fail();
+      return Value();
+    }
+    Value result;
+    result.Size = 3;
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      const int i = (comp + 1) % 3, j = (comp + 2) % 3;
+      const int first = this->Emit(OpCode::Multiply, a.Registers[i], b.Registers[j]);
+      const int second = this->Emit(OpCode::Multiply, a.Registers[j], b.Registers[i]);
+      result.Registers[comp] = this->Emit(OpCode::Subtract, first, second);
+    }
+    return result;
+  }
+
+  Value Magnitude(const Value& a)
+  {
+    const Value dot = this->Dot(a, a);
+    return dot.Size == 1 ? Scalar(this->Emit(OpCode::Sqrt, dot.Registers[0])) : Value();
+  }
+
+  Value Normalize(const Value& a)
+  {
+    const Value magnitude = this->Magnitude(a);
+    return magnitude.Size == 1 ? this->Scale(OpCode::Divide, a, magnitude, false) : Value();
+  }
+
+  //--------------------------------------------------------------------------
+  // Grammar, from the lowest to the highest precedence.
+  Value ParseConditional()
+  {
+    Value condition = this->ParseOr();
+    if (!this->IsOperator("?"))
+    {
+      return condition;
+    }
+    this->Next();
+    const Value a = this->ParseConditional();
+    if (!this->Expect(":"))
+    {
+      return Value();
+    }
+    const Value b = this->ParseConditional();
+    return this->Select(condition, a, b);
+  }
+
+  Value Select(const Value& condition, const Value& a, const Value& b)
+  {
+    if (condition.Size != 1 || a.Size != 1 || b.Size != 1)
+    {
+      this->Fail();
+      return Value();
+    }
+    return Scalar(
+      this->Emit(OpCode::Select, condition.Registers[0], a.Registers[0], b.Registers[0]));
+  }
+
+  Value ParseOr()
+  {
+    Value value = this->ParseAnd();
+    while (!this->Failed && this->IsKeyword("or"))
+    {
+      this->Next();
+      value = this->Binary(OpCode::Or, value, this->ParseAnd());
+    }
+    return value;
+  }
+
+  Value ParseAnd()
+  {
+    Value value = this->ParseComparison();
+    while (!this->Failed && this->IsKeyword("and"))
+    {
+      this->Next();
+      value = this->Binary(OpCode::And, value, this->ParseComparison());
+    }
+    return value;
+  }
+
+  Value ParseComparison()
+  {
+    const Value value = this->ParseSum();
+    OpCode code;
+    if (this->IsOperator("<"))
+    {
+      code = OpCode::Less;
+    }
+    else if (this->IsOperator("<="))
+    {
+      code = OpCode::LessEqual;
+    }
+    else if (this->IsOperator(">"))
+    {
+      code = OpCode::Greater;
+    }
+    else if (this->IsOperator(">="))
+    {
+      code = OpCode::GreaterEqual;
+    }
+    else
+    {
+      return value;
+    }
+    this->Next();
+    const Value result = this->Binary(code, value, this->ParseSum());
+    if (this->IsOperator("<") || this->IsOperator("<=") || this->IsOperator(">") ||
+      this->IsOperator(">="))
+    {
+      // chained comparisons are left to the parser.
+      this->Fail();
+    }
+    return result;
+  }
+
+  Value ParseSum()
+  {
+    Value value = this->ParseProduct();
+    while (!this->Failed && (this->IsOperator("+") || this->IsOperator("-")))
+    {
+      const OpCode code = this->Text == "+" ? OpCode::Add : OpCode::Subtract;
+      this->Next();
+      value = this->ComponentWise(code, value, this->ParseProduct());
+    }
+    return value;
+  }
+
+  Value ParseProduct()
+  {
+    Value value = this->ParseUnary();
+    while (!this->Failed && (this->IsOperator("*") || this->IsOperator("/")))
+    {
+      const OpCode code = this->Text == "*" ? OpCode::Multiply : OpCode::Divide;
+      this->Next();
+      const Value other = this->ParseUnary();
+      if (value.Size == 1 && other.Size == 1)
+      {
+        value = this->Binary(code, value, other);
+      }
+      else if (value.Size == 3 && other.Size == 1)
+      {
+        value = this->Scale(code, value, other, false);
+      }
+      else if (value.Size == 1 && other.Size == 3 && code == OpCode::Multiply)
+      {
+        value = this->Scale(code, other, value, true);
+      }
+      else
+      {
+        this->Fail();
+        return Value();
+      }
+    }
+    return value;
+  }
+
+  Value ParseUnary()
+  {
+    if (this->IsOperator("-"))
+    {
+      this->Next();
+      const Value value = this->ParseUnary();
+      if (this->LastWasPower)
+      {
+        // whether `-x^2` negates `x` or `x^2` is left to the parser.
+        this->Fail();
+        return Value();
+      }
+      Value result;
+      result.Size = value.Size;
+      for (int comp = 0; comp < value.Size; ++comp)
+      {
+        result.Registers[comp] = this->Emit(OpCode::Negate, value.Registers[comp]);
+      }
+      return result;
+    }
+    if (this->IsOperator("+"))
+    {
+      this->Next();
+      return this->ParseUnary();
+    }
+    return this->ParsePower();
+  }
+
+  Value ParsePower()
+  {
+    const Value base = this->ParsePrimary();
+    this->LastWasPower = this->IsOperator("^");
+    if (!this->LastWasPower)
+    {
+      return base;
+    }
+    this->Next();
+    Value exponent;
+    if (this->IsOperator("-"))
+    {
+      this->Next();
+      exponent = this->Unary(OpCode::Negate, this->ParsePrimary());
+    }
+    else
+    {
+      exponent = this->ParsePrimary();
+    }
+    if (this->IsOperator("^"))
+    {
+      // the associativity of chained powers is left to the parser.
+      this->Fail();
+      return Value();
+    }
+    return this->Binary(OpCode::Power, base, exponent);
+  }
+
+  bool ParseArguments(std::vector<Value>& arguments)
+  {
+    if (!this->Expect("("))
+    {
+      return false;
+    }
+    while (true)
+    {
+      arguments.push_back(this->ParseConditional());
+      if (this->Failed || arguments.back().Size == 0)
+      {
+        return this->Fail();
+      }
+      if (!this->IsOperator(","))
+      {
+        return this->Expect(")");
+      }
+      this->Next();
+    }
+  }
+
+  Value ParseFunction(const std::string& name)
+  {
+    static const std::map<std::string, OpCode> unaryFunctions = { { "abs", OpCode::Abs },
+      { "sqrt", OpCode::Sqrt }, { "exp", OpCode::Exp }, { "ln", OpCode::Log },
+      { "log", OpCode::Log }, { "log10", OpCode::Log10 }, { "sin", OpCode::Sin },
+      { "cos", OpCode::Cos }, { "tan", OpCode::Tan }, { "asin", OpCode::Asin },
+      { "acos", OpCode::Acos }, { "atan", OpCode::Atan }, { "sinh", OpCode::Sinh },
+      { "cosh", OpCode::Cosh }, { "tanh", OpCode::Tanh }, { "ceil", OpCode::Ceil },
+      { "floor", OpCode::Floor } };
+
+    std::vector<Value> args;
+    if (!this->ParseArguments(args))
+    {
+      return Value();
+    }
+
+    auto iter = unaryFunctions.find(name);
+    if (iter != unaryFunctions.end() && args.size() == 1)
+    {
+      return this->Unary(iter->second, args[0]);
+    }
+    if ((name == "min" || name == "max") && args.size() >= 2)
+    {
+      Value value = args[0];
+      for (size_t cc = 1; cc < args.size(); ++cc)
+      {
+        value = this->Binary(name == "min" ? OpCode::Minimum : OpCode::Maximum, value, args[cc]);
+      }
+      return value;
+    }
+    if (name == "if" && args.size() == 3)
+    {
+      return this->Select(args[0], args[1], args[2]);
+    }
+    if (name == "mag" && args.size() == 1)
+    {
+      return this->Magnitude(args[0]);
+    }
+    if (name == "norm" && args.size() == 1)
+    {
+      return this->Normalize(args[0]);
+    }
+    if (name == "dot" && args.size() == 2)
+    {
+      return this->Dot(args[0], args[1]);
+    }
+    if (name == "cross" && args.size() == 2)
+    {
+      return this->Cross(args[0], args[1]);
+    }
+    this->Fail();
+    return Value();
+  }
+
+  Value ParsePrimary()
+  {
+    if (this->Failed)
+    {
+      return Value();
+    }
+
+    if (this->Token == TokenType::Number)
+    {
+      const double number = this->Number;
+      this->Next();
+      return Scalar(this->EmitConstant(number));
+    }
+
+    if (this->IsOperator("("))
+    {
+      this->Next();
+      const Value value = this->ParseConditional();
+      return this->Expect(")") ? value : Value();
+    }
+
+    if (this->Token != TokenType::Name)
+    {
+      this->Fail();
+      return Value();
+    }
+
+    const std::string name = this->Text;
+    this->Next();
+    if (this->IsOperator("("))
+    {
+      return this->ParseFunction(name);
+    }
+
+    if (name == "iHat" || name == "jHat" || name == "kHat")
+    {
+      Value value;
+      value.Size = 3;
+      for (int comp = 0; comp < 3; ++comp)
+      {
+        value.Registers[comp] = this->EmitConstant(name[0] - 'i' == comp ? 1.0 : 0.0);
+      }
+      return value;
+    }
+
+    const auto iter = this->Self->Variables.find(name);
+    if (iter == this->Self->Variables.end())
+    {
+      this->Fail();
+      return Value();
+    }
+    const Variable& variable = iter->second;
+    Value value;
+    value.Size = variable.Size;
+    for (int comp = 0; comp < variable.Size; ++comp)
+    {
+      value.Registers[comp] =
+        this->EmitLoad(variable.ArrayName, variable.Coordinates, variable.Components[comp]);
+    }
+    return value;
+  }
+};
+
+//----------------------------------------------------------------------------
+void vtkPVArrayCalculatorKernel::AddScalarVariable(
+  const std::string& name, const std::string& arrayName, int component, bool coordinates)
+{
+  this->Variables[name] = Variable{ arrayName, coordinates, { component, -1, -1 }, 1 };
+}
+
+//----------------------------------------------------------------------------
+void vtkPVArrayCalculatorKernel::AddVectorVariable(const std::string& name,
+  const std::string& arrayName, const int components[3], bool coordinates)
+{
+  this->Variables[name] =
+    Variable{ arrayName, coordinates, { components[0], components[1], components[2] }, 3 };
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVArrayCalculatorKernel::Compile(const std::string& expression)
+{
+  this->Inputs.clear();
+  this->Program.clear();
+  this->Result.clear();
+  this->NumberOfRegisters = 0;
+
+  Parser parser(this, expression);
+  Parser::Value result;
+  if (!parser.Parse(result))
+  {
+    this->Inputs.clear();
+    this->Program.clear();
+    this->NumberOfRegisters = 0;
+    return false;
+  }
+  this->Result.assign(result.Registers, result.Registers + result.Size);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVArrayCalculatorKernel::Evaluate(
+  const std::vector<vtkDataArray*>& inputs, vtkDataArray* result, double invalidValue) const
+{
+  EvaluateFunctor functor(
+    this->Program, this->Result, inputs, this->NumberOfRegisters, result, invalidValue);
+  vtkSMPTools::For(0, result->GetNumberOfTuples(), 16 * BlockSize, functor);
+  return functor.GetNumberOfInvalidValues();
+}
@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVArrayCalculatorKernel
+ * @brief   compiled, block-wise evaluation of calculator expressions
+ *
+ * vtkPVArrayCalculatorKernel compiles calculator expressions written in the
+ * syntax of vtkExprTkFunctionParser into a list of instructions, each of which
+ * is applied to a whole block of tuples at once. Before evaluating a block, the
+ * components used by the expression are read into contiguous buffers using
+ * vtkArrayDispatch, so that the instructions are simple loops over arrays of
+ * doubles that the compiler can vectorize. Blocks are evaluated in parallel
+ * using vtkSMPTools.
+ *
+ * Only a subset of the language is supported: numbers, scalar and vector
+ * variables, `iHat`, `jHat` and `kHat`, the arithmetic operators, `^`, the
+ * ordering comparisons, `and`, `or`, `if(c, a, b)`, `c ? a : b`, the usual
+ * scalar functions and `mag`, `norm`, `dot` and `cross` for vectors. `Compile`
+ * returns false for anything else, in which case the expression must be
+ * evaluated by vtkArrayCalculator.
+ */
+
+#ifndef vtkPVArrayCalculatorKernel_h
+#define vtkPVArrayCalculatorKernel_h
+
+#include "vtkType.h" // for vtkIdType
+
+#include <map>    // for std::map
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class vtkDataArray;
+
+class vtkPVArrayCalculatorKernel
+{
+public:
+  /**
+   * A component read by the compiled expression, either from the array named
+   * `ArrayName` or from the point coordinates.
+   */
+  struct Input
+  {
+    std::string ArrayName;
+    bool Coordinates;
+    int Component;
+  };
+
+  ///@{
+  /**
+   * Register the variables that can be used in the expression. They must be
+   * added before calling `Compile`.
+   */
+  void AddScalarVariable(
+    const std::string& name, const std::string& arrayName, int component, bool coordinates);
+  void AddVectorVariable(const std::string& name, const std::string& arrayName,
+    const int components[3], bool coordinates);
+  ///@}
+
+  /**
+   * Compile `expression`. Returns false if it is not valid or uses features
+   * that are not supported.
+   */
+  bool Compile(const std::string& expression);
+
+  /**
+   * Returns the components read by the compiled expression. `Evaluate` expects
+   * an array for each of them, in the same order.
+   */
+  const std::vector<Input>& GetInputs() const { return this->Inputs; }
+
+  /**
+   * Returns 1 or 3 depending on whether the compiled expression is a scalar or
+   * a vector.
+   */
+  int GetNumberOfResultComponents() const { return static_cast<int>(this->Result.size()); }
+
+  /**
+   * Evaluate the compiled expression for all the tuples of `result`, which
+   * must have `GetNumberOfResultComponents` components. `inputs` holds the
+   * array to read each of the inputs from. Values that are not finite are
+   * replaced with `invalidValue`. Returns the number of values replaced.
+   */
+  vtkIdType Evaluate(
+    const std::vector<vtkDataArray*>& inputs, vtkDataArray* result, double invalidValue) const;
+
+  /**
+   * Number of tuples in each block.
+   */
+  static constexpr vtkIdType BlockSize = 512;
+
+  enum class OpCode
+  {
+    Load,
+    Constant,
+    Negate,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+    Minimum,
+    Maximum,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    And,
+    Or,
+    Select,
+    Abs,
+    Sqrt,
+    Exp,
+    Log,
+    Log10,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Sinh,
+    Cosh,
+    Tanh,
+    Ceil,
+    Floor
+  };
+
+  /**
+   * An instruction writing `Destination` from up to three registers, a
+   * constant or an input.
+   */
+  struct Instruction
+  {
+    OpCode Code;
+    int Destination;
+    int Operands[3];
+    double Value;
+  };
+
+private:
+  struct Variable
+  {
+    std::string ArrayName;
+    bool Coordinates;
+    int Components[3];
+    int Size;
+  };
+
+  class Parser;
+
+  std::map<std::string, Variable> Variables;
+  std::vector<Input> Inputs;
+  std::vector<Instruction> Program;
+  std::vector<int> Result;
+  int NumberOfRegisters = 0;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkPVArrayCalculatorKernel.h
@@ -19,10 +19,11 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
-#include "vtkOctreePointLocator.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTetra.h"
 #include "vtkTransform.h"
@@ -54,7 +55,17 @@ class vtkPVGlyphFilter::vtkInternals
   std::vector<vtkTuple<double, 3>> Points;
   std::vector<vtkIdType> PointIds;
   size_t NextPointId;
-  vtkNew<vtkOctreePointLocator> Locator;
+
+  // Point locators are kept across executions, per flat index, so that they are not
+  // rebuilt when only the glyph parameters change.
+  struct CachedLocator
+  {
+    vtkSmartPointer<vtkStaticPointLocator> Locator;
+    vtkMTimeType DataSetMTime = 0;
+  };
+  std::map<unsigned int, CachedLocator> Locators;
+  // Flat indices of the datasets in the current execution.
+  std::set<unsigned int> VisitedIndices;
 
   // Used with SPATIALLY_UNIFORM_INVERSE_TRANSFORM_SAMPLING_*
   std::map<unsigned int, std::vector<double>> UniformSamplingVectorMap;
@@ -123,18 +134,33 @@ public:
 
     if (glyphMode == vtkPVGlyphFilter::SPATIALLY_UNIFORM_DISTRIBUTION)
     {
-      this->Locator->Initialize();
-      this->Locator->SetDataSet(ds);
-      this->Locator->BuildLocator();
-
-      for (auto iter : this->Points)
+      if (ds->GetNumberOfPoints() > 0)
       {
-        double dist2;
-        vtkIdType ptId = this->Locator->FindClosestPointWithinRadius(
-          this->NearestPointRadius, iter.GetData(), dist2);
-        if (ptId >= 0)
+        vtkStaticPointLocator* locator = this->GetLocator(index, ds);
+
+        // Each sample point is independent, results do not depend on the number of threads.
+        std::vector<vtkIdType> closestPointIds(this->Points.size());
+        vtkSMPTools::For(0, static_cast<vtkIdType>(this->Points.size()),
+          [&](vtkIdType begin, vtkIdType end) {
+            for (vtkIdType cc = begin; cc < end; ++cc)
+            {
+              double dist2;
+              closestPointIds[cc] = locator->FindClosestPointWithinRadius(
+                this->NearestPointRadius, this->Points[cc].GetData(), dist2);
+            }
+          });
+        for (vtkIdType ptId : closestPointIds)
         {
-          pointIds.insert(ptId);
+          if (ptId >= 0)
+          {
+            pointIds.insert(ptId);
+          }
+        }
+
+        // Cell centers are computed again on each execution, their locator cannot be reused.
+        if (cellCenters)
+        {
+          this->Locators.erase(index);
         }
       }
     }
@@ -203,18 +229,66 @@ public:
 
     this->Bounds.Reset();
     this->Points.clear();
-    this->Locator->Initialize();
-    this->Locator->SetDataSet(nullptr);
 
     this->UniformSamplingVectorMap.clear();
     this->SamplingRunningSum = 0;
   }
 
+  //---------------------------------------------------------------------------
+  // Returns the locator for the dataset at the given flat index, building it
+  // only if the dataset changed since the last execution.
+  // Used only with SPATIALLY_UNIFORM_DISTRIBUTION
+  vtkStaticPointLocator* GetLocator(unsigned int index, vtkDataSet* ds)
+  {
+    auto& cached = this->Locators[index];
+    if (!cached.Locator || cached.Locator->GetDataSet() != ds ||
+      cached.DataSetMTime != ds->GetMTime())
+    {
+      cached.Locator = vtkSmartPointer<vtkStaticPointLocator>::New();
+      cached.Locator->SetDataSet(ds);
+      cached.Locator->BuildLocator();
+      cached.DataSetMTime = ds->GetMTime();
+    }
+    return cached.Locator;
+  }
+
+  //---------------------------------------------------------------------------
+  // Returns the locator kept for the given flat index, if any.
+  vtkStaticPointLocator* FindLocator(unsigned int index) const
+  {
+    auto iter = this->Locators.find(index);
+    return iter != this->Locators.end() ? iter->second.Locator.GetPointer() : nullptr;
+  }
+
+  //---------------------------------------------------------------------------
+  // Locators keep a reference to their dataset, release them when not needed.
+  void ReleaseLocators() { this->Locators.clear(); }
+
+  //---------------------------------------------------------------------------
+  // Releases the locators of the flat indices that are not part of the current
+  // input, so that removed blocks are not kept alive.
+  void ReleaseUnvisitedLocators()
+  {
+    for (auto iter = this->Locators.begin(); iter != this->Locators.end();)
+    {
+      if (this->VisitedIndices.find(iter->first) == this->VisitedIndices.end())
+      {
+        iter = this->Locators.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+    this->VisitedIndices.clear();
+  }
+
   //---------------------------------------------------------------------------
   vtkSmartPointer<vtkDataSet> UpdateWithDataset(
     unsigned int index, vtkDataSet* ds, vtkPVGlyphFilter* self)
   {
     assert(ds != nullptr && self != nullptr);
+    this->VisitedIndices.insert(index);
 
     vtkSmartPointer<vtkDataSet> dataSetToReturn = ds;
 
@@ -639,12 +713,17 @@ int vtkPVGlyphFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector* sourceVector = inputVector[1];
 
   this->Internals->Reset();
+  if (this->GlyphMode != SPATIALLY_UNIFORM_DISTRIBUTION)
+  {
+    this->Internals->ReleaseLocators();
+  }
 
   vtkSmartPointer<vtkDataSet> ds = vtkDataSet::GetData(inputVector[0], 0);
   vtkCompositeDataSet* cds = vtkCompositeDataSet::GetData(inputVector[0], 0);
   if (ds)
   {
     ds = this->Internals->UpdateWithDataset(0, ds, this);
+    this->Internals->ReleaseUnvisitedLocators();
     this->Internals->SynchronizeGlobalInformation(this);
 
     if (!this->IsInputArrayToProcessValid(ds))
@@ -679,6 +758,7 @@ int vtkPVGlyphFilter::RequestData(vtkInformation* vtkNotUsed(request),
         cdsCopy->SetDataSet(iter, current);
       }
     }
+    this->Internals->ReleaseUnvisitedLocators();
 
     this->Internals->SynchronizeGlobalInformation(this);
 
@@ -777,6 +857,12 @@ vtkPolyData* vtkPVGlyphFilter::GetSource(int idx, vtkInformationVector* sourceIn
   return vtkPolyData::SafeDownCast(info->Get(vtkDataObject::DATA_OBJECT()));
 }
 
+//-----------------------------------------------------------------------------
+vtkStaticPointLocator* vtkPVGlyphFilter::GetCachedLocator(unsigned int index)
+{
+  return this->Internals->FindLocator(index);
+}
+
 //-----------------------------------------------------------------------------
 bool vtkPVGlyphFilter::UseCellCenters(vtkDataSet* input)
 {
@@ -22,7 +22,9 @@
  * can be used to limit the number of sample points used for random sampling. This
  * does not equal the number of points actually glyphed, since that depends on
  * several factors. In parallel, this filter ensures that spatial bounds are collected
- * across all ranks for generating identical sample points.
+ * across all ranks for generating identical sample points. The point locator used
+ * to find the points closest to the samples is kept across executions and only
+ * rebuilt when the input changes.
  *
  * \li SPATIALLY_UNIFORM_INVERSE_TRANSFORM_SAMPLING_SURFACE: points randomly sampled
  * via an inverse transform on surface area of each cell. When used with a volume dataset,
@@ -51,6 +53,7 @@
 #include "vtkPolyDataAlgorithm.h"
 
 class vtkMultiProcessController;
+class vtkStaticPointLocator;
 class vtkTransform;
 
 class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkPVGlyphFilter : public vtkPolyDataAlgorithm
@@ -222,6 +225,12 @@ protected:
    */
   bool NeedsVectors();
 
+  /**
+   * Returns the point locator kept for the dataset at the flat index \c index
+   * with SPATIALLY_UNIFORM_DISTRIBUTION, or nullptr if there is none.
+   */
+  vtkStaticPointLocator* GetCachedLocator(unsigned int index);
+
   ///@{
   /**
    * Method called in RequestData() to do the actual data processing. This will
@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkLogger.h"
+#include "vtkMaterialInterfaceFilter.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int BlockSize = 8;
+
+// Returns the fraction of the material at the center of a cell: a large
+// sphere that spans all blocks, a small sphere inside a single block and a
+// box across the boundary of two blocks.
+unsigned char GetFraction(const double x[3])
+{
+  const double large[3] = { 8, 8, 8 };
+  const double small[3] = { 2.5, 2.5, 13.5 };
+  const bool inside = vtkMath::Distance2BetweenPoints(x, large) < 5 * 5 ||
+    vtkMath::Distance2BetweenPoints(x, small) < 1.5 * 1.5 ||
+    (x[0] > 11 && x[0] < 15 && x[1] > 0 && x[1] < 2 && x[2] > 6 && x[2] < 10);
+  return inside ? 255 : 0;
+}
+
+// Creates a single level of 2x2x2 blocks of BlockSize^3 cells.
+vtkSmartPointer<vtkNonOverlappingAMR> CreateInput()
+{
+  int blocksPerLevel[1] = { 8 };
+  auto amr = vtkSmartPointer<vtkNonOverlappingAMR>::New();
+  amr->Initialize(1, blocksPerLevel);
+  for (int blockId = 0; blockId < 8; ++blockId)
+  {
+    const double origin[3] = { static_cast<double>(BlockSize * (blockId % 2)),
+      static_cast<double>(BlockSize * ((blockId / 2) % 2)),
+      static_cast<double>(BlockSize * (blockId / 4)) };
+    vtkNew<vtkUniformGrid> grid;
+    grid->SetOrigin(origin);
+    grid->SetSpacing(1, 1, 1);
+    grid->SetDimensions(BlockSize + 1, BlockSize + 1, BlockSize + 1);
+
+    const vtkIdType numberOfCells = grid->GetNumberOfCells();
+    vtkNew<vtkUnsignedCharArray> fraction;
+    fraction->SetName("Fraction");
+    fraction->SetNumberOfTuples(numberOfCells);
+    vtkNew<vtkDoubleArray> mass;
+    mass->SetName("Mass");
+    mass->SetNumberOfTuples(numberOfCells);
+    vtkNew<vtkDoubleArray> pressure;
+    pressure->SetName("Pressure");
+    pressure->SetNumberOfTuples(numberOfCells);
+    for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+      const int ijk[3] = { static_cast<int>(cellId % BlockSize),
+        static_cast<int>((cellId / BlockSize) % BlockSize),
+        static_cast<int>(cellId / (BlockSize * BlockSize)) };
+      const double x[3] = { origin[0] + ijk[0] + 0.5, origin[1] + ijk[1] + 0.5,
+        origin[2] + ijk[2] + 0.5 };
+      const unsigned char value = ::GetFraction(x);
+      fraction->SetValue(cellId, value);
+      mass->SetValue(cellId, (2.0 + x[0] / 16.0) * value / 255.0);
+      pressure->SetValue(cellId, x[1] + 0.25 * x[2]);
+    }
+    grid->GetCellData()->AddArray(fraction);
+    grid->GetCellData()->AddArray(mass);
+    grid->GetCellData()->AddArray(pressure);
+    amr->SetDataSet(0, blockId, grid);
+  }
+  return amr;
+}
+
+struct FilterOutput
+{
+  // number of cells of each fragment mesh, sorted.
+  std::vector<vtkIdType> MeshSizes;
+  // point data of each fragment center, starting with its volume and sorted
+  // by volume since fragment ids depend on the order of the search.
+  std::vector<std::vector<double>> Attributes;
+  std::vector<std::string> AttributeNames;
+};
+
+bool RunFilter(vtkNonOverlappingAMR* input, bool useThreads, FilterOutput& output)
+{
+  vtkNew<vtkMaterialInterfaceFilter> filter;
+  filter->SetInputData(input);
+  filter->SelectMaterialArray("Fraction");
+  filter->SelectMassArray("Mass");
+  filter->SelectVolumeWtdAvgArray("Pressure");
+  filter->SelectMassWtdAvgArray("Pressure");
+  filter->SelectSummationArray("Pressure");
+  filter->SetMaterialFractionThreshold(0.5);
+  filter->SetUseThreads(useThreads);
+  filter->Update();
+
+  auto fragments = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  auto centers = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(1));
+  auto meshes = fragments ? vtkMultiPieceDataSet::SafeDownCast(fragments->GetBlock(0)) : nullptr;
+  auto points = centers ? vtkPolyData::SafeDownCast(centers->GetBlock(0)) : nullptr;
+  if (!meshes || !points)
+  {
+    vtkLogF(ERROR, "Missing output (UseThreads: %d).", useThreads);
+    return false;
+  }
+
+  for (unsigned int cc = 0; cc < meshes->GetNumberOfPieces(); ++cc)
+  {
+    if (auto mesh = vtkPolyData::SafeDownCast(meshes->GetPiece(cc)))
+    {
+      output.MeshSizes.push_back(mesh->GetNumberOfCells());
+    }
+  }
+  std::sort(output.MeshSizes.begin(), output.MeshSizes.end());
+
+  vtkPointData* pd = points->GetPointData();
+  std::vector<vtkDataArray*> arrays;
+  if (auto volume = pd->GetArray("Volume"))
+  {
+    arrays.push_back(volume);
+  }
+  for (int cc = 0; cc < pd->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* array = pd->GetArray(cc);
+    // ids depend on the order in which fragments are found.
+    if (array && strcmp(array->GetName(), "Volume") != 0 && strcmp(array->GetName(), "Id") != 0)
+    {
+      arrays.push_back(array);
+    }
+  }
+  for (vtkDataArray* array : arrays)
+  {
+    output.AttributeNames.emplace_back(array->GetName());
+  }
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    std::vector<double> row;
+    for (vtkDataArray* array : arrays)
+    {
+      for (int comp = 0; comp < array->GetNumberOfComponents(); ++comp)
+      {
+        row.push_back(array->GetComponent(ptId, comp));
+      }
+    }
+    output.Attributes.push_back(row);
+  }
+  std::sort(output.Attributes.begin(), output.Attributes.end());
+  return true;
+}
+
+bool Compare(const FilterOutput& serial, const FilterOutput& threaded)
+{
+  if (serial.Attributes.size() != 3)
+  {
+    vtkLogF(ERROR, "Expected 3 fragments, got %d.", static_cast<int>(serial.Attributes.size()));
+    return false;
+  }
+  if (serial.MeshSizes != threaded.MeshSizes)
+  {
+    vtkLogF(ERROR, "Fragment meshes differ with threads.");
+    return false;
+  }
+  if (serial.AttributeNames != threaded.AttributeNames ||
+    serial.Attributes.size() != threaded.Attributes.size())
+  {
+    vtkLogF(ERROR, "Fragment attributes differ with threads.");
+    return false;
+  }
+  for (size_t fragment = 0; fragment < serial.Attributes.size(); ++fragment)
+  {
+    const auto& expected = serial.Attributes[fragment];
+    const auto& actual = threaded.Attributes[fragment];
+    if (expected.size() != actual.size())
+    {
+      vtkLogF(ERROR, "Fragment %d has a different number of attributes with threads.",
+        static_cast<int>(fragment));
+      return false;
+    }
+    for (size_t cc = 0; cc < expected.size(); ++cc)
+    {
+      // sums are accumulated in a different order with threads.
+      if (std::abs(expected[cc] - actual[cc]) > 1e-9 * std::max(1.0, std::abs(expected[cc])))
+      {
+        vtkLogF(ERROR, "Fragment %d: value %d is %g with threads, %g without.",
+          static_cast<int>(fragment), static_cast<int>(cc), actual[cc], expected[cc]);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestMaterialInterfaceFilterThreads(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  auto input = ::CreateInput();
+  ::FilterOutput serial;
+  ::FilterOutput threaded;
+  const bool success = ::RunFilter(input, false, serial) && ::RunFilter(input, true, threaded) &&
+    ::Compare(serial, threaded);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
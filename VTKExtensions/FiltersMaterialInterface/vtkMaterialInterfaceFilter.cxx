@@ -14,6 +14,7 @@
 #include "vtkCallbackCommand.h"
 #include "vtkDataArraySelection.h"
 #include "vtkMath.h"
+#include "vtkSMPTools.h"
 // Data sets
 #include "vtkAMRBox.h"
 #include "vtkCompositeDataIterator.h"
@@ -63,6 +64,8 @@
 using std::ofstream;
 #include <sstream>
 using std::ostringstream;
+#include <memory>
+#include <utility>
 #include <vector>
 using std::vector;
 #include <string>
@@ -1529,6 +1532,93 @@ int vtkMaterialInterfaceFilterRingBuffer::Pop(vtkMaterialInterfaceFilterIterator
 
 //============================================================================
 
+//----------------------------------------------------------------------------
+// The state used to grow fragments: accumulators for the current fragment
+// and scratch space for the faces being created.
+// The serial search uses a single worker which stores fragments directly
+// in the filter. When threads are used, each block is searched by its own
+// worker. Its search does not leave the block, its fragments are numbered
+// from zero and are kept in the worker until they are merged in block order.
+class vtkMaterialInterfaceFilterWorker
+{
+public:
+  vtkMaterialInterfaceFilterWorker();
+  ~vtkMaterialInterfaceFilterWorker();
+
+  // Block the search is restricted to, or nullptr for none.
+  vtkMaterialInterfaceFilterBlock* Block;
+
+  // Id of the current fragment.
+  int FragmentId;
+  // Accumulators for the current fragment.
+  vtkPolyData* CurrentFragmentMesh;
+  double FragmentVolume;
+  double ClipDepthMin;
+  double ClipDepthMax;
+  std::vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
+  std::vector<std::vector<double>> FragmentVolumeWtdAvg;
+  std::vector<std::vector<double>> FragmentMassWtdAvg;
+  std::vector<std::vector<double>> FragmentSum;
+
+  // Ivars for computing the point on corners and edges of a face.
+  vtkMaterialInterfaceFilterIterator FaceNeighbors[32];
+  double FaceCornerPoints[12];
+  double FaceEdgePoints[12];
+  int FaceEdgeFlags[4];
+
+  // Where fragments are stored, indexed by fragment id. These point to the
+  // filter's containers for the serial search and to the local ones below
+  // for a restricted search.
+  std::vector<vtkPolyData*>* FragmentMeshes;
+  vtkDoubleArray* FragmentVolumes;
+  vtkDoubleArray* ClipDepthMinimums;
+  vtkDoubleArray* ClipDepthMaximums;
+  vtkDoubleArray* FragmentMoments;
+  std::vector<vtkDoubleArray*> FragmentVolumeWtdAvgs;
+  std::vector<vtkDoubleArray*> FragmentMassWtdAvgs;
+  std::vector<vtkDoubleArray*> FragmentSums;
+  vtkMaterialInterfaceEquivalenceSet* EquivalenceSet;
+
+  // Containers owned by a restricted worker.
+  std::vector<vtkPolyData*> LocalFragmentMeshes;
+  std::vector<vtkSmartPointer<vtkDoubleArray>> LocalArrays;
+  vtkMaterialInterfaceEquivalenceSet LocalEquivalenceSet;
+
+  // Voxels of other blocks that touch the fragments of a restricted
+  // search, paired with the local id of the fragment they touch.
+  std::vector<std::pair<int, vtkMaterialInterfaceFilterIterator>> Links;
+
+private:
+  vtkMaterialInterfaceFilterWorker(const vtkMaterialInterfaceFilterWorker&) = delete;
+  void operator=(const vtkMaterialInterfaceFilterWorker&) = delete;
+};
+
+//----------------------------------------------------------------------------
+vtkMaterialInterfaceFilterWorker::vtkMaterialInterfaceFilterWorker()
+{
+  this->Block = nullptr;
+  this->FragmentId = 0;
+  this->CurrentFragmentMesh = nullptr;
+  this->FragmentVolume = 0.0;
+  this->ClipDepthMin = VTK_FLOAT_MAX;
+  this->ClipDepthMax = 0.0;
+  this->FragmentMeshes = nullptr;
+  this->FragmentVolumes = nullptr;
+  this->ClipDepthMinimums = nullptr;
+  this->ClipDepthMaximums = nullptr;
+  this->FragmentMoments = nullptr;
+  this->EquivalenceSet = nullptr;
+}
+
+//----------------------------------------------------------------------------
+vtkMaterialInterfaceFilterWorker::~vtkMaterialInterfaceFilterWorker()
+{
+  // Fragments that were not merged into the filter.
+  ClearVectorOfVtkPointers(this->LocalFragmentMeshes);
+}
+
+//============================================================================
+
 //----------------------------------------------------------------------------
 // Description:
 // Construct object with initial range (0,1) and single contour value
@@ -1597,17 +1687,13 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
   this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
   this->FragmentVolumes = nullptr;
-  this->FragmentMoment.resize(4, 0.0);
   this->FragmentMoments = nullptr;
   this->FragmentAABBCenters = nullptr;
   this->FragmentOBBs = nullptr;
   this->FragmentSplitGeometry = nullptr;
 
   // Keep depth of crater along clip plane normal.
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
   this->ClipDepthMaximums = nullptr;
   this->ClipDepthMinimums = nullptr;
 
@@ -1622,14 +1708,11 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->ResolvedFragmentCenters = nullptr;
   this->ResolvedFragmentOBBs = nullptr;
 
-  this->FaceNeighbors = new vtkMaterialInterfaceFilterIterator[32];
-
-  this->CurrentFragmentMesh = nullptr;
-
   this->NVolumeWtdAvgs = 0;
   this->NToSum = 0;
   this->ComputeMoments = false;
   this->ComputeOBB = false;
+  this->UseThreads = false;
 
   this->MaterialFractionThreshold = 0.5;
   this->scaledMaterialFractionThreshold = 127.5;
@@ -1668,9 +1751,6 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
   this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
 
   this->SetClipFunction(nullptr);
 
@@ -1688,9 +1768,6 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   delete this->EquivalenceSet;
   this->EquivalenceSet = nullptr;
 
-  delete[] this->FaceNeighbors;
-  this->FaceNeighbors = nullptr;
-
   // clean up PV interface
   this->MaterialArraySelection->RemoveObserver(this->SelectionObserver);
   this->MaterialArraySelection->Delete();
@@ -3203,14 +3280,11 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 {
   this->FragmentId = 0;
 
-  this->FragmentVolume = 0.0;
   ReNewVtkPointer(this->FragmentVolumes);
   this->FragmentVolumes->SetName("Volume");
 
   if (this->ClipWithPlane)
   {
-    this->ClipDepthMax = 0.0;
-    this->ClipDepthMin = VTK_FLOAT_MAX;
     ReNewVtkPointer(this->ClipDepthMaximums);
     ReNewVtkPointer(this->ClipDepthMinimums);
     this->ClipDepthMaximums->SetName("ClipDepthMax");
@@ -3219,8 +3293,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 
   if (this->ComputeMoments)
   {
-    this->FragmentMoment.clear();
-    this->FragmentMoment.resize(4, 0.0);
     ReNewVtkPointer(this->FragmentMoments);
     this->FragmentMoments->SetNumberOfComponents(4);
     this->FragmentMoments->SetName("Moments");
@@ -3258,11 +3330,9 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
   // Configure data structures
   // 1) Volume weighted average of attribute over the
   // fragment set up containers
-  this->FragmentVolumeWtdAvg.clear();
-  this->FragmentVolumeWtdAvg.resize(this->NVolumeWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentVolumeWtdAvgs);
   this->FragmentVolumeWtdAvgs.resize(this->NVolumeWtdAvgs);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NVolumeWtdAvgs; ++j)
   {
     // data array
@@ -3281,16 +3351,12 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "VolumeWeightedAverage-" << thisArrayName;
     this->FragmentVolumeWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentVolumeWtdAvg[j].resize(nComp, 0.0);
   }
   // 2) Mass weighted average of attribute over the fragment
   // set up containers
-  this->FragmentMassWtdAvg.clear();
-  this->FragmentMassWtdAvg.resize(this->NMassWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentMassWtdAvgs);
   this->FragmentMassWtdAvgs.resize(this->NMassWtdAvgs);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NMassWtdAvgs; ++j)
   {
     // data array
@@ -3309,16 +3375,12 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "MassWeightedAverage-" << thisArrayName;
     this->FragmentMassWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentMassWtdAvg[j].resize(nComp, 0.0);
   }
   // 3) Summation of attribute over the fragment
   // set up containers
-  this->FragmentSum.clear();
-  this->FragmentSum.resize(this->NToSum);
   ClearVectorOfVtkPointers(this->FragmentSums);
   this->FragmentSums.resize(this->NToSum);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NToSum; ++j)
   {
     // data array
@@ -3337,8 +3399,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "Summation-" << thisArrayName;
     this->FragmentSums[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentSum[j].resize(nComp, 0.0);
   }
 
   // 4) Unique list of integrated attributes
@@ -3566,12 +3626,8 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StartTimer();
 #endif
-    int blockId;
-    for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
-    {
-      // build fragments
-      this->ProcessBlock(blockId);
-    }
+    // build fragments
+    this->ProcessBlocks();
 #ifdef vtkMaterialInterfaceFilterPROFILE
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StopTimer();
@@ -3661,6 +3717,9 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
   resolveEquivalencesTime = this->ResolveEquivalencesTimer->GetElapsedTime();
   numberOfBlocks = this->NumberOfBlocks;
   numberOfGhostBlocks = this->NumberOfGhostBlocks;
+  // Compare with a serial run to get the speedup of the threaded search.
+  const int processBlocksThreads =
+    this->UseThreads ? vtkSMPTools::GetEstimatedNumberOfThreads() : 1;
   if (this->Controller == 0)
   {
     cout << "InitializeTime: " << initializeTime << endl;
@@ -3668,6 +3727,7 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     cout << "NumberOfBlocks: " << numberOfBlocks << endl;
     cout << "NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
     cout << "ProcessBlocksTime: " << processBlocksTime << endl;
+    cout << "ProcessBlocksThreads: " << processBlocksThreads << endl;
     cout << "ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
   }
   else
@@ -3675,6 +3735,7 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     int numProcs = this->Controller->GetNumberOfProcesses();
     if (this->Controller->GetLocalProcessId() == 0)
     {
+      cout << "ProcessBlocksThreads: " << processBlocksThreads << endl;
       cout << "Process 0: \n";
       cout << "  InitializeTime: " << initializeTime << endl;
       cout << "  ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
@@ -3715,17 +3776,245 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 //----------------------------------------------------------------------------
-int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
+// Set up a worker for the serial search, when block is nullptr, or for a
+// search restricted to block.
+void vtkMaterialInterfaceFilter::InitializeWorker(
+  vtkMaterialInterfaceFilterWorker* worker, vtkMaterialInterfaceFilterBlock* block)
+{
+  worker->Block = block;
+  if (block == nullptr)
+  {
+    worker->FragmentId = this->FragmentId;
+    worker->FragmentMeshes = &this->FragmentMeshes;
+    worker->FragmentVolumes = this->FragmentVolumes;
+    worker->ClipDepthMinimums = this->ClipDepthMinimums;
+    worker->ClipDepthMaximums = this->ClipDepthMaximums;
+    worker->FragmentMoments = this->FragmentMoments;
+    worker->FragmentVolumeWtdAvgs = this->FragmentVolumeWtdAvgs;
+    worker->FragmentMassWtdAvgs = this->FragmentMassWtdAvgs;
+    worker->FragmentSums = this->FragmentSums;
+    worker->EquivalenceSet = this->EquivalenceSet;
+  }
+  else
+  {
+    // Local arrays have the same layout as the filter's arrays.
+    auto newLocalArray = [worker](vtkDoubleArray* array) -> vtkDoubleArray* {
+      vtkSmartPointer<vtkDoubleArray> local = vtkSmartPointer<vtkDoubleArray>::New();
+      local->SetNumberOfComponents(array->GetNumberOfComponents());
+      worker->LocalArrays.push_back(local);
+      return local;
+    };
+    worker->FragmentId = 0;
+    worker->FragmentMeshes = &worker->LocalFragmentMeshes;
+    worker->FragmentVolumes = newLocalArray(this->FragmentVolumes);
+    if (this->ClipWithPlane)
+    {
+      worker->ClipDepthMinimums = newLocalArray(this->ClipDepthMinimums);
+      worker->ClipDepthMaximums = newLocalArray(this->ClipDepthMaximums);
+    }
+    if (this->ComputeMoments)
+    {
+      worker->FragmentMoments = newLocalArray(this->FragmentMoments);
+    }
+    for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+    {
+      worker->FragmentVolumeWtdAvgs.push_back(newLocalArray(this->FragmentVolumeWtdAvgs[i]));
+    }
+    for (int i = 0; i < this->NMassWtdAvgs; ++i)
+    {
+      worker->FragmentMassWtdAvgs.push_back(newLocalArray(this->FragmentMassWtdAvgs[i]));
+    }
+    for (int i = 0; i < this->NToSum; ++i)
+    {
+      worker->FragmentSums.push_back(newLocalArray(this->FragmentSums[i]));
+    }
+    worker->EquivalenceSet = &worker->LocalEquivalenceSet;
+  }
+
+  // Accumulators, one for each array, scalar or vector.
+  worker->FragmentMoment.assign(4, 0.0);
+  worker->FragmentVolumeWtdAvg.resize(this->NVolumeWtdAvgs);
+  for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+  {
+    worker->FragmentVolumeWtdAvg[i].assign(
+      this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents(), 0.0);
+  }
+  worker->FragmentMassWtdAvg.resize(this->NMassWtdAvgs);
+  for (int i = 0; i < this->NMassWtdAvgs; ++i)
+  {
+    worker->FragmentMassWtdAvg[i].assign(
+      this->FragmentMassWtdAvgs[i]->GetNumberOfComponents(), 0.0);
+  }
+  worker->FragmentSum.resize(this->NToSum);
+  for (int i = 0; i < this->NToSum; ++i)
+  {
+    worker->FragmentSum[i].assign(this->FragmentSums[i]->GetNumberOfComponents(), 0.0);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Build the fragments of all local blocks.
+// With threads, each block is searched on its own by a restricted worker.
+// The fragment ids of each block are then offset to follow those of the
+// previous blocks, the fragments are merged in block order, and the
+// fragments touching across block boundaries are made equivalent. The
+// search is finally continued through the ghost blocks, as the serial
+// search would have, so that ghost equivalences can be shared as usual.
+void vtkMaterialInterfaceFilter::ProcessBlocks()
 {
+  if (!this->UseThreads || this->NumberOfInputBlocks < 2)
+  {
+    vtkMaterialInterfaceFilterWorker worker;
+    this->InitializeWorker(&worker, nullptr);
+    for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+    {
 #ifdef vtkMaterialInterfaceFilterDEBUG
-  ostringstream progressMesg;
-  progressMesg << "vtkMaterialInterfaceFilter::ProcessBlock(" << blockId << ") , Material "
-               << this->MaterialId;
-  this->SetProgressText(progressMesg.str().c_str());
+      ostringstream progressMesg;
+      progressMesg << "vtkMaterialInterfaceFilter::ProcessBlock(" << blockId << ") , Material "
+                   << this->MaterialId;
+      this->SetProgressText(progressMesg.str().c_str());
 #endif
-  this->Progress += this->ProgressBlockInc;
+      this->Progress += this->ProgressBlockInc;
+      this->UpdateProgress(this->Progress);
+      this->ProcessBlock(&worker, blockId);
+    }
+    this->FragmentId = worker.FragmentId;
+    return;
+  }
+
+  // Grow the fragments of each block.
+  std::vector<std::unique_ptr<vtkMaterialInterfaceFilterWorker>> workers(
+    this->NumberOfInputBlocks);
+  vtkSMPTools::For(0, this->NumberOfInputBlocks, 1, [&](int begin, int end) {
+    for (int blockId = begin; blockId < end; ++blockId)
+    {
+      if (this->InputBlocks[blockId])
+      {
+        workers[blockId].reset(new vtkMaterialInterfaceFilterWorker);
+        this->InitializeWorker(workers[blockId].get(), this->InputBlocks[blockId]);
+        this->ProcessBlock(workers[blockId].get(), blockId);
+      }
+    }
+  });
+  this->Progress += this->ProgressBlockInc * this->NumberOfInputBlocks;
   this->UpdateProgress(this->Progress);
 
+  // Make the fragment ids unique within this process.
+  std::vector<int> offsets(this->NumberOfInputBlocks);
+  for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+  {
+    offsets[blockId] = this->FragmentId;
+    if (workers[blockId])
+    {
+      this->FragmentId += workers[blockId]->FragmentId;
+    }
+  }
+  vtkSMPTools::For(0, this->NumberOfInputBlocks, 1, [&](int begin, int end) {
+    for (int blockId = begin; blockId < end; ++blockId)
+    {
+      vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
+      if (block == nullptr || offsets[blockId] == 0)
+      {
+        continue;
+      }
+      const int* ext = block->GetBaseCellExtent();
+      int cellIncs[3];
+      block->GetCellIncrements(cellIncs);
+      int* zPointer = block->GetBaseFragmentIdPointer();
+      for (int iz = ext[4]; iz <= ext[5]; ++iz, zPointer += cellIncs[2])
+      {
+        int* yPointer = zPointer;
+        for (int iy = ext[2]; iy <= ext[3]; ++iy, yPointer += cellIncs[1])
+        {
+          int* xPointer = yPointer;
+          for (int ix = ext[0]; ix <= ext[1]; ++ix, xPointer += cellIncs[0])
+          {
+            if (*xPointer != -1)
+            {
+              *xPointer += offsets[blockId];
+            }
+          }
+        }
+      }
+    }
+  });
+
+  // Merge the fragments in block order.
+  auto append = [](vtkDoubleArray* dest, vtkDoubleArray* src) {
+    if (dest && src)
+    {
+      dest->InsertTuples(dest->GetNumberOfTuples(), src->GetNumberOfTuples(), 0, src);
+    }
+  };
+  for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+  {
+    vtkMaterialInterfaceFilterWorker* worker = workers[blockId].get();
+    if (worker == nullptr)
+    {
+      continue;
+    }
+    const int offset = offsets[blockId];
+    for (int localId = 0; localId < worker->FragmentId; ++localId)
+    {
+      this->FragmentMeshes.push_back(worker->LocalFragmentMeshes[localId]);
+      this->EquivalenceSet->AddEquivalence(
+        localId + offset, worker->LocalEquivalenceSet.GetEquivalentSetId(localId) + offset);
+    }
+    worker->LocalFragmentMeshes.clear();
+    append(this->FragmentVolumes, worker->FragmentVolumes);
+    append(this->ClipDepthMinimums, worker->ClipDepthMinimums);
+    append(this->ClipDepthMaximums, worker->ClipDepthMaximums);
+    append(this->FragmentMoments, worker->FragmentMoments);
+    for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+    {
+      append(this->FragmentVolumeWtdAvgs[i], worker->FragmentVolumeWtdAvgs[i]);
+    }
+    for (int i = 0; i < this->NMassWtdAvgs; ++i)
+    {
+      append(this->FragmentMassWtdAvgs[i], worker->FragmentMassWtdAvgs[i]);
+    }
+    for (int i = 0; i < this->NToSum; ++i)
+    {
+      append(this->FragmentSums[i], worker->FragmentSums[i]);
+    }
+  }
+
+  // Connect the fragments across block boundaries. Every voxel of a local
+  // block has been visited, so the unvisited neighbors are in ghost blocks.
+  vtkMaterialInterfaceFilterWorker ghostWorker;
+  this->InitializeWorker(&ghostWorker, nullptr);
+  vtkMaterialInterfaceFilterRingBuffer queue;
+  for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+  {
+    if (workers[blockId] == nullptr)
+    {
+      continue;
+    }
+    for (auto& link : workers[blockId]->Links)
+    {
+      const int fragmentId = link.first + offsets[blockId];
+      vtkMaterialInterfaceFilterIterator* neighbor = &link.second;
+      const int neighborId = *(neighbor->FragmentIdPointer);
+      if (neighborId == -1)
+      {
+        // Ghost voxels do not add faces or attributes to the fragment.
+        ghostWorker.FragmentId = fragmentId;
+        ghostWorker.CurrentFragmentMesh = this->FragmentMeshes[fragmentId];
+        *(neighbor->FragmentIdPointer) = fragmentId;
+        queue.Push(neighbor);
+        this->ConnectFragment(&ghostWorker, &queue);
+      }
+      else if (neighborId != fragmentId)
+      {
+        this->EquivalenceSet->AddEquivalence(fragmentId, neighborId);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkMaterialInterfaceFilter::ProcessBlock(vtkMaterialInterfaceFilterWorker* worker, int blockId)
+{
   vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
   if (block == nullptr)
   {
@@ -3765,65 +4054,65 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
         if (*(xIterator->FragmentIdPointer) == -1 &&
           *(xIterator->VolumeFractionPointer) > this->scaledMaterialFractionThreshold)
         { // We have a new fragment.
-          this->CurrentFragmentMesh = this->NewFragmentMesh();
-          this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
+          worker->CurrentFragmentMesh = this->NewFragmentMesh();
+          worker->EquivalenceSet->AddEquivalence(worker->FragmentId, worker->FragmentId);
           // We have to mark every voxel we push on the queue.
-          *(xIterator->FragmentIdPointer) = this->FragmentId;
+          *(xIterator->FragmentIdPointer) = worker->FragmentId;
           // There should be no need to clear the queue.
           queue->Push(xIterator);
-          this->ConnectFragment(queue);
+          this->ConnectFragment(worker, queue);
           // save the current fragment mesh
           // the id is implicit given by its position in the vector, but only
           // until fragments are resolved. After resolution we add addributes such
           // as id, volume, summations averages, etc..
-          this->CurrentFragmentMesh->Squeeze();
-          this->FragmentMeshes.push_back(this->CurrentFragmentMesh);
+          worker->CurrentFragmentMesh->Squeeze();
+          worker->FragmentMeshes->push_back(worker->CurrentFragmentMesh);
           // Save the volume from the last fragment.
-          this->FragmentVolumes->InsertTuple1(this->FragmentId, this->FragmentVolume);
+          worker->FragmentVolumes->InsertTuple1(worker->FragmentId, worker->FragmentVolume);
           if (this->ClipWithPlane)
           {
-            this->ClipDepthMaximums->InsertTuple1(this->FragmentId, this->ClipDepthMax);
-            this->ClipDepthMinimums->InsertTuple1(this->FragmentId, this->ClipDepthMin);
+            worker->ClipDepthMaximums->InsertTuple1(worker->FragmentId, worker->ClipDepthMax);
+            worker->ClipDepthMinimums->InsertTuple1(worker->FragmentId, worker->ClipDepthMin);
           }
           // clear the volume accumulator
-          this->FragmentVolume = 0.0;
-          this->ClipDepthMax = 0.0;
-          this->ClipDepthMin = VTK_FLOAT_MAX;
+          worker->FragmentVolume = 0.0;
+          worker->ClipDepthMax = 0.0;
+          worker->ClipDepthMin = VTK_FLOAT_MAX;
           if (this->ComputeMoments)
           {
             // Save the moments from the last fragment
-            this->FragmentMoments->InsertTuple(this->FragmentId, &this->FragmentMoment[0]);
+            worker->FragmentMoments->InsertTuple(worker->FragmentId, &worker->FragmentMoment[0]);
             // clear the moment accumulator
-            FillVector(this->FragmentMoment, 0.0);
+            FillVector(worker->FragmentMoment, 0.0);
           }
           // for the volume weighted averaged scalars/vectors...
           for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
           {
             // update the integrated value, independent of ncomps
-            this->FragmentVolumeWtdAvgs[i]->InsertTuple(
-              this->FragmentId, &this->FragmentVolumeWtdAvg[i][0]);
+            worker->FragmentVolumeWtdAvgs[i]->InsertTuple(
+              worker->FragmentId, &worker->FragmentVolumeWtdAvg[i][0]);
             // clear the accumulator
-            FillVector(this->FragmentVolumeWtdAvg[i], 0.0);
+            FillVector(worker->FragmentVolumeWtdAvg[i], 0.0);
           }
           // for the mass weighted averaged scalars/vectors...
           for (int i = 0; i < this->NMassWtdAvgs; ++i)
           {
             // update the integrated value, independent of ncomps
-            this->FragmentMassWtdAvgs[i]->InsertTuple(
-              this->FragmentId, &this->FragmentMassWtdAvg[i][0]);
+            worker->FragmentMassWtdAvgs[i]->InsertTuple(
+              worker->FragmentId, &worker->FragmentMassWtdAvg[i][0]);
             // clear the accumulator
-            FillVector(this->FragmentMassWtdAvg[i], 0.0);
+            FillVector(worker->FragmentMassWtdAvg[i], 0.0);
           }
           // for the summed scalars/vectors...
           for (int i = 0; i < this->NToSum; ++i)
           {
             // update the integrated value, independent of ncomps
-            this->FragmentSums[i]->InsertTuple(this->FragmentId, &this->FragmentSum[i][0]);
+            worker->FragmentSums[i]->InsertTuple(worker->FragmentId, &worker->FragmentSum[i][0]);
             // clear the accumulator
-            FillVector(this->FragmentSum[i], 0.0);
+            FillVector(worker->FragmentSum[i], 0.0);
           }
           // Move to next fragment.
-          ++this->FragmentId;
+          ++worker->FragmentId;
         }
         xIterator->FlatIndex += cellIncs[0]; // 1/ncomp
         xIterator->VolumeFractionPointer += cellIncs[0];
@@ -4223,8 +4512,9 @@ int vtkMaterialInterfaceFilter::ComputeDisplacementFactors(
 // It will be modified with the sub voxel displacement.
 // The return value indicates that an edge may be non manifold.
 // It returns the y or z axis index of the edge that may be non manifold.
-int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
-  vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx, int faceAxis)
+int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(vtkMaterialInterfaceFilterWorker* worker,
+  double* point, vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx,
+  int faceAxis)
 {
   int retVal;
 
@@ -4272,13 +4562,13 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
     projection = (point[0] - this->ClipCenter[0]) * this->ClipPlaneNormal[0];
     projection += (point[1] - this->ClipCenter[1]) * this->ClipPlaneNormal[1];
     projection += (point[2] - this->ClipCenter[2]) * this->ClipPlaneNormal[2];
-    if (this->ClipDepthMax < projection)
+    if (worker->ClipDepthMax < projection)
     {
-      this->ClipDepthMax = projection;
+      worker->ClipDepthMax = projection;
     }
-    if (this->ClipDepthMin > projection)
+    if (worker->ClipDepthMin > projection)
     {
-      this->ClipDepthMin = projection;
+      worker->ClipDepthMin = projection;
     }
   }
 
@@ -4296,8 +4586,9 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
 // Now to fix cracks.  If neighbors are higher level,
 // I need to have more than 4 points for a face.
 // I am only going to support transitions of 1 level.
-void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterWorker* worker,
+  vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+  int outMaxFlag)
 {
   if (in->Block == nullptr || in->Block->GetGhostFlag())
   {
@@ -4320,8 +4611,8 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // Add points to the output.  Create separate points for each triangle.
   // We can worry about merging points later.
   vtkMaterialInterfaceFilterIterator* cornerNeighbors[8];
-  vtkPoints* points = this->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
-  vtkCellArray* polys = this->CurrentFragmentMesh->GetPolys();
+  vtkPoints* points = worker->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
+  vtkCellArray* polys = worker->CurrentFragmentMesh->GetPolys();
   vtkIdType quadCornerIds[4];
   vtkIdType quadMidIds[4];
   vtkIdType triPtIds[3];
@@ -4332,10 +4623,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
   // Compute the corner and edge points (before subpixel positioning).
   // Store the results in ivars.
-  this->ComputeFacePoints(in, out, axis, outMaxFlag);
+  this->ComputeFacePoints(worker, in, out, axis, outMaxFlag);
   // Find the neighbor iterators.
   // Store the results in ivars.
-  this->ComputeFaceNeighbors(in, out, axis, outMaxFlag);
+  this->ComputeFaceNeighbors(worker, in, out, axis, outMaxFlag);
 
   // A word about indexing:
   // face neighbors 2x4x4 indexed face normal axis first, axis1, then axis2.
@@ -4370,55 +4661,55 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // to perform connectivity on the 2x2x2 point neighbors.
   int inNeighborIdx;
 
-  cornerNeighbors[i0] = &(this->FaceNeighbors[0]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[1]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[2]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[3]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[8]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[9]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[10]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[11]);
+  cornerNeighbors[i0] = &(worker->FaceNeighbors[0]);
+  cornerNeighbors[i1] = &(worker->FaceNeighbors[1]);
+  cornerNeighbors[i2] = &(worker->FaceNeighbors[2]);
+  cornerNeighbors[i3] = &(worker->FaceNeighbors[3]);
+  cornerNeighbors[i4] = &(worker->FaceNeighbors[8]);
+  cornerNeighbors[i5] = &(worker->FaceNeighbors[9]);
+  cornerNeighbors[i6] = &(worker->FaceNeighbors[10]);
+  cornerNeighbors[i7] = &(worker->FaceNeighbors[11]);
   inNeighborIdx = outMaxFlag ? i6 : i7; // Face neighbor 10 or 11
-  manifoldIssue[0] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis);
+  manifoldIssue[0] = this->SubVoxelPositionCorner(
+    worker, worker->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis);
   // 1 =>
-  quadCornerIds[0] = points->InsertNextPoint(this->FaceCornerPoints);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[4]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[5]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[6]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[7]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[12]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[13]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[14]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[15]);
+  quadCornerIds[0] = points->InsertNextPoint(worker->FaceCornerPoints);
+  cornerNeighbors[i0] = &(worker->FaceNeighbors[4]);
+  cornerNeighbors[i1] = &(worker->FaceNeighbors[5]);
+  cornerNeighbors[i2] = &(worker->FaceNeighbors[6]);
+  cornerNeighbors[i3] = &(worker->FaceNeighbors[7]);
+  cornerNeighbors[i4] = &(worker->FaceNeighbors[12]);
+  cornerNeighbors[i5] = &(worker->FaceNeighbors[13]);
+  cornerNeighbors[i6] = &(worker->FaceNeighbors[14]);
+  cornerNeighbors[i7] = &(worker->FaceNeighbors[15]);
   inNeighborIdx = outMaxFlag ? i4 : i5; // Face neighbor 12 or 13
-  manifoldIssue[1] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[1] = points->InsertNextPoint(this->FaceCornerPoints + 3);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[16]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[17]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[18]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[19]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[24]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[25]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[26]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[27]);
+  manifoldIssue[1] = this->SubVoxelPositionCorner(
+    worker, worker->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis);
+  quadCornerIds[1] = points->InsertNextPoint(worker->FaceCornerPoints + 3);
+  cornerNeighbors[i0] = &(worker->FaceNeighbors[16]);
+  cornerNeighbors[i1] = &(worker->FaceNeighbors[17]);
+  cornerNeighbors[i2] = &(worker->FaceNeighbors[18]);
+  cornerNeighbors[i3] = &(worker->FaceNeighbors[19]);
+  cornerNeighbors[i4] = &(worker->FaceNeighbors[24]);
+  cornerNeighbors[i5] = &(worker->FaceNeighbors[25]);
+  cornerNeighbors[i6] = &(worker->FaceNeighbors[26]);
+  cornerNeighbors[i7] = &(worker->FaceNeighbors[27]);
   inNeighborIdx = outMaxFlag ? i2 : i3; // Face neighbor 18 or 19
-  manifoldIssue[2] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[2] = points->InsertNextPoint(this->FaceCornerPoints + 6);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[20]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[21]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[22]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[23]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[28]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[29]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[30]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[31]);
+  manifoldIssue[2] = this->SubVoxelPositionCorner(
+    worker, worker->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis);
+  quadCornerIds[2] = points->InsertNextPoint(worker->FaceCornerPoints + 6);
+  cornerNeighbors[i0] = &(worker->FaceNeighbors[20]);
+  cornerNeighbors[i1] = &(worker->FaceNeighbors[21]);
+  cornerNeighbors[i2] = &(worker->FaceNeighbors[22]);
+  cornerNeighbors[i3] = &(worker->FaceNeighbors[23]);
+  cornerNeighbors[i4] = &(worker->FaceNeighbors[28]);
+  cornerNeighbors[i5] = &(worker->FaceNeighbors[29]);
+  cornerNeighbors[i6] = &(worker->FaceNeighbors[30]);
+  cornerNeighbors[i7] = &(worker->FaceNeighbors[31]);
   inNeighborIdx = outMaxFlag ? i0 : i1; // Face neighbor 20 or 21
-  manifoldIssue[3] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[3] = points->InsertNextPoint(this->FaceCornerPoints + 9);
+  manifoldIssue[3] = this->SubVoxelPositionCorner(
+    worker, worker->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis);
+  quadCornerIds[3] = points->InsertNextPoint(worker->FaceCornerPoints + 9);
 
   // If both corners of an edge have an issue, the we need an extra
   // point on the edge to generate a hole.
@@ -4431,93 +4722,97 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   if (manifoldIssue[0] != 0 && manifoldIssue[1] != 0 && tmp[manifoldIssue[0]] == 1 &&
     tmp[manifoldIssue[1]] == 1)
   {
-    this->FaceEdgeFlags[0] = 1;
+    worker->FaceEdgeFlags[0] = 1;
   }
 
   if (manifoldIssue[0] != 0 && manifoldIssue[2] != 0 && tmp[manifoldIssue[0]] == 2 &&
     tmp[manifoldIssue[2]] == 2)
   {
-    this->FaceEdgeFlags[1] = 1;
+    worker->FaceEdgeFlags[1] = 1;
   }
   if (manifoldIssue[1] != 0 && manifoldIssue[3] != 0 && tmp[manifoldIssue[1]] == 2 &&
     tmp[manifoldIssue[3]] == 2)
   {
-    this->FaceEdgeFlags[2] = 1;
+    worker->FaceEdgeFlags[2] = 1;
   }
   if (manifoldIssue[2] != 0 && manifoldIssue[3] && tmp[manifoldIssue[2]] == 1 &&
     tmp[manifoldIssue[3]] == 1)
   {
-    this->FaceEdgeFlags[3] = 1;
+    worker->FaceEdgeFlags[3] = 1;
   }
 
   // Now for the mid edge point if the neighbors on that side are smaller.
-  if (this->FaceEdgeFlags[0])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[2]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[3]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[4]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[5]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[13]);
+  if (worker->FaceEdgeFlags[0])
+  {
+    cornerNeighbors[i0] = &(worker->FaceNeighbors[2]);
+    cornerNeighbors[i1] = &(worker->FaceNeighbors[3]);
+    cornerNeighbors[i2] = &(worker->FaceNeighbors[4]);
+    cornerNeighbors[i3] = &(worker->FaceNeighbors[5]);
+    cornerNeighbors[i4] = &(worker->FaceNeighbors[10]);
+    cornerNeighbors[i5] = &(worker->FaceNeighbors[11]);
+    cornerNeighbors[i6] = &(worker->FaceNeighbors[12]);
+    cornerNeighbors[i7] = &(worker->FaceNeighbors[13]);
     // Two choices here (10, 12) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i4 : i5;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[0] = points->InsertNextPoint(this->FaceEdgePoints);
-  }
-  if (this->FaceEdgeFlags[1])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[8]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[9]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[16]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[17]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[19]);
+    this->SubVoxelPositionCorner(
+      worker, worker->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[0] = points->InsertNextPoint(worker->FaceEdgePoints);
+  }
+  if (worker->FaceEdgeFlags[1])
+  {
+    cornerNeighbors[i0] = &(worker->FaceNeighbors[8]);
+    cornerNeighbors[i1] = &(worker->FaceNeighbors[9]);
+    cornerNeighbors[i2] = &(worker->FaceNeighbors[10]);
+    cornerNeighbors[i3] = &(worker->FaceNeighbors[11]);
+    cornerNeighbors[i4] = &(worker->FaceNeighbors[16]);
+    cornerNeighbors[i5] = &(worker->FaceNeighbors[17]);
+    cornerNeighbors[i6] = &(worker->FaceNeighbors[18]);
+    cornerNeighbors[i7] = &(worker->FaceNeighbors[19]);
     // Two choices here (10, 18) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i2 : i3;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[1] = points->InsertNextPoint(this->FaceEdgePoints + 3);
-  }
-  if (this->FaceEdgeFlags[2])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[13]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[14]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[15]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[22]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[23]);
+    this->SubVoxelPositionCorner(
+      worker, worker->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[1] = points->InsertNextPoint(worker->FaceEdgePoints + 3);
+  }
+  if (worker->FaceEdgeFlags[2])
+  {
+    cornerNeighbors[i0] = &(worker->FaceNeighbors[12]);
+    cornerNeighbors[i1] = &(worker->FaceNeighbors[13]);
+    cornerNeighbors[i2] = &(worker->FaceNeighbors[14]);
+    cornerNeighbors[i3] = &(worker->FaceNeighbors[15]);
+    cornerNeighbors[i4] = &(worker->FaceNeighbors[20]);
+    cornerNeighbors[i5] = &(worker->FaceNeighbors[21]);
+    cornerNeighbors[i6] = &(worker->FaceNeighbors[22]);
+    cornerNeighbors[i7] = &(worker->FaceNeighbors[23]);
     // Two choices here (12, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[2] = points->InsertNextPoint(this->FaceEdgePoints + 6);
-  }
-  if (this->FaceEdgeFlags[3])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[19]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[26]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[27]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[28]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[29]);
+    this->SubVoxelPositionCorner(
+      worker, worker->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[2] = points->InsertNextPoint(worker->FaceEdgePoints + 6);
+  }
+  if (worker->FaceEdgeFlags[3])
+  {
+    cornerNeighbors[i0] = &(worker->FaceNeighbors[18]);
+    cornerNeighbors[i1] = &(worker->FaceNeighbors[19]);
+    cornerNeighbors[i2] = &(worker->FaceNeighbors[20]);
+    cornerNeighbors[i3] = &(worker->FaceNeighbors[21]);
+    cornerNeighbors[i4] = &(worker->FaceNeighbors[26]);
+    cornerNeighbors[i5] = &(worker->FaceNeighbors[27]);
+    cornerNeighbors[i6] = &(worker->FaceNeighbors[28]);
+    cornerNeighbors[i7] = &(worker->FaceNeighbors[29]);
     // Two choices here (18, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[3] = points->InsertNextPoint(this->FaceEdgePoints + 9);
+    this->SubVoxelPositionCorner(
+      worker, worker->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis);
+    quadMidIds[3] = points->InsertNextPoint(worker->FaceEdgePoints + 9);
   }
 
   // Now there are 9 possibilities
   // (10 if you count the two ways to triangulate the simple quad).
   // No edges, $ cases with one mid point, 4 cases with two mid points.
   // That is all because the face is always the smallest of the two in/out voxels.
-  int caseIdx = this->FaceEdgeFlags[0] | (this->FaceEdgeFlags[1] << 1) |
-    (this->FaceEdgeFlags[2] << 2) | (this->FaceEdgeFlags[3] << 3);
+  int caseIdx = worker->FaceEdgeFlags[0] | (worker->FaceEdgeFlags[1] << 1) |
+    (worker->FaceEdgeFlags[2] << 2) | (worker->FaceEdgeFlags[3] << 3);
 
   // c2 e3 c3
   // e1    e2
@@ -4663,10 +4958,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
       // This will help us decide which way to split up the quad into triangles.
       double d0011 = 0.0;
       double d0110 = 0.0;
-      double* pt00 = this->FaceCornerPoints;
-      double* pt01 = this->FaceCornerPoints + 3;
-      double* pt10 = this->FaceCornerPoints + 6;
-      double* pt11 = this->FaceCornerPoints + 9;
+      double* pt00 = worker->FaceCornerPoints;
+      double* pt01 = worker->FaceCornerPoints + 3;
+      double* pt10 = worker->FaceCornerPoints + 6;
+      double* pt11 = worker->FaceCornerPoints + 9;
       for (int ii = 0; ii < 3; ++ii)
       {
         double tmp2 = pt00[ii] - pt11[ii];
@@ -4716,7 +5011,7 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
     // fragment
     vtkDoubleArray* destArray =
-      dynamic_cast<vtkDoubleArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray(i));
+      dynamic_cast<vtkDoubleArray*>(worker->CurrentFragmentMesh->GetCellData()->GetArray(i));
     for (vtkIdType ii = 0; ii < numTris; ++ii)
     {
       destArray->InsertNextTuple(&thisTup[0]);
@@ -4725,13 +5020,13 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 // Cell data attributes for debugging.
 #ifdef vtkMaterialInterfaceFilterDEBUG
   vtkIntArray* levelArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
+    dynamic_cast<vtkIntArray*>(worker->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
 
   vtkIntArray* blockIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
+    dynamic_cast<vtkIntArray*>(worker->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
 
   vtkIntArray* procIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
+    dynamic_cast<vtkIntArray*>(worker->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
 
   for (vtkIdType ii = 0; ii < numTris; ++ii)
   {
@@ -4745,8 +5040,9 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 //----------------------------------------------------------------------------
 // Computes the face and edge middle points of the shared contact face
 // between the two iterators.
-void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterWorker* worker,
+  vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+  int outMaxFlag)
 {
   vtkMaterialInterfaceFilterIterator* smaller;
   double* origin;
@@ -4786,41 +5082,42 @@ void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIte
   // 6 9
   // 0 3
   // First set them all to the origin.
-  this->FaceCornerPoints[0] = this->FaceCornerPoints[3] = this->FaceCornerPoints[6] =
-    this->FaceCornerPoints[9] = faceOrigin[0];
-  this->FaceCornerPoints[1] = this->FaceCornerPoints[4] = this->FaceCornerPoints[7] =
-    this->FaceCornerPoints[10] = faceOrigin[1];
-  this->FaceCornerPoints[2] = this->FaceCornerPoints[5] = this->FaceCornerPoints[8] =
-    this->FaceCornerPoints[11] = faceOrigin[2];
+  worker->FaceCornerPoints[0] = worker->FaceCornerPoints[3] = worker->FaceCornerPoints[6] =
+    worker->FaceCornerPoints[9] = faceOrigin[0];
+  worker->FaceCornerPoints[1] = worker->FaceCornerPoints[4] = worker->FaceCornerPoints[7] =
+    worker->FaceCornerPoints[10] = faceOrigin[1];
+  worker->FaceCornerPoints[2] = worker->FaceCornerPoints[5] = worker->FaceCornerPoints[8] =
+    worker->FaceCornerPoints[11] = faceOrigin[2];
   // Now offset them to the corners.
-  this->FaceCornerPoints[3 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[9 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[6 + axis2] += spacing[axis2];
-  this->FaceCornerPoints[9 + axis2] += spacing[axis2];
+  worker->FaceCornerPoints[3 + axis1] += spacing[axis1];
+  worker->FaceCornerPoints[9 + axis1] += spacing[axis1];
+  worker->FaceCornerPoints[6 + axis2] += spacing[axis2];
+  worker->FaceCornerPoints[9 + axis2] += spacing[axis2];
 
   // Now do the same for the edge points
   //   3
   // 1   2
   //   0
   // First set them all to the origin.
-  this->FaceEdgePoints[0] = this->FaceEdgePoints[3] = this->FaceEdgePoints[6] =
-    this->FaceEdgePoints[9] = faceOrigin[0];
-  this->FaceEdgePoints[1] = this->FaceEdgePoints[4] = this->FaceEdgePoints[7] =
-    this->FaceEdgePoints[10] = faceOrigin[1];
-  this->FaceEdgePoints[2] = this->FaceEdgePoints[5] = this->FaceEdgePoints[8] =
-    this->FaceEdgePoints[11] = faceOrigin[2];
+  worker->FaceEdgePoints[0] = worker->FaceEdgePoints[3] = worker->FaceEdgePoints[6] =
+    worker->FaceEdgePoints[9] = faceOrigin[0];
+  worker->FaceEdgePoints[1] = worker->FaceEdgePoints[4] = worker->FaceEdgePoints[7] =
+    worker->FaceEdgePoints[10] = faceOrigin[1];
+  worker->FaceEdgePoints[2] = worker->FaceEdgePoints[5] = worker->FaceEdgePoints[8] =
+    worker->FaceEdgePoints[11] = faceOrigin[2];
   // Now offset the points to the middle of the edges.
-  this->FaceEdgePoints[axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[6 + axis1] += spacing[axis1];
-  this->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[9 + axis2] += spacing[axis2];
+  worker->FaceEdgePoints[axis1] += halfSpacing[axis1];
+  worker->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
+  worker->FaceEdgePoints[6 + axis1] += spacing[axis1];
+  worker->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
+  worker->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
+  worker->FaceEdgePoints[9 + axis2] += spacing[axis2];
 }
 
 //----------------------------------------------------------------------------
-void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilterWorker* worker,
+  vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+  int outMaxFlag)
 {
   int axis1 = (axis + 1) % 3;
   int axis2 = (axis + 2) % 3;
@@ -4867,17 +5164,17 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // for subdivision.
   if (outMaxFlag)
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *in;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *out;
+    worker->FaceNeighbors[10] = worker->FaceNeighbors[12] = worker->FaceNeighbors[18] =
+      worker->FaceNeighbors[20] = *in;
+    worker->FaceNeighbors[11] = worker->FaceNeighbors[13] = worker->FaceNeighbors[19] =
+      worker->FaceNeighbors[21] = *out;
   }
   else
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *out;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *in;
+    worker->FaceNeighbors[10] = worker->FaceNeighbors[12] = worker->FaceNeighbors[18] =
+      worker->FaceNeighbors[20] = *out;
+    worker->FaceNeighbors[11] = worker->FaceNeighbors[13] = worker->FaceNeighbors[19] =
+      worker->FaceNeighbors[21] = *in;
   }
 
   // Ok, we have 24 neighbors to compute.
@@ -4887,91 +5184,91 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // increments: 1, 2, 8
   // Start at the corner and march around the edges.
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 3, this->FaceNeighbors + 11);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 3, worker->FaceNeighbors + 11);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 5, this->FaceNeighbors + 3);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 5, worker->FaceNeighbors + 3);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 7, this->FaceNeighbors + 5);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 7, worker->FaceNeighbors + 5);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 15, this->FaceNeighbors + 7);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 15, worker->FaceNeighbors + 7);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 23, this->FaceNeighbors + 15);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 23, worker->FaceNeighbors + 15);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 31, this->FaceNeighbors + 23);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 31, worker->FaceNeighbors + 23);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 29, this->FaceNeighbors + 31);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 29, worker->FaceNeighbors + 31);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 27, this->FaceNeighbors + 29);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 27, worker->FaceNeighbors + 29);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 25, this->FaceNeighbors + 27);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 25, worker->FaceNeighbors + 27);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 17, this->FaceNeighbors + 25);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 17, worker->FaceNeighbors + 25);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 9, this->FaceNeighbors + 17);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 9, worker->FaceNeighbors + 17);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 1, this->FaceNeighbors + 9);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 1, worker->FaceNeighbors + 9);
   // Now for the other side (min axis).
   faceIndex[axis] -= 1;  // Move to the other layer
   faceIndex[axis1] += 1; // Start below reference block.
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 2, this->FaceNeighbors + 10);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 2, worker->FaceNeighbors + 10);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 4, this->FaceNeighbors + 2);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 4, worker->FaceNeighbors + 2);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 6, this->FaceNeighbors + 4);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 6, worker->FaceNeighbors + 4);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 14, this->FaceNeighbors + 6);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 14, worker->FaceNeighbors + 6);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 22, this->FaceNeighbors + 14);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 22, worker->FaceNeighbors + 14);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 30, this->FaceNeighbors + 22);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 30, worker->FaceNeighbors + 22);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 28, this->FaceNeighbors + 30);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 28, worker->FaceNeighbors + 30);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 26, this->FaceNeighbors + 28);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 26, worker->FaceNeighbors + 28);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 24, this->FaceNeighbors + 26);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 24, worker->FaceNeighbors + 26);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 16, this->FaceNeighbors + 24);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 16, worker->FaceNeighbors + 24);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 8, this->FaceNeighbors + 16);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 8, worker->FaceNeighbors + 16);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 0, this->FaceNeighbors + 8);
+  this->FindNeighbor(faceIndex, faceLevel, worker->FaceNeighbors + 0, worker->FaceNeighbors + 8);
 
   // Split edges if neighbors are a higher level than face.
   --faceLevel;
-  this->FaceEdgeFlags[0] = 0;
+  worker->FaceEdgeFlags[0] = 0;
   // Checking equivalences (this->FaceNeighbor[2] != this->FaceNeighbor[4])
   // May be faster and work fine.
-  if (this->FaceNeighbors[2].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[3].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[4].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[5].Block->GetLevel() > faceLevel)
+  if (worker->FaceNeighbors[2].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[3].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[4].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[5].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[0] = 1;
+    worker->FaceEdgeFlags[0] = 1;
   }
-  this->FaceEdgeFlags[1] = 0;
-  if (this->FaceNeighbors[8].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[9].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[16].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[17].Block->GetLevel() > faceLevel)
+  worker->FaceEdgeFlags[1] = 0;
+  if (worker->FaceNeighbors[8].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[9].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[16].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[17].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[1] = 1;
+    worker->FaceEdgeFlags[1] = 1;
   }
-  this->FaceEdgeFlags[2] = 0;
-  if (this->FaceNeighbors[14].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[15].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[22].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[23].Block->GetLevel() > faceLevel)
+  worker->FaceEdgeFlags[2] = 0;
+  if (worker->FaceNeighbors[14].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[15].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[22].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[23].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[2] = 1;
+    worker->FaceEdgeFlags[2] = 1;
   }
-  this->FaceEdgeFlags[3] = 0;
-  if (this->FaceNeighbors[26].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[27].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[28].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[29].Block->GetLevel() > faceLevel)
+  worker->FaceEdgeFlags[3] = 0;
+  if (worker->FaceNeighbors[26].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[27].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[28].Block->GetLevel() > faceLevel ||
+    worker->FaceNeighbors[29].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[3] = 1;
+    worker->FaceEdgeFlags[3] = 1;
   }
 }
 
@@ -5452,7 +5749,8 @@ inline int vtkMaterialInterfaceFilter::AccumulateMoments(double* moments, // =(M
 // This integrates quantities at the same time.
 // This is called only when the voxel is part of a fragment.
 // I tried to create a generic API to replace the hard coded conditional ifs.
-void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* queue)
+void vtkMaterialInterfaceFilter::ConnectFragment(
+  vtkMaterialInterfaceFilterWorker* worker, vtkMaterialInterfaceFilterRingBuffer* queue)
 {
   while (queue->GetSize())
   {
@@ -5472,14 +5770,14 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       double voxelVolumeFrac =
         dX[0] * dX[1] * dX[2] * (double)(*(iterator.VolumeFractionPointer)) / 255.0;
 #endif
-      this->FragmentVolume += voxelVolumeFrac;
+      worker->FragmentVolume += voxelVolumeFrac;
       // The clip depth is accumulated in SubvoxelPositionCorner.
       // accumulate volume weighted average
       for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
       {
         vtkDataArray* arrayToIntegrate = iterator.Block->GetVolumeWtdAvgArray(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
-        this->Accumulate(&this->FragmentVolumeWtdAvg[i][0], arrayToIntegrate, nComps,
+        this->Accumulate(&worker->FragmentVolumeWtdAvg[i][0], arrayToIntegrate, nComps,
           iterator.FlatIndex, voxelVolumeFrac);
       }
       // accumulate mass weighted average
@@ -5491,7 +5789,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         const double* X0 = iterator.Block->GetOrigin();
         double X[3] = { X0[0] + dX[0] * (0.5 + iterator.Index[0]),
           X0[1] + dX[1] * (0.5 + iterator.Index[1]), X0[2] + dX[2] * (0.5 + iterator.Index[2]) };
-        this->AccumulateMoments(&this->FragmentMoment[0], massArray, iterator.FlatIndex, X);
+        this->AccumulateMoments(&worker->FragmentMoment[0], massArray, iterator.FlatIndex, X);
         // mass weighted averages
         double voxelMass;
         massArray->GetTuple(iterator.FlatIndex, &voxelMass);
@@ -5499,7 +5797,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         {
           vtkDataArray* arrayToIntegrate = iterator.Block->GetMassWtdAvgArray(i);
           int nComps = arrayToIntegrate->GetNumberOfComponents();
-          this->Accumulate(&this->FragmentMassWtdAvg[i][0], arrayToIntegrate, nComps,
+          this->Accumulate(&worker->FragmentMassWtdAvg[i][0], arrayToIntegrate, nComps,
             iterator.FlatIndex, voxelMass);
         }
       }
@@ -5509,7 +5807,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         vtkDataArray* arrayToIntegrate = iterator.Block->GetArrayToSum(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
         this->Accumulate(
-          &this->FragmentSum[i][0], arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
+          &worker->FragmentSum[i][0], arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
       }
     }
 
@@ -5528,185 +5826,40 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       // axis2 = (ii+2)%3;
       // idxMin = 2*ii;
       // idxMax = 2*ii+1this->IndexMax+1;
-      // "Left"/min
-      this->GetNeighborIterator(&next, &iterator, ii, 0, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
-
-      if (next.VolumeFractionPointer == nullptr ||
-        next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-      {
-        // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 0);
-      }
-      else if (next.FragmentIdPointer[0] == -1)
-      { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
-        queue->Push(&next);
-      }
-      else
-      { // The last case is that we have already visited this voxel and it
-        // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
-      }
-
-      // Handle the case when the new iterator is a higher level.
-      // We need to loop over all the faces of the higher level that touch this face.
-      // We will restrict our case to 4 neighbors (max difference in levels is 1).
-      // If level skip, things should still work OK. Biggest issue is holes in surface.
-      // This also sort of assumes that at most one other block touches this face.
-      // Holes might appear if this is not true.
-      if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
+      for (int maxFlag = 0; maxFlag < 2; ++maxFlag)
       {
-        vtkMaterialInterfaceFilterIterator next2;
-        bool threeDimFlag = next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
-        // Take the first neighbor found and move +Y
-        if (ii != 1 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // Take the fist iterator found and move +Z
-        if (ii != 0 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
-        if (next2.Block && threeDimFlag)
+        // "Left"/min then "Right"/max
+        this->GetNeighborIterator(&next, &iterator, ii, maxFlag, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
+        this->ConnectNeighbor(worker, queue, &iterator, &next, &iterator, ii, maxFlag);
+
+        // Handle the case when the new iterator is a higher level.
+        // We need to loop over all the faces of the higher level that touch this face.
+        // We will restrict our case to 4 neighbors (max difference in levels is 1).
+        // If level skip, things should still work OK. Biggest issue is holes in surface.
+        // This also sort of assumes that at most one other block touches this face.
+        // Holes might appear if this is not true.
+        if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
         {
-          this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == nullptr ||
-            next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 0);
-          }
-          else if (next.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-      }
-
-      // "Right"/max
-      this->GetNeighborIterator(&next, &iterator, ii, 1, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
-      if (next.VolumeFractionPointer == nullptr ||
-        next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-      { // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 1);
-      }
-      else if (next.FragmentIdPointer[0] == -1)
-      { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
-        queue->Push(&next);
-      }
-      else
-      { // The last case is that we have already visited this voxel and it
-        // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
-      }
-      // Same case as above with the same logic to visit the
-      // four smaller cells that touch this face of the current block.
-      if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
-      {
-        vtkMaterialInterfaceFilterIterator next2;
-        bool threeDimFlag = next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
-        // Take the first neighbor found and move +Y
-        if (ii != 1 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // Take the fist iterator found and move +Z
-        if (ii != 0 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
+          vtkMaterialInterfaceFilterIterator next2;
+          bool threeDimFlag =
+            next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
+          // Take the first neighbor found and move +Y
+          if (ii != 1 || threeDimFlag)
+          { // stupid after the fact way of dealing with 2d AMR input.
+            this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
+            this->ConnectNeighbor(worker, queue, &iterator, &next2, &next, ii, maxFlag);
           }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+          // Take the fist iterator found and move +Z
+          if (ii != 0 || threeDimFlag)
+          { // stupid after the fact way of dealing with 2d AMR input.
+            this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
+            this->ConnectNeighbor(worker, queue, &iterator, &next2, &next, ii, maxFlag);
           }
-        }
-        // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
-        if (next2.Block && threeDimFlag)
-        {
-          this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == nullptr ||
-            next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+          // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
+          if (next2.Block && threeDimFlag)
           {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 1);
-          }
-          else if (next.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
+            this->ConnectNeighbor(worker, queue, &iterator, &next, &next2, ii, maxFlag);
           }
         }
       }
@@ -5714,6 +5867,37 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
   }
 }
 
+//----------------------------------------------------------------------------
+// Visit a voxel touching a face of the voxel being searched: create the
+// face, or add the neighbor to the fragment. When the neighbor was already
+// visited, it is made equivalent to "reference".
+void vtkMaterialInterfaceFilter::ConnectNeighbor(vtkMaterialInterfaceFilterWorker* worker,
+  vtkMaterialInterfaceFilterRingBuffer* queue, vtkMaterialInterfaceFilterIterator* iterator,
+  vtkMaterialInterfaceFilterIterator* neighbor, vtkMaterialInterfaceFilterIterator* reference,
+  int axis, int outMaxFlag)
+{
+  if (neighbor->VolumeFractionPointer == nullptr ||
+    neighbor->VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+  { // Neighbor is outside of fragment.  Make a face.
+    this->CreateFace(worker, iterator, neighbor, axis, outMaxFlag);
+  }
+  else if (worker->Block && neighbor->Block != worker->Block)
+  { // Another worker may be searching this block. Connect the fragments
+    // once all blocks have been searched.
+    worker->Links.emplace_back(worker->FragmentId, *neighbor);
+  }
+  else if (neighbor->FragmentIdPointer[0] == -1)
+  { // We have not visited this neighbor yet. Mark the voxel and recurse.
+    *(neighbor->FragmentIdPointer) = worker->FragmentId;
+    queue->Push(neighbor);
+  }
+  else
+  { // The last case is that we have already visited this voxel and it
+    // is in the same fragment.
+    this->AddEquivalence(worker, worker->Block ? iterator : reference, neighbor);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -6309,7 +6493,7 @@ void vtkMaterialInterfaceFilter::SetUpperLoadingBound(int nPolys)
 // Chains can leave orphans, loops break when two nodes in the loop are
 // equated a second time.
 // Lets try a directed tree
-void vtkMaterialInterfaceFilter::AddEquivalence(
+void vtkMaterialInterfaceFilter::AddEquivalence(vtkMaterialInterfaceFilterWorker* worker,
   vtkMaterialInterfaceFilterIterator* neighbor1, vtkMaterialInterfaceFilterIterator* neighbor2)
 {
   int id1 = *(neighbor1->FragmentIdPointer);
@@ -6317,7 +6501,7 @@ void vtkMaterialInterfaceFilter::AddEquivalence(
 
   if (id1 != id2 && id1 != -1 && id2 != -1)
   {
-    this->EquivalenceSet->AddEquivalence(id1, id2);
+    worker->EquivalenceSet->AddEquivalence(id1, id2);
   }
 }
 
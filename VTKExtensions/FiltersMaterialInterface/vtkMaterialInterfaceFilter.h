@@ -52,6 +52,7 @@ class vtkMaterialInterfaceFilterBlock;
 class vtkMaterialInterfaceFilterIterator;
 class vtkMaterialInterfaceEquivalenceSet;
 class vtkMaterialInterfaceFilterRingBuffer;
+class vtkMaterialInterfaceFilterWorker;
 class vtkMaterialInterfacePieceLoading;
 class vtkMaterialInterfaceCommBuffer;
 
@@ -250,6 +251,17 @@ public:
   vtkGetMacro(ComputeOBB, bool);
   ///@}
 
+  /// Threading
+  ///@{
+  /**
+   * When on, the local blocks are searched for fragments concurrently using
+   * vtkSMPTools. Fragments crossing block boundaries are merged within the
+   * process before they are resolved across processes. Off by default.
+   */
+  vtkSetMacro(UseThreads, bool);
+  vtkGetMacro(UseThreads, bool);
+  ///@}
+
   /// Loading
   ///@{
   /**
@@ -337,22 +349,33 @@ protected:
     std::vector<std::string>& integratedArrayNames);
   // Create a new fragment/piece.
   vtkPolyData* NewFragmentMesh();
+  // Set up the state used to search for fragments, optionally restricted
+  // to a single block.
+  void InitializeWorker(
+    vtkMaterialInterfaceFilterWorker* worker, vtkMaterialInterfaceFilterBlock* block);
+  // Process all local blocks, serially or using threads.
+  void ProcessBlocks();
   // Process each cell, looking for fragments.
-  int ProcessBlock(int blockId);
+  int ProcessBlock(vtkMaterialInterfaceFilterWorker* worker, int blockId);
   // Cell has been identified as inside the fragment. Integrate, and
   // generate fragment surface etc...
-  void ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* iterator);
+  void ConnectFragment(
+    vtkMaterialInterfaceFilterWorker* worker, vtkMaterialInterfaceFilterRingBuffer* iterator);
+  void ConnectNeighbor(vtkMaterialInterfaceFilterWorker* worker,
+    vtkMaterialInterfaceFilterRingBuffer* queue, vtkMaterialInterfaceFilterIterator* iterator,
+    vtkMaterialInterfaceFilterIterator* neighbor, vtkMaterialInterfaceFilterIterator* reference,
+    int axis, int outMaxFlag);
   void GetNeighborIterator(vtkMaterialInterfaceFilterIterator* next,
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
   void GetNeighborIteratorPad(vtkMaterialInterfaceFilterIterator* next,
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
-  void CreateFace(vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out,
-    int axis, int outMaxFlag);
+  void CreateFace(vtkMaterialInterfaceFilterWorker* worker, vtkMaterialInterfaceFilterIterator* in,
+    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
   int ComputeDisplacementFactors(vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8],
     double displacmentFactors[3], int rootNeighborIdx, int faceAxis);
-  int SubVoxelPositionCorner(double* point,
+  int SubVoxelPositionCorner(vtkMaterialInterfaceFilterWorker* worker, double* point,
     vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx,
     int faceAxis);
   void FindPointNeighbors(vtkMaterialInterfaceFilterIterator* iteratorMin0,
@@ -375,7 +398,7 @@ protected:
   vtkMultiProcessController* Controller;
 
   vtkMaterialInterfaceEquivalenceSet* EquivalenceSet;
-  void AddEquivalence(
+  void AddEquivalence(vtkMaterialInterfaceFilterWorker* worker,
     vtkMaterialInterfaceFilterIterator* neighbor1, vtkMaterialInterfaceFilterIterator* neighbor2);
   //
   void PrepareForResolveEquivalences();
@@ -514,10 +537,6 @@ protected:
   char* MaterialFractionArrayName;
   vtkSetStringMacro(MaterialFractionArrayName);
 
-  // while processing a material array this holds
-  // a pointer to the output poly data
-  // data set
-  vtkPolyData* CurrentFragmentMesh;
   // As pieces/fragments are found they are stored here
   // until resolution.
   std::vector<vtkPolyData*> FragmentMeshes;
@@ -527,23 +546,18 @@ protected:
   // all of the supported operations.
   /// class vtkMaterialInterfaceFilterIntegrator
   ///{
-  // Local id of current fragment
+  // Number of local fragments found so far. The accumulators for the
+  // current fragment are kept by vtkMaterialInterfaceFilterWorker.
   int FragmentId;
-  // Accumulator for the volume of the current fragment.
-  double FragmentVolume;
   // Fragment volumes indexed by the fragment id. It's a local
   // per-process indexing until fragments have been resolved
   vtkDoubleArray* FragmentVolumes;
 
   // Min and max depth of crater.
   // These are only computed when the clip plane is on.
-  double ClipDepthMin;
-  double ClipDepthMax;
   vtkDoubleArray* ClipDepthMinimums;
   vtkDoubleArray* ClipDepthMaximums;
 
-  // Accumulator for moments of the current fragment
-  std::vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
   // Moments indexed by fragment id
   vtkDoubleArray* FragmentMoments;
   // Centers of fragment AABBs, only computed if moments are not
@@ -552,8 +566,6 @@ protected:
   bool ComputeMoments;
 
   // Weighted average, where weights correspond to fragment volume.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double>> FragmentVolumeWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentVolumeWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -562,8 +574,6 @@ protected:
   std::vector<std::string> VolumeWtdAvgArrayNames;
 
   // Weighted average, where weights correspond to fragment mass.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double>> FragmentMassWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentMassWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -580,8 +590,6 @@ protected:
   int NToIntegrate;
 
   // Sum of data over the fragment.
-  // Accumulators, one for each array to sum
-  std::vector<std::vector<double>> FragmentSum;
   // sums indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentSums;
   // number of arrays for which to compute the weighted average
@@ -593,6 +601,9 @@ protected:
   // turn on/off OBB calculation
   bool ComputeOBB;
 
+  // Search the local blocks concurrently.
+  bool UseThreads;
+
   // Upper bound used to exclude heavily loaded procs
   // from work sharing. Reducing may aliviate oom issues.
   int UpperLoadingBound;
@@ -645,20 +656,18 @@ protected:
   // It could be changed into the primary storage of blocks.
   std::vector<vtkMaterialInterfaceLevel*> Levels;
 
-  // Ivars for computing the point on corners and edges of a face.
-  vtkMaterialInterfaceFilterIterator* FaceNeighbors;
   // Permutation of the neighbors. Axis0 normal to face.
   int faceAxis0;
   int faceAxis1;
   int faceAxis2;
-  double FaceCornerPoints[12];
-  double FaceEdgePoints[12];
-  int FaceEdgeFlags[4];
   // outMaxFlag implies out is positive direction of axis.
-  void ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
-  void ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
+  // The points and neighbors are stored in the worker.
+  void ComputeFacePoints(vtkMaterialInterfaceFilterWorker* worker,
+    vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+    int outMaxFlag);
+  void ComputeFaceNeighbors(vtkMaterialInterfaceFilterWorker* worker,
+    vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out, int axis,
+    int outMaxFlag);
 
   long ComputeProximity(const int faceIdx[3], int faceLevel, const int ext[6], int refLevel);
 
@@ -252,5 +252,6 @@ void vtkPythonCalculator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Expression: " << this->Expression << endl;
   os << indent << "MultilineExpression: " << this->MultilineExpression << endl;
   os << indent << "UseMultilineExpression: " << this->UseMultilineExpression << endl;
+  os << indent << "EvaluateBlocksConcurrently: " << this->EvaluateBlocksConcurrently << endl;
   os << indent << "ArrayName: " << this->ArrayName << endl;
 }
@@ -89,6 +89,21 @@ public:
   vtkSetMacro(UseMultilineExpression, bool);
   ///@}
 
+  ///@{
+  /**
+   * If true and the input is a composite dataset, the expression is evaluated
+   * for each block independently, with blocks distributed over a pool of
+   * threads. Input arrays are wrapped without copying and numpy releases the
+   * GIL while computing, so blocks are processed concurrently. Expressions
+   * using functions that reduce over the whole dataset, such as `max(x)`, and
+   * all expressions when running with several ranks are still evaluated on the
+   * whole dataset. Initial value is false.
+   */
+  vtkGetMacro(EvaluateBlocksConcurrently, bool);
+  vtkSetMacro(EvaluateBlocksConcurrently, bool);
+  vtkBooleanMacro(EvaluateBlocksConcurrently, bool);
+  ///@}
+
   /**
    * For internal use only.
    */
@@ -119,6 +134,7 @@ protected:
   std::string Expression;
   std::string MultilineExpression;
   bool UseMultilineExpression = false;
+  bool EvaluateBlocksConcurrently = false;
 
   char* ArrayName = nullptr;
   int ArrayAssociation = vtkDataObject::FIELD_ASSOCIATION_POINTS;
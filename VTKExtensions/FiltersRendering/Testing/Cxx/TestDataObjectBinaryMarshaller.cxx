@@ -0,0 +1,434 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObjectBinaryMarshaller.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Adds point, cell and field arrays, with active scalars.
+void AddAttributes(vtkDataSet* dataSet)
+{
+  vtkNew<vtkFloatArray> elevation;
+  elevation->SetName("elevation");
+  elevation->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < dataSet->GetNumberOfPoints(); ++cc)
+  {
+    elevation->SetValue(cc, static_cast<float>(std::sin(0.1 * cc)));
+  }
+  dataSet->GetPointData()->SetScalars(elevation);
+
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfComponents(2);
+  ids->SetComponentName(0, "rank");
+  ids->SetComponentName(1, "id");
+  ids->SetNumberOfTuples(dataSet->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < dataSet->GetNumberOfCells(); ++cc)
+  {
+    ids->SetTypedComponent(cc, 0, 3);
+    ids->SetTypedComponent(cc, 1, static_cast<int>(cc));
+  }
+  dataSet->GetCellData()->AddArray(ids);
+
+  vtkNew<vtkDoubleArray> time;
+  time->SetName("time");
+  time->InsertNextValue(1.5);
+  dataSet->GetFieldData()->AddArray(time);
+}
+
+vtkSmartPointer<vtkPoints> CreatePoints(int size)
+{
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  for (int j = 0; j < size; ++j)
+  {
+    for (int i = 0; i < size; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.01 * i * j);
+    }
+  }
+  return points;
+}
+
+vtkSmartPointer<vtkPolyData> CreatePolyData(int size)
+{
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(::CreatePoints(size));
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j + 1 < size; ++j)
+  {
+    for (int i = 0; i + 1 < size; ++i)
+    {
+      const vtkIdType quad[4] = { j * size + i, j * size + i + 1, (j + 1) * size + i + 1,
+        (j + 1) * size + i };
+      polys->InsertNextCell(4, quad);
+    }
+  }
+  polyData->SetPolys(polys);
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell(1);
+  verts->InsertCellPoint(0);
+  polyData->SetVerts(verts);
+  ::AddAttributes(polyData);
+  return polyData;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> CreateUnstructuredGrid(int size)
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(::CreatePoints(size));
+  grid->Allocate(2 * size * size);
+  for (int j = 0; j + 1 < size; ++j)
+  {
+    for (int i = 0; i + 1 < size; ++i)
+    {
+      const vtkIdType tri1[3] = { j * size + i, j * size + i + 1, (j + 1) * size + i + 1 };
+      const vtkIdType tri2[3] = { j * size + i, (j + 1) * size + i + 1, (j + 1) * size + i };
+      grid->InsertNextCell(VTK_TRIANGLE, 3, tri1);
+      grid->InsertNextCell(VTK_TRIANGLE, 3, tri2);
+    }
+  }
+  grid->GetCells()->ConvertTo32BitStorage();
+  ::AddAttributes(grid);
+  return grid;
+}
+
+vtkSmartPointer<vtkImageData> CreateImage()
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(2, 6, -1, 3, 0, 2);
+  image->SetOrigin(1, 2, 3);
+  image->SetSpacing(0.5, 0.25, 2);
+  const double direction[9] = { 0, 1, 0, -1, 0, 0, 0, 0, 1 };
+  image->SetDirectionMatrix(direction);
+  ::AddAttributes(image);
+  return image;
+}
+
+bool CompareArrays(vtkAbstractArray* a, vtkAbstractArray* b)
+{
+  if (!a || !b)
+  {
+    vtkLogF(ERROR, "Missing array.");
+    return false;
+  }
+  if (a->GetDataType() != b->GetDataType() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+    a->GetNumberOfTuples() != b->GetNumberOfTuples())
+  {
+    vtkLogF(ERROR, "Array layouts differ.");
+    return false;
+  }
+  if ((a->GetName() == nullptr) != (b->GetName() == nullptr) ||
+    (a->GetName() && strcmp(a->GetName(), b->GetName()) != 0))
+  {
+    vtkLogF(ERROR, "Array names differ.");
+    return false;
+  }
+  for (int cc = 0; a->HasAComponentName() && cc < a->GetNumberOfComponents(); ++cc)
+  {
+    if (!b->GetComponentName(cc) || strcmp(a->GetComponentName(cc), b->GetComponentName(cc)) != 0)
+    {
+      vtkLogF(ERROR, "Component names differ.");
+      return false;
+    }
+  }
+  if (memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0),
+        a->GetNumberOfValues() * a->GetDataTypeSize()) != 0)
+  {
+    vtkLogF(ERROR, "Array values differ.");
+    return false;
+  }
+  return true;
+}
+
+bool CompareFieldData(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    vtkLogF(ERROR, "Number of arrays differ.");
+    return false;
+  }
+  for (int cc = 0; cc < a->GetNumberOfArrays(); ++cc)
+  {
+    if (!::CompareArrays(a->GetAbstractArray(cc), b->GetAbstractArray(cc)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareDataObjects(vtkDataObject* a, vtkDataObject* b)
+{
+  if ((a == nullptr) != (b == nullptr))
+  {
+    vtkLogF(ERROR, "Null blocks differ.");
+    return false;
+  }
+  if (!a)
+  {
+    return true;
+  }
+  if (strcmp(a->GetClassName(), b->GetClassName()) != 0)
+  {
+    vtkLogF(ERROR, "Types differ.");
+    return false;
+  }
+  if (!::CompareFieldData(a->GetFieldData(), b->GetFieldData()))
+  {
+    return false;
+  }
+
+  if (auto multiBlock = vtkMultiBlockDataSet::SafeDownCast(a))
+  {
+    auto other = vtkMultiBlockDataSet::SafeDownCast(b);
+    if (multiBlock->GetNumberOfBlocks() != other->GetNumberOfBlocks())
+    {
+      vtkLogF(ERROR, "Block counts differ.");
+      return false;
+    }
+    for (unsigned int cc = 0; cc < multiBlock->GetNumberOfBlocks(); ++cc)
+    {
+      if (multiBlock->HasMetaData(cc) != other->HasMetaData(cc))
+      {
+        vtkLogF(ERROR, "Block metadata differ.");
+        return false;
+      }
+      if (multiBlock->HasMetaData(cc))
+      {
+        if (strcmp(multiBlock->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME()),
+              other->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())) != 0)
+        {
+          vtkLogF(ERROR, "Block names differ.");
+          return false;
+        }
+      }
+      if (!::CompareDataObjects(multiBlock->GetBlock(cc), other->GetBlock(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (auto partitioned = vtkPartitionedDataSet::SafeDownCast(a))
+  {
+    auto other = vtkPartitionedDataSet::SafeDownCast(b);
+    if (partitioned->GetNumberOfPartitions() != other->GetNumberOfPartitions())
+    {
+      vtkLogF(ERROR, "Partition counts differ.");
+      return false;
+    }
+    for (unsigned int cc = 0; cc < partitioned->GetNumberOfPartitions(); ++cc)
+    {
+      if (!::CompareDataObjects(partitioned->GetPartitionAsDataObject(cc),
+            other->GetPartitionAsDataObject(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto dataSet = vtkDataSet::SafeDownCast(a);
+  auto other = vtkDataSet::SafeDownCast(b);
+  if (dataSet->GetNumberOfPoints() != other->GetNumberOfPoints() ||
+    dataSet->GetNumberOfCells() != other->GetNumberOfCells())
+  {
+    vtkLogF(ERROR, "Dataset sizes differ.");
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < dataSet->GetNumberOfPoints(); ++cc)
+  {
+    double p[3], q[3];
+    dataSet->GetPoint(cc, p);
+    other->GetPoint(cc, q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+    {
+      vtkLogF(ERROR, "Points differ.");
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> ids, otherIds;
+  for (vtkIdType cc = 0; cc < dataSet->GetNumberOfCells(); ++cc)
+  {
+    dataSet->GetCellPoints(cc, ids);
+    other->GetCellPoints(cc, otherIds);
+    if (dataSet->GetCellType(cc) != other->GetCellType(cc))
+    {
+      vtkLogF(ERROR, "Cell types differ.");
+      return false;
+    }
+    if (ids->GetNumberOfIds() != otherIds->GetNumberOfIds() ||
+      !std::equal(ids->begin(), ids->end(), otherIds->begin()))
+    {
+      vtkLogF(ERROR, "Cells differ.");
+      return false;
+    }
+  }
+  if (!other->GetPointData()->GetScalars() ||
+    strcmp(other->GetPointData()->GetScalars()->GetName(), "elevation") != 0)
+  {
+    vtkLogF(ERROR, "Active scalars were lost.");
+    return false;
+  }
+  return ::CompareFieldData(dataSet->GetPointData(), other->GetPointData()) &&
+    ::CompareFieldData(dataSet->GetCellData(), other->GetCellData());
+}
+
+bool TestRoundTrip(vtkDataObject* data)
+{
+  // Through a single buffer, as vtkMPIMoveData does.
+  vtkDataObjectBinaryMarshaller marshaller;
+  if (!marshaller.Marshal(data))
+  {
+    vtkLogF(ERROR, "Failed to marshal.");
+    return false;
+  }
+  std::vector<char> buffer(marshaller.GetTotalSize());
+  marshaller.Gather(buffer.data());
+  if (!vtkDataObjectBinaryMarshaller::IsMarshaled(buffer.data(), buffer.size()))
+  {
+    vtkLogF(ERROR, "Buffer is not recognized.");
+    return false;
+  }
+  auto result = vtkDataObjectBinaryMarshaller::Unmarshal(buffer.data(), buffer.size());
+  if (!result)
+  {
+    vtkLogF(ERROR, "Failed to unmarshal.");
+    return false;
+  }
+  if (!::CompareDataObjects(data, result))
+  {
+    return false;
+  }
+
+  // Segment by segment, as vtkClientServerMoveData does.
+  vtkDataObjectBinaryMarshaller receiver;
+  if (!receiver.ParseHeader(marshaller.GetHeader(), marshaller.GetHeaderSize()))
+  {
+    vtkLogF(ERROR, "Failed to parse the header.");
+    return false;
+  }
+  if (receiver.GetSegments().size() != marshaller.GetSegments().size())
+  {
+    vtkLogF(ERROR, "Segment counts differ.");
+    return false;
+  }
+  for (size_t cc = 0; cc < receiver.GetSegments().size(); ++cc)
+  {
+    const auto& source = marshaller.GetSegments()[cc];
+    const auto& destination = receiver.GetSegments()[cc];
+    if (source.Size != destination.Size)
+    {
+      vtkLogF(ERROR, "Segment sizes differ.");
+      return false;
+    }
+    if (source.Size > 0)
+    {
+      memcpy(destination.Data, source.Data, source.Size);
+    }
+  }
+  if (!::CompareDataObjects(data, receiver.Finish()))
+  {
+    return false;
+  }
+
+  // Truncated buffers must be rejected.
+  if (vtkDataObjectBinaryMarshaller::Unmarshal(buffer.data(), buffer.size() - 1))
+  {
+    vtkLogF(ERROR, "Truncated buffer was accepted.");
+    return false;
+  }
+  if (receiver.ParseHeader(marshaller.GetHeader(), marshaller.GetHeaderSize() - 1))
+  {
+    vtkLogF(ERROR, "Truncated header was accepted.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDataObjectBinaryMarshaller(int, char*[])
+{
+  auto polyData = ::CreatePolyData(20);
+  auto grid = ::CreateUnstructuredGrid(20);
+  auto image = ::CreateImage();
+
+  bool success = ::TestRoundTrip(polyData);
+  success &= ::TestRoundTrip(grid);
+  success &= ::TestRoundTrip(image);
+
+  // Image geometry must be kept, unlike with the legacy writer.
+  vtkDataObjectBinaryMarshaller marshaller;
+  marshaller.Marshal(image);
+  std::vector<char> buffer(marshaller.GetTotalSize());
+  marshaller.Gather(buffer.data());
+  auto decoded = vtkDataObjectBinaryMarshaller::Unmarshal(buffer.data(), buffer.size());
+  auto imageResult = vtkImageData::SafeDownCast(decoded);
+  if (!imageResult || imageResult->GetExtent()[0] != 2 || imageResult->GetOrigin()[1] != 2 ||
+    imageResult->GetSpacing()[2] != 2 || imageResult->GetDirectionMatrix()->GetElement(0, 1) != 1)
+  {
+    vtkLogF(ERROR, "Image geometry was lost.");
+    success = false;
+  }
+
+  vtkNew<vtkPartitionedDataSet> partitioned;
+  partitioned->SetPartition(0, image);
+  partitioned->SetPartition(1, polyData);
+  vtkNew<vtkMultiBlockDataSet> multiBlock;
+  multiBlock->SetBlock(0, polyData);
+  multiBlock->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "surface");
+  multiBlock->SetBlock(1, nullptr);
+  multiBlock->SetBlock(2, grid);
+  multiBlock->SetBlock(3, partitioned);
+  success &= ::TestRoundTrip(multiBlock);
+
+  // Data that cannot be encoded is left to the legacy writer.
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("strings");
+  strings->InsertNextValue("value");
+  vtkNew<vtkPolyData> unsupported;
+  unsupported->DeepCopy(polyData);
+  unsupported->GetFieldData()->AddArray(strings);
+  if (marshaller.Marshal(unsupported) || marshaller.GetHeaderSize() != 0)
+  {
+    vtkLogF(ERROR, "String arrays should not be marshaled.");
+    success = false;
+  }
+  const char legacy[] = "# vtk DataFile Version 5.1\n";
+  if (vtkDataObjectBinaryMarshaller::IsMarshaled(legacy, sizeof(legacy)))
+  {
+    vtkLogF(ERROR, "Legacy buffer detected as binary.");
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
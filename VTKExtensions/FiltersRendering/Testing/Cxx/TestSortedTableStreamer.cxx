@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+namespace
+{
+// Pages through the whole sorted table, NumberOfBlocks blocks at a time, and
+// checks that the concatenated pages match `expected` and contain every row
+// once. The `extra` column must be present unless it is skipped.
+bool CheckPages(
+  vtkSortedTableStreamer* streamer, const std::vector<double>& expected, bool extra = true)
+{
+  const vtkIdType numberOfRows = static_cast<vtkIdType>(expected.size());
+  const vtkIdType pageSize = streamer->GetBlockSize() * streamer->GetNumberOfBlocks();
+  std::vector<double> values;
+  std::vector<bool> seen(expected.size(), false);
+  for (vtkIdType block = 0; block * streamer->GetBlockSize() < numberOfRows;
+       block += streamer->GetNumberOfBlocks())
+  {
+    streamer->SetBlock(block);
+    streamer->Update();
+    auto output = streamer->GetOutput();
+    auto data = vtkDoubleArray::SafeDownCast(output->GetColumnByName("data"));
+    auto ids = vtkIdTypeArray::SafeDownCast(output->GetColumnByName("id"));
+    if (!data || !ids)
+    {
+      vtkLogF(ERROR, "Missing output columns.");
+      return false;
+    }
+    if ((output->GetColumnByName("extra") != nullptr) != extra)
+    {
+      vtkLogF(ERROR, "Incorrect extra column.");
+      return false;
+    }
+    const vtkIdType offset = block * streamer->GetBlockSize();
+    if (output->GetNumberOfRows() != std::min(pageSize, numberOfRows - offset))
+    {
+      vtkLogF(ERROR, "Incorrect page size.");
+      return false;
+    }
+    for (vtkIdType cc = 0; cc < output->GetNumberOfRows(); ++cc)
+    {
+      const vtkIdType id = ids->GetValue(cc);
+      if (id < 0 || id >= numberOfRows || seen[id])
+      {
+        vtkLogF(ERROR, "Row missing or seen twice.");
+        return false;
+      }
+      seen[id] = true;
+      values.push_back(data->GetValue(cc));
+    }
+  }
+  if (values != expected)
+  {
+    vtkLogF(ERROR, "Incorrect sorted values.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestSortedTableStreamer(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  // Several partitions with many repeated values.
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  vtkNew<vtkPartitionedDataSet> input;
+  std::vector<double> expected;
+  vtkIdType id = 0;
+  for (vtkIdType size : { 300, 450, 250 })
+  {
+    vtkNew<vtkDoubleArray> data;
+    data->SetName("data");
+    data->SetNumberOfTuples(size);
+    vtkNew<vtkIdTypeArray> ids;
+    ids->SetName("id");
+    ids->SetNumberOfTuples(size);
+    for (vtkIdType cc = 0; cc < size; ++cc)
+    {
+      random->Next();
+      data->SetValue(cc, std::floor(50 * random->GetValue()));
+      ids->SetValue(cc, id++);
+      expected.push_back(data->GetValue(cc));
+    }
+    vtkNew<vtkDoubleArray> extra;
+    extra->SetName("extra");
+    extra->SetNumberOfTuples(size);
+    extra->FillValue(1.0);
+    vtkNew<vtkTable> table;
+    table->AddColumn(data);
+    table->AddColumn(ids);
+    table->AddColumn(extra);
+    input->SetPartition(input->GetNumberOfPartitions(), table);
+  }
+
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetInputData(input);
+  streamer->SetColumnNameToSort("data");
+  streamer->SetSelectedComponent(0);
+  streamer->SetBlockSize(128);
+
+  bool success = true;
+  std::sort(expected.begin(), expected.end());
+  success &= ::CheckPages(streamer, expected);
+
+  // Flipping the order reuses the sorted cache, make sure it is still right.
+  std::vector<double> reversed(expected.rbegin(), expected.rend());
+  streamer->SetInvertOrder(1);
+  success &= ::CheckPages(streamer, reversed);
+  streamer->SetInvertOrder(0);
+  success &= ::CheckPages(streamer, expected);
+
+  // Several blocks at once, with skipped columns. The column to sort is never
+  // skipped.
+  streamer->SetNumberOfBlocks(3);
+  streamer->AddColumnToSkip("extra");
+  streamer->AddColumnToSkip("data");
+  success &= ::CheckPages(streamer, expected, false);
+  streamer->RemoveAllColumnsToSkip();
+  success &= ::CheckPages(streamer, expected);
+  streamer->SetNumberOfBlocks(1);
+
+  // Modifying the input must invalidate the cache.
+  auto data = vtkDoubleArray::SafeDownCast(
+    vtkTable::SafeDownCast(input->GetPartitionAsDataObject(0))->GetColumnByName("data"));
+  const double oldValue = data->GetValue(0);
+  data->SetValue(0, 100.0);
+  data->Modified();
+  expected.erase(std::find(expected.begin(), expected.end(), oldValue));
+  expected.push_back(100.0);
+  std::sort(expected.begin(), expected.end(), std::greater<double>());
+  streamer->SetInvertOrder(1);
+  success &= ::CheckPages(streamer, expected);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -5,6 +5,7 @@
 
 #include "vtkCharArray.h"
 #include "vtkDataObject.h"
+#include "vtkDataObjectBinaryMarshaller.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkGenericDataObjectWriter.h"
@@ -22,6 +23,7 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkClientServerMoveData);
 vtkCxxSetObjectMacro(vtkClientServerMoveData, Controller, vtkMultiProcessController);
@@ -220,14 +222,43 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
 
       // Send the size of the string.
       int size = static_cast<int>(res.str().size());
-      controller->Send(&size, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+      if (!controller->Send(&size, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT))
+      {
+        return 0;
+      }
       // Send the XML string.
       return controller->Send(
         res.str().c_str(), size, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
     }
   }
 
-  return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  // Send the header followed by each array straight from its memory when the
+  // data can be encoded that way, and let the controller marshal it otherwise.
+  vtkDataObjectBinaryMarshaller marshaller;
+  int binary = marshaller.Marshal(input) ? 1 : 0;
+  if (!controller->Send(&binary, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT))
+  {
+    return 0;
+  }
+  if (!binary)
+  {
+    return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  }
+
+  vtkIdType headerSize = marshaller.GetHeaderSize();
+  int status =
+    controller->Send(&headerSize, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT) &&
+    controller->Send(
+      marshaller.GetHeader(), headerSize, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  for (const auto& segment : marshaller.GetSegments())
+  {
+    if (status && segment.Size > 0)
+    {
+      status = controller->Send(
+        segment.Data, segment.Size, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    }
+  }
+  return status;
 }
 
 //-----------------------------------------------------------------------------
@@ -238,25 +269,70 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
   {
     // Get the size of the string.
     int size = 0;
-    controller->Receive(&size, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
-    if (size == 0)
+    if (!controller->Receive(&size, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT) ||
+      size <= 0)
     {
       return nullptr;
     }
-    char* xml = new char[size + 1];
+    std::vector<char> xml(size + 1);
     // Get the string itself.
-    controller->Receive(xml, size, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    if (!controller->Receive(xml.data(), size, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT))
+    {
+      vtkErrorMacro("Failed to receive the selection from the server.");
+      return nullptr;
+    }
     xml[size] = 0;
 
     // Parse the XML.
     vtkSelection* sel = vtkSelection::New();
-    vtkSelectionSerializer::Parse(xml, sel);
-    delete[] xml;
+    vtkSelectionSerializer::Parse(xml.data(), sel);
     data = sel;
   }
   else
   {
-    data = controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    int binary = 0;
+    if (!controller->Receive(&binary, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT))
+    {
+      vtkErrorMacro("Failed to receive the data object from the server.");
+      return nullptr;
+    }
+    if (!binary)
+    {
+      return controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    }
+
+    // Receive the arrays directly into the reconstructed data object.
+    vtkIdType headerSize = 0;
+    if (!controller->Receive(&headerSize, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT) ||
+      headerSize <= 0)
+    {
+      vtkErrorMacro("Failed to receive the data object from the server.");
+      return nullptr;
+    }
+    std::vector<char> header(headerSize);
+    vtkDataObjectBinaryMarshaller marshaller;
+    if (!controller->Receive(
+          header.data(), headerSize, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT) ||
+      !marshaller.ParseHeader(header.data(), headerSize))
+    {
+      vtkErrorMacro("Failed to decode the data object received from the server.");
+      return nullptr;
+    }
+    for (const auto& segment : marshaller.GetSegments())
+    {
+      if (segment.Size > 0 &&
+        !controller->Receive(
+          segment.Data, segment.Size, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT))
+      {
+        vtkErrorMacro("Failed to receive the arrays of the data object from the server.");
+        return nullptr;
+      }
+    }
+    data = marshaller.Finish();
+    if (data)
+    {
+      data->Register(nullptr);
+    }
   }
   return data;
 }
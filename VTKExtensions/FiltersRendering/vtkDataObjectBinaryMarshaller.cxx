@@ -0,0 +1,839 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDataObjectBinaryMarshaller.h"
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMatrix3x3.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTable.h"
+#include "vtkTypeInt32Array.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace
+{
+// The header starts with a tag identifying the format and its version
+// followed by the byte order of the sender ('L' or 'B'), then the size of
+// the header and the size of the payload.
+const char Tag[] = "PVMOVE1";
+constexpr size_t TagSize = sizeof(Tag) - 1;
+constexpr size_t PrefixSize = TagSize + 1 + 2 * sizeof(vtkTypeUInt64);
+#ifdef VTK_WORDS_BIGENDIAN
+constexpr char NativeOrder = 'B';
+#else
+constexpr char NativeOrder = 'L';
+#endif
+
+// Length used to encode a null string.
+constexpr vtkTypeUInt32 NullString = 0xffffffff;
+
+bool IsSupportedType(int type)
+{
+  switch (type)
+  {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_INT:
+    case VTK_UNSIGNED_INT:
+    case VTK_LONG:
+    case VTK_UNSIGNED_LONG:
+    case VTK_LONG_LONG:
+    case VTK_UNSIGNED_LONG_LONG:
+    case VTK_ID_TYPE:
+    case VTK_FLOAT:
+    case VTK_DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename TreeType>
+const char* GetBlockName(TreeType* tree, unsigned int index)
+{
+  if (tree->HasMetaData(index) && tree->GetMetaData(index)->Has(vtkCompositeDataSet::NAME()))
+  {
+    return tree->GetMetaData(index)->Get(vtkCompositeDataSet::NAME());
+  }
+  return nullptr;
+}
+}
+
+//----------------------------------------------------------------------------
+// Writes the header and collects the segments of a data object.
+class vtkDataObjectBinaryMarshaller::Encoder
+{
+public:
+  Encoder(vtkDataObjectBinaryMarshaller* self)
+    : Self(self)
+  {
+  }
+
+  template <typename T>
+  void Write(T value)
+  {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    this->Self->Header.insert(this->Self->Header.end(), bytes, bytes + sizeof(T));
+  }
+
+  void WriteString(const char* str)
+  {
+    if (!str)
+    {
+      this->Write(NullString);
+      return;
+    }
+    const vtkTypeUInt32 length = static_cast<vtkTypeUInt32>(strlen(str));
+    this->Write(length);
+    this->Self->Header.insert(this->Self->Header.end(), str, str + length);
+  }
+
+  bool WriteArray(vtkAbstractArray* abstractArray)
+  {
+    vtkDataArray* array = vtkDataArray::SafeDownCast(abstractArray);
+    if (!array || !::IsSupportedType(array->GetDataType()))
+    {
+      return false;
+    }
+    if (!array->HasStandardMemoryLayout())
+    {
+      // Use a contiguous copy, kept alive until the next Marshal.
+      auto copy = vtkSmartPointer<vtkDataArray>::Take(
+        vtkDataArray::CreateDataArray(array->GetDataType()));
+      copy->DeepCopy(array);
+      this->Self->Arrays.push_back(copy);
+      array = copy;
+    }
+
+    const int numberOfComponents = array->GetNumberOfComponents();
+    const vtkIdType numberOfTuples = array->GetNumberOfTuples();
+    const int elementSize = array->GetDataTypeSize();
+    this->Write<vtkTypeInt32>(array->GetDataType());
+    this->Write<vtkTypeInt32>(elementSize);
+    this->Write<vtkTypeInt32>(numberOfComponents);
+    this->Write<vtkTypeInt64>(numberOfTuples);
+    this->WriteString(array->GetName());
+    const bool hasComponentNames = array->HasAComponentName();
+    this->Write<vtkTypeUInt8>(hasComponentNames ? 1 : 0);
+    for (int cc = 0; hasComponentNames && cc < numberOfComponents; ++cc)
+    {
+      this->WriteString(array->GetComponentName(cc));
+    }
+
+    const vtkIdType size = numberOfTuples * numberOfComponents * elementSize;
+    this->Self->Segments.push_back(
+      Segment{ size ? static_cast<char*>(array->GetVoidPointer(0)) : nullptr, size, elementSize });
+    return true;
+  }
+
+  bool WriteFieldData(vtkFieldData* fieldData)
+  {
+    vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(fieldData);
+    const int numberOfArrays = fieldData ? fieldData->GetNumberOfArrays() : 0;
+    this->Write<vtkTypeInt32>(numberOfArrays);
+    for (int cc = 0; cc < numberOfArrays; ++cc)
+    {
+      this->Write<vtkTypeInt32>(attributes ? attributes->IsArrayAnAttribute(cc) : -1);
+      if (!this->WriteArray(fieldData->GetAbstractArray(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool WritePoints(vtkPoints* points)
+  {
+    this->Write<vtkTypeUInt8>(points ? 1 : 0);
+    return !points || this->WriteArray(points->GetData());
+  }
+
+  bool WriteCells(vtkCellArray* cells)
+  {
+    this->Write<vtkTypeUInt8>(cells ? 1 : 0);
+    if (!cells)
+    {
+      return true;
+    }
+    if (cells->IsStorage64Bit())
+    {
+      return this->WriteArray(cells->GetOffsetsArray64()) &&
+        this->WriteArray(cells->GetConnectivityArray64());
+    }
+    return this->WriteArray(cells->GetOffsetsArray32()) &&
+      this->WriteArray(cells->GetConnectivityArray32());
+  }
+
+  bool WriteDataSetAttributes(vtkDataSet* dataSet)
+  {
+    return this->WriteFieldData(dataSet->GetPointData()) &&
+      this->WriteFieldData(dataSet->GetCellData());
+  }
+
+  bool WriteDataObject(vtkDataObject* data)
+  {
+    if (!data)
+    {
+      this->Write<vtkTypeInt32>(-1);
+      return true;
+    }
+
+    const int type = data->GetDataObjectType();
+    this->Write<vtkTypeInt32>(type);
+    bool status = false;
+    switch (type)
+    {
+      case VTK_POLY_DATA:
+      {
+        vtkPolyData* polyData = vtkPolyData::SafeDownCast(data);
+        status = this->WritePoints(polyData->GetPoints()) &&
+          this->WriteCells(polyData->GetVerts()) && this->WriteCells(polyData->GetLines()) &&
+          this->WriteCells(polyData->GetPolys()) && this->WriteCells(polyData->GetStrips()) &&
+          this->WriteDataSetAttributes(polyData);
+      }
+      break;
+
+      case VTK_UNSTRUCTURED_GRID:
+      {
+        vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(data);
+        vtkUnsignedCharArray* types = grid->GetCellTypesArray();
+        vtkCellArray* cells = grid->GetCells();
+        if (types && cells)
+        {
+          // Polyhedra need their faces, leave them to the legacy writer.
+          const unsigned char* begin = types->GetPointer(0);
+          const unsigned char* end = begin + types->GetNumberOfValues();
+          if (std::find(begin, end, VTK_POLYHEDRON) != end)
+          {
+            return false;
+          }
+        }
+        this->Write<vtkTypeUInt8>(types && cells ? 1 : 0);
+        status = this->WritePoints(grid->GetPoints()) &&
+          (!types || !cells || (this->WriteArray(types) && this->WriteCells(cells))) &&
+          this->WriteDataSetAttributes(grid);
+      }
+      break;
+
+      case VTK_IMAGE_DATA:
+      case VTK_STRUCTURED_POINTS:
+      case VTK_UNIFORM_GRID:
+      {
+        vtkImageData* image = vtkImageData::SafeDownCast(data);
+        const int* extent = image->GetExtent();
+        for (int cc = 0; cc < 6; ++cc)
+        {
+          this->Write<vtkTypeInt32>(extent[cc]);
+        }
+        const double* origin = image->GetOrigin();
+        const double* spacing = image->GetSpacing();
+        for (int cc = 0; cc < 3; ++cc)
+        {
+          this->Write(origin[cc]);
+          this->Write(spacing[cc]);
+        }
+        const double* direction = image->GetDirectionMatrix()->GetData();
+        for (int cc = 0; cc < 9; ++cc)
+        {
+          this->Write(direction[cc]);
+        }
+        status = this->WriteDataSetAttributes(image);
+      }
+      break;
+
+      case VTK_TABLE:
+        status = this->WriteFieldData(vtkTable::SafeDownCast(data)->GetRowData());
+        break;
+
+      case VTK_MULTIBLOCK_DATA_SET:
+      {
+        vtkMultiBlockDataSet* multiBlock = vtkMultiBlockDataSet::SafeDownCast(data);
+        const unsigned int numberOfBlocks = multiBlock->GetNumberOfBlocks();
+        this->Write<vtkTypeUInt32>(numberOfBlocks);
+        status = true;
+        for (unsigned int cc = 0; status && cc < numberOfBlocks; ++cc)
+        {
+          this->WriteString(::GetBlockName(multiBlock, cc));
+          status = this->WriteDataObject(multiBlock->GetBlock(cc));
+        }
+      }
+      break;
+
+      case VTK_PARTITIONED_DATA_SET:
+      case VTK_MULTIPIECE_DATA_SET:
+      {
+        vtkPartitionedDataSet* partitioned = vtkPartitionedDataSet::SafeDownCast(data);
+        const unsigned int numberOfPartitions = partitioned->GetNumberOfPartitions();
+        this->Write<vtkTypeUInt32>(numberOfPartitions);
+        status = true;
+        for (unsigned int cc = 0; status && cc < numberOfPartitions; ++cc)
+        {
+          this->WriteString(::GetBlockName(partitioned, cc));
+          status = this->WriteDataObject(partitioned->GetPartitionAsDataObject(cc));
+        }
+      }
+      break;
+
+      default:
+        break;
+    }
+    return status && this->WriteFieldData(data->GetFieldData());
+  }
+
+private:
+  vtkDataObjectBinaryMarshaller* Self;
+};
+
+//----------------------------------------------------------------------------
+// Reads the header, creating the data object and the segments to fill.
+class vtkDataObjectBinaryMarshaller::Decoder
+{
+public:
+  Decoder(vtkDataObjectBinaryMarshaller* self, const char* begin, const char* end)
+    : Self(self)
+    , Position(begin)
+    , End(end)
+    , RemainingPayload(0)
+  {
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (this->End - this->Position < static_cast<vtkIdType>(sizeof(T)))
+    {
+      return false;
+    }
+    memcpy(&value, this->Position, sizeof(T));
+    this->Position += sizeof(T);
+    if (this->Self->Swap)
+    {
+      vtkByteSwap::SwapVoidRange(&value, 1, sizeof(T));
+    }
+    return true;
+  }
+
+  bool ReadString(std::string& str, bool& isNull)
+  {
+    vtkTypeUInt32 length;
+    if (!this->Read(length))
+    {
+      return false;
+    }
+    isNull = length == NullString;
+    if (isNull)
+    {
+      str.clear();
+      return true;
+    }
+    if (this->End - this->Position < static_cast<vtkIdType>(length))
+    {
+      return false;
+    }
+    str.assign(this->Position, length);
+    this->Position += length;
+    return true;
+  }
+
+  // Reads an array description. Cell arrays are created as vtkTypeInt32Array
+  // or vtkTypeInt64Array, as required by vtkCellArray.
+  bool ReadArray(vtkSmartPointer<vtkDataArray>& array, bool cellStorage = false)
+  {
+    vtkTypeInt32 type, elementSize, numberOfComponents;
+    vtkTypeInt64 numberOfTuples;
+    std::string name;
+    bool nullName;
+    if (!this->Read(type) || !this->Read(elementSize) || !this->Read(numberOfComponents) ||
+      !this->Read(numberOfTuples) || !this->ReadString(name, nullName) ||
+      !::IsSupportedType(type) || numberOfComponents < 1 || numberOfTuples < 0 ||
+      elementSize < 1 ||
+      numberOfTuples >
+        this->RemainingPayload / (static_cast<vtkIdType>(numberOfComponents) * elementSize))
+    {
+      return false;
+    }
+
+    if (cellStorage && elementSize == 8)
+    {
+      array = vtkSmartPointer<vtkTypeInt64Array>::New();
+    }
+    else if (cellStorage && elementSize == 4)
+    {
+      array = vtkSmartPointer<vtkTypeInt32Array>::New();
+    }
+    else if (!cellStorage)
+    {
+      array.TakeReference(vtkDataArray::CreateDataArray(type));
+    }
+    // The element size must match, e.g. for vtkIdType or long.
+    if (!array || array->GetDataTypeSize() != elementSize)
+    {
+      return false;
+    }
+
+    array->SetNumberOfComponents(numberOfComponents);
+    array->SetNumberOfTuples(numberOfTuples);
+    if (!nullName)
+    {
+      array->SetName(name.c_str());
+    }
+    vtkTypeUInt8 hasComponentNames;
+    if (!this->Read(hasComponentNames))
+    {
+      return false;
+    }
+    for (int cc = 0; hasComponentNames && cc < numberOfComponents; ++cc)
+    {
+      if (!this->ReadString(name, nullName))
+      {
+        return false;
+      }
+      if (!nullName)
+      {
+        array->SetComponentName(cc, name.c_str());
+      }
+    }
+
+    const vtkIdType size = numberOfTuples * numberOfComponents * elementSize;
+    this->RemainingPayload -= size;
+    this->Self->Segments.push_back(
+      Segment{ size ? static_cast<char*>(array->GetVoidPointer(0)) : nullptr, size, elementSize });
+    return true;
+  }
+
+  bool ReadFieldData(vtkFieldData* fieldData)
+  {
+    vtkDataSetAttributes* attributes = vtkDataSetAttributes::SafeDownCast(fieldData);
+    vtkTypeInt32 numberOfArrays;
+    if (!this->Read(numberOfArrays) || numberOfArrays < 0)
+    {
+      return false;
+    }
+    for (vtkTypeInt32 cc = 0; cc < numberOfArrays; ++cc)
+    {
+      vtkTypeInt32 attribute;
+      vtkSmartPointer<vtkDataArray> array;
+      if (!this->Read(attribute) || !this->ReadArray(array))
+      {
+        return false;
+      }
+      const int index = fieldData->AddArray(array);
+      if (attributes && attribute >= 0 && attribute < vtkDataSetAttributes::NUM_ATTRIBUTES)
+      {
+        attributes->SetActiveAttribute(index, attribute);
+      }
+    }
+    return true;
+  }
+
+  bool ReadPoints(vtkSmartPointer<vtkPoints>& points)
+  {
+    vtkTypeUInt8 hasPoints;
+    if (!this->Read(hasPoints))
+    {
+      return false;
+    }
+    if (hasPoints)
+    {
+      vtkSmartPointer<vtkDataArray> array;
+      if (!this->ReadArray(array))
+      {
+        return false;
+      }
+      points = vtkSmartPointer<vtkPoints>::New();
+      points->SetData(array);
+    }
+    return true;
+  }
+
+  bool ReadCells(vtkSmartPointer<vtkCellArray>& cells)
+  {
+    vtkTypeUInt8 hasCells;
+    if (!this->Read(hasCells))
+    {
+      return false;
+    }
+    if (hasCells)
+    {
+      vtkSmartPointer<vtkDataArray> offsets, connectivity;
+      if (!this->ReadArray(offsets, true) || !this->ReadArray(connectivity, true) ||
+        offsets->GetDataTypeSize() != connectivity->GetDataTypeSize())
+      {
+        return false;
+      }
+      cells = vtkSmartPointer<vtkCellArray>::New();
+      if (offsets->GetDataTypeSize() == 8)
+      {
+        cells->SetData(vtkTypeInt64Array::SafeDownCast(offsets),
+          vtkTypeInt64Array::SafeDownCast(connectivity));
+      }
+      else
+      {
+        cells->SetData(vtkTypeInt32Array::SafeDownCast(offsets),
+          vtkTypeInt32Array::SafeDownCast(connectivity));
+      }
+    }
+    return true;
+  }
+
+  bool ReadDataSetAttributes(vtkDataSet* dataSet)
+  {
+    return this->ReadFieldData(dataSet->GetPointData()) &&
+      this->ReadFieldData(dataSet->GetCellData());
+  }
+
+  bool ReadDataObject(vtkSmartPointer<vtkDataObject>& data)
+  {
+    vtkTypeInt32 type;
+    if (!this->Read(type))
+    {
+      return false;
+    }
+    if (type < 0)
+    {
+      data = nullptr;
+      return true;
+    }
+
+    bool status = false;
+    switch (type)
+    {
+      case VTK_POLY_DATA:
+      {
+        auto polyData = vtkSmartPointer<vtkPolyData>::New();
+        vtkSmartPointer<vtkPoints> points;
+        vtkSmartPointer<vtkCellArray> verts, lines, polys, strips;
+        status = this->ReadPoints(points) && this->ReadCells(verts) && this->ReadCells(lines) &&
+          this->ReadCells(polys) && this->ReadCells(strips) &&
+          this->ReadDataSetAttributes(polyData);
+        polyData->SetPoints(points);
+        polyData->SetVerts(verts);
+        polyData->SetLines(lines);
+        polyData->SetPolys(polys);
+        polyData->SetStrips(strips);
+        data = polyData;
+      }
+      break;
+
+      case VTK_UNSTRUCTURED_GRID:
+      {
+        auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+        vtkTypeUInt8 hasCells;
+        vtkSmartPointer<vtkPoints> points;
+        vtkSmartPointer<vtkDataArray> types;
+        vtkSmartPointer<vtkCellArray> cells;
+        status = this->Read(hasCells) && this->ReadPoints(points) &&
+          (!hasCells ||
+            (this->ReadArray(types) && vtkUnsignedCharArray::SafeDownCast(types) &&
+              this->ReadCells(cells))) &&
+          this->ReadDataSetAttributes(grid);
+        grid->SetPoints(points);
+        if (status && hasCells)
+        {
+          // SetCells looks at the cell types, which are not received yet.
+          vtkSmartPointer<vtkUnsignedCharArray> cellTypes =
+            vtkUnsignedCharArray::SafeDownCast(types);
+          this->Self->FinishSteps.emplace_back(
+            [grid, cellTypes, cells]() { grid->SetCells(cellTypes, cells); });
+        }
+        data = grid;
+      }
+      break;
+
+      case VTK_IMAGE_DATA:
+      case VTK_STRUCTURED_POINTS:
+      case VTK_UNIFORM_GRID:
+      {
+        vtkSmartPointer<vtkImageData> image;
+        image.TakeReference(vtkImageData::SafeDownCast(vtkDataObjectTypes::NewDataObject(type)));
+        vtkTypeInt32 extent[6];
+        double origin[3], spacing[3], direction[9];
+        status = image != nullptr;
+        for (int cc = 0; status && cc < 6; ++cc)
+        {
+          status = this->Read(extent[cc]);
+        }
+        for (int cc = 0; status && cc < 3; ++cc)
+        {
+          status = this->Read(origin[cc]) && this->Read(spacing[cc]);
+        }
+        for (int cc = 0; status && cc < 9; ++cc)
+        {
+          status = this->Read(direction[cc]);
+        }
+        if (status)
+        {
+          image->SetExtent(extent);
+          image->SetOrigin(origin);
+          image->SetSpacing(spacing);
+          image->SetDirectionMatrix(direction);
+          status = this->ReadDataSetAttributes(image);
+        }
+        data = image;
+      }
+      break;
+
+      case VTK_TABLE:
+      {
+        auto table = vtkSmartPointer<vtkTable>::New();
+        status = this->ReadFieldData(table->GetRowData());
+        data = table;
+      }
+      break;
+
+      case VTK_MULTIBLOCK_DATA_SET:
+      {
+        auto multiBlock = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+        vtkTypeUInt32 numberOfBlocks;
+        status = this->Read(numberOfBlocks) &&
+          numberOfBlocks <= static_cast<vtkTypeUInt32>(this->End - this->Position);
+        if (status)
+        {
+          multiBlock->SetNumberOfBlocks(numberOfBlocks);
+        }
+        for (vtkTypeUInt32 cc = 0; status && cc < numberOfBlocks; ++cc)
+        {
+          std::string name;
+          bool nullName;
+          vtkSmartPointer<vtkDataObject> block;
+          status = this->ReadString(name, nullName) && this->ReadDataObject(block);
+          multiBlock->SetBlock(cc, block);
+          if (status && !nullName)
+          {
+            multiBlock->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+          }
+        }
+        data = multiBlock;
+      }
+      break;
+
+      case VTK_PARTITIONED_DATA_SET:
+      case VTK_MULTIPIECE_DATA_SET:
+      {
+        vtkSmartPointer<vtkPartitionedDataSet> partitioned;
+        partitioned.TakeReference(
+          vtkPartitionedDataSet::SafeDownCast(vtkDataObjectTypes::NewDataObject(type)));
+        vtkTypeUInt32 numberOfPartitions;
+        status = partitioned && this->Read(numberOfPartitions) &&
+          numberOfPartitions <= static_cast<vtkTypeUInt32>(this->End - this->Position);
+        if (status)
+        {
+          partitioned->SetNumberOfPartitions(numberOfPartitions);
+        }
+        for (vtkTypeUInt32 cc = 0; status && cc < numberOfPartitions; ++cc)
+        {
+          std::string name;
+          bool nullName;
+          vtkSmartPointer<vtkDataObject> partition;
+          status = this->ReadString(name, nullName) && this->ReadDataObject(partition);
+          partitioned->SetPartition(cc, partition);
+          if (status && !nullName)
+          {
+            partitioned->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), name.c_str());
+          }
+        }
+        data = partitioned;
+      }
+      break;
+
+      default:
+        break;
+    }
+    return status && this->ReadFieldData(data->GetFieldData());
+  }
+
+  vtkDataObjectBinaryMarshaller* Self;
+  const char* Position;
+  const char* End;
+  vtkIdType RemainingPayload;
+};
+
+//----------------------------------------------------------------------------
+vtkDataObjectBinaryMarshaller::vtkDataObjectBinaryMarshaller()
+  : Swap(false)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDataObjectBinaryMarshaller::~vtkDataObjectBinaryMarshaller() = default;
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectBinaryMarshaller::Marshal(vtkDataObject* data)
+{
+  this->Reset();
+  if (!data)
+  {
+    return false;
+  }
+
+  this->Header.resize(PrefixSize);
+  memcpy(this->Header.data(), Tag, TagSize);
+  this->Header[TagSize] = NativeOrder;
+  Encoder encoder(this);
+  if (!encoder.WriteDataObject(data))
+  {
+    this->Reset();
+    return false;
+  }
+
+  const vtkTypeUInt64 headerSize = this->Header.size();
+  const vtkTypeUInt64 payloadSize = this->GetTotalSize() - this->Header.size();
+  memcpy(this->Header.data() + TagSize + 1, &headerSize, sizeof(headerSize));
+  memcpy(this->Header.data() + TagSize + 1 + sizeof(headerSize), &payloadSize, sizeof(payloadSize));
+  this->DataObject = data;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectBinaryMarshaller::ParseHeader(const char* buffer, vtkIdType length)
+{
+  this->Reset();
+  if (!vtkDataObjectBinaryMarshaller::IsMarshaled(buffer, length))
+  {
+    return false;
+  }
+
+  this->Swap = buffer[TagSize] != NativeOrder;
+  Decoder decoder(this, buffer + TagSize + 1, buffer + length);
+  vtkTypeUInt64 headerSize, payloadSize;
+  if (!decoder.Read(headerSize) || !decoder.Read(payloadSize) || headerSize < PrefixSize ||
+    headerSize > static_cast<vtkTypeUInt64>(length) ||
+    payloadSize > static_cast<vtkTypeUInt64>(VTK_ID_MAX))
+  {
+    this->Reset();
+    return false;
+  }
+  decoder.End = buffer + headerSize;
+  decoder.RemainingPayload = static_cast<vtkIdType>(payloadSize);
+
+  vtkSmartPointer<vtkDataObject> data;
+  if (!decoder.ReadDataObject(data) || !data || decoder.Position != decoder.End ||
+    decoder.RemainingPayload != 0)
+  {
+    this->Reset();
+    return false;
+  }
+  this->Header.assign(buffer, buffer + headerSize);
+  this->DataObject = data;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkDataObjectBinaryMarshaller::Finish()
+{
+  if (this->Swap)
+  {
+    for (const Segment& segment : this->Segments)
+    {
+      if (segment.ElementSize > 1)
+      {
+        vtkByteSwap::SwapVoidRange(
+          segment.Data, segment.Size / segment.ElementSize, segment.ElementSize);
+      }
+    }
+    this->Swap = false;
+  }
+  for (const auto& step : this->FinishSteps)
+  {
+    step();
+  }
+  this->FinishSteps.clear();
+  return this->DataObject;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDataObjectBinaryMarshaller::GetTotalSize() const
+{
+  vtkIdType size = this->GetHeaderSize();
+  for (const Segment& segment : this->Segments)
+  {
+    size += segment.Size;
+  }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectBinaryMarshaller::Gather(char* buffer) const
+{
+  memcpy(buffer, this->Header.data(), this->Header.size());
+  buffer += this->Header.size();
+  for (const Segment& segment : this->Segments)
+  {
+    if (segment.Size > 0)
+    {
+      memcpy(buffer, segment.Data, segment.Size);
+      buffer += segment.Size;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectBinaryMarshaller::Scatter(const char* buffer, vtkIdType length)
+{
+  if (length < this->GetTotalSize())
+  {
+    return false;
+  }
+  buffer += this->Header.size();
+  for (const Segment& segment : this->Segments)
+  {
+    if (segment.Size > 0)
+    {
+      memcpy(segment.Data, buffer, segment.Size);
+      buffer += segment.Size;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDataObjectBinaryMarshaller::Reset()
+{
+  this->DataObject = nullptr;
+  this->Arrays.clear();
+  this->Header.clear();
+  this->Segments.clear();
+  this->FinishSteps.clear();
+  this->Swap = false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkDataObjectBinaryMarshaller::IsMarshaled(const char* buffer, vtkIdType length)
+{
+  return buffer && length >= static_cast<vtkIdType>(PrefixSize) &&
+    memcmp(buffer, Tag, TagSize) == 0 && (buffer[TagSize] == 'L' || buffer[TagSize] == 'B');
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkDataObjectBinaryMarshaller::Unmarshal(
+  const char* buffer, vtkIdType length)
+{
+  vtkDataObjectBinaryMarshaller marshaller;
+  if (!marshaller.ParseHeader(buffer, length) || !marshaller.Scatter(buffer, length))
+  {
+    return nullptr;
+  }
+  return marshaller.Finish();
+}
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkDataObjectBinaryMarshaller
+ * @brief   raw binary encoding of data objects for data movement
+ *
+ * vtkDataObjectBinaryMarshaller encodes poly data, unstructured grids, image
+ * data, tables and multiblock or partitioned datasets made of them as a small
+ * header followed by the raw memory of their points, cells and attribute
+ * arrays. Nothing is formatted or parsed: the payload is a list of segments
+ * pointing at the arrays of the encoded data object, which can either be sent
+ * one after the other or gathered into a single buffer.
+ *
+ * On the receiving side, `ParseHeader` recreates the data object with arrays
+ * of the right type and size and exposes them as the matching list of
+ * segments, so that the payload can be received or copied directly into
+ * place before calling `Finish`.
+ *
+ * `Marshal` returns false for data that cannot be encoded this way, such as
+ * string arrays or polyhedral cells, so that callers can fall back to
+ * vtkGenericDataObjectWriter. The encoding records the byte order of the
+ * sender and is swapped on receipt if needed.
+ */
+
+#ifndef vtkDataObjectBinaryMarshaller_h
+#define vtkDataObjectBinaryMarshaller_h
+
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
+#include "vtkSmartPointer.h"                          // for vtkSmartPointer
+#include "vtkType.h"                                  // for vtkIdType
+
+#include <functional> // for std::function
+#include <vector>     // for std::vector
+
+class vtkAbstractArray;
+class vtkDataObject;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkDataObjectBinaryMarshaller
+{
+public:
+  vtkDataObjectBinaryMarshaller();
+  ~vtkDataObjectBinaryMarshaller();
+
+  /**
+   * A contiguous block of the payload: the memory of one array.
+   */
+  struct Segment
+  {
+    char* Data;
+    vtkIdType Size;
+    int ElementSize;
+  };
+
+  /**
+   * Encode `data`. On success, the header and the segments referring to the
+   * arrays of `data` are available until the next call to `Marshal`,
+   * `ParseHeader` or `Reset`. Returns false if `data` cannot be encoded.
+   */
+  bool Marshal(vtkDataObject* data);
+
+  /**
+   * Decode the header at the start of `buffer` and create the data object it
+   * describes. On success, the segments point at the uninitialized arrays of
+   * the new data object, in the order in which they were marshaled.
+   */
+  bool ParseHeader(const char* buffer, vtkIdType length);
+
+  /**
+   * Finish decoding once the segments have been filled and return the data
+   * object.
+   */
+  vtkDataObject* Finish();
+
+  ///@{
+  /**
+   * Access the header and the payload segments.
+   */
+  const char* GetHeader() const { return this->Header.data(); }
+  vtkIdType GetHeaderSize() const { return static_cast<vtkIdType>(this->Header.size()); }
+  const std::vector<Segment>& GetSegments() const { return this->Segments; }
+  ///@}
+
+  /**
+   * Returns the size of the header and payload together.
+   */
+  vtkIdType GetTotalSize() const;
+
+  /**
+   * Copy the header and payload to `buffer`, which must hold
+   * `GetTotalSize()` bytes.
+   */
+  void Gather(char* buffer) const;
+
+  /**
+   * Copy the payload following the header in `buffer` into the segments.
+   * Returns false if `buffer` is too short.
+   */
+  bool Scatter(const char* buffer, vtkIdType length);
+
+  /**
+   * Release the data object, header and segments.
+   */
+  void Reset();
+
+  /**
+   * Returns true if `buffer` starts with a marshaled header. Otherwise, it
+   * was presumably written by vtkGenericDataObjectWriter.
+   */
+  static bool IsMarshaled(const char* buffer, vtkIdType length);
+
+  /**
+   * Decode a contiguous buffer produced by `Gather`. Returns nullptr on error.
+   */
+  static vtkSmartPointer<vtkDataObject> Unmarshal(const char* buffer, vtkIdType length);
+
+private:
+  vtkDataObjectBinaryMarshaller(const vtkDataObjectBinaryMarshaller&) = delete;
+  void operator=(const vtkDataObjectBinaryMarshaller&) = delete;
+
+  class Encoder;
+  class Decoder;
+
+  vtkSmartPointer<vtkDataObject> DataObject;
+  std::vector<vtkSmartPointer<vtkAbstractArray>> Arrays;
+  std::vector<char> Header;
+  std::vector<Segment> Segments;
+  std::vector<std::function<void()>> FinishSteps;
+  bool Swap;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkDataObjectBinaryMarshaller.h
@@ -7,6 +7,7 @@
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkDataObjectBinaryMarshaller.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkGenericDataObjectWriter.h"
@@ -945,42 +946,58 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
-  // Copy input to isolate reader from the pipeline.
-  vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
-  writer->SetInputData(data);
-  if (imageData)
+  // Send the raw arrays when possible, which avoids formatting and parsing
+  // with the legacy writer and reader altogether.
+  char* buffer = nullptr;
+  vtkIdType buffer_length = 0;
+  vtkSmartPointer<vtkDataWriter> writer;
+  vtkDataObjectBinaryMarshaller marshaller;
+  if (marshaller.Marshal(data))
   {
-    // We add the image extents to the header, since the writer doesn't preserve
-    // the extents.
-    int* extent = imageData->GetExtent();
-    double* origin = imageData->GetOrigin();
-    std::ostringstream stream;
-    stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
-           << " " << extent[4] << " " << extent[5];
-    stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
-    writer->SetHeader(stream.str().c_str());
+    buffer_length = marshaller.GetTotalSize();
+    buffer = new char[buffer_length];
+    marshaller.Gather(buffer);
+    marshaller.Reset();
   }
+  else
+  {
+    // Copy input to isolate reader from the pipeline.
+    writer = vtkSmartPointer<vtkGenericDataObjectWriter>::New();
+    writer->SetInputData(data);
+    if (imageData)
+    {
+      // We add the image extents to the header, since the writer doesn't preserve
+      // the extents.
+      int* extent = imageData->GetExtent();
+      double* origin = imageData->GetOrigin();
+      std::ostringstream stream;
+      stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
+             << " " << extent[4] << " " << extent[5];
+      stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
+      writer->SetHeader(stream.str().c_str());
+    }
 
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->Write();
-
-  char* buffer = nullptr;
-  vtkIdType buffer_length = 0;
+    writer->SetFileTypeToBinary();
+    writer->WriteToOutputStringOn();
+    writer->Write();
+    buffer_length = writer->GetOutputStringLength();
+    buffer = writer->RegisterAndGetOutputString();
+  }
 
   if (vtkMPIMoveData::UseZLibCompression)
   {
     vtkTimerLog::MarkStartEvent("Zlib compress");
     // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
+    char* uncompressed = buffer;
+    uLongf out_size = compressBound(buffer_length);
     buffer = new char[out_size + 8];
     memcpy(buffer, "zlib0000", 8);
 
     compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
+      reinterpret_cast<const Bytef*>(uncompressed), buffer_length,
       /* compression_level */ Z_DEFAULT_COMPRESSION);
     vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
+    int in_size = static_cast<int>(buffer_length);
     for (int cc = 0; cc < 4; cc++)
     {
       // the first 4 bytes in the header are "zlib" which helps the receiver
@@ -991,11 +1008,7 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
       in_size = in_size >> 8;
     }
     buffer_length = out_size + 8;
-  }
-  else
-  {
-    buffer_length = writer->GetOutputStringLength();
-    buffer = writer->RegisterAndGetOutputString();
+    delete[] uncompressed;
   }
 
   // Get string.
@@ -1006,9 +1019,6 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   this->BufferOffsets[0] = 0;
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
-
-  writer->Delete();
-  writer = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -1051,6 +1061,25 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
       bufferLength = uncompressed_length;
     }
 
+    if (vtkDataObjectBinaryMarshaller::IsMarshaled(bufferArray, bufferLength))
+    {
+      // Raw binary encoding, which also preserves image extents and origins.
+      vtkSmartPointer<vtkDataObject> output =
+        vtkDataObjectBinaryMarshaller::Unmarshal(bufferArray, bufferLength);
+      if (output)
+      {
+        // reconstructing data distributted on MPI node, so global ids are valid
+        unsetGlobalIdsAttribute(output);
+        pieces.push_back(output);
+      }
+      else
+      {
+        vtkErrorMacro("Failed to decode data received from another process.");
+      }
+      delete[] realBuffer;
+      continue;
+    }
+
     // Setup a reader.
     vtkDataReader* reader = vtkGenericDataObjectReader::New();
     reader->ReadFromInputStringOn();
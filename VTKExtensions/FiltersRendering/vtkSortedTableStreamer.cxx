@@ -20,6 +20,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
@@ -44,9 +45,9 @@ public:
   virtual void SetSelectedComponent(int newValue) = 0;
   virtual void InvalidateCache() = 0;
   virtual int Extract(
-    vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
+    vtkTable* input, vtkTable* output, vtkIdType offset, vtkIdType size, bool revertOrder) = 0;
   virtual int Compute(
-    vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
+    vtkTable* input, vtkTable* output, vtkIdType offset, vtkIdType size, bool revertOrder) = 0;
   virtual bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) = 0;
   virtual bool IsSortable() = 0;
   virtual bool TestInternalClasses() = 0;
@@ -382,6 +383,15 @@ public:
       }
     }
 
+    // Description:
+    // Mirror the histogram so that it matches the same values sorted in the
+    // opposite order.
+    void Reverse()
+    {
+      std::reverse(this->Values, this->Values + this->Size);
+      this->Inverted = !this->Inverted;
+    }
+
     void ClearHistogramValues()
     {
       this->TotalValues = 0;
@@ -546,11 +556,12 @@ public:
       // Sort it
       if (reverseOrder)
       {
-        std::sort(this->Array, this->Array + this->ArraySize, SortableArrayItem::Ascendent);
+        vtkSMPTools::Sort(this->Array, this->Array + this->ArraySize, SortableArrayItem::Ascendent);
       }
       else
       {
-        std::sort(this->Array, this->Array + this->ArraySize, SortableArrayItem::Descendent);
+        vtkSMPTools::Sort(
+          this->Array, this->Array + this->ArraySize, SortableArrayItem::Descendent);
       }
     }
 
@@ -579,11 +590,12 @@ public:
       // Sort it
       if (reverseOrder)
       {
-        std::sort(this->Array, this->Array + this->ArraySize, SortableArrayItem::Ascendent);
+        vtkSMPTools::Sort(this->Array, this->Array + this->ArraySize, SortableArrayItem::Ascendent);
       }
       else
       {
-        std::sort(this->Array, this->Array + this->ArraySize, SortableArrayItem::Descendent);
+        vtkSMPTools::Sort(
+          this->Array, this->Array + this->ArraySize, SortableArrayItem::Descendent);
       }
     }
   };
@@ -601,6 +613,8 @@ public:
     // Default values
     this->SelectedComponent = 0;
     this->NeedToBuildCache = true;
+    this->CacheSorted = false;
+    this->CacheInverted = false;
     this->DataToSort = dataToSort;
 
     this->InputMTime = input->GetMTime();
@@ -698,6 +712,8 @@ public:
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
+    this->CacheSorted = sortableArray;
+    this->CacheInverted = invertOrder;
 
     // Communication buffer
     vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
@@ -751,9 +767,28 @@ public:
     return 1;
   }
 
+  // --------------------------------------------------------------------------
+  // As the sorting comparators break ties using the original index, sorting
+  // in the opposite order gives exactly the reversed array. So flipping the
+  // order only needs to reverse the cached array and histograms.
+  void ReverseCache()
+  {
+    if (this->LocalSorter->Array)
+    {
+      std::reverse(
+        this->LocalSorter->Array, this->LocalSorter->Array + this->LocalSorter->ArraySize);
+    }
+    if (this->LocalSorter->Histo)
+    {
+      this->LocalSorter->Histo->Reverse();
+    }
+    this->GlobalHistogram->Reverse();
+    this->CacheInverted = !this->CacheInverted;
+  }
+
   // --------------------------------------------------------------------------
   // The sorting is based on processId and the current order
-  int Extract(vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize,
+  int Extract(vtkTable* input, vtkTable* output, vtkIdType offset, vtkIdType size,
     bool revertOrder) override
   {
     // ------------------------------------------------------------------------
@@ -761,14 +796,14 @@ public:
     //    This will sort the local array, that's why we don't want to do it
     //    at each execution. Specially when we only change the requested block.
     // ------------------------------------------------------------------------
-    if (this->NeedToBuildCache)
+    if (this->NeedToBuildCache || this->CacheSorted)
     {
       this->BuildCache(false, revertOrder);
     }
 
     // Build empty local table with empty arrays so they stay in the same order
     vtkSmartPointer<vtkTable> localResult;
-    localResult.TakeReference(NewSubsetTable(input, nullptr, 0, blockSize));
+    localResult.TakeReference(NewSubsetTable(input, nullptr, 0, size));
 
     // Get the array size of each processes
     vtkIdType* tableSizes = new vtkIdType[this->NumProcs];
@@ -776,7 +811,7 @@ public:
     this->MPI->AllGather(&nbElems, tableSizes, 1);
 
     // Get local idx based on the global one
-    vtkIdType localOffset = block * blockSize;
+    vtkIdType localOffset = offset;
     if (revertOrder)
     {
       for (int i = this->NumProcs - 1; this->Me < i; i--)
@@ -793,11 +828,11 @@ public:
     }
 
     // Extract the subset
-    vtkIdType localSize = vtkMath::Min(tableSizes[this->Me], blockSize);
+    vtkIdType localSize = vtkMath::Min(tableSizes[this->Me], size);
     if (localOffset < 0)
     {
       localSize = vtkMath::Max(static_cast<vtkIdType>(0),
-        vtkMath::Min(localOffset + vtkMath::Max(tableSizes[this->Me], blockSize), blockSize));
+        vtkMath::Min(localOffset + vtkMath::Max(tableSizes[this->Me], size), size));
       localOffset = 0;
     }
     else if (localOffset >= tableSizes[this->Me])
@@ -832,7 +867,7 @@ public:
         vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
         processIdArray->SetName("vtkOriginalProcessIds");
         processIdArray->SetNumberOfComponents(1);
-        processIdArray->Allocate(blockSize);
+        processIdArray->Allocate(size);
         vtkIdType processId = this->Me;
         for (vtkIdType idx = 0; idx < localResult->GetNumberOfRows(); idx++)
         {
@@ -849,7 +884,7 @@ public:
           continue;
 
         this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localResult.GetPointer(), blockSize);
+        this->MergeTable(i, tmp.GetPointer(), localResult.GetPointer(), size);
       }
 
       // Sort new table/array
@@ -886,7 +921,7 @@ public:
     return 1;
   }
   // --------------------------------------------------------------------------
-  int Compute(vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize,
+  int Compute(vtkTable* input, vtkTable* output, vtkIdType offset, vtkIdType size,
     bool revertOrder) override
   {
     // ------------------------------------------------------------------------
@@ -894,10 +929,14 @@ public:
     //    This will sort the local array, that's why we don't want to do it
     //    at each execution. Specially when we only change the requested block.
     // ------------------------------------------------------------------------
-    if (this->NeedToBuildCache)
+    if (this->NeedToBuildCache || !this->CacheSorted)
     {
       this->BuildCache(true, revertOrder);
     }
+    else if (this->CacheInverted != revertOrder)
+    {
+      this->ReverseCache();
+    }
 
     // ------------------------------------------------------------------------
     // Search for lower bound
@@ -905,7 +944,7 @@ public:
     vtkIdType nbElementsToRemoveFromHead = 0;
     vtkIdType localOffset = 0;
     vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
+    this->SearchGlobalIndexLocation(offset, this->LocalSorter->Histo,
       this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
 
     // ------------------------------------------------------------------------
@@ -913,9 +952,9 @@ public:
     // ------------------------------------------------------------------------
     vtkIdType upperOffset = 0;
     vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
+    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < offset + size)
       ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
+      : (offset + size);
     searchIdx--; // It is not a size it is an index (so -1)
 
     this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
@@ -944,7 +983,7 @@ public:
       vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
       processIdArray->SetName("vtkOriginalProcessIds");
       processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
+      processIdArray->Allocate((size < localSize) ? localSize : size);
       for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
       {
         processIdArray->InsertNextTuple1(mergePid);
@@ -972,7 +1011,7 @@ public:
           continue;
 
         this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
+        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), size);
       }
 
       // Sort new table/array
@@ -997,7 +1036,7 @@ public:
 
       // trim it (remove head and tail that don't belong to the result)
       localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
+        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, size));
 
       // Add extra information such as structured indices, block number...
       this->DecorateTable(input, localSubset.GetPointer(), mergePid);
@@ -1149,8 +1188,8 @@ public:
   // --------------------------------------------------------------------------
   bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) override
   {
-    return !dataToProcess || input->GetMTime() != this->InputMTime ||
-      dataToProcess->GetMTime() != this->DataMTime;
+    return dataToProcess != this->DataToSort || input->GetMTime() != this->InputMTime ||
+      (dataToProcess && dataToProcess->GetMTime() != this->DataMTime);
   }
 
   // --------------------------------------------------------------------------
@@ -1363,6 +1402,8 @@ private:
   vtkCommunicator* MPI;       // MPI communicator to send/receive/gather
   int SelectedComponent;      // Component used to sort array
   bool NeedToBuildCache;
+  bool CacheSorted;   // LocalSorter holds the sorted array (not the identity)
+  bool CacheInverted; // Order of the sorted array and histograms
   bool Debug;
 
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
@@ -1611,12 +1652,39 @@ vtkSmartPointer<vtkIdTypeArray> vtkSortedTableStreamer::GenerateBlockIndicesArra
 }
 
 //----------------------------------------------------------------------------
-int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+vtkMTimeType vtkSortedTableStreamer::GetInputMTime(vtkPartitionedDataSet* ptd)
 {
-  // Manage multiblock dataset by merging data into a single vtkTable
-  auto inputPTD = vtkPartitionedDataSet::GetData(inputVector[0], 0);
+  vtkMTimeType mtime = ptd->GetMTime();
+  for (unsigned int cc = 0, max = ptd->GetNumberOfPartitions(); cc < max; ++cc)
+  {
+    if (auto dobj = ptd->GetPartitionAsDataObject(cc))
+    {
+      mtime = std::max(mtime, dobj->GetMTime());
+    }
+  }
+  return mtime;
+}
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkTable> vtkSortedTableStreamer::PrepareInput(vtkPartitionedDataSet* inputPTD)
+{
+  // Reuse the table built for the previous request when the input did not
+  // change on any process, so that paging through blocks keeps the sorted
+  // cache and does not merge the partitions again.
+  int reuseInput = this->PreparedInput && this->PreparedInputShowFieldData == this->ShowFieldData &&
+    this->PreparedInputMTime == this->GetInputMTime(inputPTD);
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    int globalReuseInput;
+    this->Controller->AllReduce(&reuseInput, &globalReuseInput, 1, vtkCommunicator::MIN_OP);
+    reuseInput = globalReuseInput;
+  }
+  if (reuseInput)
+  {
+    return this->PreparedInput;
+  }
+
+  // Manage multiblock dataset by merging data into a single vtkTable
   vtkSmartPointer<vtkTable> input = this->MergeBlocks(inputPTD);
   if (this->ShowFieldData)
   {
@@ -1660,6 +1728,20 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // The arrays added above may have modified the input partition itself.
+  this->PreparedInput = input;
+  this->PreparedInputMTime = this->GetInputMTime(inputPTD);
+  this->PreparedInputShowFieldData = this->ShowFieldData;
+  return input;
+}
+
+//----------------------------------------------------------------------------
+int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  auto inputPTD = vtkPartitionedDataSet::GetData(inputVector[0], 0);
+  vtkSmartPointer<vtkTable> input = this->PrepareInput(inputPTD);
+
   // Get input data
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   vtkTable* output = vtkTable::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
@@ -1675,8 +1757,16 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   // single point/cell.
   // --------------------------------------------------------------------------
 
-  // Delete internal object if the input has change (table or array to sort)
-  if (this->Internal && this->Internal->IsInvalid(input, arrayToProcess))
+  // Delete internal object if the input has change (table or array to sort).
+  // All processes must agree as building the cache involves collective calls.
+  int invalid = this->Internal && this->Internal->IsInvalid(input, arrayToProcess);
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    int globalInvalid;
+    this->Controller->AllReduce(&invalid, &globalInvalid, 1, vtkCommunicator::MAX_OP);
+    invalid = globalInvalid;
+  }
+  if (invalid)
   {
     delete this->Internal;
     this->Internal = nullptr;
@@ -1688,15 +1778,21 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
     (!arrayToProcess) ? 0 : this->GetSelectedComponent() % arrayToProcess->GetNumberOfComponents();
   this->Internal->SetSelectedComponent(realComponent);
 
+  // The sorted cache refers to the rows of the input, which the projected
+  // table shares. Only the columns that are not skipped are extracted.
+  vtkSmartPointer<vtkTable> projected = this->ProjectInput(input);
+  const vtkIdType offset = this->Block * this->BlockSize;
+  const vtkIdType size = this->BlockSize * this->NumberOfBlocks;
+
   // Manage custom case where sorting occur on a virtual array (process id)
   if (!this->Internal->IsSortable() ||
     (this->GetColumnToSort() && (strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) == 0)))
   {
-    this->Internal->Extract(input, output, this->Block, this->BlockSize, orderInverted);
+    this->Internal->Extract(projected, output, offset, size, orderInverted);
   }
   else
   {
-    this->Internal->Compute(input, output, this->Block, this->BlockSize, orderInverted);
+    this->Internal->Compute(projected, output, offset, size, orderInverted);
   }
 
   if (auto names = input->GetFieldData()->GetAbstractArray("vtkBlockNames"))
@@ -1712,6 +1808,50 @@ void vtkSortedTableStreamer::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Sorting column: " << (this->ColumnToSort ? this->ColumnToSort : "(none)")
      << endl;
+  os << indent << "NumberOfBlocks: " << this->NumberOfBlocks << endl;
+  os << indent << "Columns to skip: " << this->ColumnsToSkip.size() << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkSortedTableStreamer::AddColumnToSkip(const char* columnName)
+{
+  if (columnName && this->ColumnsToSkip.insert(columnName).second)
+  {
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSortedTableStreamer::RemoveAllColumnsToSkip()
+{
+  if (!this->ColumnsToSkip.empty())
+  {
+    this->ColumnsToSkip.clear();
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkTable> vtkSortedTableStreamer::ProjectInput(vtkTable* input)
+{
+  if (this->ColumnsToSkip.empty())
+  {
+    return input;
+  }
+
+  auto projected = vtkSmartPointer<vtkTable>::New();
+  projected->SetFieldData(input->GetFieldData());
+  for (vtkIdType cc = 0; cc < input->GetNumberOfColumns(); ++cc)
+  {
+    vtkAbstractArray* column = input->GetColumn(cc);
+    const char* name = column->GetName();
+    if (name == nullptr || this->ColumnsToSkip.find(name) == this->ColumnsToSkip.end() ||
+      (this->ColumnToSort && strcmp(name, this->ColumnToSort) == 0))
+    {
+      projected->AddColumn(column);
+    }
+  }
+  return projected;
 }
 
 //----------------------------------------------------------------------------
@@ -1735,16 +1875,8 @@ void vtkSortedTableStreamer::SetColumnNameToSort(const char* columnName)
 //----------------------------------------------------------------------------
 void vtkSortedTableStreamer::SetInvertOrder(int newValue)
 {
-  bool changed = this->InvertOrder != newValue;
-  bool removeInternal = changed && strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0;
-
-  if (removeInternal && this->Internal)
-  {
-    delete this->Internal;
-    this->Internal = nullptr;
-  }
-
-  if (changed)
+  // No need to reset the internal object, its cache is reversed when needed.
+  if (this->InvertOrder != newValue)
   {
     this->InvertOrder = newValue;
     this->Modified();
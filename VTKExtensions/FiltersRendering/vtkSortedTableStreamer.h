@@ -17,6 +17,8 @@
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
 #include "vtkSmartPointer.h"                          // for vtkSmartPointer
 #include "vtkTableAlgorithm.h"
+#include <set>     // for std::set
+#include <string>  // for std::string
 #include <utility> // for std::pair
 
 class vtkDataArray;
@@ -69,6 +71,27 @@ public:
   vtkSetMacro(BlockSize, vtkIdType);
   ///@}
 
+  ///@{
+  /**
+   * Number of consecutive blocks, starting at Block, to put in the output.
+   * Fetching neighboring blocks together avoids a sort and gather pass for
+   * each of them. Default value is 1.
+   */
+  vtkGetMacro(NumberOfBlocks, vtkIdType);
+  vtkSetClampMacro(NumberOfBlocks, vtkIdType, 1, VTK_ID_MAX);
+  ///@}
+
+  ///@{
+  /**
+   * Names of columns to leave out of the output. Skipped columns are not
+   * extracted nor sent to the merging process. Skipping columns does not
+   * invalidate the sorted cache and the column to sort is never skipped.
+   * Note that the same columns must be skipped on all processes.
+   */
+  void AddColumnToSkip(const char* columnName);
+  void RemoveAllColumnsToSkip();
+  ///@}
+
   ///@{
   /**
    * Choose on which column the sort operation should occur
@@ -116,6 +139,11 @@ protected:
   void CreateInternalIfNeeded(vtkTable* input, vtkDataArray* data);
   vtkDataArray* GetDataArrayToProcess(vtkTable* input);
 
+  /**
+   * Returns a table sharing the columns of the input that are not skipped.
+   */
+  vtkSmartPointer<vtkTable> ProjectInput(vtkTable* input);
+
   ///@{
   /**
    * Choose on which column the sort operation should occur
@@ -126,6 +154,8 @@ protected:
 
   vtkIdType Block;
   vtkIdType BlockSize;
+  vtkIdType NumberOfBlocks = 1;
+  std::set<std::string> ColumnsToSkip;
   vtkMultiProcessController* Controller;
 
   char* ColumnToSort;
@@ -139,6 +169,18 @@ private:
 
   vtkSmartPointer<vtkTable> MergeBlocks(vtkPartitionedDataSet* cd);
 
+  /**
+   * Merge the input partitions into a single table and add the composite
+   * index arrays. The table is reused while the input is unchanged, which
+   * keeps the sorted cache of the internal object valid while paging.
+   */
+  vtkSmartPointer<vtkTable> PrepareInput(vtkPartitionedDataSet* ptd);
+  vtkMTimeType GetInputMTime(vtkPartitionedDataSet* ptd);
+
+  vtkSmartPointer<vtkTable> PreparedInput;
+  vtkMTimeType PreparedInputMTime = 0;
+  bool PreparedInputShowFieldData = false;
+
   /**
    * Add field data columns defined by block to the output table.
    */
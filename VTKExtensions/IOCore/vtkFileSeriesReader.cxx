@@ -19,6 +19,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkTypeTraits.h"
+#include "vtkXMLDataReader.h"
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
@@ -27,9 +28,13 @@
 
 #include <algorithm>
 #include <cctype> // for isprint().
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vtk_jsoncpp.h"
@@ -360,6 +365,171 @@ private:
 };
 }
 
+//=============================================================================
+// Internal class reading files ahead of time on a background thread.
+class vtkFileSeriesReaderPrefetcher
+{
+public:
+  ~vtkFileSeriesReaderPrefetcher() { this->Stop(); }
+
+  // Replaces the list of files to prefetch, in order of priority. Prefetched
+  // files that are not in the list are released. When `keepData` is false, the
+  // files are only read to bring them into the page cache.
+  void Prefetch(const std::vector<std::string>& fileNames, bool keepData, size_t memoryLimit)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (auto iter = this->Buffers.begin(); iter != this->Buffers.end();)
+    {
+      if (std::find(fileNames.begin(), fileNames.end(), iter->first) == fileNames.end())
+      {
+        this->BufferedSize -= iter->second.Data.size();
+        iter = this->Buffers.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+
+    this->Queue.clear();
+    for (const auto& fileName : fileNames)
+    {
+      if (fileName != this->Reading && this->Buffers.find(fileName) == this->Buffers.end())
+      {
+        this->Queue.push_back(fileName);
+      }
+    }
+    this->KeepData = keepData;
+    this->MemoryLimit = memoryLimit;
+
+    if (!this->Thread.joinable())
+    {
+      this->Done = false;
+      this->Thread = std::thread(&vtkFileSeriesReaderPrefetcher::Run, this);
+    }
+    this->Condition.notify_all();
+  }
+
+  // Returns true and the content of `fileName` in `data` if the file has been
+  // prefetched, waiting for it if it is being read. `data` is empty if the file
+  // was only brought into the page cache.
+  bool Take(const std::string& fileName, std::string& data)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Queue.erase(
+      std::remove(this->Queue.begin(), this->Queue.end(), fileName), this->Queue.end());
+    this->Condition.wait(lock, [&]() { return this->Reading != fileName; });
+
+    auto iter = this->Buffers.find(fileName);
+    if (iter == this->Buffers.end())
+    {
+      return false;
+    }
+    const bool unchanged =
+      iter->second.ModifiedTime == vtksys::SystemTools::ModifiedTime(fileName);
+    this->BufferedSize -= iter->second.Data.size();
+    data = unchanged ? std::move(iter->second.Data) : std::string();
+    this->Buffers.erase(iter);
+    return unchanged;
+  }
+
+  // Stops the background thread and releases all prefetched files.
+  void Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Done = true;
+      this->Queue.clear();
+      this->Condition.notify_all();
+    }
+    if (this->Thread.joinable())
+    {
+      this->Thread.join();
+    }
+    this->Buffers.clear();
+    this->BufferedSize = 0;
+  }
+
+private:
+  struct vtkBuffer
+  {
+    std::string Data;
+    long ModifiedTime;
+  };
+
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Done || !this->Queue.empty(); });
+      if (this->Done)
+      {
+        return;
+      }
+
+      const std::string fileName = this->Queue.front();
+      this->Queue.pop_front();
+      this->Reading = fileName;
+      const bool keepData = this->KeepData;
+      lock.unlock();
+
+      vtkBuffer buffer;
+      buffer.ModifiedTime = vtksys::SystemTools::ModifiedTime(fileName);
+      const size_t size = static_cast<size_t>(vtksys::SystemTools::FileLength(fileName));
+
+      lock.lock();
+      if (keepData && this->BufferedSize + size > this->MemoryLimit)
+      {
+        // does not fit, leave it to the reader.
+        this->Reading.clear();
+        this->Condition.notify_all();
+        continue;
+      }
+      // reserve the memory while reading without holding the lock.
+      this->BufferedSize += keepData ? size : 0;
+      lock.unlock();
+
+      vtksys::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+      bool success = file.good();
+      if (success && keepData)
+      {
+        buffer.Data.resize(size);
+        success = static_cast<bool>(file.read(&buffer.Data[0], size));
+      }
+      else if (success)
+      {
+        char chunk[65536];
+        while (file.read(chunk, sizeof(chunk)))
+        {
+        }
+        success = file.eof();
+      }
+
+      lock.lock();
+      this->BufferedSize -= keepData ? size : 0;
+      if (success)
+      {
+        this->BufferedSize += buffer.Data.size();
+        this->Buffers[fileName] = std::move(buffer);
+      }
+      this->Reading.clear();
+      this->Condition.notify_all();
+    }
+  }
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::thread Thread;
+  std::deque<std::string> Queue;
+  std::map<std::string, vtkBuffer> Buffers;
+  std::string Reading;
+  size_t BufferedSize = 0;
+  size_t MemoryLimit = 0;
+  bool KeepData = false;
+  bool Done = false;
+};
+
 //=============================================================================
 struct vtkFileSeriesReaderInternals
 {
@@ -368,6 +538,12 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+
+  vtkFileSeriesReaderPrefetcher Prefetcher;
+  // Whether the reader was last given the content of a prefetched file.
+  bool ReaderUsesPrefetchedFile = false;
+  int LastRequestedIndex = -1;
+  int PrefetchDirection = 1;
 };
 
 //=============================================================================
@@ -384,11 +560,17 @@ vtkFileSeriesReader::vtkFileSeriesReader()
   this->UseJsonMetaFile = false;
 
   this->IgnoreReaderTime = false;
+
+  this->NumberOfFilesToPrefetch = 0;
+  this->PrefetchMemoryLimit = 1024;
+  this->PrefetchHits = 0;
+  this->PrefetchMisses = 0;
 }
 
 //-----------------------------------------------------------------------------
 vtkFileSeriesReader::~vtkFileSeriesReader()
 {
+  this->Internal->Prefetcher.Stop();
   delete this->Internal->TimeRanges;
   delete this->Internal;
 }
@@ -679,6 +861,7 @@ int vtkFileSeriesReader::RequestUpdateExtent(vtkInformation* request,
   outputVector->GetInformationObject(requestFromPort)
     ->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), index);
   this->RequestInformationForInput(index);
+  this->PrefetchFiles(index);
 
 // I commented out the following block because it is probably not important
 // and it is causing a crash in some circumstances (bug #7253).
@@ -737,6 +920,9 @@ int vtkFileSeriesReader::RequestInformationForInput(
     {
       this->ReaderSetFileName(nullptr);
     }
+    // Only data requests read the prefetched files, RequestInformation goes
+    // over all of them.
+    this->UsePrefetchedFile(outputVector == nullptr ? this->GetFileName(index) : nullptr);
 
     this->_FileIndex = index;
     // Need to call RequestInformation on reader to refresh any metadata for the
@@ -960,6 +1146,91 @@ void vtkFileSeriesReader::UpdateMetaData()
   this->MetaFileReadTime.Modified();
 }
 
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::SetNumberOfFilesToPrefetch(int count)
+{
+  // prefetching does not affect the output, hence no Modified().
+  this->NumberOfFilesToPrefetch = std::max(count, 0);
+  if (this->NumberOfFilesToPrefetch == 0)
+  {
+    this->Internal->Prefetcher.Stop();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::SetPrefetchMemoryLimit(int limit)
+{
+  this->PrefetchMemoryLimit = std::max(limit, 0);
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::ResetPrefetchStatistics()
+{
+  this->PrefetchHits = 0;
+  this->PrefetchMisses = 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::UsePrefetchedFile(const char* fileName)
+{
+  auto& internals = *this->Internal;
+  std::string data;
+  bool prefetched = false;
+  if (fileName && this->NumberOfFilesToPrefetch > 0)
+  {
+    prefetched = internals.Prefetcher.Take(fileName, data);
+    ++(prefetched ? this->PrefetchHits : this->PrefetchMisses);
+  }
+
+  // Serial XML readers can parse the content from memory.
+  auto xmlReader = vtkXMLDataReader::SafeDownCast(this->Reader);
+  if (!xmlReader)
+  {
+    return;
+  }
+  if (prefetched && !data.empty())
+  {
+    xmlReader->SetInputString(data);
+    xmlReader->ReadFromInputStringOn();
+    internals.ReaderUsesPrefetchedFile = true;
+  }
+  else if (internals.ReaderUsesPrefetchedFile)
+  {
+    xmlReader->ReadFromInputStringOff();
+    xmlReader->SetInputString(std::string());
+    internals.ReaderUsesPrefetchedFile = false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::PrefetchFiles(int index)
+{
+  auto& internals = *this->Internal;
+  if (index != internals.LastRequestedIndex && internals.LastRequestedIndex >= 0)
+  {
+    internals.PrefetchDirection = index < internals.LastRequestedIndex ? -1 : 1;
+  }
+  internals.LastRequestedIndex = index;
+  if (this->NumberOfFilesToPrefetch <= 0)
+  {
+    return;
+  }
+
+  const int numFiles = static_cast<int>(this->GetNumberOfFileNames());
+  std::vector<std::string> fileNames;
+  for (int cc = 1; cc <= this->NumberOfFilesToPrefetch; ++cc)
+  {
+    const int next = index + cc * internals.PrefetchDirection;
+    if (next < 0 || next >= numFiles)
+    {
+      break;
+    }
+    fileNames.emplace_back(this->GetFileName(next));
+  }
+  internals.Prefetcher.Prefetch(fileNames, vtkXMLDataReader::SafeDownCast(this->Reader) != nullptr,
+    static_cast<size_t>(this->PrefetchMemoryLimit) * 1024 * 1024);
+}
+
 //-----------------------------------------------------------------------------
 const char* vtkFileSeriesReader::GetCurrentFileName()
 {
@@ -975,6 +1246,10 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "NumberOfFilesToPrefetch: " << this->NumberOfFilesToPrefetch << endl;
+  os << indent << "PrefetchMemoryLimit: " << this->PrefetchMemoryLimit << endl;
+  os << indent << "PrefetchHits: " << this->PrefetchHits << endl;
+  os << indent << "PrefetchMisses: " << this->PrefetchMisses << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -55,6 +55,11 @@
  * with SetMetaFileName in this case. Do not use the AddFileName() method when
  * using SetMetaFileName() as names set with AddFileName() will be ignored.
  *
+ * To hide the disk latency when playing an animation, the reader can read the
+ * next files of the series in the direction of the animation on a background
+ * thread (see SetNumberOfFilesToPrefetch). Serial XML readers are given the
+ * prefetched content directly; for other readers, prefetching only brings the
+ * files into the page cache of the operating system.
 */
 
 #ifndef vtkFileSeriesReader_h
@@ -133,6 +138,36 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set/get the number of files following the one being read, in the direction
+   * in which time steps are requested, that are read ahead on a background
+   * thread. 0 (default) disables prefetching. Changing this value does not
+   * modify the reader since it does not affect its output.
+   */
+  void SetNumberOfFilesToPrefetch(int count);
+  vtkGetMacro(NumberOfFilesToPrefetch, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/get the maximum amount of memory, in MiB, used to hold prefetched
+   * files. Files that do not fit are not prefetched. Default is 1024.
+   */
+  void SetPrefetchMemoryLimit(int limit);
+  vtkGetMacro(PrefetchMemoryLimit, int);
+  ///@}
+
+  ///@{
+  /**
+   * Returns the number of files read while prefetching was enabled that had
+   * been prefetched (hits) or not (misses).
+   */
+  vtkGetMacro(PrefetchHits, vtkIdType);
+  vtkGetMacro(PrefetchMisses, vtkIdType);
+  void ResetPrefetchStatistics();
+  ///@}
+
   // Expose number of files, first filename and current file number as
   // information keys for potential use in the internal reader
   static vtkInformationIntegerKey* FILE_SERIES_NUMBER_OF_FILES();
@@ -215,6 +250,22 @@ protected:
 
   int ChooseInput(vtkInformation*);
 
+  /**
+   * Hands the prefetched content of `fileName`, if any, to the reader. Passing
+   * nullptr makes the reader read from its file again.
+   */
+  void UsePrefetchedFile(const char* fileName);
+
+  /**
+   * Schedules prefetching of the files following `index`.
+   */
+  void PrefetchFiles(int index);
+
+  int NumberOfFilesToPrefetch;
+  int PrefetchMemoryLimit;
+  vtkIdType PrefetchHits;
+  vtkIdType PrefetchMisses;
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
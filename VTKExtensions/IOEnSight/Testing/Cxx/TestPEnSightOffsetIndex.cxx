@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPEnSightGoldReader.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <map>
+#include <string>
+
+namespace
+{
+// Exposes the offset index API of the reader.
+class vtkOffsetIndexReader : public vtkPEnSightGoldReader
+{
+public:
+  static vtkOffsetIndexReader* New();
+  vtkTypeMacro(vtkOffsetIndexReader, vtkPEnSightGoldReader);
+
+  using vtkPEnSightReader::LoadFileOffsetIndex;
+  using vtkPEnSightReader::SaveFileOffsetIndices;
+
+  std::map<int, long>& GetFileOffsets(const std::string& fileName)
+  {
+    return this->FileOffsets[fileName];
+  }
+};
+vtkStandardNewMacro(vtkOffsetIndexReader);
+
+bool WriteDataFile(const std::string& fileName, size_t size)
+{
+  vtksys::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  file << std::string(size, 'x');
+  return static_cast<bool>(file);
+}
+
+bool CheckOffsets(const std::map<int, long>& offsets, const std::map<int, long>& expected,
+  const std::string& fileName)
+{
+  if (offsets != expected)
+  {
+    vtkLogF(ERROR, "Incorrect offsets for '%s': %d time steps read, %d expected.",
+      fileName.c_str(), static_cast<int>(offsets.size()), static_cast<int>(expected.size()));
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPEnSightOffsetIndex(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string path = std::string(tempDir) + "/TestPEnSightOffsetIndex";
+  delete[] tempDir;
+  vtksys::SystemTools::MakeDirectory(path);
+
+  // a geometry and a variable file, each with its own time step offsets.
+  const std::map<std::string, std::map<int, long>> expected = {
+    { "data.geo", { { 0, 80 }, { 1, 1024 }, { 2, 1968 }, { 5, 4800 } } },
+    { "data.scl", { { 0, 80 }, { 3, 2480 } } }
+  };
+  for (const auto& file : expected)
+  {
+    vtksys::SystemTools::RemoveFile(path + "/" + file.first + ".pvindex");
+    if (!::WriteDataFile(path + "/" + file.first, 8192))
+    {
+      vtkLogF(ERROR, "Failed to write '%s'.", file.first.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  {
+    vtkNew<vtkOffsetIndexReader> writer;
+    writer->SetFilePath(path.c_str());
+    writer->UseOffsetIndexFilesOn();
+    for (const auto& file : expected)
+    {
+      // no index yet.
+      writer->LoadFileOffsetIndex(file.first.c_str());
+      if (!writer->GetFileOffsets(file.first).empty())
+      {
+        vtkLogF(ERROR, "Offsets loaded without an index for '%s'.", file.first.c_str());
+        return EXIT_FAILURE;
+      }
+      writer->GetFileOffsets(file.first) = file.second;
+    }
+    writer->SaveFileOffsetIndices();
+  }
+
+  // read back the indices with a new reader.
+  vtkNew<vtkOffsetIndexReader> reader;
+  reader->SetFilePath(path.c_str());
+  reader->UseOffsetIndexFilesOn();
+  for (const auto& file : expected)
+  {
+    if (!vtksys::SystemTools::FileExists(path + "/" + file.first + ".pvindex", true))
+    {
+      vtkLogF(ERROR, "No index written for '%s'.", file.first.c_str());
+      return EXIT_FAILURE;
+    }
+    reader->LoadFileOffsetIndex(file.first.c_str());
+    if (!::CheckOffsets(reader->GetFileOffsets(file.first), file.second, file.first))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // indices are not used when disabled.
+  vtkNew<vtkOffsetIndexReader> disabled;
+  disabled->SetFilePath(path.c_str());
+  disabled->LoadFileOffsetIndex("data.geo");
+  if (!disabled->GetFileOffsets("data.geo").empty())
+  {
+    vtkLogF(ERROR, "Offsets loaded while UseOffsetIndexFiles is off.");
+    return EXIT_FAILURE;
+  }
+
+  // the index of a rewritten data file is out of date.
+  if (!::WriteDataFile(path + "/data.geo", 4096))
+  {
+    vtkLogF(ERROR, "Failed to write 'data.geo'.");
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkOffsetIndexReader> outOfDate;
+  outOfDate->SetFilePath(path.c_str());
+  outOfDate->UseOffsetIndexFilesOn();
+  outOfDate->LoadFileOffsetIndex("data.geo");
+  outOfDate->LoadFileOffsetIndex("data.scl");
+  if (!outOfDate->GetFileOffsets("data.geo").empty() ||
+    !::CheckOffsets(outOfDate->GetFileOffsets("data.scl"), expected.at("data.scl"), "data.scl"))
+  {
+    vtkLogF(ERROR, "Out of date index was used.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
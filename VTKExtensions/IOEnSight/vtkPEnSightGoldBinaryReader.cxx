@@ -245,6 +245,7 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
   {
     int realTimeStep = timeStep - 1;
     int j = 0;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     for (i = realTimeStep; i >= 0; i--)
     {
@@ -1124,6 +1125,7 @@ int vtkPEnSightGoldBinaryReader::ReadMeasuredGeometryFile(
   {
     int realTimeStep = timeStep - 1;
     int k, j = 0;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     for (k = realTimeStep; k >= 0; k--)
     {
@@ -1310,6 +1312,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1527,6 +1530,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1733,6 +1737,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
   {
     int realTimeStep = timeStep - 1;
     int j = 0;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     for (i = realTimeStep; i >= 0; i--)
     {
@@ -1892,6 +1897,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -2138,6 +2144,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -2384,6 +2391,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
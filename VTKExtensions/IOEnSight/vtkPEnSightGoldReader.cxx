@@ -115,6 +115,7 @@ int vtkPEnSightGoldReader::ReadGeometryFile(
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -320,6 +321,7 @@ int vtkPEnSightGoldReader::ReadMeasuredGeometryFile(
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -470,6 +472,7 @@ int vtkPEnSightGoldReader::ReadScalarsPerNode(const char* fileName, const char*
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -690,6 +693,7 @@ int vtkPEnSightGoldReader::ReadVectorsPerNode(const char* fileName, const char*
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -869,6 +873,7 @@ int vtkPEnSightGoldReader::ReadTensorsPerNode(const char* fileName, const char*
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -995,6 +1000,7 @@ int vtkPEnSightGoldReader::ReadScalarsPerElement(const char* fileName, const cha
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     int j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1202,6 +1208,7 @@ int vtkPEnSightGoldReader::ReadVectorsPerElement(const char* fileName, const cha
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
@@ -1371,6 +1378,7 @@ int vtkPEnSightGoldReader::ReadTensorsPerElement(const char* fileName, const cha
   if (this->UseFileSets)
   {
     int realTimeStep = timeStep - 1;
+    this->LoadFileOffsetIndex(fileName);
     // Try to find the nearest time step for which we know the offset
     j = 0;
     for (i = realTimeStep; i >= 0; i--)
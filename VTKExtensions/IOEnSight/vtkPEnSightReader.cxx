@@ -28,6 +28,7 @@
 #include "vtkUnstructuredGrid.h"
 
 #include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
 
 typedef std::vector<vtkPEnSightReader::vtkPEnSightReaderCellIds*> vtkPEnSightReaderCellIdsTypeBase;
 class vtkPEnSightReaderCellIdsType : public vtkPEnSightReaderCellIdsTypeBase
@@ -426,9 +427,137 @@ int vtkPEnSightReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  this->SaveFileOffsetIndices();
+
   return 1;
 }
 
+//----------------------------------------------------------------------------
+// Offset index files are small text files stored next to the data files:
+//
+//   pvindex 1
+//   size <size of the data file in bytes>
+//   mtime <modification time of the data file>
+//   <time step> <offset>
+//   ...
+//
+// The size and modification time of the data file are used to discard
+// indices of files that were rewritten since the index was saved.
+namespace
+{
+const char* OffsetIndexExtension = ".pvindex";
+
+std::string GetFullFileName(const char* filePath, const char* fileName)
+{
+  std::string result;
+  if (filePath && *filePath)
+  {
+    result = filePath;
+    if (result.back() != '/')
+    {
+      result += "/";
+    }
+  }
+  result += fileName;
+  return result;
+}
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightReader::LoadFileOffsetIndex(const char* fileName)
+{
+  if (!this->UseOffsetIndexFiles || !fileName ||
+    this->IndexedFileOffsets.find(fileName) != this->IndexedFileOffsets.end())
+  {
+    return;
+  }
+  // Only look for the index the first time the file is used.
+  size_t& indexed = this->IndexedFileOffsets[fileName];
+  indexed = 0;
+
+  const std::string dataFileName = ::GetFullFileName(this->FilePath, fileName);
+  vtksys::ifstream index((dataFileName + ::OffsetIndexExtension).c_str());
+  if (!index)
+  {
+    return;
+  }
+
+  std::string magic, sizeKey, mtimeKey;
+  int version = 0;
+  unsigned long size = 0;
+  long mtime = 0;
+  index >> magic >> version >> sizeKey >> size >> mtimeKey >> mtime;
+  if (!index || magic != "pvindex" || version != 1 || sizeKey != "size" || mtimeKey != "mtime" ||
+    size != vtksys::SystemTools::FileLength(dataFileName) ||
+    mtime != vtksys::SystemTools::ModifiedTime(dataFileName))
+  {
+    vtkDebugMacro("Ignoring out of date offset index for " << dataFileName);
+    return;
+  }
+
+  std::map<int, long>& offsets = this->FileOffsets[fileName];
+  int timeStep;
+  long offset;
+  while (index >> timeStep >> offset)
+  {
+    offsets.insert(std::make_pair(timeStep, offset));
+  }
+  indexed = offsets.size();
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightReader::SaveFileOffsetIndices()
+{
+  // All processes find the same offsets, so only one of them writes.
+  if (!this->UseOffsetIndexFiles || this->GetMultiProcessLocalProcessId() > 0)
+  {
+    return;
+  }
+
+  for (const auto& fileOffsets : this->FileOffsets)
+  {
+    size_t& indexed = this->IndexedFileOffsets[fileOffsets.first];
+    if (fileOffsets.second.size() <= indexed)
+    {
+      continue;
+    }
+
+    // Write to a temporary file first so that other processes or sessions
+    // never read a partial index. Failures are not errors: the index is
+    // only an optimization.
+    const std::string dataFileName =
+      ::GetFullFileName(this->FilePath, fileOffsets.first.c_str());
+    const std::string indexFileName = dataFileName + ::OffsetIndexExtension;
+    const std::string tmpFileName = indexFileName + ".tmp";
+    {
+      vtksys::ofstream index(tmpFileName.c_str());
+      if (!index)
+      {
+        continue;
+      }
+      index << "pvindex 1\n"
+            << "size " << vtksys::SystemTools::FileLength(dataFileName) << "\n"
+            << "mtime " << vtksys::SystemTools::ModifiedTime(dataFileName) << "\n";
+      for (const auto& offset : fileOffsets.second)
+      {
+        index << offset.first << " " << offset.second << "\n";
+      }
+      if (!index)
+      {
+        continue;
+      }
+    }
+    if (vtksys::SystemTools::RenameFile(tmpFileName, indexFileName))
+    {
+      indexed = fileOffsets.second.size();
+    }
+    else
+    {
+      vtksys::SystemTools::RemoveFile(tmpFileName);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightReader::RequestInformation(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
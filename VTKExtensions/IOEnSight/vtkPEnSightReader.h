@@ -805,6 +805,20 @@ protected:
 
   std::map<std::string, std::map<int, long>> FileOffsets;
 
+  ///@{
+  /**
+   * Offset index support, see UseOffsetIndexFiles. LoadFileOffsetIndex merges
+   * the sidecar index of a data file into FileOffsets the first time the file
+   * is seeked. SaveFileOffsetIndices writes the index of every data file for
+   * which new offsets were found.
+   */
+  void LoadFileOffsetIndex(const char* fileName);
+  void SaveFileOffsetIndices();
+  ///@}
+
+  // Number of offsets stored in the sidecar index of each data file.
+  std::map<std::string, size_t> IndexedFileOffsets;
+
 private:
   vtkPEnSightReader(const vtkPEnSightReader&) = delete;
   void operator=(const vtkPEnSightReader&) = delete;
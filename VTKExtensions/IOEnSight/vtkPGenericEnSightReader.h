@@ -27,6 +27,20 @@ public:
   vtkTypeMacro(vtkPGenericEnSightReader, vtkGenericEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * When on, the offsets of the time steps found while seeking in transient
+   * single-file data files are saved next to each data file in a
+   * `<file>.pvindex` sidecar and reused by later sessions, so jumping to a
+   * time step no longer scans all the preceding ones. An index is ignored
+   * when the size or modification time of its data file changed. Only used
+   * by the parallel Gold readers. Default is off.
+   */
+  vtkSetMacro(UseOffsetIndexFiles, bool);
+  vtkGetMacro(UseOffsetIndexFiles, bool);
+  vtkBooleanMacro(UseOffsetIndexFiles, bool);
+  ///@}
+
 protected:
   vtkPGenericEnSightReader();
   ~vtkPGenericEnSightReader() override;
@@ -45,6 +59,8 @@ protected:
   int MultiProcessLocalProcessId;
   int MultiProcessNumberOfProcesses;
 
+  bool UseOffsetIndexFiles;
+
 private:
   vtkPGenericEnSightReader(const vtkPGenericEnSightReader&) = delete;
   void operator=(const vtkPGenericEnSightReader&) = delete;
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkByteSwap.h"
+#include "vtkLogger.h"
+#include "vtkSpyPlotIStream.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Writes `numberOfValues` big-endian integers followed by as many big-endian
+// doubles, as found in SpyPlot files.
+bool WriteFile(const std::string& filename, int numberOfValues, int offset)
+{
+  std::vector<int> ints(numberOfValues);
+  std::vector<double> doubles(numberOfValues);
+  for (int cc = 0; cc < numberOfValues; ++cc)
+  {
+    ints[cc] = offset + cc;
+    doubles[cc] = 0.5 * (offset + cc);
+  }
+  vtkByteSwap::SwapBERange(ints.data(), numberOfValues);
+  vtkByteSwap::SwapBERange(doubles.data(), numberOfValues);
+
+  vtksys::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(ints.data()), ints.size() * sizeof(int));
+  file.write(reinterpret_cast<const char*>(doubles.data()), doubles.size() * sizeof(double));
+  return static_cast<bool>(file);
+}
+
+bool ReadFile(const vtkSpyPlotMappedFile& mappedFile, int numberOfValues, int offset)
+{
+  vtkSpyPlotIStream spis;
+  spis.SetMappedFile(&mappedFile);
+  if (!spis.IsMapped())
+  {
+    vtkLogF(ERROR, "Stream is not mapped.");
+    return false;
+  }
+
+  std::vector<int> ints(numberOfValues);
+  std::vector<double> doubles(numberOfValues);
+  if (!spis.ReadInt32s(ints.data(), numberOfValues) ||
+    !spis.ReadDoubles(doubles.data(), numberOfValues))
+  {
+    vtkLogF(ERROR, "Failed to read values.");
+    return false;
+  }
+  for (int cc = 0; cc < numberOfValues; ++cc)
+  {
+    if (ints[cc] != offset + cc || doubles[cc] != 0.5 * (offset + cc))
+    {
+      vtkLogF(ERROR, "Incorrect value at %d: %d, %g", cc, ints[cc], doubles[cc]);
+      return false;
+    }
+  }
+
+  // reading past the end fails and leaves the stream at the end.
+  int value;
+  if (spis.ReadInt32s(&value, 1) || spis.Tell() != static_cast<vtkTypeInt64>(mappedFile.GetSize()))
+  {
+    vtkLogF(ERROR, "Reading past the end of the mapping did not fail.");
+    return false;
+  }
+
+  // in-place reads point into the mapping.
+  spis.Seek(4);
+  const unsigned char* data = spis.ReadInPlace(sizeof(int));
+  int expected = offset + 1;
+  vtkByteSwap::SwapBE(&expected);
+  if (data != mappedFile.GetData() + 4 || memcmp(data, &expected, sizeof(int)) != 0 ||
+    spis.Tell() != 8)
+  {
+    vtkLogF(ERROR, "Incorrect in-place read.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestSpyPlotMappedFile(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string filename = std::string(tempDir) + "/TestSpyPlotMappedFile.bin";
+  delete[] tempDir;
+
+  if (!::WriteFile(filename, 1000, 0))
+  {
+    vtkLogF(ERROR, "Failed to write '%s'.", filename.c_str());
+    return EXIT_FAILURE;
+  }
+
+  vtkSpyPlotMappedFile mappedFile;
+  if (!mappedFile.Open(filename.c_str()) || !mappedFile.IsOpen(filename.c_str()) ||
+    mappedFile.GetSize() != 1000 * (sizeof(int) + sizeof(double)))
+  {
+    vtkLogF(ERROR, "Failed to map '%s'.", filename.c_str());
+    return EXIT_FAILURE;
+  }
+  if (!::ReadFile(mappedFile, 1000, 0))
+  {
+    return EXIT_FAILURE;
+  }
+
+#if !defined(_WIN32)
+  // a rewritten file must not be read through the old mapping. Windows does
+  // not allow writing to mapped files.
+  if (!::WriteFile(filename, 1500, 7))
+  {
+    vtkLogF(ERROR, "Failed to write '%s'.", filename.c_str());
+    return EXIT_FAILURE;
+  }
+  if (mappedFile.IsOpen(filename.c_str()))
+  {
+    vtkLogF(ERROR, "Mapping of a modified file is reused.");
+    return EXIT_FAILURE;
+  }
+  if (!mappedFile.Open(filename.c_str()) || !::ReadFile(mappedFile, 1500, 7))
+  {
+    return EXIT_FAILURE;
+  }
+#endif
+
+  mappedFile.Close();
+  if (mappedFile.IsOpen() || mappedFile.IsOpen(filename.c_str()))
+  {
+    vtkLogF(ERROR, "Mapping is still open after Close().");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkByteSwap.h"
+#include "vtkLogger.h"
+#include "vtkSMPTools.h"
+#include "vtkSpyPlotRunLengthDecoder.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+void AppendFloat(std::vector<unsigned char>& buffer, float value)
+{
+  vtkByteSwap::SwapBE(&value);
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(float));
+}
+
+// Run-length encodes `values` the way CTH does: runs of up to 127 repeated
+// values, or up to 127 literal values.
+std::vector<unsigned char> Encode(const std::vector<float>& values)
+{
+  std::vector<unsigned char> result;
+  size_t cc = 0;
+  while (cc < values.size())
+  {
+    size_t run = 1;
+    while (cc + run < values.size() && run < 127 && values[cc + run] == values[cc])
+    {
+      ++run;
+    }
+    if (run > 2)
+    {
+      result.push_back(static_cast<unsigned char>(run));
+      ::AppendFloat(result, values[cc]);
+      cc += run;
+      continue;
+    }
+    size_t literals = 0;
+    while (cc + literals < values.size() && literals < 127 &&
+      !(cc + literals + 2 < values.size() && values[cc + literals] == values[cc + literals + 1] &&
+        values[cc + literals] == values[cc + literals + 2]))
+    {
+      ++literals;
+    }
+    result.push_back(static_cast<unsigned char>(128 + literals));
+    for (size_t k = 0; k < literals; ++k)
+    {
+      ::AppendFloat(result, values[cc + k]);
+    }
+    cc += literals;
+  }
+  return result;
+}
+
+// Synthetic volume fraction like plane: constant regions with a noisy
+// interface.
+std::vector<float> CreatePlane(int block, int z, int planeSize)
+{
+  std::vector<float> values(planeSize);
+  for (int cc = 0; cc < planeSize; ++cc)
+  {
+    const double v = std::sin(0.05 * (cc + 7 * block + 13 * z));
+    values[cc] = v > 0.5 ? 1.0f : (v < -0.5 ? 0.0f : static_cast<float>(0.5 + v));
+  }
+  return values;
+}
+
+bool Decode(const std::vector<std::vector<unsigned char>>& encoded, int planeSize,
+  std::vector<float>& floats, std::vector<unsigned char>& chars)
+{
+  vtkSpyPlotRunLengthDecoder decoder;
+  for (size_t cc = 0; cc < encoded.size(); ++cc)
+  {
+    const int size = static_cast<int>(encoded[cc].size());
+    memcpy(decoder.AddPlane(size, floats.data() + cc * planeSize, planeSize), encoded[cc].data(),
+      size);
+    memcpy(decoder.AddPlane(size, chars.data() + cc * planeSize, planeSize), encoded[cc].data(),
+      size);
+  }
+  return decoder.Execute();
+}
+}
+
+int TestSpyPlotRunLengthDecoder(int, char*[])
+{
+  const int numberOfBlocks = 200;
+  const int blockSize = 20;
+  const int planeSize = blockSize * blockSize;
+  std::vector<std::vector<unsigned char>> encoded;
+  std::vector<float> expected;
+  for (int block = 0; block < numberOfBlocks; ++block)
+  {
+    for (int z = 0; z < blockSize; ++z)
+    {
+      auto plane = ::CreatePlane(block, z, planeSize);
+      encoded.push_back(::Encode(plane));
+      expected.insert(expected.end(), plane.begin(), plane.end());
+    }
+  }
+
+  // corrupt input must be rejected.
+  std::vector<float> plane(planeSize);
+  std::vector<unsigned char> corrupt = encoded[0];
+  corrupt.resize(corrupt.size() - 1);
+  if (vtkSpyPlotRunLengthDecoder::Decode(
+        corrupt.data(), static_cast<int>(corrupt.size()), plane.data(), planeSize) ||
+    vtkSpyPlotRunLengthDecoder::Decode(
+      encoded[0].data(), static_cast<int>(encoded[0].size()), plane.data(), planeSize - 1))
+  {
+    vtkLogF(ERROR, "Corrupt input was not detected.");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<float> serialFloats(expected.size()), floats(expected.size());
+  std::vector<unsigned char> serialChars(expected.size()), chars(expected.size());
+  bool serialStatus = false;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 },
+    [&]() { serialStatus = ::Decode(encoded, planeSize, serialFloats, serialChars); });
+  if (!serialStatus || !::Decode(encoded, planeSize, floats, chars))
+  {
+    vtkLogF(ERROR, "Failed to decode.");
+    return EXIT_FAILURE;
+  }
+
+  for (size_t cc = 0; cc < expected.size(); ++cc)
+  {
+    const unsigned char expectedChar = static_cast<unsigned char>(expected[cc] * 255);
+    if (floats[cc] != expected[cc] || serialFloats[cc] != expected[cc] ||
+      chars[cc] != expectedChar || serialChars[cc] != expectedChar)
+    {
+      vtkLogF(ERROR, "Mismatch at %d: %g != %g", static_cast<int>(cc), floats[cc], expected[cc]);
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
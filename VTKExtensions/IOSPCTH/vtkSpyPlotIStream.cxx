@@ -3,32 +3,175 @@
 #include "vtkSpyPlotIStream.h"
 #include "vtkByteSwap.h"
 
-int vtkSpyPlotIStream::ReadString(char* str, size_t len)
+#include <vtksys/SystemTools.hxx>
+
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+vtkSpyPlotMappedFile::vtkSpyPlotMappedFile()
+  : Data(nullptr)
+  , Size(0)
+  , ModifiedTime(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+vtkSpyPlotMappedFile::~vtkSpyPlotMappedFile()
+{
+  this->Close();
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSpyPlotMappedFile::Open(const char* filename)
 {
-  this->IStream->read(str, len);
-  if (len != static_cast<size_t>(this->IStream->gcount()))
+  this->Close();
+  if (!filename)
   {
-    return 0;
+    return false;
   }
-  return 1;
+
+#if defined(_WIN32)
+  HANDLE file =
+    CreateFileW(vtksys::SystemTools::ConvertToWindowsExtendedPath(filename).c_str(), GENERIC_READ,
+      FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  LARGE_INTEGER size;
+  HANDLE mapping = nullptr;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+  {
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  }
+  CloseHandle(file);
+  if (!mapping)
+  {
+    return false;
+  }
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!data)
+  {
+    return false;
+  }
+  this->Size = static_cast<size_t>(size.QuadPart);
+#else
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat info;
+  void* data = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && info.st_size > 0)
+  {
+    data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    return false;
+  }
+  this->Size = static_cast<size_t>(info.st_size);
+#if defined(POSIX_MADV_SEQUENTIAL)
+  posix_madvise(data, this->Size, POSIX_MADV_SEQUENTIAL);
+#endif
+#endif
+
+  this->Data = static_cast<const unsigned char*>(data);
+  this->FileName = filename;
+  this->ModifiedTime = vtksys::SystemTools::ModifiedTime(filename);
+  return true;
 }
+
 //-----------------------------------------------------------------------------
-int vtkSpyPlotIStream::ReadString(unsigned char* str, size_t len)
+bool vtkSpyPlotMappedFile::IsOpen(const char* filename) const
 {
-  this->IStream->read(reinterpret_cast<char*>(str), len);
-  if (len != static_cast<size_t>(this->IStream->gcount()))
+  // the file may have been rewritten since it was mapped.
+  return this->Data && filename && this->FileName == filename &&
+    static_cast<size_t>(vtksys::SystemTools::FileLength(filename)) == this->Size &&
+    vtksys::SystemTools::ModifiedTime(filename) == this->ModifiedTime;
+}
+
+//-----------------------------------------------------------------------------
+void vtkSpyPlotMappedFile::Close()
+{
+  if (this->Data)
   {
-    return 0;
+#if defined(_WIN32)
+    UnmapViewOfFile(this->Data);
+#else
+    munmap(const_cast<unsigned char*>(this->Data), this->Size);
+#endif
   }
-  return 1;
+  this->Data = nullptr;
+  this->Size = 0;
+  this->ModifiedTime = 0;
+  this->FileName.clear();
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSpyPlotIStream::Read(void* dest, size_t len)
+{
+  if (this->MappedData)
+  {
+    if (this->MappedPosition < 0 ||
+      static_cast<vtkTypeInt64>(len) > this->MappedSize - this->MappedPosition)
+    {
+      // like istream, reading past the end leaves the stream at the end.
+      this->MappedPosition = this->MappedSize;
+      return false;
+    }
+    memcpy(dest, this->MappedData + this->MappedPosition, len);
+    this->MappedPosition += static_cast<vtkTypeInt64>(len);
+    return true;
+  }
+
+  this->IStream->read(static_cast<char*>(dest), len);
+  return len == static_cast<size_t>(this->IStream->gcount());
+}
+
+//-----------------------------------------------------------------------------
+const unsigned char* vtkSpyPlotIStream::ReadInPlace(size_t len)
+{
+  if (!this->MappedData || this->MappedPosition < 0 ||
+    static_cast<vtkTypeInt64>(len) > this->MappedSize - this->MappedPosition)
+  {
+    return nullptr;
+  }
+  const unsigned char* result = this->MappedData + this->MappedPosition;
+  this->MappedPosition += static_cast<vtkTypeInt64>(len);
+  return result;
+}
+
+//-----------------------------------------------------------------------------
+int vtkSpyPlotIStream::ReadString(char* str, size_t len)
+{
+  return this->Read(str, len) ? 1 : 0;
+}
+//-----------------------------------------------------------------------------
+int vtkSpyPlotIStream::ReadString(unsigned char* str, size_t len)
+{
+  return this->Read(str, len) ? 1 : 0;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSpyPlotIStream::ReadInt32s(int* val, int num)
 {
   size_t len = 4 * num;
-  this->IStream->read(reinterpret_cast<char*>(val), len);
-  if (len != static_cast<size_t>(this->IStream->gcount()))
+  if (!this->Read(val, len))
   {
     return 0;
   }
@@ -41,6 +184,11 @@ int vtkSpyPlotIStream::ReadInt32sNoSwap(int* val, int num)
 {
   size_t len = 4 * num;
 
+  if (this->MappedData)
+  {
+    return this->Read(val, len) ? 1 : 0;
+  }
+
   //
   // We are not going to check the length of the read, rely on the
   // read itself for errors.
@@ -58,17 +206,16 @@ int vtkSpyPlotIStream::ReadInt32sNoSwap(int* val, int num)
 //-----------------------------------------------------------------------------
 int vtkSpyPlotIStream::ReadInt64s(vtkTypeInt64* val, int num)
 {
+  // 64-bit integers are stored as doubles; swap them all at once.
+  std::vector<double> values(num);
+  if (!this->ReadDoubles(values.data(), num))
+  {
+    return 0;
+  }
   int cc;
   for (cc = 0; cc < num; ++cc)
   {
-    double d;
-    int res = this->ReadDoubles(&d, 1);
-    if (!res)
-    {
-      return 0;
-    }
-    *val = static_cast<vtkTypeInt64>(d);
-    val++;
+    val[cc] = static_cast<vtkTypeInt64>(values[cc]);
   }
   return 1;
 }
@@ -76,8 +223,7 @@ int vtkSpyPlotIStream::ReadInt64s(vtkTypeInt64* val, int num)
 int vtkSpyPlotIStream::ReadDoubles(double* val, int num)
 {
   size_t len = 8 * num;
-  this->IStream->read(reinterpret_cast<char*>(val), len);
-  if (len != static_cast<size_t>(this->IStream->gcount()))
+  if (!this->Read(val, len))
   {
     return 0;
   }
@@ -87,7 +233,11 @@ int vtkSpyPlotIStream::ReadDoubles(double* val, int num)
 
 void vtkSpyPlotIStream::Seek(vtkTypeInt64 offset, bool rel)
 {
-  if (rel)
+  if (this->MappedData)
+  {
+    this->MappedPosition = rel ? this->MappedPosition + offset : offset;
+  }
+  else if (rel)
   {
     this->IStream->seekg(offset, ios::cur);
   }
@@ -99,6 +249,10 @@ void vtkSpyPlotIStream::Seek(vtkTypeInt64 offset, bool rel)
 
 vtkTypeInt64 vtkSpyPlotIStream::Tell()
 {
+  if (this->MappedData)
+  {
+    return this->MappedPosition;
+  }
   return this->IStream->tellg();
 }
 
@@ -112,12 +266,24 @@ void vtkSpyPlotIStream::SetStream(istream* ist)
   std::streamsize s = sizeof(char) * (this->FileBufferSize - 1);
   ist->rdbuf()->pubsetbuf(this->Buffer, s);
   this->IStream = ist;
+  this->MappedData = nullptr;
+}
+
+void vtkSpyPlotIStream::SetMappedFile(const vtkSpyPlotMappedFile* file)
+{
+  this->IStream = nullptr;
+  this->MappedData = (file && file->IsOpen()) ? file->GetData() : nullptr;
+  this->MappedSize = this->MappedData ? static_cast<vtkTypeInt64>(file->GetSize()) : 0;
+  this->MappedPosition = 0;
 }
 
 vtkSpyPlotIStream::vtkSpyPlotIStream()
   : FileBufferSize(2097152)
   , Buffer(nullptr)
   , IStream(nullptr)
+  , MappedData(nullptr)
+  , MappedSize(0)
+  , MappedPosition(0)
 {
 }
 
@@ -7,7 +7,8 @@
  * vtkSpyPlotIStream represents input functionality required by
  * the vtkSpyPlotReader and vtkSpyPlotUniReader classes.  The class
  * was factored out of vtkSpyPlotReader.cxx.  The class wraps an already
- * opened istream
+ * opened istream, or a memory-mapped file (see vtkSpyPlotMappedFile) in
+ * which case values are decoded directly from the mapped pages.
  *
  */
 
@@ -17,6 +18,44 @@
 #include "vtkSystemIncludes.h"               // for istream
 #include "vtkType.h"                         // for vtkTypeInt64
 
+#include <string> // for std::string
+
+//-----------------------------------------------------------------------------
+// Read-only memory mapping of a whole file. The file handle is released once
+// mapped, so keeping a mapping open does not use up file descriptors.
+class VTKPVVTKEXTENSIONSIOSPCTH_EXPORT vtkSpyPlotMappedFile
+{
+public:
+  vtkSpyPlotMappedFile();
+  ~vtkSpyPlotMappedFile();
+
+  // Description:
+  // Map `filename`, replacing any existing mapping. Returns false if the file
+  // cannot be mapped (e.g. it is empty or the platform does not support it).
+  bool Open(const char* filename);
+  void Close();
+
+  bool IsOpen() const { return this->Data != nullptr; }
+
+  // Description:
+  // Returns true if `filename` is mapped and has not been modified since, i.e.
+  // its size and modification time are unchanged.
+  bool IsOpen(const char* filename) const;
+  const std::string& GetFileName() const { return this->FileName; }
+  const unsigned char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+
+private:
+  vtkSpyPlotMappedFile(const vtkSpyPlotMappedFile&) = delete;
+  void operator=(const vtkSpyPlotMappedFile&) = delete;
+
+  std::string FileName;
+  const unsigned char* Data;
+  size_t Size;
+  long ModifiedTime;
+};
+
+//-----------------------------------------------------------------------------
 class VTKPVVTKEXTENSIONSIOSPCTH_EXPORT vtkSpyPlotIStream
 {
 public:
@@ -24,6 +63,19 @@ public:
   virtual ~vtkSpyPlotIStream();
   void SetStream(istream*);
   istream* GetStream();
+
+  // Description:
+  // Read from a memory-mapped file instead of an istream. The mapping must
+  // remain open for as long as this stream is used.
+  void SetMappedFile(const vtkSpyPlotMappedFile* file);
+  bool IsMapped() const { return this->MappedData != nullptr; }
+
+  // Description:
+  // For mapped streams, returns a pointer to the next `len` bytes and moves
+  // past them, avoiding a copy. Returns nullptr if the stream is not mapped or
+  // fewer than `len` bytes remain.
+  const unsigned char* ReadInPlace(size_t len);
+
   int ReadString(char* str, size_t len);
   int ReadString(unsigned char* str, size_t len);
   int ReadInt32s(int* val, int num);
@@ -34,9 +86,15 @@ public:
   vtkTypeInt64 Tell();
 
 protected:
+  // Copies `len` bytes from the current position of the stream.
+  bool Read(void* dest, size_t len);
+
   const int FileBufferSize;
   char* Buffer;
   istream* IStream;
+  const unsigned char* MappedData;
+  vtkTypeInt64 MappedSize;
+  vtkTypeInt64 MappedPosition;
 
 private:
   vtkSpyPlotIStream(const vtkSpyPlotIStream&) = delete;
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSpyPlotRunLengthDecoder.h"
+
+#include "vtkByteSwap.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace
+{
+inline float ReadBEFloat(const unsigned char* ptr)
+{
+  float val;
+  memcpy(&val, ptr, sizeof(float));
+  vtkByteSwap::SwapBE(&val);
+  return val;
+}
+
+// Copies `count` big-endian floats from `in` to `out`, scaled by `scale`.
+template <class T>
+void CopyValues(const unsigned char* in, int count, T* out, T scale)
+{
+  for (int k = 0; k < count; ++k)
+  {
+    out[k] = static_cast<T>(::ReadBEFloat(in + 4 * k) * scale);
+  }
+}
+
+// Floats can be copied directly and swapped in place, which vectorizes well.
+void CopyValues(const unsigned char* in, int count, float* out, float)
+{
+  memcpy(out, in, count * sizeof(float));
+  vtkByteSwap::SwapBERange(out, static_cast<size_t>(count));
+}
+
+/* Routine run-length-decodes the data pointed to by *in and
+   returns a collection of values in *out. Each run starts with a
+   byte: values below 128 are followed by a single float repeated
+   that many times, otherwise the byte minus 128 gives the number of
+   floats that follow. */
+template <class T>
+bool RunLengthDecode(const unsigned char* in, int inSize, T* out, int outSize, T scale = 1)
+{
+  int outIndex = 0, inIndex = 0;
+  while ((outIndex < outSize) && (inIndex < inSize))
+  {
+    const int runLength = in[inIndex];
+    if (runLength < 128)
+    {
+      if (inIndex + 5 > inSize || outIndex + runLength > outSize)
+      {
+        return false;
+      }
+      const T value = static_cast<T>(::ReadBEFloat(in + inIndex + 1) * scale);
+      std::fill_n(out + outIndex, runLength, value);
+      outIndex += runLength;
+      inIndex += 5;
+    }
+    else
+    {
+      const int count = runLength - 128;
+      if (inIndex + 1 + 4 * count > inSize || outIndex + count > outSize)
+      {
+        return false;
+      }
+      ::CopyValues(in + inIndex + 1, count, out + outIndex, scale);
+      outIndex += count;
+      inIndex += 4 * count + 1;
+    }
+  }
+  return true;
+}
+}
+
+//-----------------------------------------------------------------------------
+vtkSpyPlotRunLengthDecoder::vtkSpyPlotRunLengthDecoder() = default;
+
+//-----------------------------------------------------------------------------
+vtkSpyPlotRunLengthDecoder::~vtkSpyPlotRunLengthDecoder() = default;
+
+//-----------------------------------------------------------------------------
+bool vtkSpyPlotRunLengthDecoder::Decode(
+  const unsigned char* in, int inSize, float* out, int outSize)
+{
+  return ::RunLengthDecode(in, inSize, out, outSize);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSpyPlotRunLengthDecoder::Decode(const unsigned char* in, int inSize, int* out, int outSize)
+{
+  return ::RunLengthDecode(in, inSize, out, outSize);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSpyPlotRunLengthDecoder::Decode(
+  const unsigned char* in, int inSize, unsigned char* out, int outSize)
+{
+  return ::RunLengthDecode(in, inSize, out, outSize, static_cast<unsigned char>(255));
+}
+
+//-----------------------------------------------------------------------------
+unsigned char* vtkSpyPlotRunLengthDecoder::AddPlane(int inSize, float* out, int outSize)
+{
+  return this->AddPlane(inSize, out, outSize, false);
+}
+
+//-----------------------------------------------------------------------------
+unsigned char* vtkSpyPlotRunLengthDecoder::AddPlane(int inSize, unsigned char* out, int outSize)
+{
+  return this->AddPlane(inSize, out, outSize, true);
+}
+
+//-----------------------------------------------------------------------------
+void vtkSpyPlotRunLengthDecoder::AddPlane(
+  const unsigned char* in, int inSize, float* out, int outSize)
+{
+  this->Planes.push_back(Plane{ in, 0, inSize, out, outSize, false });
+}
+
+//-----------------------------------------------------------------------------
+void vtkSpyPlotRunLengthDecoder::AddPlane(
+  const unsigned char* in, int inSize, unsigned char* out, int outSize)
+{
+  this->Planes.push_back(Plane{ in, 0, inSize, out, outSize, true });
+}
+
+//-----------------------------------------------------------------------------
+unsigned char* vtkSpyPlotRunLengthDecoder::AddPlane(
+  int inSize, void* out, int outSize, bool unsignedChar)
+{
+  const size_t offset = this->Buffer.size();
+  this->Buffer.resize(offset + std::max(inSize, 0));
+  this->Planes.push_back(Plane{ nullptr, offset, inSize, out, outSize, unsignedChar });
+  return this->Buffer.data() + offset;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSpyPlotRunLengthDecoder::Execute()
+{
+  std::atomic<bool> status(true);
+  const unsigned char* buffer = this->Buffer.data();
+  const Plane* planes = this->Planes.data();
+  vtkSMPTools::For(0, this->GetNumberOfPlanes(), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end && status; ++cc)
+    {
+      const Plane& plane = planes[cc];
+      const unsigned char* in = plane.In ? plane.In : buffer + plane.Offset;
+      const bool decoded = plane.UnsignedChar
+        ? Decode(in, plane.InSize, static_cast<unsigned char*>(plane.Out), plane.OutSize)
+        : Decode(in, plane.InSize, static_cast<float*>(plane.Out), plane.OutSize);
+      if (!decoded)
+      {
+        status = false;
+      }
+    }
+  });
+  this->Reset();
+  return status;
+}
+
+//-----------------------------------------------------------------------------
+void vtkSpyPlotRunLengthDecoder::Reset()
+{
+  this->Buffer.clear();
+  this->Planes.clear();
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkSpyPlotRunLengthDecoder
+ *
+ * vtkSpyPlotRunLengthDecoder decodes the run-length encoded planes found in
+ * SpyPlot (CTH) files. Planes can either be decoded one at a time using the
+ * static `Decode` methods, or queued using `AddPlane` and decoded concurrently
+ * using vtkSMPTools by calling `Execute`. The latter is used by
+ * vtkSpyPlotUniReader to decode all planes of all blocks of a variable at once.
+ *
+ * Output to unsigned char is scaled by 255, as is used for volume fractions.
+ */
+
+#ifndef vtkSpyPlotRunLengthDecoder_h
+#define vtkSpyPlotRunLengthDecoder_h
+
+#include "vtkPVVTKExtensionsIOSPCTHModule.h" //needed for exports
+#include "vtkType.h"                         // for vtkIdType
+
+#include <cstddef> // for size_t
+#include <vector>  // for std::vector
+
+class VTKPVVTKEXTENSIONSIOSPCTH_EXPORT vtkSpyPlotRunLengthDecoder
+{
+public:
+  vtkSpyPlotRunLengthDecoder();
+  ~vtkSpyPlotRunLengthDecoder();
+
+  // Description:
+  // Decode `inSize` bytes from `in` into `outSize` values in `out`.
+  // Returns false if the input is corrupt or decodes to more than
+  // `outSize` values.
+  static bool Decode(const unsigned char* in, int inSize, float* out, int outSize);
+  static bool Decode(const unsigned char* in, int inSize, int* out, int outSize);
+  static bool Decode(const unsigned char* in, int inSize, unsigned char* out, int outSize);
+
+  // Description:
+  // Queue a plane to decode into `out`. Returns a buffer of `inSize` bytes
+  // in which the caller must store the encoded plane. The buffer is only valid
+  // until the next call to `AddPlane`.
+  unsigned char* AddPlane(int inSize, float* out, int outSize);
+  unsigned char* AddPlane(int inSize, unsigned char* out, int outSize);
+
+  // Description:
+  // Queue a plane to decode from `in`, which must remain valid until
+  // `Execute` is called. Used to decode directly from memory-mapped files.
+  void AddPlane(const unsigned char* in, int inSize, float* out, int outSize);
+  void AddPlane(const unsigned char* in, int inSize, unsigned char* out, int outSize);
+
+  // Description:
+  // Decode all queued planes concurrently. Returns false if any plane failed
+  // to decode. The queue is cleared in either case.
+  bool Execute();
+
+  // Description:
+  // Returns the number of queued planes.
+  vtkIdType GetNumberOfPlanes() const { return static_cast<vtkIdType>(this->Planes.size()); }
+
+  // Description:
+  // Remove all queued planes.
+  void Reset();
+
+private:
+  vtkSpyPlotRunLengthDecoder(const vtkSpyPlotRunLengthDecoder&) = delete;
+  void operator=(const vtkSpyPlotRunLengthDecoder&) = delete;
+
+  struct Plane
+  {
+    // Input is either external or at `Offset` in `Buffer`.
+    const unsigned char* In;
+    size_t Offset;
+    int InSize;
+    void* Out;
+    int OutSize;
+    bool UnsignedChar;
+  };
+
+  unsigned char* AddPlane(int inSize, void* out, int outSize, bool unsignedChar);
+
+  std::vector<unsigned char> Buffer;
+  std::vector<Plane> Planes;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSpyPlotRunLengthDecoder.h
@@ -9,6 +9,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
+#include "vtkSpyPlotRunLengthDecoder.h"
 #include "vtkUnsignedCharArray.h"
 
 #include "vtksys/FStream.hxx"
@@ -43,6 +44,29 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+namespace
+{
+// Sets up `spis` to read `filename`, preferably through `mappedFile` which is
+// only (re)mapped if it does not already map that file. Otherwise, falls back
+// to reading through `ifs`.
+bool vtkSpyPlotOpenStream(const char* filename, vtkSpyPlotMappedFile* mappedFile,
+  vtksys::ifstream& ifs, vtkSpyPlotIStream& spis)
+{
+  if (mappedFile->IsOpen(filename) || mappedFile->Open(filename))
+  {
+    spis.SetMappedFile(mappedFile);
+    return true;
+  }
+  ifs.open(filename, ios::binary | ios::in);
+  if (!ifs)
+  {
+    return false;
+  }
+  spis.SetStream(&ifs);
+  return true;
+}
+}
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -72,6 +96,7 @@ vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 
   this->DataDumps = nullptr;
   this->Blocks = nullptr;
+  this->MappedFile = new vtkSpyPlotMappedFile;
 
   this->CellArraySelection = nullptr;
 
@@ -98,6 +123,8 @@ vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::~vtkSpyPlotUniReader()
 {
+  delete this->MappedFile;
+
   // Cleanup header
   delete[] this->CellFields;
   delete[] this->MaterialFields;
@@ -217,9 +244,13 @@ int vtkSpyPlotUniReader::MakeCurrent()
   }
 
   std::vector<unsigned char> arrayBuffer;
-  vtksys::ifstream ifs(this->FileName, ios::binary | ios::in);
+  vtksys::ifstream ifs;
   vtkSpyPlotIStream spis;
-  spis.SetStream(&ifs);
+  if (!::vtkSpyPlotOpenStream(this->FileName, this->MappedFile, ifs, spis))
+  {
+    vtkErrorMacro("Cannot open file: " << this->FileName);
+    return 0;
+  }
   int dump;
   vtkSpyPlotUniReader::DataDump* dp;
   int blocksUpdated = 0;
@@ -392,6 +423,8 @@ int vtkSpyPlotUniReader::MakeCurrent()
     // << " [" << var->Name << "]" );
     // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
     spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
+    // The planes of all blocks are read first and then decoded concurrently.
+    vtkSpyPlotRunLengthDecoder decoder;
     int numBytes;
     int block;
     int actualBlockId = 0;
@@ -433,32 +466,48 @@ int vtkSpyPlotUniReader::MakeCurrent()
             vtkErrorMacro("Problem reading the number of bytes");
             return 0;
           }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
+          if ((floatArray || unsignedCharArray) && spis.IsMapped())
           {
-            arrayBuffer.resize(numBytes);
+            // decode straight from the mapped file.
+            const unsigned char* in = spis.ReadInPlace(numBytes);
+            if (!in)
+            {
+              vtkErrorMacro("Problem reading the bytes");
+              return 0;
+            }
+            if (floatArray)
+            {
+              decoder.AddPlane(in, numBytes, floatArray->GetPointer(zax * planeSize), planeSize);
+            }
+            else
+            {
+              decoder.AddPlane(
+                in, numBytes, unsignedCharArray->GetPointer(zax * planeSize), planeSize);
+            }
+            continue;
           }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
+          unsigned char* buffer;
+          if (floatArray)
           {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
+            buffer = decoder.AddPlane(numBytes, floatArray->GetPointer(zax * planeSize), planeSize);
           }
-          if (floatArray)
+          else if (unsignedCharArray)
           {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding float data array");
-              return 0;
-            }
+            buffer =
+              decoder.AddPlane(numBytes, unsignedCharArray->GetPointer(zax * planeSize), planeSize);
           }
-          if (unsignedCharArray)
+          else
           {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
+            if (static_cast<int>(arrayBuffer.size()) < numBytes)
             {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
-              return 0;
+              arrayBuffer.resize(numBytes);
             }
+            buffer = &*arrayBuffer.begin();
+          }
+          if (!spis.ReadString(buffer, numBytes))
+          {
+            vtkErrorMacro("Problem reading the bytes");
+            return 0;
           }
         }
         if (dataArray)
@@ -470,6 +519,11 @@ int vtkSpyPlotUniReader::MakeCurrent()
         }
       }
     }
+    if (!decoder.Execute())
+    {
+      vtkErrorMacro("Problem RLD decoding data array: " << var->Name);
+      return 0;
+    }
   }
 
   if (blocksUpdated && needMarkers)
@@ -658,95 +712,43 @@ void vtkSpyPlotUniReader::PrintInformation()
    Note: *out needs to be allocated by the calling application.
    Its worst-case size is 5*n bytes. */
 
-/* Routine run-length-decodes the data pointed to by *in and
-   returns a collection of doubles in *data. Performs the
-   inverse of rle above. Application should provide both
-   n (the expected number of doubles) and n_in the number
-   of bytes to decode from *in. Again, the application needs
-   to provide allocated space for *data which will be
-   n bytes long. */
-
-//-----------------------------------------------------------------------------
-template <class t>
-int vtkSpyPlotUniReaderRunLengthDataDecode(
-  vtkSpyPlotUniReader* self, const unsigned char* in, int inSize, t* out, int outSize, t scale = 1)
-{
-  int outIndex = 0, inIndex = 0;
-
-  const unsigned char* ptmp = in;
-
-  /* Run-length decode */
-  while ((outIndex < outSize) && (inIndex < inSize))
-  {
-    // Okay get the run length
-    unsigned char runLength = *ptmp;
-    ptmp++;
-    if (runLength < 128)
-    {
-      float val;
-      memcpy(&val, ptmp, sizeof(float));
-      vtkByteSwap::SwapBE(&val);
-      ptmp += 4;
-      // Now populate the out data
-      int k;
-      for (k = 0; k < runLength; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(
-            self, "Problem doing RLD decode. Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-      }
-      inIndex += 5;
-    }
-    else // runLength >= 128
-    {
-      int k;
-      for (k = 0; k < runLength - 128; ++k)
-      {
-        if (outIndex >= outSize)
-        {
-          vtkErrorWithObjectMacro(
-            self, "Problem doing RLD decode. Too much data generated. Expected: " << outSize);
-          return 0;
-        }
-        float val;
-        memcpy(&val, ptmp, sizeof(float));
-        vtkByteSwap::SwapBE(&val);
-        out[outIndex] = static_cast<t>(val * scale);
-        outIndex++;
-        ptmp += 4;
-      }
-      inIndex += 4 * (runLength - 128) + 1;
-    }
-  } // while
-
-  return 1;
-}
-
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, float* out, int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(this, in, inSize, out, outSize);
+  if (!vtkSpyPlotRunLengthDecoder::Decode(in, inSize, out, outSize))
+  {
+    vtkErrorMacro(
+      "Problem doing RLD decode. Corrupt data or too much data generated. Expected: " << outSize);
+    return 0;
+  }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, int* out, int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(this, in, inSize, out, outSize);
+  if (!vtkSpyPlotRunLengthDecoder::Decode(in, inSize, out, outSize))
+  {
+    vtkErrorMacro(
+      "Problem doing RLD decode. Corrupt data or too much data generated. Expected: " << outSize);
+    return 0;
+  }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::RunLengthDataDecode(
   const unsigned char* in, int inSize, unsigned char* out, int outSize)
 {
-  return ::vtkSpyPlotUniReaderRunLengthDataDecode(
-    this, in, inSize, out, outSize, static_cast<unsigned char>(255));
+  if (!vtkSpyPlotRunLengthDecoder::Decode(in, inSize, out, outSize))
+  {
+    vtkErrorMacro(
+      "Problem doing RLD decode. Corrupt data or too much data generated. Expected: " << outSize);
+    return 0;
+  }
+  return 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -1363,14 +1365,13 @@ int vtkSpyPlotUniReader::ReadInformation()
     vtkErrorMacro("FileName not specified");
     return 0;
   }
-  vtksys::ifstream ifs(this->FileName, ios::binary | ios::in);
-  if (!ifs)
+  vtksys::ifstream ifs;
+  vtkSpyPlotIStream spis;
+  if (!::vtkSpyPlotOpenStream(this->FileName, this->MappedFile, ifs, spis))
   {
     vtkErrorMacro("Cannot open file: " << this->FileName);
     return 0;
   }
-  vtkSpyPlotIStream spis;
-  spis.SetStream(&ifs);
 
   if (!this->ReadHeader(&spis))
   {
@@ -32,6 +32,7 @@ class vtkFloatArray;
 class vtkIntArray;
 class vtkUnsignedCharArray;
 class vtkSpyPlotIStream;
+class vtkSpyPlotMappedFile;
 
 class VTKPVVTKEXTENSIONSIOSPCTH_EXPORT vtkSpyPlotUniReader : public vtkObject
 {
@@ -279,6 +280,9 @@ private:
   // File name
   char* FileName;
 
+  // Memory mapping of FileName shared by ReadInformation and MakeCurrent
+  vtkSpyPlotMappedFile* MappedFile;
+
   // Was information read
   int HaveInformation;
 
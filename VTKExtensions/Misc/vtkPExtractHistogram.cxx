@@ -18,9 +18,22 @@
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
+namespace
+{
+bool IsAverageArray(vtkAbstractArray* array)
+{
+  vtksys::RegularExpression reg_ex("^(.*)_average$");
+  return array->GetName() && reg_ex.find(array->GetName());
+}
+}
+
 vtkStandardNewMacro(vtkPExtractHistogram);
 vtkCxxSetObjectMacro(vtkPExtractHistogram, Controller, vtkMultiProcessController);
 //-----------------------------------------------------------------------------
@@ -90,84 +103,185 @@ int vtkPExtractHistogram::RequestData(
   {
     vtkSmartPointer<vtkDataArray> oldExtents =
       output->GetRowData()->GetArray(this->BinExtentsArrayName);
-    if (oldExtents == nullptr)
+    if (this->ReduceBinsInPlace(output))
+    {
+      if (!isRoot)
+      {
+        output->Initialize();
+      }
+    }
+    else if (oldExtents == nullptr)
     {
       // Nothing to do if there is no data
       return 1;
     }
-    // Now we need to collect and reduce data from all nodes on the root.
-    vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
-    reduceFilter->SetController(this->Controller);
+    else if (!this->ReduceBinsUsingReductionFilter(output, oldExtents))
+    {
+      return 0;
+    }
+  }
 
-    if (isRoot)
+  if (isRoot)
+  {
+    if (this->Normalize)
+    {
+      this->Superclass::NormalizeBins(output);
+    }
+    if (this->Accumulation)
     {
-      // PostGatherHelper needs to be set only on the root node.
-      vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
-        vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
-      rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
-      rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
-      reduceFilter->SetPostGatherHelper(rf);
+      this->Superclass::AccumulateBins(output);
     }
+  }
 
-    vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
-    copy->ShallowCopy(output);
-    reduceFilter->SetInputData(copy);
-    reduceFilter->Update();
-    if (isRoot)
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ReduceBinsInPlace(vtkTable* output)
+{
+  // Collect the arrays to sum up. The bin extents are the same on all ranks and
+  // averages are recomputed from the totals, so these are skipped.
+  std::vector<vtkDataArray*> arrays;
+  std::string signature;
+  vtkIdType numberOfValues = 0;
+  vtkDataSetAttributes* rowData = output->GetRowData();
+  if (rowData->GetArray(this->BinExtentsArrayName) != nullptr)
+  {
+    for (int cc = 0, max = rowData->GetNumberOfArrays(); cc < max; ++cc)
     {
-      // We save the old bin extents and then revert to be restored later since
-      // the reduction reduces the bin extents as well.
-      output->ShallowCopy(reduceFilter->GetOutput());
-      if (output->GetRowData()->GetNumberOfArrays() == 0)
+      vtkDataArray* array = rowData->GetArray(cc);
+      if (array == nullptr || array->GetName() == nullptr ||
+        strcmp(array->GetName(), this->BinExtentsArrayName) == 0 || ::IsAverageArray(array))
       {
-        vtkErrorMacro(<< "Reduced data has 0 arrays");
-        return 0;
+        continue;
       }
-      output->GetRowData()->GetArray(this->BinExtentsArrayName)->DeepCopy(oldExtents);
-      if (this->CalculateAverages)
+      arrays.push_back(array);
+      numberOfValues += array->GetNumberOfValues();
+      signature += array->GetName();
+      signature += ":" + std::to_string(array->GetNumberOfValues()) + ";";
+    }
+  }
+
+  // The direct reduction is only possible if all ranks have the same arrays
+  // with the same number of values. Check that using a single collective.
+  const long long hash = static_cast<long long>(std::hash<std::string>{}(signature) >> 2);
+  const long long local[4] = { numberOfValues, -numberOfValues, hash, -hash };
+  long long global[4];
+  if (!this->Controller->AllReduce(local, global, 4, vtkCommunicator::MAX_OP))
+  {
+    vtkErrorMacro("Parallel communication error.");
+    return false;
+  }
+  if (numberOfValues == 0 || global[0] != -global[1] || global[2] != -global[3])
+  {
+    return false;
+  }
+
+  // Pack all values in a single buffer and sum them up on the root.
+  std::vector<double> sendBuffer(numberOfValues);
+  auto iter = sendBuffer.begin();
+  for (vtkDataArray* array : arrays)
+  {
+    const auto range = vtk::DataArrayValueRange(array);
+    iter = std::copy(range.cbegin(), range.cend(), iter);
+  }
+
+  const bool isRoot = this->Controller->GetLocalProcessId() == 0;
+  std::vector<double> recvBuffer(isRoot ? numberOfValues : 0);
+  if (!this->Controller->Reduce(
+        sendBuffer.data(), recvBuffer.data(), numberOfValues, vtkCommunicator::SUM_OP, 0))
+  {
+    vtkErrorMacro("Parallel communication error. Could not reduce bins.");
+    return false;
+  }
+
+  if (isRoot)
+  {
+    auto riter = recvBuffer.cbegin();
+    for (vtkDataArray* array : arrays)
+    {
+      auto range = vtk::DataArrayValueRange(array);
+      std::copy(riter, riter + range.size(), range.begin());
+      riter += range.size();
+      array->Modified();
+    }
+    this->ComputeAverages(output);
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPExtractHistogram::ComputeAverages(vtkTable* output)
+{
+  if (!this->CalculateAverages)
+  {
+    return;
+  }
+
+  vtkDataArray* bin_values = output->GetRowData()->GetArray(this->BinValuesArrayName);
+  vtksys::RegularExpression reg_ex("^(.*)_average$");
+  int numArrays = output->GetRowData()->GetNumberOfArrays();
+  for (int i = 0; i < numArrays; i++)
+  {
+    vtkDataArray* array = output->GetRowData()->GetArray(i);
+    if (array && reg_ex.find(array->GetName()))
+    {
+      int numComps = array->GetNumberOfComponents();
+      std::string name = reg_ex.match(1) + "_total";
+      vtkDataArray* tarray = output->GetRowData()->GetArray(name.c_str());
+      for (vtkIdType idx = 0; idx < this->BinCount; idx++)
       {
-        vtkDataArray* bin_values = output->GetRowData()->GetArray(this->BinValuesArrayName);
-        vtksys::RegularExpression reg_ex("^(.*)_average$");
-        int numArrays = output->GetRowData()->GetNumberOfArrays();
-        for (int i = 0; i < numArrays; i++)
+        for (int j = 0; j < numComps; j++)
         {
-          vtkDataArray* array = output->GetRowData()->GetArray(i);
-          if (array && reg_ex.find(array->GetName()))
-          {
-            int numComps = array->GetNumberOfComponents();
-            std::string name = reg_ex.match(1) + "_total";
-            vtkDataArray* tarray = output->GetRowData()->GetArray(name.c_str());
-            for (vtkIdType idx = 0; idx < this->BinCount; idx++)
-            {
-              for (int j = 0; j < numComps; j++)
-              {
-                array->SetComponent(
-                  idx, j, tarray->GetComponent(idx, j) / bin_values->GetTuple1(idx));
-              }
-            }
-          }
+          array->SetComponent(idx, j, tarray->GetComponent(idx, j) / bin_values->GetTuple1(idx));
         }
       }
     }
-    else
-    {
-      output->Initialize();
-    }
   }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ReduceBinsUsingReductionFilter(
+  vtkTable* output, vtkDataArray* oldExtents)
+{
+  const bool isRoot = this->Controller->GetLocalProcessId() == 0;
+
+  // Now we need to collect and reduce data from all nodes on the root.
+  vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
+  reduceFilter->SetController(this->Controller);
 
   if (isRoot)
   {
-    if (this->Normalize)
-    {
-      this->Superclass::NormalizeBins(output);
-    }
-    if (this->Accumulation)
+    // PostGatherHelper needs to be set only on the root node.
+    vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
+      vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
+    rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
+    rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+    reduceFilter->SetPostGatherHelper(rf);
+  }
+
+  vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
+  copy->ShallowCopy(output);
+  reduceFilter->SetInputData(copy);
+  reduceFilter->Update();
+  if (isRoot)
+  {
+    // We save the old bin extents and then revert to be restored later since
+    // the reduction reduces the bin extents as well.
+    output->ShallowCopy(reduceFilter->GetOutput());
+    if (output->GetRowData()->GetNumberOfArrays() == 0)
     {
-      this->Superclass::AccumulateBins(output);
+      vtkErrorMacro(<< "Reduced data has 0 arrays");
+      return false;
     }
+    output->GetRowData()->GetArray(this->BinExtentsArrayName)->DeepCopy(oldExtents);
+    this->ComputeAverages(output);
   }
-
-  return 1;
+  else
+  {
+    output->Initialize();
+  }
+  return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -7,6 +7,10 @@
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
  * It gathers the histogram data on the root node.
+ *
+ * When all ranks produce the same set of bin arrays, the bin values are summed
+ * on the root using a single `vtkCommunicator::SUM_OP` reduction. Otherwise,
+ * the histogram tables are gathered and summed using vtkReductionFilter.
  */
 
 #ifndef vtkPExtractHistogram_h
@@ -15,7 +19,9 @@
 #include "vtkExtractHistogram.h"
 #include "vtkPVVTKExtensionsMiscModule.h" //needed for exports
 
+class vtkDataArray;
 class vtkMultiProcessController;
+class vtkTable;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -46,6 +52,25 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Sums the bin arrays from all ranks on the root using a single reduction.
+   * Returns false, on all ranks, if the ranks don't have matching arrays, in
+   * which case `output` is left unchanged.
+   */
+  bool ReduceBinsInPlace(vtkTable* output);
+
+  /**
+   * Gathers the histogram tables on the root and sums them using
+   * vtkReductionFilter. Used when `ReduceBinsInPlace` is not applicable.
+   */
+  bool ReduceBinsUsingReductionFilter(vtkTable* output, vtkDataArray* oldExtents);
+
+  /**
+   * Computes the `*_average` arrays from the `*_total` arrays, if
+   * CalculateAverages is enabled.
+   */
+  void ComputeAverages(vtkTable* output);
+
   vtkMultiProcessController* Controller;
 
 private:
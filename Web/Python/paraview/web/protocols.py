@@ -455,6 +455,49 @@ class ParaViewWebViewPortImageDelivery(ParaViewWebProtocol):
 
         return reply
 
+    # RpcName: stillRenderDelta => viewport.image.delta.render
+    @exportRpc("viewport.image.delta.render")
+    def stillRenderDelta(self, options):
+        """
+        RPC Callback to render a view and obtain a delta-encoded frame. The
+        optional "reference" option is the id of the frame displayed by the
+        client; a key frame is returned when it is not the last acknowledged
+        frame.
+        """
+        beginTime = int(round(time.time() * 1000))
+        view = self.getView(options["view"])
+        quality = options.get("quality", 100)
+        reference = options.get("reference", -1)
+        app = self.getApplication()
+        frame = app.StillRenderDelta(view.SMProxy, quality, reference)
+
+        reply = {}
+        reply["image"] = (
+            base64.standard_b64encode(memoryview(frame).tobytes()).decode("ascii")
+            if frame
+            else None
+        )
+        reply["keyFrame"] = app.GetLastDeltaFrameIsKeyFrame()
+        reply["size"] = view.ViewSize[0:2]
+        reply["format"] = "delta;base64"
+        reply["global_id"] = view.GetGlobalIDAsString()
+
+        endTime = int(round(time.time() * 1000))
+        reply["workTime"] = endTime - beginTime
+
+        return reply
+
+    # RpcName: acknowledgeFrame => viewport.image.delta.ack
+    @exportRpc("viewport.image.delta.ack")
+    def acknowledgeFrame(self, viewId, frameId):
+        """
+        RPC Callback to notify that the client has received and displayed a
+        delta-encoded frame, which then becomes the reference for later frames.
+        """
+        view = self.getView(viewId)
+        self.getApplication().AcknowledgeFrame(view.SMProxy, frameId)
+        return {"result": "success"}
+
 
 # =============================================================================
 #
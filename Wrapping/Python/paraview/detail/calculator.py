@@ -16,8 +16,11 @@ from vtkmodules.numpy_interface.algorithms import *
 from paraview.vtk import vtkDataObject, vtkDoubleArray, vtkSelectionNode, vtkSelection, vtkStreamingDemandDrivenPipeline
 from paraview.modules import vtkPVVTKExtensionsFiltersPython
 from paraview.vtk.util.numpy_support import get_numpy_array_type
+import re
 import sys
 import textwrap
+from concurrent.futures import ThreadPoolExecutor
+from functools import lru_cache
 
 if sys.version_info >= (3,):
     xrange = range
@@ -135,6 +138,26 @@ def cellContainsPoint(inputs, locations):
     return output.CellData.GetArray('vtkInsidedness')
 
 
+@lru_cache(maxsize=32)
+def compile_expression(expression, multiline=False):
+    """Compiles `expression` to the list of code objects evaluated by
+    `compute`. Results are cached so that expressions are compiled once,
+    not once per block or per execution."""
+    if multiline:
+        # Wrap multiline expressions returning a value in a function, and evaluate it.
+        if "return" not in expression:
+            raise ValueError(
+                "Multiline expression does not contain a return statement.")
+
+        multilineFunction = f'def func():\n' \
+                            f'{textwrap.indent(expression, " " * 4)}\n' \
+                            f'result = func()\n'
+        return [compile(multilineFunction, "<calculator>", "exec")]
+
+    # ' and ' is used in 'extract_selection' to find data matching multiple criteria
+    return [compile(subEx, "<calculator>", "eval") for subEx in expression.split(' and ')]
+
+
 def compute(inputs, expression, ns=None, multiline=False):
     #  build the locals environment used to eval the expression.
     mylocals = dict()
@@ -146,25 +169,18 @@ def compute(inputs, expression, ns=None, multiline=False):
     except AttributeError:
         pass
 
+    codes = compile_expression(expression, multiline)
     if multiline:
-        # Wrap multiline expressions returning a value in a function, and evaluate it.
-        if "return" not in expression:
-            raise ValueError(
-                "Multiline expression does not contain a return statement.")
-
-        multilineFunction = f'def func():\n' \
-                            f'{textwrap.indent(expression, " " * 4)}\n' \
-                            f'result = func()\n'
         returnValueDict = {}
 
         # `mylocals` need to be in the global `exec` scope, otherwise it would not be accessible inside the `func` scope
-        exec(multilineFunction, dict(globals(), **mylocals), returnValueDict)
+        exec(codes[0], dict(globals(), **mylocals), returnValueDict)
 
         return returnValueDict['result']
     else:
         finalRet = None
-        for subEx in expression.split(' and '):  # Used in 'extract_selection' to find data matching multiple criteria
-            retVal = eval(subEx, globals(), mylocals)
+        for code in codes:
+            retVal = eval(code, globals(), mylocals)
             if finalRet is None:
                 finalRet = retVal
             else:
@@ -172,6 +188,130 @@ def compute(inputs, expression, ns=None, multiline=False):
         return finalRet
 
 
+def get_block_arrays(attribs, names, dataset):
+    """Returns a 'dict' referring to the arrays of the vtkDataSetAttributes
+    `attribs` of a single block, using the variable names in `names`, a 'dict'
+    mapping array names to variable names. Arrays are wrapped without copying
+    their values. Variables without an array in this block are NoneArray."""
+    arrays = dict.fromkeys(names.values(), dsa.NoneArray)
+    if attribs is None:
+        return arrays
+    for index in range(attribs.GetNumberOfArrays()):
+        array = attribs.GetArray(index)
+        if array is None or array.GetName() not in names:
+            continue
+        # vtkDataArrayToVTKArray shares the memory of the VTK array.
+        arrays[names[array.GetName()]] = dsa.vtkDataArrayToVTKArray(array, dataset)
+    return arrays
+
+
+def convert_result(self, retVal):
+    """Converts the result array type if requested."""
+    if self.GetResultArrayType() == -1:
+        return retVal
+    dtype = get_numpy_array_type(self.GetResultArrayType())
+    # avoid copying arrays that already have the requested type.
+    if isinstance(retVal, np.ndarray):
+        return retVal.astype(dtype, copy=False)
+    # handles VTKCompositeDataArray
+    if hasattr(retVal, "astype"):
+        return retVal.astype(dtype)
+    # we can also get a scalar, convert to single element array of correct type
+    return numpy.asarray(retVal, dtype)
+
+
+def append_result(self, output, retVal):
+    """Adds `retVal` to the attributes of the wrapped `output`."""
+    # by default, use filter ArrayAssociation for output attribute.
+    outputAttribute = output.GetAttributes(self.GetArrayAssociation())
+    outputToFieldData = self.GetArrayAssociation() == dsa.ArrayAssociation.FIELD
+
+    # if the computation changes this association for anything other than FIELD, use it instead.
+    # this is useful for some custom methods, like `volume` that apply only for some Array Association (CELL in the example)
+    if not outputToFieldData \
+            and hasattr(retVal, "Association") \
+            and retVal.Association not in [None, dsa.ArrayAssociation.FIELD]:
+        outputAttribute = output.GetAttributes(retVal.Association)
+
+    outputAttribute.append(convert_result(self, retVal), self.GetArrayName())
+
+
+# functions of vtkmodules.numpy_interface.algorithms that reduce over the whole
+# dataset, across ranks when running in parallel.
+_global_reduction = re.compile(r"\b(?:max|min|sum|mean|var|std|all)(?:_per_block)?\s*\(")
+
+
+def can_execute_blocks(expression):
+    """Returns True if `expression` can be evaluated on each block independently
+    by `execute_blocks`. Global reductions, such as `max(x)`, need the whole
+    dataset, and when running with several ranks, any function may communicate
+    with the other ranks, which must not happen on several threads at once."""
+    controller = vtkMultiProcessController.GetGlobalController() \
+        if vtkMultiProcessController is not None else None
+    if controller and controller.GetNumberOfProcesses() > 1:
+        return False
+    return _global_reduction.search(expression) is None
+
+
+def execute_blocks(self, inputs, output, expression, ns, multiline):
+    """Evaluates `expression` on each leaf of the composite dataset `inputs[0]`
+    independently, distributing chunks of leaves over a pool of threads.
+    numpy releases the GIL inside its kernels, so the arithmetic of different
+    blocks runs concurrently. Only used for expressions accepted by
+    `can_execute_blocks`."""
+    inputDO = inputs[0].VTKObject
+    outputDO = output.VTKObject
+    association = self.GetArrayAssociation()
+
+    # variable names are valid for every block, even those missing an array.
+    names = dict()
+    for key in inputs[0].GetAttributes(association).keys():
+        names[key] = paraview.make_name_valid(key)
+    for varname in ns:
+        if varname not in names.values() and ns[varname] is dsa.NoneArray:
+            names[varname] = varname
+
+    blocks = []
+    it = inputDO.NewIterator()
+    it.SkipEmptyNodesOn()
+    it.InitTraversal()
+    while not it.IsDoneWithTraversal():
+        blocks.append((it.GetCurrentDataObject(), outputDO.GetDataSet(it)))
+        it.GoToNextItem()
+
+    def evaluate(chunk):
+        results = []
+        for block, _ in chunk:
+            wrapped = dsa.WrapDataObject(block)
+            wrapped.time_value = wrapped.t_value = inputs[0].time_value
+            wrapped.time_index = wrapped.t_index = inputs[0].time_index
+            variables = dict(ns)
+            variables.update(get_block_arrays(
+                block.GetAttributes(association) if association != dsa.ArrayAssociation.FIELD
+                else block.GetFieldData(), names, block))
+            results.append(compute([wrapped], expression, ns=variables, multiline=multiline))
+        return results
+
+    try:
+        from vtkmodules.vtkCommonCore import vtkSMPTools
+        numberOfThreads = vtkSMPTools.GetEstimatedNumberOfThreads()
+    except ImportError:
+        import os
+        numberOfThreads = os.cpu_count() or 1
+    numberOfThreads = max(1, numberOfThreads)
+    # a few chunks per thread balance the load while keeping the per-task
+    # overhead low for datasets with many small blocks.
+    chunkSize = max(1, len(blocks) // (4 * numberOfThreads))
+    chunks = [blocks[i:i + chunkSize] for i in range(0, len(blocks), chunkSize)]
+    with ThreadPoolExecutor(max_workers=numberOfThreads) as executor:
+        results = executor.map(evaluate, chunks)
+        # results are added to the output on this thread, in order.
+        for chunk, chunkResults in zip(chunks, results):
+            for (_, outputBlock), retVal in zip(chunk, chunkResults):
+                if retVal is not None and retVal is not dsa.NoneArray and outputBlock is not None:
+                    append_result(self, dsa.WrapDataObject(outputBlock), retVal)
+
+
 def get_data_time(self, do, ininfo):
     dinfo = do.GetInformation()
     if dinfo and dinfo.Has(do.DATA_TIME_STEP()):
@@ -231,28 +371,13 @@ def execute(self, expression, multiline=False):
                       "t_value": inputs[0].t_value,
                       "time_index": inputs[0].time_index,
                       "t_index": inputs[0].t_index})
+    if self.GetEvaluateBlocksConcurrently() and len(inputs) == 1 \
+            and inputs[0].VTKObject.IsA("vtkCompositeDataSet") \
+            and can_execute_blocks(expression):
+        execute_blocks(self, inputs, output, expression, variables, multiline)
+        return
+
     retVal = compute(inputs, expression, ns=variables, multiline=multiline)
 
     if retVal is not None:
-        vtkRet = retVal
-        # Convert the result array type if requested.
-        if self.GetResultArrayType() != -1:
-            # handles VTKArray and VTKCompositeDataArray
-            if hasattr(retVal, "astype"):
-                vtkRet = retVal.astype(get_numpy_array_type(self.GetResultArrayType()))
-            else:
-                # we can also get a scalar, convert to single element array of correct type
-                vtkRet = numpy.asarray(retVal, get_numpy_array_type(self.GetResultArrayType()))
-
-        # by default, use filter ArrayAssociation for output attribute.
-        outputAttribute = output.GetAttributes(self.GetArrayAssociation())
-        outputToFieldData = self.GetArrayAssociation() == dsa.ArrayAssociation.FIELD
-
-        # if the computation changes this association for anything other than FIELD, use it instead.
-        # this is useful for some custom methods, like `volume` that apply only for some Array Association (CELL in the example)
-        if not outputToFieldData \
-                and hasattr(retVal, "Association") \
-                and retVal.Association not in [None, dsa.ArrayAssociation.FIELD]:
-            outputAttribute = output.GetAttributes(retVal.Association)
-
-        outputAttribute.append(vtkRet, self.GetArrayName())
+        append_result(self, output, retVal)